@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+/****
+ * Benchmark of the binary checkpoint of Circuit. On a synthetic circuit, it
+ * measures Circuit::SaveCheckpoint() and Circuit::LoadCheckpoint(), and checks
+ * that the loaded circuit has the same blocks, nets and HPWL.
+ *
+ * usage: circuit_checkpoint_bench [num_cells] [checkpoint_file] [num_threads]
+ * ****/
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+
+#include "dali/circuit/circuit.h"
+#include "dali/common/elapsed_time.h"
+
+using namespace dali;
+
+namespace {
+
+// Cells are placed randomly, and net i connects cell i to cells nearby. Most
+// nets have 2 to 5 pins, every 100th net has 40 pins.
+void BuildCircuit(Circuit& circuit, int num_cells) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  BlockType* cell = circuit.AddBlockType("CELL", 1.2, 1.6);
+  for (int p = 0; p < 4; ++p) {
+    Pin* pin = circuit.AddBlkTypePin(cell, "P" + std::to_string(p), p != 3);
+    pin->SetOffset(0.2 * p, 0.4 * p);
+  }
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 10000000, 10000000);
+  circuit.ReserveSpaceForDesignImp(num_cells, 0, num_cells);
+  for (int i = 0; i < num_cells; ++i) {
+    circuit.AddBlock("c" + std::to_string(i), "CELL", 0, 0, PLACED, N, true);
+  }
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> dist(0, 50000);
+  for (auto& block : circuit.Blocks()) {
+    block.SetLoc(dist(rng), dist(rng));
+  }
+  for (int i = 0; i < num_cells; ++i) {
+    std::string net_name = "n" + std::to_string(i);
+    int fanout = i % 100 == 0 ? 40 : 2 + i % 4;
+    fanout = std::min(fanout, num_cells - i);
+    circuit.AddNet(net_name, fanout);
+    for (int k = 0; k < fanout; ++k) {
+      circuit.AddBlkPinToNet("c" + std::to_string(i + k),
+                             "P" + std::to_string(k % 4), net_name);
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int num_cells = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  std::string file_name =
+      argc > 2 ? argv[2]
+               : (std::filesystem::temp_directory_path() /
+                  "dali_checkpoint_bench.ckpt")
+                     .string();
+  int num_threads = argc > 3 ? std::atoi(argv[3]) : 1;
+  InitLogging("", severity::warning);
+
+  Circuit circuit;
+  BuildCircuit(circuit, num_cells);
+
+  ElapsedTime elapsed_time;
+  elapsed_time.RecordStartTime();
+  circuit.SaveCheckpoint(file_name, "global_placement");
+  elapsed_time.RecordEndTime();
+  double save_time = elapsed_time.GetWallTime();
+
+  elapsed_time.RecordStartTime();
+  Circuit loaded;
+  std::string stage = loaded.LoadCheckpoint(file_name, nullptr, num_threads);
+  elapsed_time.RecordEndTime();
+  double load_time = elapsed_time.GetWallTime();
+
+  bool is_same = stage == "global_placement" &&
+                 loaded.Blocks().size() == circuit.Blocks().size() &&
+                 loaded.Nets().size() == circuit.Nets().size() &&
+                 loaded.WeightedHPWL() == circuit.WeightedHPWL();
+  printf("cells: %d, nets: %zu, file size: %.1f MB\n", num_cells,
+         circuit.Nets().size(),
+         std::filesystem::file_size(file_name) / 1048576.0);
+  printf("save: %.3f s, load with %d threads: %.3f s, %s\n", save_time,
+         num_threads, load_time, is_same ? "same" : "DIFFERENT");
+  std::filesystem::remove(file_name);
+  return is_same ? 0 : 1;
+}
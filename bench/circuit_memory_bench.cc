@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+/****
+ * Benchmark of Circuit::CompactStorage(). On a synthetic circuit, it reports
+ * the estimated memory of each container and the RSS before and after
+ * compaction, the time of compaction, and checks that HPWL is unchanged.
+ *
+ * usage: circuit_memory_bench [num_cells]
+ * ****/
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "dali/circuit/circuit.h"
+#include "dali/common/elapsed_time.h"
+#include "dali/common/memory.h"
+
+using namespace dali;
+
+namespace {
+
+// Cells are placed randomly, and net i connects cell i to cells nearby. Most
+// nets have 2 to 5 pins, every 100th net has 40 pins.
+void BuildCircuit(Circuit& circuit, int num_cells) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  BlockType* cell = circuit.AddBlockType("CELL", 1.2, 1.6);
+  for (int p = 0; p < 4; ++p) {
+    Pin* pin = circuit.AddBlkTypePin(cell, "P" + std::to_string(p), p != 3);
+    pin->SetOffset(0.2 * p, 0.4 * p);
+  }
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 10000000, 10000000);
+  circuit.ReserveSpaceForDesignImp(num_cells, 0, num_cells);
+  for (int i = 0; i < num_cells; ++i) {
+    circuit.AddBlock("c" + std::to_string(i), "CELL", 0, 0, PLACED, N, true);
+  }
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> dist(0, 50000);
+  for (auto& block : circuit.Blocks()) {
+    block.SetLoc(dist(rng), dist(rng));
+  }
+  for (int i = 0; i < num_cells; ++i) {
+    std::string net_name = "n" + std::to_string(i);
+    int fanout = i % 100 == 0 ? 40 : 2 + i % 4;
+    fanout = std::min(fanout, num_cells - i);
+    circuit.AddNet(net_name, fanout);
+    for (int k = 0; k < fanout; ++k) {
+      circuit.AddBlkPinToNet("c" + std::to_string(i + k),
+                             "P" + std::to_string(k % 4), net_name);
+    }
+  }
+}
+
+void PrintMemoryUsage(char const* title,
+                      std::vector<ContainerMemory> const& usage) {
+  printf("%s\n", title);
+  size_t total_bytes = 0;
+  for (auto const& container : usage) {
+    printf("  %-36s %12zu elements %10.1f MB\n", container.name.c_str(),
+           container.count, container.bytes / 1048576.0);
+    total_bytes += container.bytes;
+  }
+  printf("  %-36s %32.1f MB (RSS: %.1f MB)\n", "total",
+         total_bytes / 1048576.0, getCurrentRSS() / 1048576.0);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int num_cells = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  InitLogging("", severity::warning);
+
+  Circuit circuit;
+  BuildCircuit(circuit, num_cells);
+  printf("cells: %d, nets: %zu, sizeof(Block): %zu, sizeof(NetPin): %zu\n",
+         num_cells, circuit.Nets().size(), sizeof(Block), sizeof(NetPin));
+  PrintMemoryUsage("before compaction:", circuit.MemoryUsage());
+  double hpwl = circuit.WeightedHPWL();
+
+  ElapsedTime elapsed_time;
+  elapsed_time.RecordStartTime();
+  circuit.CompactStorage();
+  elapsed_time.RecordEndTime();
+
+  PrintMemoryUsage("after compaction:", circuit.MemoryUsage());
+  bool is_same = circuit.WeightedHPWL() == hpwl;
+  printf("compaction: %.3f s, HPWL %s\n", elapsed_time.GetWallTime(),
+         is_same ? "same" : "DIFFERENT");
+  return is_same ? 0 : 1;
+}
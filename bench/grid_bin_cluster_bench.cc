@@ -0,0 +1,324 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+/****
+ * Micro-benchmark of over-filled grid bin clusters in look-ahead legalization.
+ * On a random mesh, it compares GridBinClusterQueue against the previous
+ * std::multiset of clusters, each with a std::set of bins. Both build the
+ * cluster list, which is update_cluster_list_time_ of the legalizer, and then
+ * drain it the way the legalizer does, marking the bounding box of the largest
+ * cluster as roughly legalized. It reports time, heap allocations, and checks
+ * that the largest clusters come in the same order.
+ *
+ * usage: grid_bin_cluster_bench [mesh_size] [num_repeats]
+ * ****/
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <queue>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "dali/common/elapsed_time.h"
+#include "dali/placer/global_placer/grid_bin_cluster.h"
+
+namespace {
+
+size_t num_allocations = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  ++num_allocations;
+  void* ptr = std::malloc(size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+using namespace dali;
+
+namespace {
+
+typedef std::vector<std::vector<GridBin>> GridBinMesh;
+
+int cluster_upper_size = 3;
+
+// the previous implementation of LookAheadLegalizer clusters
+struct LegacyCluster {
+  unsigned long long total_cell_area = 0;
+  unsigned long long total_white_space = 0;
+  std::set<GridBinIndex> bin_set;
+  bool operator>(const LegacyCluster& rhs) const {
+    return total_cell_area > rhs.total_cell_area;
+  }
+};
+
+typedef std::multiset<LegacyCluster, std::greater<>> LegacyClusterSet;
+
+void LegacyUpdateClusterArea(GridBinMesh& grid_bin_mesh,
+                             LegacyCluster& cluster) {
+  cluster.total_cell_area = 0;
+  cluster.total_white_space = 0;
+  for (auto& index : cluster.bin_set) {
+    cluster.total_cell_area += grid_bin_mesh[index.x][index.y].cell_area;
+    cluster.total_white_space += grid_bin_mesh[index.x][index.y].white_space;
+  }
+}
+
+void LegacyUpdateClusterList(GridBinMesh& grid_bin_mesh,
+                             LegacyClusterSet& cluster_set) {
+  cluster_set.clear();
+  int m = (int)grid_bin_mesh.size();
+  int n = (int)grid_bin_mesh[0].size();
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) grid_bin_mesh[i][j].cluster_visited = false;
+  }
+  int cnt = 0;
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      if (grid_bin_mesh[i][j].cluster_visited || !grid_bin_mesh[i][j].over_fill)
+        continue;
+      GridBinIndex b(i, j);
+      LegacyCluster H;
+      H.bin_set.insert(b);
+      grid_bin_mesh[i][j].cluster_visited = true;
+      cnt = 0;
+      std::queue<GridBinIndex> Q;
+      Q.push(b);
+      while (!Q.empty()) {
+        b = Q.front();
+        Q.pop();
+        for (auto& index : grid_bin_mesh[b.x][b.y].adjacent_bin_index) {
+          GridBin& bin = grid_bin_mesh[index.x][index.y];
+          if (!bin.cluster_visited && bin.over_fill) {
+            if (cnt > cluster_upper_size) {
+              LegacyUpdateClusterArea(grid_bin_mesh, H);
+              cluster_set.insert(H);
+              break;
+            }
+            bin.cluster_visited = true;
+            H.bin_set.insert(index);
+            ++cnt;
+            Q.push(index);
+          }
+        }
+      }
+      LegacyUpdateClusterArea(grid_bin_mesh, H);
+      cluster_set.insert(H);
+    }
+  }
+}
+
+void LegacyUpdateLargestCluster(GridBinMesh& grid_bin_mesh,
+                                LegacyClusterSet& cluster_set) {
+  for (auto it = cluster_set.begin(); it != cluster_set.end();) {
+    bool is_contact = true;
+    for (auto& index : it->bin_set) {
+      if (grid_bin_mesh[index.x][index.y].global_placed) {
+        is_contact = false;
+      }
+    }
+    if (is_contact) break;
+
+    std::vector<GridBinIndex> grid_bin_list(it->bin_set.begin(),
+                                            it->bin_set.end());
+    std::unordered_map<GridBinIndex, bool, GridBinIndexHasher>
+        grid_bin_visited;
+    for (auto& index : it->bin_set) {
+      grid_bin_visited.insert({index, false});
+    }
+    int cnt = 0;
+    for (auto& grid_index : grid_bin_list) {
+      int i = grid_index.x;
+      int j = grid_index.y;
+      if (grid_bin_visited[grid_index]) continue;
+      if (grid_bin_mesh[i][j].global_placed) continue;
+      GridBinIndex b(i, j);
+      LegacyCluster H;
+      H.bin_set.insert(b);
+      grid_bin_visited[grid_index] = true;
+      cnt = 0;
+      std::queue<GridBinIndex> Q;
+      Q.push(b);
+      while (!Q.empty()) {
+        b = Q.front();
+        Q.pop();
+        for (auto& index : grid_bin_mesh[b.x][b.y].adjacent_bin_index) {
+          if (grid_bin_visited.find(index) == grid_bin_visited.end()) {
+            continue;
+          }
+          if (grid_bin_visited[index]) continue;
+          if (grid_bin_mesh[index.x][index.y].global_placed) continue;
+          if (cnt > cluster_upper_size) {
+            LegacyUpdateClusterArea(grid_bin_mesh, H);
+            cluster_set.insert(H);
+            break;
+          }
+          grid_bin_visited[index] = true;
+          H.bin_set.insert(index);
+          ++cnt;
+          Q.push(index);
+        }
+      }
+      LegacyUpdateClusterArea(grid_bin_mesh, H);
+      cluster_set.insert(H);
+    }
+    it = cluster_set.erase(it);
+  }
+}
+
+// Over-filled bins come in blobs, so that clusters have several bins.
+GridBinMesh BuildMesh(int mesh_size) {
+  GridBinMesh grid_bin_mesh(mesh_size, std::vector<GridBin>(mesh_size));
+  std::mt19937 rng(1);
+  std::uniform_int_distribution<int> area_dist(0, 1000);
+  for (int i = 0; i < mesh_size; ++i) {
+    for (int j = 0; j < mesh_size; ++j) {
+      GridBin& bin = grid_bin_mesh[i][j];
+      bin.index = {i, j};
+      bin.white_space = 1000;
+      bin.cell_area = area_dist(rng);
+      bin.create_adjacent_bin_list(mesh_size, mesh_size);
+    }
+  }
+  for (int i = 0; i < mesh_size; ++i) {
+    for (int j = 0; j < mesh_size; ++j) {
+      unsigned long long area = grid_bin_mesh[i][j].cell_area;
+      for (auto& index : grid_bin_mesh[i][j].adjacent_bin_index) {
+        area += grid_bin_mesh[index.x][index.y].cell_area;
+      }
+      grid_bin_mesh[i][j].over_fill = area > 5 * 560;
+    }
+  }
+  return grid_bin_mesh;
+}
+
+void ClearPlacedFlags(GridBinMesh& grid_bin_mesh) {
+  for (auto& column : grid_bin_mesh) {
+    for (auto& bin : column) bin.global_placed = false;
+  }
+}
+
+template <typename Iterable>
+unsigned long long PlaceBoundingBox(GridBinMesh& grid_bin_mesh,
+                                    Iterable begin, Iterable end,
+                                    unsigned long long cell_area) {
+  int llx = INT32_MAX, lly = INT32_MAX, urx = 0, ury = 0;
+  for (auto it = begin; it != end; ++it) {
+    llx = std::min(llx, it->x);
+    lly = std::min(lly, it->y);
+    urx = std::max(urx, it->x);
+    ury = std::max(ury, it->y);
+  }
+  for (int x = llx; x <= urx; ++x) {
+    for (int y = lly; y <= ury; ++y) grid_bin_mesh[x][y].global_placed = true;
+  }
+  return (cell_area * 1000003ull) ^ (llx * 1009ull + lly * 31ull + urx + ury);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int mesh_size = argc > 1 ? std::atoi(argv[1]) : 1000;
+  int num_repeats = argc > 2 ? std::atoi(argv[2]) : 5;
+  GridBinMesh grid_bin_mesh = BuildMesh(mesh_size);
+  ElapsedTime elapsed_time;
+
+  LegacyClusterSet cluster_set;
+  size_t legacy_allocations = num_allocations;
+  elapsed_time.RecordStartTime();
+  for (int r = 0; r < num_repeats; ++r) {
+    LegacyUpdateClusterList(grid_bin_mesh, cluster_set);
+  }
+  elapsed_time.RecordEndTime();
+  double legacy_list_time = elapsed_time.GetWallTime() / num_repeats;
+  legacy_allocations = (num_allocations - legacy_allocations) / num_repeats;
+  size_t num_legacy_clusters = cluster_set.size();
+
+  unsigned long long legacy_checksum = 0;
+  int legacy_num_boxes = 0;
+  elapsed_time.RecordStartTime();
+  while (!cluster_set.empty()) {
+    LegacyUpdateLargestCluster(grid_bin_mesh, cluster_set);
+    if (cluster_set.empty()) break;
+    auto& cluster = *cluster_set.begin();
+    legacy_checksum = legacy_checksum * 31 +
+                      PlaceBoundingBox(grid_bin_mesh, cluster.bin_set.begin(),
+                                       cluster.bin_set.end(),
+                                       cluster.total_cell_area);
+    ++legacy_num_boxes;
+  }
+  elapsed_time.RecordEndTime();
+  double legacy_drain_time = elapsed_time.GetWallTime();
+  ClearPlacedFlags(grid_bin_mesh);
+
+  GridBinClusterQueue cluster_queue;
+  // the first build sizes buffers, later builds reuse them
+  cluster_queue.Build(grid_bin_mesh, cluster_upper_size);
+  size_t flat_allocations = num_allocations;
+  elapsed_time.RecordStartTime();
+  for (int r = 0; r < num_repeats; ++r) {
+    cluster_queue.Build(grid_bin_mesh, cluster_upper_size);
+  }
+  elapsed_time.RecordEndTime();
+  double flat_list_time = elapsed_time.GetWallTime() / num_repeats;
+  flat_allocations = (num_allocations - flat_allocations) / num_repeats;
+  int num_flat_clusters = cluster_queue.NumClusters();
+
+  unsigned long long flat_checksum = 0;
+  int flat_num_boxes = 0;
+  elapsed_time.RecordStartTime();
+  while (!cluster_queue.IsEmpty()) {
+    cluster_queue.SplitPlacedClusters(grid_bin_mesh, cluster_upper_size);
+    if (cluster_queue.IsEmpty()) break;
+    auto& cluster = cluster_queue.Top();
+    auto& bins = cluster_queue.Bins();
+    flat_checksum = flat_checksum * 31 +
+                    PlaceBoundingBox(grid_bin_mesh,
+                                     bins.begin() + cluster.bin_begin,
+                                     bins.begin() + cluster.bin_end,
+                                     cluster.total_cell_area);
+    ++flat_num_boxes;
+  }
+  elapsed_time.RecordEndTime();
+  double flat_drain_time = elapsed_time.GetWallTime();
+
+  printf("mesh: %d x %d, legacy clusters: %zu, flat clusters: %d\n",
+         mesh_size, mesh_size, num_legacy_clusters, num_flat_clusters);
+  printf("%-8s %16s %14s %12s %10s\n", "impl", "cluster list (ms)",
+         "allocations", "drain (ms)", "boxes");
+  printf("%-8s %16.3f %14zu %12.3f %10d\n", "legacy", legacy_list_time * 1e3,
+         legacy_allocations, legacy_drain_time * 1e3, legacy_num_boxes);
+  printf("%-8s %16.3f %14zu %12.3f %10d\n", "flat", flat_list_time * 1e3,
+         flat_allocations, flat_drain_time * 1e3, flat_num_boxes);
+  bool is_same = legacy_checksum == flat_checksum &&
+                 legacy_num_boxes == flat_num_boxes;
+  printf("largest clusters in the same order: %s\n", is_same ? "yes" : "NO");
+  return is_same ? 0 : 1;
+}
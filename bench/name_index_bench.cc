@@ -0,0 +1,140 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+/****
+ * Benchmark of NameIndex against the std::unordered_map it replaces in
+ * NamedInstanceCollection. It inserts num_names names one by one, inserts
+ * them again with NameIndex::BulkInsert(), and looks up every name in a
+ * random order, half of them through a std::string_view of a longer string.
+ *
+ * usage: name_index_bench [num_names] [name_prefix]
+ * ****/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "dali/common/elapsed_time.h"
+#include "dali/common/helper.h"
+#include "dali/common/name_index.h"
+
+using namespace dali;
+
+namespace {
+
+double Seconds(ElapsedTime& elapsed_time) {
+  elapsed_time.RecordEndTime();
+  return elapsed_time.GetWallTime();
+}
+
+void PrintResult(char const* name, double insert_time, double lookup_time,
+                 size_t bytes, size_t checksum) {
+  printf("%-22s insert: %7.3f s, lookup: %7.3f s, memory: %8.1f MB, "
+         "checksum: %zu\n",
+         name, insert_time, lookup_time, bytes / 1048576.0, checksum);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  size_t num_names = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::string prefix = argc > 2 ? argv[2] : "inst_";
+  InitLogging("", severity::warning);
+
+  std::vector<std::string> names(num_names);
+  for (size_t i = 0; i < num_names; ++i) {
+    names[i] = prefix + std::to_string(i);
+  }
+  // queries of odd positions are views into "/" + name
+  std::vector<size_t> order(num_names);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937_64(1));
+  std::vector<std::string> long_names(num_names);
+  for (size_t i = 1; i < num_names; i += 2) {
+    long_names[i] = "/" + names[i];
+  }
+  auto query = [&](size_t i) -> std::string_view {
+    if (i % 2 == 0) return names[i];
+    return std::string_view(long_names[i]).substr(1);
+  };
+  ElapsedTime elapsed_time;
+
+  {
+    elapsed_time.RecordStartTime();
+    std::unordered_map<std::string, size_t> map;
+    map.reserve(num_names);
+    for (size_t i = 0; i < num_names; ++i) {
+      map.try_emplace(names[i], i);
+    }
+    double insert_time = Seconds(elapsed_time);
+    elapsed_time.RecordStartTime();
+    size_t checksum = 0;
+    for (size_t i : order) {
+      // std::unordered_map needs a std::string key for a lookup
+      checksum += map.find(std::string(query(i)))->second;
+    }
+    double lookup_time = Seconds(elapsed_time);
+    PrintResult("std::unordered_map", insert_time, lookup_time,
+                StringMapBytes(map), checksum);
+  }
+
+  {
+    elapsed_time.RecordStartTime();
+    NameIndex index;
+    index.Reserve(num_names);
+    for (size_t i = 0; i < num_names; ++i) {
+      index.Insert(names[i]);
+    }
+    double insert_time = Seconds(elapsed_time);
+    elapsed_time.RecordStartTime();
+    size_t checksum = 0;
+    for (size_t i : order) {
+      checksum += index.Find(query(i));
+    }
+    double lookup_time = Seconds(elapsed_time);
+    PrintResult("NameIndex::Insert", insert_time, lookup_time,
+                index.HeapBytes(), checksum);
+  }
+
+  {
+    elapsed_time.RecordStartTime();
+    NameIndex index;
+    size_t duplicate = index.BulkInsert(
+        num_names,
+        [&names](size_t i) -> std::string const& { return names[i]; });
+    double insert_time = Seconds(elapsed_time);
+    elapsed_time.RecordStartTime();
+    size_t checksum = 0;
+    for (size_t i : order) {
+      checksum += index.Find(query(i));
+    }
+    double lookup_time = Seconds(elapsed_time);
+    PrintResult("NameIndex::BulkInsert", insert_time, lookup_time,
+                index.HeapBytes(), checksum);
+    if (duplicate != NameIndex::kNotFound) return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+/****
+ * Micro-benchmark of the batched netlist kernels. On a synthetic circuit, it
+ * compares the per-net scalar path, Net::UpdateMaxMinIndex() and
+ * Circuit::WeightedHPWL(), against NetlistView kernels at every SIMD level
+ * supported by this processor, and checks that the results are the same.
+ *
+ * usage: netlist_kernels_bench [num_cells] [num_repeats] [num_threads]
+ * ****/
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dali/circuit/circuit.h"
+#include "dali/common/elapsed_time.h"
+
+using namespace dali;
+
+namespace {
+
+// Cells are placed randomly, and net i connects cell i to cells nearby. Most
+// nets have 2 to 5 pins, every 100th net has 40 pins.
+void BuildCircuit(Circuit& circuit, int num_cells) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  BlockType* cell = circuit.AddBlockType("CELL", 1.2, 1.6);
+  for (int p = 0; p < 4; ++p) {
+    Pin* pin = circuit.AddBlkTypePin(cell, "P" + std::to_string(p), p != 3);
+    pin->SetOffset(0.2 * p, 0.4 * p);
+  }
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 10000000, 10000000);
+  circuit.ReserveSpaceForDesignImp(num_cells, 0, num_cells);
+  for (int i = 0; i < num_cells; ++i) {
+    circuit.AddBlock("c" + std::to_string(i), "CELL", 0, 0, PLACED, N, true);
+  }
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<double> dist(0, 50000);
+  for (auto& block : circuit.Blocks()) {
+    block.SetLoc(dist(rng), dist(rng));
+  }
+  for (int i = 0; i < num_cells; ++i) {
+    std::string net_name = "n" + std::to_string(i);
+    int fanout = i % 100 == 0 ? 40 : 2 + i % 4;
+    fanout = std::min(fanout, num_cells - i);
+    circuit.AddNet(net_name, fanout);
+    for (int k = 0; k < fanout; ++k) {
+      circuit.AddBlkPinToNet("c" + std::to_string(i + k),
+                             "P" + std::to_string(k % 4), net_name);
+    }
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int num_cells = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  int num_repeats = argc > 2 ? std::atoi(argv[2]) : 10;
+  int num_threads = argc > 3 ? std::atoi(argv[3]) : 1;
+  InitLogging("", severity::warning);
+
+  Circuit circuit;
+  BuildCircuit(circuit, num_cells);
+  NetlistView netlist_view;
+  circuit.BuildNetlistView(netlist_view);
+  printf("cells: %d, nets: %d, pins: %d, detected SIMD level: %s\n",
+         netlist_view.NumBlocks(), netlist_view.NumNets(),
+         netlist_view.NumPins(), SimdLevelStr(DetectSimdLevel()).c_str());
+
+  ElapsedTime elapsed_time;
+  elapsed_time.RecordStartTime();
+  for (int r = 0; r < num_repeats; ++r) {
+    for (auto& net : circuit.Nets()) {
+      net.UpdateMaxMinIndex();
+    }
+  }
+  elapsed_time.RecordEndTime();
+  double scalar_max_min_time = elapsed_time.GetWallTime() / num_repeats;
+
+  double hpwl = 0;
+  elapsed_time.RecordStartTime();
+  for (int r = 0; r < num_repeats; ++r) {
+    hpwl = circuit.WeightedHPWLX() + circuit.WeightedHPWLY();
+  }
+  elapsed_time.RecordEndTime();
+  double scalar_hpwl_time = elapsed_time.GetWallTime() / num_repeats;
+
+  printf("%-8s %14s %9s %14s %9s  %s\n", "path", "max/min (ms)", "speedup",
+         "hpwl (ms)", "speedup", "check");
+  printf("%-8s %14.3f %9s %14.3f %9s\n", "Net", scalar_max_min_time * 1e3, "",
+         scalar_hpwl_time * 1e3, "");
+
+  int num_nets = netlist_view.NumNets();
+  std::vector<double> pin_loc_x, pin_loc_y;
+  std::vector<int> max_pin_x, min_pin_x, max_pin_y, min_pin_y;
+  bool is_all_same = true;
+  for (auto simd_level :
+       {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512}) {
+    if (simd_level > DetectSimdLevel()) continue;
+    netlist_view.SetSimdLevel(simd_level);
+
+    elapsed_time.RecordStartTime();
+    for (int r = 0; r < num_repeats; ++r) {
+      netlist_view.UpdateBlockLocationsX(circuit.Blocks(), num_threads);
+      netlist_view.UpdateBlockLocationsY(circuit.Blocks(), num_threads);
+      netlist_view.ComputePinLocations(true, netlist_view.BlockX().data(),
+                                       pin_loc_x, num_threads);
+      netlist_view.ComputePinLocations(false, netlist_view.BlockY().data(),
+                                       pin_loc_y, num_threads);
+      netlist_view.FindMaxMinPins(pin_loc_x, max_pin_x, min_pin_x,
+                                  num_threads);
+      netlist_view.FindMaxMinPins(pin_loc_y, max_pin_y, min_pin_y,
+                                  num_threads);
+    }
+    elapsed_time.RecordEndTime();
+    double max_min_time = elapsed_time.GetWallTime() / num_repeats;
+
+    double view_hpwl = 0;
+    elapsed_time.RecordStartTime();
+    for (int r = 0; r < num_repeats; ++r) {
+      view_hpwl = circuit.WeightedHPWLX(netlist_view, num_threads) +
+                  circuit.WeightedHPWLY(netlist_view, num_threads);
+    }
+    elapsed_time.RecordEndTime();
+    double hpwl_time = elapsed_time.GetWallTime() / num_repeats;
+
+    bool is_same = view_hpwl == hpwl;
+    for (int i = 0; i < num_nets; ++i) {
+      Net& net = circuit.Nets()[i];
+      is_same = is_same && max_pin_x[i] == net.MaxBlkPinIdX() &&
+                min_pin_x[i] == net.MinBlkPinIdX() &&
+                max_pin_y[i] == net.MaxBlkPinIdY() &&
+                min_pin_y[i] == net.MinBlkPinIdY();
+    }
+    is_all_same = is_all_same && is_same;
+    printf("%-8s %14.3f %9.2f %14.3f %9.2f  %s\n",
+           SimdLevelStr(simd_level).c_str(), max_min_time * 1e3,
+           scalar_max_min_time / max_min_time, hpwl_time * 1e3,
+           scalar_hpwl_time / hpwl_time, is_same ? "same" : "DIFFERENT");
+  }
+  return is_all_same ? 0 : 1;
+}
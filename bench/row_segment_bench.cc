@@ -0,0 +1,287 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+/****
+ * Micro-benchmark of consensus iterations of the gridded row legalizer. Random
+ * rows of single-row and double-row cells are optimized the way
+ * IterativeCellReorderingInStripes does it, once with the previous
+ * RowSegment::OptimizeQuadraticDisplacement, which sorts every row segment
+ * from scratch and allocates its variables and Abacus clusters, and once with
+ * a reused RowSegmentWorkspace. It reports time and heap allocations per
+ * consensus iteration, and checks that final locations are the same.
+ *
+ * usage: row_segment_bench [num_rows] [cells_per_row] [num_iterations]
+ * ****/
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dali/circuit/circuit.h"
+#include "dali/common/elapsed_time.h"
+#include "dali/placer/well_legalizer/legalizer_block_aux.h"
+#include "dali/placer/well_legalizer/optimization_helper.h"
+#include "dali/placer/well_legalizer/row_segment.h"
+
+namespace {
+
+size_t num_allocations = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  ++num_allocations;
+  void* ptr = std::malloc(size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+using namespace dali;
+
+namespace {
+
+int row_width = 0;
+
+// Every row has cells_per_row cells, one in ten is a double-row cell which also
+// has a sub-cell in the row above.
+void BuildCircuit(Circuit& circuit, int num_rows, int cells_per_row) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  circuit.SetNwellParams(0.0, 0.0, 0.0, 1e8, 0.0);
+  circuit.SetPwellParams(0.0, 0.0, 0.0, 1e8, 0.0);
+  int num_types = 4;
+  for (int t = 0; t < num_types; ++t) {
+    std::string name = "T" + std::to_string(t);
+    double width = 0.4 * (t + 2);
+    circuit.AddBlockType(name, width, 1.6);
+    circuit.SetWellRect(name, false, 0, 0, width, 0.8);
+    circuit.SetWellRect(name, true, 0, 0.8, width, 1.6);
+  }
+  circuit.AddBlockType("DH", 1.2, 3.2);
+  circuit.SetWellRect("DH", false, 0, 0, 1.2, 0.8);
+  circuit.SetWellRect("DH", true, 0, 0.8, 1.2, 1.6);
+  circuit.SetWellRect("DH", true, 0, 1.6, 1.2, 2.4);
+  circuit.SetWellRect("DH", false, 0, 2.4, 1.2, 3.2);
+
+  // cells fill 80% of a row on average
+  row_width = static_cast<int>(cells_per_row * 4 / 0.8);
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, row_width * 200, num_rows * 1600 + 3200);
+  int num_cells = num_rows * cells_per_row;
+  circuit.ReserveSpaceForDesignImp(num_cells, 0, 0);
+  std::mt19937 rng(1);
+  for (int i = 0; i < num_cells; ++i) {
+    std::string type_name = rng() % 10 == 0
+                                ? std::string("DH")
+                                : "T" + std::to_string(rng() % num_types);
+    circuit.AddBlock("c" + std::to_string(i), type_name, 0, 0, PLACED, N,
+                     true);
+  }
+  for (auto& block : circuit.Blocks()) {
+    std::uniform_real_distribution<double> x_dist(0,
+                                                  row_width - block.Width());
+    block.SetLLX(x_dist(rng));
+    auto aux_ptr = new LegalizerBlockAux(&block);
+    aux_ptr->StoreCurLocAsInitLoc();
+  }
+}
+
+std::vector<RowSegment> BuildRowSegments(Circuit& circuit, int num_rows,
+                                         int cells_per_row) {
+  std::vector<RowSegment> segments(num_rows + 1);
+  for (auto& segment : segments) {
+    segment.SetLLX(0);
+    segment.SetWidth(row_width);
+  }
+  auto& blocks = circuit.Blocks();
+  for (int i = 0; i < num_rows * cells_per_row; ++i) {
+    int row = i / cells_per_row;
+    segments[row].AddBlockRegion(&blocks[i], 0);
+    if (blocks[i].TypePtr()->RegionCount() > 1) {
+      segments[row + 1].AddBlockRegion(&blocks[i], 1);
+    }
+  }
+  return segments;
+}
+
+// the previous implementation of RowSegment::OptimizeQuadraticDisplacement
+std::vector<BlockDisplacementVariable> LegacyOptimizeQuadraticDisplacement(
+    RowSegment& segment, double lambda, bool is_weighted_anchor,
+    bool is_reorder) {
+  std::vector<BlockDisplacementVariable> vars;
+  std::vector<BlockRegion>& blk_regions = segment.BlkRegions();
+  if (blk_regions.empty()) return vars;
+
+  std::sort(blk_regions.begin(), blk_regions.end(),
+            [](const BlockRegion& br0, const BlockRegion& br1) {
+              return (br0.block->LLX() < br1.block->LLX()) ||
+                     ((br0.block->LLX() == br1.block->LLX()) &&
+                      (br0.block->Id() < br1.block->Id()));
+            });
+
+  double ave_discrepancy = 1;
+  if (is_weighted_anchor) {
+    int sub_cell_cnt = 0;
+    double sum_discrepancy = 0;
+    for (auto& block_region : blk_regions) {
+      auto aux_ptr =
+          static_cast<LegalizerBlockAux*>(block_region.block->AuxPtr());
+      double sub_loc = aux_ptr->SubLocs()[block_region.region_id];
+      sum_discrepancy += std::fabs(aux_ptr->AverageLoc() - sub_loc);
+      ++sub_cell_cnt;
+    }
+    ave_discrepancy = std::max(sum_discrepancy / sub_cell_cnt, 1e-5);
+  }
+
+  vars.reserve(blk_regions.size());
+  for (auto& block_region : blk_regions) {
+    Block* blk_ptr = block_region.block;
+    int region_cnt = blk_ptr->TypePtr()->RegionCount();
+    auto aux_ptr = static_cast<LegalizerBlockAux*>(blk_ptr->AuxPtr());
+    vars.emplace_back(blk_ptr->Width(), aux_ptr->InitLoc().x,
+                      lambda / region_cnt);
+    vars.back().block_region = block_region;
+    if (region_cnt <= 1) continue;
+    double weight_discrepancy = 1;
+    if (is_weighted_anchor) {
+      double sub_loc = aux_ptr->SubLocs()[block_region.region_id];
+      double tmp_discrepancy = std::fabs(aux_ptr->AverageLoc() - sub_loc);
+      weight_discrepancy = pow(1 + tmp_discrepancy / ave_discrepancy, 2.0);
+    }
+    vars.back().SetAnchor(aux_ptr->AverageLoc(),
+                          (1 - lambda) * weight_discrepancy);
+  }
+
+  AbacusPlaceRow(vars);
+  if (is_weighted_anchor) {
+    segment.FitInRange(vars);
+    if (is_reorder) {
+      std::vector<BlockDisplacementVariable> res_local_order;
+      segment.LocalReorder(vars, res_local_order, 3, 0, false);
+    }
+  }
+  return vars;
+}
+
+void UpdateSubCellLocs(std::vector<BlockDisplacementVariable>& vars) {
+  for (auto& var : vars) {
+    auto aux_ptr =
+        static_cast<LegalizerBlockAux*>(var.block_region.block->AuxPtr());
+    aux_ptr->SetSubCellLoc(var.block_region.region_id, var.Solution(),
+                           var.SegmentWeight());
+  }
+}
+
+void UpdateAverageLocs(Circuit& circuit) {
+  for (auto& block : circuit.Blocks()) {
+    auto aux_ptr = static_cast<LegalizerBlockAux*>(block.AuxPtr());
+    aux_ptr->ComputeAverageLoc();
+    block.SetLLX(aux_ptr->AverageLoc());
+  }
+}
+
+uint64_t LocationChecksum(Circuit& circuit) {
+  uint64_t checksum = 1469598103934665603ull;
+  for (auto& block : circuit.Blocks()) {
+    double x = block.LLX();
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    checksum = (checksum ^ bits) * 1099511628211ull;
+  }
+  return checksum;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int num_rows = argc > 1 ? std::atoi(argv[1]) : 200;
+  int cells_per_row = argc > 2 ? std::atoi(argv[2]) : 100;
+  int num_iterations = argc > 3 ? std::atoi(argv[3]) : 50;
+  ElapsedTime elapsed_time;
+
+  Circuit legacy_circuit;
+  BuildCircuit(legacy_circuit, num_rows, cells_per_row);
+  std::vector<RowSegment> legacy_segments =
+      BuildRowSegments(legacy_circuit, num_rows, cells_per_row);
+  size_t legacy_allocations = num_allocations;
+  elapsed_time.RecordStartTime();
+  for (int i = 0; i < num_iterations; ++i) {
+    double lambda = 1 / double(i + 1);
+    for (auto& segment : legacy_segments) {
+      std::vector<BlockDisplacementVariable> vars =
+          LegacyOptimizeQuadraticDisplacement(segment, lambda, i >= 5,
+                                              i % 10 == 0);
+      UpdateSubCellLocs(vars);
+    }
+    UpdateAverageLocs(legacy_circuit);
+  }
+  elapsed_time.RecordEndTime();
+  double legacy_time = elapsed_time.GetWallTime() / num_iterations;
+  legacy_allocations = (num_allocations - legacy_allocations) / num_iterations;
+
+  Circuit circuit;
+  BuildCircuit(circuit, num_rows, cells_per_row);
+  std::vector<RowSegment> segments =
+      BuildRowSegments(circuit, num_rows, cells_per_row);
+  RowSegmentWorkspace workspace;
+  size_t workspace_allocations = num_allocations;
+  elapsed_time.RecordStartTime();
+  for (int i = 0; i < num_iterations; ++i) {
+    double lambda = 1 / double(i + 1);
+    for (auto& segment : segments) {
+      segment.OptimizeQuadraticDisplacement(lambda, i >= 5, i % 10 == 0,
+                                            workspace);
+      UpdateSubCellLocs(workspace.vars);
+    }
+    UpdateAverageLocs(circuit);
+  }
+  elapsed_time.RecordEndTime();
+  double workspace_time = elapsed_time.GetWallTime() / num_iterations;
+  workspace_allocations =
+      (num_allocations - workspace_allocations) / num_iterations;
+
+  printf("rows: %d, cells per row: %d, iterations: %d\n", num_rows,
+         cells_per_row, num_iterations);
+  printf("%-10s %20s %24s\n", "impl", "time/iteration (ms)",
+         "allocations/iteration");
+  printf("%-10s %20.3f %24zu\n", "legacy", legacy_time * 1e3,
+         legacy_allocations);
+  printf("%-10s %20.3f %24zu\n", "workspace", workspace_time * 1e3,
+         workspace_allocations);
+  bool is_same = LocationChecksum(legacy_circuit) == LocationChecksum(circuit);
+  printf("same final locations: %s\n", is_same ? "yes" : "NO");
+  return is_same ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+/****
+ * Micro-benchmark of TetrisSpace queries. Every row of the space is fragmented
+ * by random blocks, then single-row and double-row blocks are placed at random
+ * locations using TetrisSpace::IsSpaceAvail and, if that fails,
+ * TetrisSpace::FindBlockLoc, which is what TetrisLegalizer does. It reports
+ * time and heap allocations per query, and a checksum of block locations.
+ *
+ * usage: tetris_space_bench [num_rows] [blocks_per_row] [num_queries]
+ * ****/
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "dali/common/elapsed_time.h"
+#include "dali/common/misc.h"
+#include "dali/placer/legalizer/tetris_legalizer/tetris_space.h"
+
+namespace {
+
+size_t num_allocations = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  ++num_allocations;
+  void* ptr = std::malloc(size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+using namespace dali;
+
+int main(int argc, char* argv[]) {
+  int num_rows = argc > 1 ? std::atoi(argv[1]) : 10000;
+  int blocks_per_row = argc > 2 ? std::atoi(argv[2]) : 100;
+  int num_queries = argc > 3 ? std::atoi(argv[3]) : 20000;
+  int row_height = 10;
+  int min_width = 10;
+  // blocks of the fragmentation step fill about 50% of a row
+  int row_width = blocks_per_row * 120;
+  std::mt19937 rng(7);
+
+  ElapsedTime elapsed_time;
+  elapsed_time.RecordStartTime();
+  TetrisSpace space(0, row_width, 0, num_rows * row_height, row_height,
+                    min_width);
+  for (int row = 0; row < num_rows; ++row) {
+    for (int i = 0; i < blocks_per_row; ++i) {
+      int width = 20 + static_cast<int>(rng() % 80);
+      int llx = static_cast<int>(rng() % (row_width - width));
+      space.IsSpaceAvail(llx, row * row_height, width, row_height);
+    }
+  }
+  elapsed_time.RecordEndTime();
+  double fragment_time = elapsed_time.GetWallTime();
+
+  uint64_t checksum = 1469598103934665603ull;
+  int num_failures = 0;
+  size_t query_allocations = num_allocations;
+  elapsed_time.RecordStartTime();
+  for (int i = 0; i < num_queries; ++i) {
+    int width = min_width + static_cast<int>(rng() % 50);
+    int height = rng() % 5 == 0 ? 2 * row_height : row_height;
+    int llx = static_cast<int>(rng() % (row_width - width));
+    int lly = static_cast<int>(rng() % (num_rows - 2)) * row_height;
+    int2d loc(llx, lly);
+    if (!space.IsSpaceAvail(llx, lly, width, height) &&
+        !space.FindBlockLoc(llx, lly, width, height, loc)) {
+      ++num_failures;
+      continue;
+    }
+    checksum = (checksum ^ static_cast<uint64_t>(loc.x)) * 1099511628211ull;
+    checksum = (checksum ^ static_cast<uint64_t>(loc.y)) * 1099511628211ull;
+  }
+  elapsed_time.RecordEndTime();
+  double query_time = elapsed_time.GetWallTime() / num_queries;
+  query_allocations = num_allocations - query_allocations;
+
+  printf("rows: %d, blocks per row: %d, queries: %d\n", num_rows,
+         blocks_per_row, num_queries);
+  printf("fragmentation time: %.3f s\n", fragment_time);
+  printf("time/query: %.3f us\n", query_time * 1e6);
+  printf("allocations/query: %.2f\n",
+         static_cast<double>(query_allocations) / num_queries);
+  printf("failures: %d, checksum: %016llx\n", num_failures,
+         static_cast<unsigned long long>(checksum));
+  return 0;
+}
@@ -18,6 +18,7 @@
 #include <iostream>
 
 #include "dali/common/helper.h"
+#include "dali/dali.h"
 
 namespace dali {
 namespace {
@@ -74,6 +75,13 @@ void ReportDaliUsage(std::ostream& output) {
       << "  -num_threads <n>                           number of OpenMP threads to use\n"
       << "  -v                                         verbosity_level (optional, 0-5, default 1)\n"
       << "  -disable_log_prefix                        optional, if this flag is present, then only messages will be saved to the log file\n"
+      << "  -save_checkpoint <stage> <file.ckpt>       (optional, save a checkpoint after global_placement/legalization/filler_cell_placement/io_pin_placement)\n"
+      << "  -load_checkpoint <file.ckpt>               (optional, start from a checkpoint, stages done before it was saved are skipped)\n"
+      << "  -compact_storage                           optional, if this flag is present, then net lists of cells are stored in one array to save memory\n"
+      << "  -linear_solver <diagonal/ic/amg>           (optional, preconditioner of the global placement CG solver, default diagonal)\n"
+      << "  -config <file.conf>                        (optional, ACT configuration file, e.g. for dali.global_placer.* parameters)\n"
+      << "  -row_band_legalization                     optional, if this flag is present, then standard cells are legalized in row bands concurrently, results differ from the default serial legalization\n"
+      << "  -parallel_local_reorder                    optional, if this flag is present, then well legalization reorders cells of different clusters concurrently, results differ from the default serial reorder\n"
       << "(flag order does not matter)"
       << "\033[0m\n";
   // clang-format on
@@ -207,6 +215,41 @@ bool ParseDaliCommandLine(int argc, char* argv[],
       EnableConfigFlag("dali.enable_end_cap_cell");
     } else if (arg == "-enable_shrink_off_grid_die_area") {
       EnableConfigFlag("dali.enable_shrink_off_grid_die_area");
+    } else if (arg == "-compact_storage") {
+      EnableConfigFlag("dali.compact_storage");
+    } else if (arg == "-row_band_legalization") {
+      EnableConfigFlag("dali.row_band_legalization");
+    } else if (arg == "-parallel_local_reorder") {
+      EnableConfigFlag("dali.parallel_local_reorder");
+    } else if (arg == "-linear_solver") {
+      if (!TryGetValue(argc, argv, &i, &value) ||
+          (value != "diagonal" && value != "ic" && value != "amg")) {
+        error_output << "Invalid linear solver!\n";
+        return false;
+      }
+      config_set_string("dali.global_placer.linear_solver", value.c_str());
+    } else if (arg == "-config") {
+      if (!TryGetValue(argc, argv, &i, &value)) {
+        error_output << "Invalid configuration file name!\n";
+        return false;
+      }
+      config_read(value.c_str());
+    } else if (arg == "-save_checkpoint") {
+      std::string file_name;
+      if (!TryGetValue(argc, argv, &i, &value) ||
+          !Dali::IsPlacementStage(value) ||
+          !TryGetValue(argc, argv, &i, &file_name)) {
+        error_output << "Invalid stage or file name of checkpoint!\n";
+        return false;
+      }
+      config_set_string("dali.save_checkpoint_stage", value.c_str());
+      config_set_string("dali.save_checkpoint_file", file_name.c_str());
+    } else if (arg == "-load_checkpoint") {
+      if (!TryGetValue(argc, argv, &i, &value)) {
+        error_output << "Invalid checkpoint file name!\n";
+        return false;
+      }
+      config_set_string("dali.load_checkpoint_file", value.c_str());
     } else {
       error_output << "Unknown arg: " << arg << "\n";
       return false;
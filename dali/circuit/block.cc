@@ -21,11 +21,85 @@
 #include "block.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "dali/common/helper.h"
 
 namespace dali {
 
+BlockNetList::BlockNetList(BlockNetList const& other)
+    : size_(other.size_), capacity_(other.capacity_) {
+  if (other.IsBorrowed()) {
+    data_ = other.data_;
+  } else if (capacity_ > 0) {
+    data_ = new int[capacity_];
+    std::copy(other.begin(), other.end(), data_);
+  }
+}
+
+BlockNetList::BlockNetList(BlockNetList&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      capacity_(std::exchange(other.capacity_, 0)) {}
+
+BlockNetList& BlockNetList::operator=(BlockNetList other) noexcept {
+  swap(*this, other);
+  return *this;
+}
+
+BlockNetList::~BlockNetList() {
+  if (!IsBorrowed()) {
+    delete[] data_;
+  }
+}
+
+void BlockNetList::push_back(int net_id) {
+  // reserve() exits if the ids are borrowed
+  if (size_ == capacity_ || IsBorrowed()) {
+    reserve(capacity_ == 0 ? 4 : 2 * static_cast<size_t>(capacity_));
+  }
+  data_[size_++] = net_id;
+}
+
+void BlockNetList::reserve(size_t capacity) {
+  DaliExpects(!IsBorrowed(), "Cannot add nets to a compacted block");
+  if (capacity <= capacity_) return;
+  DaliExpects(capacity < kBorrowed, "Too many nets on a block");
+  int* data = new int[capacity];
+  std::copy(begin(), end(), data);
+  delete[] data_;
+  data_ = data;
+  capacity_ = static_cast<uint32_t>(capacity);
+}
+
+void BlockNetList::Borrow(int* data, size_t size) {
+  DaliExpects(size < kBorrowed, "Too many nets on a block");
+  BlockNetList borrowed;
+  borrowed.data_ = data;
+  borrowed.size_ = static_cast<uint32_t>(size);
+  borrowed.capacity_ = kBorrowed;
+  swap(*this, borrowed);
+}
+
+void BlockNetList::MakeOwned() {
+  if (!IsBorrowed()) return;
+  BlockNetList owned;
+  owned.reserve(size_);
+  std::copy(begin(), end(), owned.data_);
+  owned.size_ = size_;
+  swap(*this, owned);
+}
+
+bool operator==(BlockNetList const& lhs, BlockNetList const& rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+void swap(BlockNetList& lhs, BlockNetList& rhs) noexcept {
+  std::swap(lhs.data_, rhs.data_);
+  std::swap(lhs.size_, rhs.size_);
+  std::swap(lhs.capacity_, rhs.capacity_);
+}
+
 void Block::SetHeight(int height) {
   eff_height_ = height;
   eff_area_ = eff_height_ * type_ptr_->Width();
@@ -22,24 +22,65 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <charconv>
 #include <chrono>
 #include <climits>
 #include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <optional>
 #include <string>
+#include <string_view>
 
 #include "dali/circuit/enums.h"
 #include "dali/common/elapsed_time.h"
 #include "dali/common/helper.h"
+#include "dali/common/mapped_file.h"
 #include "dali/common/opt_reg_dist.h"
+#include "dali/common/placement_metrics.h"
 
 namespace dali {
 
+namespace {
+
+void AppendInt(std::string& buf, long long value) {
+  char digits[24];
+  auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  buf.append(digits, result.ptr);
+}
+
+// the same text as an std::ostream with default flags
+void AppendDouble(std::string& buf, double value) {
+  char digits[32];
+  int length = snprintf(digits, sizeof(digits), "%g", value);
+  buf.append(digits, length);
+}
+
+// the position after the end of the line containing pos
+size_t LineEnd(std::string_view content, size_t pos) {
+  size_t line_end = content.find('\n', pos);
+  return (line_end == std::string_view::npos) ? content.size() : line_end + 1;
+}
+
+// runs one phase of loading from PhyDB with a nested placement timer, and
+// reports its wall time
+template <typename Load>
+void RunLoadPhase(std::string const& name, Load&& load) {
+  ScopedPlacementTimer timer(name);
+  ElapsedTime elapsed_time;
+  elapsed_time.RecordStartTime();
+  load();
+  elapsed_time.RecordEndTime();
+  LOG(info) << "  " << name << ": " << elapsed_time.GetWallTime() << " s\n";
+}
+
+}  // namespace
+
 Circuit::Circuit() { AddDummyIOPinBlockType(); }
 
-void Circuit::InitializeFromPhyDB(phydb::PhyDB* phy_db_ptr) {
+void Circuit::InitializeFromPhyDB(phydb::PhyDB* phy_db_ptr, int num_threads) {
+  ScopedPlacementTimer timer("load_phydb");
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
@@ -47,10 +88,10 @@ void Circuit::InitializeFromPhyDB(phydb::PhyDB* phy_db_ptr) {
 
   PrintHorizontalLine();
   LOG(info) << "Load information from PhyDB\n";
-  LoadTech(phy_db_ptr_);
-  LoadDesign();
-  LoadCell(phy_db_ptr_);
-  UpdateTotalBlkArea();
+  RunLoadPhase("tech", [&]() { LoadTech(phy_db_ptr_); });
+  LoadDesign(num_threads);
+  RunLoadPhase("cell", [&]() { LoadCell(phy_db_ptr_); });
+  RunLoadPhase("block_area", [&]() { UpdateTotalBlkArea(); });
 
   elapsed_time.RecordEndTime();
   elapsed_time.PrintTimeElapsed();
@@ -411,22 +452,24 @@ int Circuit::DieAreaOffsetY() const {
 
 void Circuit::ReserveSpaceForDesignImp(size_t components_count,
                                        size_t pins_count, size_t nets_count) {
-  design_.Blocks().reserve(components_count + pins_count);
+  design_.block_collection_.Reserve(components_count + pins_count);
   design_.iopins_.reserve(pins_count);
+  design_.iopin_name_id_map_.reserve(pins_count);
   design_.nets_.reserve(nets_count);
+  design_.net_name_index_.Reserve(nets_count);
 }
 
 std::vector<Block>& Circuit::Blocks() { return design_.Blocks(); }
 
-bool Circuit::IsBlockExisting(std::string const& block_name) {
+bool Circuit::IsBlockExisting(std::string_view block_name) {
   return design_.block_collection_.NameExists(block_name);
 }
 
-int Circuit::GetBlockId(std::string const& block_name) {
+int Circuit::GetBlockId(std::string_view block_name) {
   return design_.block_collection_.GetInstanceIdByName(block_name);
 }
 
-Block* Circuit::GetBlockPtr(std::string const& block_name) {
+Block* Circuit::GetBlockPtr(std::string_view block_name) {
   return design_.block_collection_.GetInstanceByName(block_name);
 }
 
@@ -477,8 +520,9 @@ void Circuit::ReportBlockList() {
 }
 
 void Circuit::ReportBlockMap() {
-  for (auto& it : design_.BlockNameIdMap()) {
-    LOG(info) << it.first << " " << it.second << "\n";
+  NameIndex const& block_names = design_.BlockNameIdMap();
+  for (size_t id = 0; id < block_names.Size(); ++id) {
+    LOG(info) << block_names.Name(id) << " " << id << "\n";
   }
 }
 
@@ -563,21 +607,18 @@ void Circuit::ReportIOPin() {
 
 std::vector<Net>& Circuit::Nets() { return design_.nets_; }
 
-bool Circuit::IsNetExisting(std::string const& net_name) {
-  return !(design_.net_name_id_map_.find(net_name) ==
-           design_.net_name_id_map_.end());
+bool Circuit::IsNetExisting(std::string_view net_name) {
+  return design_.net_name_index_.Find(net_name) != NameIndex::kNotFound;
 }
 
-int Circuit::GetNetId(std::string const& net_name) {
-  auto ret = design_.net_name_id_map_.find(net_name);
-  if (ret == design_.net_name_id_map_.end()) {
-    DaliExpects(false,
-                "Net name does not exist, cannot find index " + net_name);
-  }
-  return ret->second;
+int Circuit::GetNetId(std::string_view net_name) {
+  size_t id = design_.net_name_index_.Find(net_name);
+  DaliExpects(id != NameIndex::kNotFound,
+              "Net name does not exist, cannot find index " << net_name);
+  return static_cast<int>(id);
 }
 
-Net* Circuit::GetNetPtr(std::string const& net_name) {
+Net* Circuit::GetNetPtr(std::string_view net_name) {
   return &design_.nets_[GetNetId(net_name)];
 }
 
@@ -590,17 +631,17 @@ Net* Circuit::GetNetPtr(std::string const& net_name) {
  * ****/
 Net* Circuit::AddNet(std::string const& net_name, size_t capacity,
                      double weight) {
-  DaliExpects(!IsNetExisting(net_name),
+  DaliExpects(!design_.is_storage_compact_,
+              "Cannot add nets after Circuit::CompactStorage()");
+  auto [id, is_inserted] = design_.net_name_index_.Insert(net_name);
+  DaliExpects(is_inserted,
               "Net exists, cannot create this net again: " + net_name);
-  int map_size = (int)design_.net_name_id_map_.size();
-  design_.net_name_id_map_.insert(
-      std::unordered_map<std::string, int>::value_type(net_name, map_size));
-  std::pair<const std::string, int>* name_id_pair_ptr =
-      &(*design_.net_name_id_map_.find(net_name));
+  DaliExpects(id < INT_MAX, "Cannot add more nets, the limit is INT_MAX");
   if (weight < 0) {
     weight = constants_.normal_net_weight;
   }
-  design_.nets_.emplace_back(name_id_pair_ptr, capacity, weight);
+  design_.nets_.emplace_back(&design_.net_name_index_.Name(id),
+                             static_cast<int>(id), capacity, weight);
   return &design_.nets_.back();
 }
 
@@ -611,8 +652,11 @@ void Circuit::AddIoPinToNet(std::string const& iopin_name,
   iopin->SetNetPtr(io_net);
   io_net->AddIoPin(iopin);
   if (iopin->IsPrePlaced()) {
+    DaliExpects(!design_.is_storage_compact_,
+                "Cannot add block pins after Circuit::CompactStorage()");
     Block* blk_ptr = GetBlockPtr(iopin_name);
     Pin* pin = &(blk_ptr->TypePtr()->PinList()[0]);
+    blk_ptr->NetList().MakeOwned();
     io_net->AddBlkPinPair(blk_ptr, pin);
   }
 }
@@ -620,9 +664,13 @@ void Circuit::AddIoPinToNet(std::string const& iopin_name,
 void Circuit::AddBlkPinToNet(std::string const& blk_name,
                              std::string const& pin_name,
                              std::string const& net_name) {
+  DaliExpects(!design_.is_storage_compact_,
+              "Cannot add block pins after Circuit::CompactStorage()");
   Block* blk_ptr = GetBlockPtr(blk_name);
   Pin* pin = blk_ptr->TypePtr()->GetPinPtr(pin_name);
   Net* net = GetNetPtr(net_name);
+  // net lists loaded in bulk are borrowed from the block-to-net array
+  blk_ptr->NetList().MakeOwned();
   net->AddBlkPinPair(blk_ptr, pin);
 }
 
@@ -640,8 +688,9 @@ void Circuit::ReportNetList() {
 }
 
 void Circuit::ReportNetMap() {
-  for (auto& it : design_.net_name_id_map_) {
-    LOG(info) << it.first << " " << it.second << "\n";
+  NameIndex const& net_names = design_.net_name_index_;
+  for (size_t id = 0; id < net_names.Size(); ++id) {
+    LOG(info) << net_names.Name(id) << " " << id << "\n";
   }
 }
 
@@ -702,6 +751,136 @@ void Circuit::ReportBriefSummary() {
   ReportHPWL();
 }
 
+void Circuit::SetBlockNetLists(std::vector<size_t> const& offsets,
+                               std::vector<int>&& net_ids, int num_threads) {
+  std::vector<Block>& blocks = design_.Blocks();
+  DaliExpects(offsets.size() == blocks.size() + 1 &&
+                  offsets.back() == net_ids.size(),
+              "Block-to-net array does not match blocks");
+  // moving the array keeps its buffer, so net lists can point into it
+  design_.block_net_ids_ = std::move(net_ids);
+  int* data = design_.block_net_ids_.data();
+  int block_count = static_cast<int>(blocks.size());
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(blocks, offsets, data, block_count) schedule(static)
+  for (int i = 0; i < block_count; ++i) {
+    blocks[i].NetList().Borrow(data + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+}
+
+void Circuit::CompactStorage() {
+  if (design_.is_storage_compact_) return;
+  std::vector<Block>& blocks = design_.Blocks();
+  size_t net_id_count = 0;
+  bool is_borrowed = true;
+  for (auto& block : blocks) {
+    net_id_count += block.NetList().size();
+    is_borrowed = is_borrowed && block.NetList().IsBorrowed();
+  }
+
+  // net lists loaded in bulk already borrow from the block-to-net array
+  if (!is_borrowed) {
+    std::vector<size_t> offsets(blocks.size() + 1, 0);
+    std::vector<int> net_ids(net_id_count);
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      BlockNetList& net_list = blocks[i].NetList();
+      std::copy(net_list.begin(), net_list.end(),
+                net_ids.begin() + offsets[i]);
+      offsets[i + 1] = offsets[i] + net_list.size();
+    }
+    SetBlockNetLists(offsets, std::move(net_ids), 1);
+  }
+
+  // net capacities may be overestimated when nets are loaded
+  for (auto& net : design_.nets_) {
+    net.BlockPins().shrink_to_fit();
+    net.IoPinPtrs().shrink_to_fit();
+  }
+  design_.is_storage_compact_ = true;
+}
+
+std::vector<ContainerMemory> Circuit::MemoryUsage() {
+  std::vector<ContainerMemory> usage;
+
+  std::vector<Block>& blocks = design_.Blocks();
+  usage.push_back({"blocks", blocks.size(),
+                   HeapAllocationBytes(blocks.capacity() * sizeof(Block))});
+  ContainerMemory block_nets{
+      "block net lists", 0,
+      HeapAllocationBytes(design_.block_net_ids_.capacity() * sizeof(int))};
+  ContainerMemory stretch_lengths{"block stretch lengths", 0, 0};
+  for (auto& block : blocks) {
+    block_nets.count += block.NetList().size();
+    block_nets.bytes += HeapAllocationBytes(block.NetList().HeapBytes());
+    stretch_lengths.count += block.StretchLengths().size();
+    stretch_lengths.bytes +=
+        HeapAllocationBytes(block.StretchLengths().capacity() * sizeof(int));
+  }
+  usage.push_back(block_nets);
+  usage.push_back(stretch_lengths);
+  NameIndex const& block_names = design_.BlockNameIdMap();
+  usage.push_back(
+      {"block name map", block_names.Size(), block_names.HeapBytes()});
+
+  ContainerMemory other_blocks{"well tap, filler and end cap cells", 0, 0};
+  for (auto* collection :
+       {&design_.well_tap_cell_collection_, &design_.filler_cell_collection_,
+        &design_.end_cap_cell_collection_}) {
+    other_blocks.count += collection->GetSize();
+    other_blocks.bytes +=
+        HeapAllocationBytes(collection->Instances().capacity() *
+                            sizeof(Block)) +
+        collection->NameToIdMap().HeapBytes();
+  }
+  usage.push_back(other_blocks);
+
+  ContainerMemory block_types{"block types", 0, 0};
+  for (auto* collection : {&tech_.block_type_collection_,
+                           &tech_.end_cap_cell_type_collection_}) {
+    block_types.count += collection->GetSize();
+    block_types.bytes +=
+        HeapAllocationBytes(collection->Instances().capacity() *
+                            sizeof(BlockType)) +
+        collection->NameToIdMap().HeapBytes();
+    for (auto& block_type : collection->Instances()) {
+      block_types.bytes +=
+          HeapAllocationBytes(block_type.PinList().capacity() * sizeof(Pin));
+    }
+  }
+  usage.push_back(block_types);
+
+  std::vector<Net>& nets = design_.nets_;
+  usage.push_back({"nets", nets.size(),
+                   HeapAllocationBytes(nets.capacity() * sizeof(Net))});
+  ContainerMemory net_pins{"net block pins", 0, 0};
+  ContainerMemory net_iopins{"net I/O pins", 0, 0};
+  for (auto& net : nets) {
+    net_pins.count += net.BlockPins().size();
+    net_pins.bytes +=
+        HeapAllocationBytes(net.BlockPins().capacity() * sizeof(NetPin));
+    net_iopins.count += net.IoPinPtrs().size();
+    net_iopins.bytes +=
+        HeapAllocationBytes(net.IoPinPtrs().capacity() * sizeof(IoPin*));
+  }
+  usage.push_back(net_pins);
+  usage.push_back(net_iopins);
+  usage.push_back({"net name map", design_.net_name_index_.Size(),
+                   design_.net_name_index_.HeapBytes()});
+
+  std::vector<IoPin>& iopins = design_.iopins_;
+  usage.push_back({"I/O pins", iopins.size(),
+                   HeapAllocationBytes(iopins.capacity() * sizeof(IoPin)) +
+                       StringMapBytes(design_.iopin_name_id_map_)});
+  usage.push_back(
+      {"rows", design_.rows_.size(),
+       HeapAllocationBytes(design_.rows_.capacity() * sizeof(GeneralRow))});
+  return usage;
+}
+
+void Circuit::ReportMemoryUsage() {
+  ReportContainerMemory("Circuit memory usage", MemoryUsage());
+}
+
 void Circuit::SetNwellParams(double width, double spacing, double op_spacing,
                              double max_plug_dist, double overhang) {
   tech_.nwell_layer_.SetParams(width, spacing, op_spacing, max_plug_dist,
@@ -1089,6 +1268,20 @@ double Circuit::WeightedHPWL() {
   return hpwl_x * GridValueX() + hpwl_y * GridValueY();
 }
 
+void Circuit::BuildNetlistView(NetlistView& netlist_view) {
+  netlist_view.Build(design_.nets_, design_.Blocks());
+}
+
+double Circuit::WeightedHPWLX(NetlistView& netlist_view, int num_threads) {
+  netlist_view.UpdateBlockLocationsX(design_.Blocks(), num_threads);
+  return netlist_view.TotalWeightedHpwl(true, num_threads) * GridValueX();
+}
+
+double Circuit::WeightedHPWLY(NetlistView& netlist_view, int num_threads) {
+  netlist_view.UpdateBlockLocationsY(design_.Blocks(), num_threads);
+  return netlist_view.TotalWeightedHpwl(false, num_threads) * GridValueY();
+}
+
 void Circuit::ReportHPWL() {
   LOG(info) << "  current weighted HPWL: " << WeightedHPWL() << "um\n";
 }
@@ -1422,233 +1615,187 @@ void Circuit::SaveLefFile(std::string const& input_lef_file_full_name,
   ist.close();
 }
 
-void Circuit::SaveCell(std::ofstream& ost, Block& blk) const {
-  ost << "- " << blk.Name() << " " << blk.TypePtr()->Name() << " + "
-      << blk.StatusStr() << " "
-      << "( " << LocDali2PhydbX(blk.LLX()) << " " << LocDali2PhydbY(blk.LLY())
-      << " ) " << OrientStr(blk.Orient()) << " ;\n";
+void Circuit::AppendCell(std::string& buf, Block& blk) const {
+  buf += "- ";
+  buf += blk.Name();
+  buf += ' ';
+  buf += blk.TypePtr()->Name();
+  buf += " + ";
+  buf += blk.StatusStr();
+  buf += " ( ";
+  AppendInt(buf, LocDali2PhydbX(blk.LLX()));
+  buf += ' ';
+  AppendInt(buf, LocDali2PhydbY(blk.LLY()));
+  buf += " ) ";
+  buf += OrientStr(blk.Orient());
+  buf += " ;\n";
 }
 
-void Circuit::SaveNormalCells(std::ofstream& ost,
-                              std::unordered_set<PlaceStatus>* filter_out) {
+void Circuit::AppendNormalCells(std::string& buf, bool is_unplaced_skipped) {
   for (auto& blk : design_.Blocks()) {
     if (blk.TypePtr() == tech_.io_dummy_blk_type_ptr_) continue;
-    if (filter_out != nullptr &&
-        filter_out->find(blk.Status()) != filter_out->end()) {
-      continue;
-    }
-    SaveCell(ost, blk);
+    if (is_unplaced_skipped && blk.Status() == UNPLACED) continue;
+    AppendCell(buf, blk);
   }
 }
 
-void Circuit::SaveWellTapCells(std::ofstream& ost) {
+void Circuit::AppendWellTapCells(std::string& buf) {
   for (auto& blk : design_.WellTaps()) {
-    SaveCell(ost, blk);
+    AppendCell(buf, blk);
   }
 }
 
-void Circuit::SaveEndCapCells(std::ofstream& ost) {
+void Circuit::AppendEndCapCells(std::string& buf) {
   for (auto& block : design_.EndCapCellCollection().Instances()) {
-    SaveCell(ost, block);
-  }
-}
-
-void Circuit::SaveCircuitWellCoverCell(std::ofstream& ost,
-                                       std::string const& base_name) const {
-  ost << "- " << "npwells" << " " << base_name + "well" << " + "
-      << "COVER "
-      << "( " << LocDali2PhydbX(RegionLLX()) << " "
-      << LocDali2PhydbY(RegionLLY()) << " ) "
-      << "N"
-      << " ;\n";
-}
-
-void Circuit::SaveCircuitPpnpCoverCell(std::ofstream& ost,
-                                       std::string const& base_name) const {
-  ost << "- " << "ppnps" << " " << base_name + "ppnp" << " + "
-      << "COVER "
-      << "( " << LocDali2PhydbX(RegionLLX()) << " "
-      << LocDali2PhydbY(RegionLLY()) << " ) "
-      << "N"
-      << " ;\n";
-}
-
-void Circuit::ExportNormalCells(std::ofstream& ost) {
-  // count the number of normal cells
-  size_t cell_count = 0;
-  for (auto& block : design_.Blocks()) {
-    // skip dummy cells for I/O pins
-    if (block.TypePtr() == tech_.io_dummy_blk_type_ptr_) {
-      continue;
-    }
-    ++cell_count;
+    AppendCell(buf, block);
   }
-  cell_count += design_.WellTaps().size();
-  cell_count += design_.EndCapCellCollection().Instances().size();
-  ost << "COMPONENTS " << cell_count << " ;\n";
-  SaveNormalCells(ost);
-  SaveWellTapCells(ost);
-  SaveEndCapCells(ost);
-  ost << "END COMPONENTS\n\n";
 }
 
-void Circuit::ExportWellTapCells(std::ofstream& ost) {
-  size_t cell_count = design_.WellTaps().size();
-  ost << "COMPONENTS " << cell_count << " ;\n";
-  SaveWellTapCells(ost);
-  ost << "END COMPONENTS\n\n";
+void Circuit::AppendCoverCell(std::string& buf, std::string const& cell_name,
+                              std::string const& type_name) const {
+  buf += "- ";
+  buf += cell_name;
+  buf += ' ';
+  buf += type_name;
+  buf += " + COVER ( ";
+  AppendInt(buf, LocDali2PhydbX(RegionLLX()));
+  buf += ' ';
+  AppendInt(buf, LocDali2PhydbY(RegionLLY()));
+  buf += " ) N ;\n";
 }
 
-void Circuit::ExportNormalAndWellTapCells(std::ofstream& ost,
-                                          std::string const& base_name) {
-  size_t cell_count = 0;
-  for (auto& block : design_.Blocks()) {
-    if (block.TypePtr() == tech_.io_dummy_blk_type_ptr_) continue;
-    ++cell_count;
-  }
-  cell_count += design_.WellTaps().size();
-  cell_count += design_.EndCapCellCollection().Instances().size();
-  cell_count += 1;
-  ost << "COMPONENTS " << cell_count << " ;\n";
-  SaveCircuitWellCoverCell(ost, base_name);
-  SaveNormalCells(ost);
-  SaveWellTapCells(ost);
-  SaveEndCapCells(ost);
-  ost << "END COMPONENTS\n\n";
-}
-
-void Circuit::ExportNormalWellTapAndCoverCells(std::ofstream& ost,
-                                               std::string const& base_name) {
-  size_t cell_count = 0;
-  for (auto& block : design_.Blocks()) {
-    if (block.TypePtr() == tech_.io_dummy_blk_type_ptr_) continue;
-    ++cell_count;
+/****
+ * @brief Append the COMPONENTS section to a buffer.
+ *
+ * @param mode: the same as save_cell of SaveDefFile().
+ */
+void Circuit::AppendCells(std::string& buf, std::string const& base_name,
+                          int mode) {
+  if (mode == 0) {  // no cells are saved
+    buf += "COMPONENTS 0 ;\nEND COMPONENTS\n\n";
+    return;
   }
-  cell_count += design_.WellTaps().size();
-  cell_count += design_.EndCapCellCollection().Instances().size();
-  cell_count += 2;
-  ost << "COMPONENTS " << cell_count << " ;\n";
-  SaveCircuitWellCoverCell(ost, base_name);
-  SaveCircuitPpnpCoverCell(ost, base_name);
-  SaveNormalCells(ost);
-  SaveWellTapCells(ost);
-  SaveEndCapCells(ost);
-  ost << "END COMPONENTS\n\n";
-}
-
-void Circuit::ExportCellsExcept(std::ofstream& ost,
-                                std::unordered_set<PlaceStatus>* filter) {
   size_t cell_count = 0;
+  size_t normal_cell_count = 0;
   for (auto& block : design_.Blocks()) {
+    // skip dummy cells for I/O pins
     if (block.TypePtr() == tech_.io_dummy_blk_type_ptr_) continue;
-    if (block.Status() == UNPLACED) continue;
+    ++normal_cell_count;
+    if (mode == 5 && block.Status() == UNPLACED) continue;
     ++cell_count;
   }
-  cell_count += design_.WellTaps().size();
-  ost << "COMPONENTS " << cell_count << " ;\n";
-  SaveNormalCells(ost, filter);
-  SaveWellTapCells(ost);
-  ost << "END COMPONENTS\n\n";
-}
-
-void Circuit::ExportCells(std::ofstream& ost, std::string const& base_name,
-                          int mode) {
+  size_t well_tap_count = design_.WellTaps().size();
+  size_t end_cap_count = design_.EndCapCellCollection().Instances().size();
   switch (mode) {
-    case 0: {  // no cells are saved
-      ost << "COMPONENTS 0 ;\n";
-      ost << "END COMPONENTS\n\n";
-      break;
-    }
     case 1: {  // save all normal cells, regardless of the placement status
-      ExportNormalCells(ost);
+      cell_count += well_tap_count + end_cap_count;
       break;
     }
     case 2: {  // save only well tap cells
-      ExportWellTapCells(ost);
+      cell_count = well_tap_count;
       break;
     }
     case 3: {  // save all normal cells + dummy cell for well filling
-      ExportNormalAndWellTapCells(ost, base_name);
+      cell_count += well_tap_count + end_cap_count + 1;
       break;
     }
     case 4: {  // save all normal cells + dummy cell for well filling + dummy
                // cell for n/p-plus filling
-      ExportNormalWellTapAndCoverCells(ost, base_name);
+      cell_count += well_tap_count + end_cap_count + 2;
       break;
     }
     case 5: {  // save all placed and fixed cells
-      std::unordered_set<PlaceStatus> filter_out;
-      filter_out.insert(UNPLACED);
-      ExportCellsExcept(ost, &filter_out);
+      cell_count += well_tap_count;
       break;
     }
     default: {
       DaliExpects(false, "Unknown option, allowed value: 0-5");
     }
   }
-}
-
-void Circuit::SaveIoPin(std::ofstream& ost, IoPin& iopin,
-                        bool after_io_place) const {
-  ost << "- " << iopin.Name() << " + NET " << iopin.NetName() << " + DIRECTION "
-      << iopin.SigDirectStr() << " + USE " << iopin.SigUseStr();
+  // a component takes about 50 characters
+  buf.reserve(buf.size() + 64 * (normal_cell_count + well_tap_count));
+  buf += "COMPONENTS ";
+  AppendInt(buf, static_cast<long long>(cell_count));
+  buf += " ;\n";
+  if (mode == 3 || mode == 4) {
+    AppendCoverCell(buf, "npwells", base_name + "well");
+  }
+  if (mode == 4) {
+    AppendCoverCell(buf, "ppnps", base_name + "ppnp");
+  }
+  if (mode != 2) {
+    AppendNormalCells(buf, mode == 5);
+  }
+  AppendWellTapCells(buf);
+  if (mode != 2 && mode != 5) {
+    AppendEndCapCells(buf);
+  }
+  buf += "END COMPONENTS\n\n";
+}
+
+void Circuit::AppendIoPin(std::string& buf, IoPin& iopin,
+                          bool after_io_place) const {
+  buf += "- ";
+  buf += iopin.Name();
+  buf += " + NET ";
+  buf += iopin.NetName();
+  buf += " + DIRECTION ";
+  buf += iopin.SigDirectStr();
+  buf += " + USE ";
+  buf += iopin.SigUseStr();
   if ((after_io_place && iopin.IsPlaced()) ||
       (!after_io_place && iopin.IsPrePlaced())) {
-    std::string const& metal_name = iopin.LayerName();
-    ost << "\n  + LAYER " << metal_name << " ( "
-        << iopin.GetShape().LLX() * design_.distance_microns_ << " "
-        << iopin.GetShape().LLY() * design_.distance_microns_ << " ) "
-        << " ( " << iopin.GetShape().URX() * design_.distance_microns_ << " "
-        << iopin.GetShape().URY() * design_.distance_microns_ << " ) ";
-    ost << "\n  + PLACED ( " << LocDali2PhydbX(iopin.X()) << " "
-        << LocDali2PhydbY(iopin.Y()) << " ) ";
+    double distance_microns = design_.distance_microns_;
+    buf += "\n  + LAYER ";
+    buf += iopin.LayerName();
+    buf += " ( ";
+    AppendDouble(buf, iopin.GetShape().LLX() * distance_microns);
+    buf += ' ';
+    AppendDouble(buf, iopin.GetShape().LLY() * distance_microns);
+    buf += " )  ( ";
+    AppendDouble(buf, iopin.GetShape().URX() * distance_microns);
+    buf += ' ';
+    AppendDouble(buf, iopin.GetShape().URY() * distance_microns);
+    buf += " ) \n  + PLACED ( ";
+    AppendInt(buf, LocDali2PhydbX(iopin.X()));
+    buf += ' ';
+    AppendInt(buf, LocDali2PhydbY(iopin.Y()));
+    buf += " ) ";
     if (iopin.X() == design_.die_area_.region_left_) {
-      ost << "E";
+      buf += 'E';
     } else if (iopin.X() == design_.die_area_.region_right_) {
-      ost << "W";
+      buf += 'W';
     } else if (iopin.Y() == design_.die_area_.region_bottom_) {
-      ost << "N";
+      buf += 'N';
     } else {
-      ost << "S";
+      buf += 'S';
     }
   }
-  ost << " ;\n";
-}
-
-void Circuit::ExportIoPinsInfoAfterIoPlacement(std::ofstream& ost) {
-  ost << "PINS " << design_.iopins_.size() << " ;\n";
-  DaliExpects(!tech_.metal_list_.empty(),
-              "Need metal layer info to generate PIN location\n");
-  for (auto& iopin : design_.iopins_) {
-    bool after_io_place = true;
-    SaveIoPin(ost, iopin, after_io_place);
-  }
-  ost << "END PINS\n\n";
+  buf += " ;\n";
 }
 
-void Circuit::ExportIoPinsInfoBeforeIoPlacement(std::ofstream& ost) {
-  ost << "PINS " << design_.iopins_.size() << " ;\n";
-  DaliExpects(!tech_.metal_list_.empty(),
-              "Need metal layer info to generate PIN location\n");
-  for (auto& iopin : design_.iopins_) {
-    bool after_io_place = false;
-    SaveIoPin(ost, iopin, after_io_place);
-  }
-  ost << "END PINS\n\n";
-}
-
-void Circuit::ExportIoPins(std::ofstream& ost, int mode) {
+/****
+ * @brief Append the PINS section to a buffer.
+ *
+ * @param mode: the same as save_iopin of SaveDefFile().
+ */
+void Circuit::AppendIoPins(std::string& buf, int mode) {
   switch (mode) {
     case 0: {  // no IOPINs are saved
-      ost << "PINS 0 ;\n";
-      break;
-    }
-    case 1: {  // save all IOPINs
-      ExportIoPinsInfoAfterIoPlacement(ost);
+      buf += "PINS 0 ;\n";
       break;
     }
+    case 1:    // save all IOPINs
     case 2: {  // save all IOPINs with status before IO placement
-      ExportIoPinsInfoBeforeIoPlacement(ost);
+      DaliExpects(!tech_.metal_list_.empty(),
+                  "Need metal layer info to generate PIN location\n");
+      buf += "PINS ";
+      AppendInt(buf, static_cast<long long>(design_.iopins_.size()));
+      buf += " ;\n";
+      for (auto& iopin : design_.iopins_) {
+        AppendIoPin(buf, iopin, mode == 1);
+      }
+      buf += "END PINS\n\n";
       break;
     }
     default: {
@@ -1657,54 +1804,68 @@ void Circuit::ExportIoPins(std::ofstream& ost, int mode) {
   }
 }
 
-void Circuit::ExportAllNets(std::ofstream& ost) {
-  ost << "NETS " << design_.nets_.size() << " ;\n";
+void Circuit::AppendAllNets(std::string& buf) {
+  buf += "NETS ";
+  AppendInt(buf, static_cast<long long>(design_.nets_.size()));
+  buf += " ;\n";
   for (auto& net : design_.nets_) {
-    ost << "- " << net.Name() << "\n";
-    ost << " ";
+    buf += "- ";
+    buf += net.Name();
+    buf += "\n ";
     for (auto& iopin : net.IoPinPtrs()) {
-      ost << " ( PIN " << iopin->Name() << " ) ";
+      buf += " ( PIN ";
+      buf += iopin->Name();
+      buf += " ) ";
     }
     for (auto& pin_pair : net.BlockPins()) {
       if (pin_pair.BlkPtr()->TypePtr() == tech_.io_dummy_blk_type_ptr_) {
         continue;
       }
-      ost << " ( " << pin_pair.BlockName() << " " << pin_pair.PinName()
-          << " ) ";
+      buf += " ( ";
+      buf += pin_pair.BlockName();
+      buf += ' ';
+      buf += pin_pair.PinName();
+      buf += " ) ";
     }
-    ost << "\n" << " ;\n";
+    buf += "\n ;\n";
   }
-  ost << "END NETS\n\n";
+  buf += "END NETS\n\n";
 }
 
-void Circuit::ExportPowerNetsForWellTapCells(std::ofstream& ost) {
-  ost << "\nNETS 2 ;\n";
+void Circuit::AppendPowerNetsForWellTapCells(std::string& buf) {
+  buf += "\nNETS 2 ;\n";
   // GND
-  ost << "- ggnndd\n";
-  ost << " ";
+  buf += "- ggnndd\n ";
   for (auto& block : design_.WellTaps()) {
-    ost << " ( " << block.Name() << " g0 )";
+    buf += " ( ";
+    buf += block.Name();
+    buf += " g0 )";
   }
-  ost << "\n" << " ;\n";
+  buf += "\n ;\n";
   // Vdd
-  ost << "- vvdddd\n";
-  ost << " ";
+  buf += "- vvdddd\n ";
   for (auto& block : design_.WellTaps()) {
-    ost << " ( " << block.Name() << " v0 )";
+    buf += " ( ";
+    buf += block.Name();
+    buf += " v0 )";
   }
-  ost << "\n" << " ;\n";
-  ost << "END NETS\n\n";
+  buf += "\n ;\n";
+  buf += "END NETS\n\n";
 }
 
-void Circuit::ExportNets(std::ofstream& ost, int mode) {
+/****
+ * @brief Append the NETS section to a buffer.
+ *
+ * @param mode: the same as save_net of SaveDefFile().
+ */
+void Circuit::AppendNets(std::string& buf, int mode) {
   switch (mode) {
     case 0: {  // no nets are saved
-      ost << "NETS 0 ;\n";
-      ost << "END NETS\n\n";
+      buf += "NETS 0 ;\nEND NETS\n\n";
       break;
     }
     case 1: {  // save all nets
-      ExportAllNets(ost);
+      AppendAllNets(buf);
       break;
     }
     case 2: {  // save nets containing saved cells and IOPINs
@@ -1712,7 +1873,7 @@ void Circuit::ExportNets(std::ofstream& ost, int mode) {
       break;
     }
     case 3: {  // save power nets for well tap cell
-      ExportPowerNetsForWellTapCells(ost);
+      AppendPowerNetsForWellTapCells(buf);
       break;
     }
     default: {
@@ -1755,89 +1916,162 @@ void Circuit::SaveDefFile(std::string const& base_name,
                           std::string const& def_file_name,
                           [[maybe_unused]] int save_floorplan, int save_cell,
                           int save_iopin, int save_net) {
-  std::string file_name = base_name + name_padding + ".def";
-  LOG(info) << "Writing DEF file: " << file_name << "\n";
-  std::ofstream ost(file_name.c_str());
-  DaliExpects(ost.is_open(), "Cannot open file " + file_name);
-  std::ifstream ist(def_file_name.c_str());
-  DaliExpects(ist.is_open(), "Cannot open file " + def_file_name);
-
-  // title of this DEF file
-  using std::chrono::system_clock;
-  system_clock::time_point today = system_clock::now();
-  std::time_t tt = system_clock::to_time_t(today);
-  ost << "##################################################\n";
-  ost << "#  created by: Dali, build time: " << __DATE__ << " " << __TIME__
-      << "\n";
-  ost << "#  time: " << ctime(&tt);
-  ost << "##################################################\n";
-
-  std::string line;
-  // 1. floor-plan
-  while (true) {
-    getline(ist, line);
-    if (line.find("COMPONENTS") != std::string::npos || ist.eof()) {
-      break;
-    }
-    ost << line << "\n";
-  }
-  // 2. COMPONENT
-  ExportCells(ost, base_name, save_cell);
-  // 3. PIN
-  ExportIoPins(ost, save_iopin);
-  // 4. NET
-  ExportNets(ost, save_net);
-
-  ost << "END DESIGN\n";
-
-  ost.close();
-  ist.close();
+  DefFileOptions def_file;
+  def_file.file_name = base_name + name_padding + ".def";
+  def_file.base_name = base_name;
+  def_file.save_cell = save_cell;
+  def_file.save_iopin = save_iopin;
+  def_file.save_net = save_net;
+  SaveDefFiles({def_file}, def_file_name);
 }
 
 void Circuit::SaveDefFileComponent(std::string const& name_of_file,
                                    std::string const& def_file_name) {
-  std::string file_name = name_of_file;
-  LOG(info) << "Writing DEF file: " << file_name << "\n";
-  std::ofstream ost(file_name.c_str());
-  DaliExpects(ost.is_open(), "Cannot open file " + file_name);
-  std::ifstream ist(def_file_name.c_str());
-  DaliExpects(ist.is_open(), "Cannot open file " + def_file_name);
-
-  // title of this DEF file
-  using std::chrono::system_clock;
-  system_clock::time_point today = system_clock::now();
-  std::time_t tt = system_clock::to_time_t(today);
-  ost << "##################################################\n";
-  ost << "#  created by: Dali, build time: " << __DATE__ << " " << __TIME__
-      << "\n";
-  ost << "#  time: " << ctime(&tt);
-  ost << "##################################################\n";
+  DefFileOptions def_file;
+  def_file.file_name = name_of_file;
+  def_file.save_cell = 1;
+  def_file.is_component_only = true;
+  SaveDefFiles({def_file}, def_file_name);
+}
 
-  std::string line;
-  // copy everything before COMPONENTS
-  while (true) {
-    getline(ist, line);
-    if (line.find("COMPONENTS") != std::string::npos || ist.eof()) {
-      break;
+/****
+ * @brief Save DEF files which share the floorplan of an input DEF file.
+ *
+ * The input DEF file is mapped into memory and read once. Everything before
+ * the first line containing COMPONENTS is the floorplan, and everything after
+ * the next line containing END COMPONENTS is only copied to files with
+ * is_component_only. Every distinct COMPONENTS, PINS and NETS section is
+ * formatted once into a buffer, buffers are shared by all files which need
+ * them. With more than one thread, sections are formatted and files are
+ * written concurrently, the files are the same for any number of threads.
+ *
+ * @param def_files: output files and the content of each one.
+ * @param def_file_name: the input DEF file.
+ * @param num_threads: the number of threads to format and write files.
+ */
+void Circuit::SaveDefFiles(std::vector<DefFileOptions> const& def_files,
+                           std::string const& def_file_name,
+                           int num_threads) {
+  MappedFile input(def_file_name);
+  std::string_view content = input.Content();
+  // only complete lines are copied
+  size_t content_end = content.rfind('\n');
+  content_end = (content_end == std::string_view::npos) ? 0 : content_end + 1;
+  std::string_view floorplan = content.substr(0, content_end);
+  std::string_view remainder;
+  size_t components_pos = content.find("COMPONENTS");
+  if (components_pos != std::string_view::npos) {
+    size_t line_begin = content.rfind('\n', components_pos);
+    line_begin = (line_begin == std::string_view::npos) ? 0 : line_begin + 1;
+    floorplan = content.substr(0, line_begin);
+    size_t end_pos = content.find("END COMPONENTS", LineEnd(content,
+                                                           components_pos));
+    if (end_pos != std::string_view::npos) {
+      size_t remainder_begin = std::min(LineEnd(content, end_pos), content_end);
+      remainder = content.substr(remainder_begin,
+                                 content_end - remainder_begin);
     }
-    ost << line << "\n";
   }
-  // COMPONENT
-  ExportCells(ost, "", 1);
 
-  // copy everything after END COMPONENTS
-  while (true) {
-    getline(ist, line);
-    if (line.find("END COMPONENTS") != std::string::npos || ist.eof()) {
-      break;
+  // sections are identified by their kind, mode and base name
+  enum SectionKind { CELLS = 0, IOPINS = 1, NETS = 2 };
+  struct DefSection {
+    SectionKind kind;
+    int mode;
+    std::string base_name;
+    std::string text;
+  };
+  std::vector<DefSection> sections;
+  auto find_or_add_section = [&](SectionKind kind, int mode,
+                                 std::string const& base_name) {
+    for (size_t i = 0; i < sections.size(); ++i) {
+      if (sections[i].kind == kind && sections[i].mode == mode &&
+          sections[i].base_name == base_name) {
+        return static_cast<int>(i);
+      }
+    }
+    sections.push_back({kind, mode, base_name, ""});
+    return static_cast<int>(sections.size()) - 1;
+  };
+  std::vector<std::vector<int>> file_sections(def_files.size());
+  for (size_t i = 0; i < def_files.size(); ++i) {
+    DefFileOptions const& def_file = def_files[i];
+    // options are checked here, errors cannot be raised by worker threads
+    DaliExpects(def_file.save_cell >= 0 && def_file.save_cell <= 5,
+                "Unknown option, allowed value: 0-5");
+    bool is_cover_cell_saved =
+        def_file.save_cell == 3 || def_file.save_cell == 4;
+    file_sections[i].push_back(find_or_add_section(
+        CELLS, def_file.save_cell,
+        is_cover_cell_saved ? def_file.base_name : ""));
+    if (def_file.is_component_only) continue;
+    DaliExpects(def_file.save_iopin >= 0 && def_file.save_iopin <= 2,
+                "Unknown option, allowed value: 0-2\n");
+    DaliExpects(def_file.save_iopin == 0 || !tech_.metal_list_.empty(),
+                "Need metal layer info to generate PIN location\n");
+    DaliExpects(def_file.save_net >= 0 && def_file.save_net <= 3,
+                "Unknown option, allowed value: 0-3\n");
+    DaliExpects(def_file.save_net != 2,
+                "This part has not been implemented\n");
+    file_sections[i].push_back(
+        find_or_add_section(IOPINS, def_file.save_iopin, ""));
+    file_sections[i].push_back(
+        find_or_add_section(NETS, def_file.save_net, ""));
+  }
+
+  int num_sections = static_cast<int>(sections.size());
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(sections, num_sections) schedule(dynamic, 1)
+  for (int i = 0; i < num_sections; ++i) {
+    DefSection& section = sections[i];
+    if (section.kind == CELLS) {
+      AppendCells(section.text, section.base_name, section.mode);
+    } else if (section.kind == IOPINS) {
+      AppendIoPins(section.text, section.mode);
+    } else {
+      AppendNets(section.text, section.mode);
     }
   }
-  while (true) {
-    getline(ist, line);
-    if (ist.eof()) {
-      break;
+
+  // title of DEF files
+  using std::chrono::system_clock;
+  system_clock::time_point today = system_clock::now();
+  std::time_t tt = system_clock::to_time_t(today);
+  std::string title = "##################################################\n";
+  title += "#  created by: Dali, build time: ";
+  title += __DATE__;
+  title += " ";
+  title += __TIME__;
+  title += "\n#  time: ";
+  title += ctime(&tt);
+  title += "##################################################\n";
+
+  int num_files = static_cast<int>(def_files.size());
+  std::vector<std::ofstream> osts(num_files);
+  for (int i = 0; i < num_files; ++i) {
+    std::string const& file_name = def_files[i].file_name;
+    LOG(info) << "Writing DEF file: " << file_name << "\n";
+    osts[i].open(file_name, std::ios::binary);
+    DaliExpects(osts[i].is_open(), "Cannot open file " + file_name);
+  }
+#pragma omp parallel for num_threads(num_threads) default(none)              \
+    shared(def_files, num_files, osts, file_sections, sections, title, \
+               floorplan, remainder) schedule(dynamic, 1)
+  for (int i = 0; i < num_files; ++i) {
+    std::ofstream& ost = osts[i];
+    ost.write(title.data(), static_cast<std::streamsize>(title.size()));
+    ost.write(floorplan.data(), static_cast<std::streamsize>(floorplan.size()));
+    for (int section_id : file_sections[i]) {
+      std::string const& text = sections[section_id].text;
+      ost.write(text.data(), static_cast<std::streamsize>(text.size()));
     }
-    ost << line << "\n";
+    if (def_files[i].is_component_only) {
+      ost.write(remainder.data(),
+                static_cast<std::streamsize>(remainder.size()));
+    } else {
+      ost << "END DESIGN\n";
+    }
+    ost.close();
   }
 }
 
@@ -1937,11 +2171,12 @@ void Circuit::LoadBookshelfPl(std::string const& name_of_file) {
     getline(ist, line);
     StrTokenize(line, res);
     if (res.size() >= 4) {
-      if (IsBlockExisting(res[0])) {
+      size_t id = design_.BlockNameIdMap().Find(res[0]);
+      if (id != NameIndex::kNotFound) {
         try {
           lx = std::stod(res[1]) / GridValueX() / design_.distance_microns_;
           ly = std::stod(res[2]) / GridValueY() / design_.distance_microns_;
-          GetBlockPtr(res[0])->SetLoc(lx, ly);
+          Blocks()[id].SetLoc(lx, ly);
         } catch (...) {
           DaliExpects(false, "Invalid stod conversion:\n\t" + line);
         }
@@ -1999,6 +2234,10 @@ BlockType* Circuit::AddBlockTypeWithGridUnit(std::string const& block_type_name,
   BlockType& block_type =
       tech_.block_type_collection_.CreateInstance(block_type_name);
   block_type.SetSize(width, height);
+  // the I/O pin type is the first one, it may move when the collection grows
+  if (tech_.io_dummy_blk_type_ptr_ != nullptr) {
+    tech_.io_dummy_blk_type_ptr_ = &tech_.BlockTypes()[0];
+  }
 
   if (block_type.Area() > INT_MAX) {
     block_type.Report();
@@ -2077,23 +2316,30 @@ void Circuit::AddBlock(std::string const& block_name, BlockType* block_type_ptr,
               "Cannot add new Block, because net_list now is not empty");
   DaliExpects(Blocks().size() < Blocks().capacity(),
               "Cannot add new Block, because block list is full");
-  DaliExpects(!IsBlockExisting(block_name),
-              "Block exists, cannot create this block again: " + block_name);
-  int id = static_cast<int>(design_.BlockNameIdMap().size());
-  if (id < 0 || id > INT_MAX) {
-    DaliExpects(false, "Cannot add more blocks, the limit is INT_MAX");
-  }
+  size_t id = design_.block_collection_.GetSize();
+  DaliExpects(id < INT_MAX, "Cannot add more blocks, the limit is INT_MAX");
 
+  // the collection exits if a block with this name exists
   Block& block = design_.block_collection_.CreateInstance(block_name);
+  block.SetId(static_cast<int>(id));
+  SetUpBlock(block, block_type_ptr, llx, lly, place_status, orient,
+             is_real_cel);
+}
+
+void Circuit::SetUpBlock(Block& block, BlockType* block_type_ptr, double llx,
+                         double lly, PlaceStatus place_status,
+                         BlockOrient orient, bool is_real_cel) {
   block.SetType(block_type_ptr);
-  block.SetId(design_.block_collection_.GetInstanceIdByName(block_name));
   block.SetLLX(llx);
   block.SetLLY(lly);
   block.SetPlacementStatus(place_status);
   block.SetOrient(orient);
 
   if (!is_real_cel) return;
-  // update statistics of blocks
+  UpdateRealBlockStatistics(block);
+}
+
+void Circuit::UpdateRealBlockStatistics(Block& block) {
   ++design_.real_block_count_;
   design_.tot_width_ += block.Width();
   design_.tot_height_ += block.Height();
@@ -2453,9 +2699,31 @@ void Circuit::LoadDieArea() {
 void Circuit::LoadComponents() {
   auto& phy_db_design = *(phy_db_ptr_->GetDesignPtr());
   auto& components = phy_db_design.GetComponentsRef();
-  for (auto& comp : components) {
-    std::string blk_name(comp.GetName());
-    std::string blk_type_name(comp.GetMacro()->GetName());
+  // components find their BlockTypes by the index of their macros
+  auto& macros = phy_db_ptr_->GetTechPtr()->GetMacrosRef();
+  std::vector<BlockType*> macro_types;
+  macro_types.reserve(macros.size());
+  for (auto& macro : macros) {
+    macro_types.push_back(GetBlockTypePtr(macro.GetName()));
+  }
+  DaliExpects(design_.nets_.empty() &&
+                  Blocks().size() + components.size() <= INT_MAX,
+              "Cannot add components");
+
+  // all component names are added to the block name index at once
+  size_t first_id = design_.block_collection_.CreateInstances(
+      components.size(),
+      [&components](size_t i) -> decltype(auto) {
+        return components[i].GetName();
+      });
+  for (size_t i = 0; i < components.size(); ++i) {
+    auto& comp = components[i];
+    phydb::Macro* macro_ptr = comp.GetMacro();
+    auto macro_id = macro_ptr - macros.data();
+    BlockType* block_type =
+        (macro_id >= 0 && macro_id < static_cast<long>(macros.size()))
+            ? macro_types[macro_id]
+            : GetBlockTypePtr(macro_ptr->GetName());
     auto location = comp.GetLocation();
     int llx = location.x;
     int lly = location.y;
@@ -2463,7 +2731,9 @@ void Circuit::LoadComponents() {
     double ly = std::round(LocPhydb2DaliY(lly));
     auto place_status = PlaceStatus(comp.GetPlacementStatus());
     auto orient = BlockOrient(comp.GetOrientation());
-    AddBlock(blk_name, blk_type_name, lx, ly, place_status, orient);
+    Block& block = Blocks()[first_id + i];
+    block.SetId(static_cast<int>(first_id + i));
+    SetUpBlock(block, block_type, lx, ly, place_status, orient, true);
   }
 }
 
@@ -2485,40 +2755,117 @@ void Circuit::LoadPlacementBlockages() {
   }
 }
 
-void Circuit::LoadNets() {
+/****
+ * Names of all nets are added to the net name index at once, and nets are
+ * created in the same order. Then their pins are filled in parallel. PhyDB
+ * component ids are Dali block ids, because components are the first blocks,
+ * and PhyDB I/O pin ids are Dali I/O pin ids. A PhyDB pin id is the index of
+ * the pin in its macro, and LoadTech() adds pins to a BlockType in the same
+ * order. At last, net ids are added to blocks in the order of nets, the same
+ * order as AddBlkPinToNet(). Blocks borrow their net lists from one
+ * block-to-net array, so no per-block list is allocated.
+ * ****/
+void Circuit::LoadNets(int num_threads) {
   auto& phy_db_design = *(phy_db_ptr_->GetDesignPtr());
-  auto& components = phy_db_design.GetComponentsRef();
-  auto& io_pins = phy_db_design.GetIoPinsRef();
   auto& nets = phy_db_design.GetNetsRef();
-  for (auto& net : nets) {
-    std::string net_name(net.GetName());
-    auto& net_pins = net.GetPinsRef();
-    std::vector<int>& io_pin_ids = net.GetIoPinIdsRef();
-    int net_capacity = int(net_pins.size() + io_pin_ids.size());
-    AddNet(net_name, net_capacity, design_.normal_signal_weight_);
-
-    for (int& id : io_pin_ids) {
-      AddIoPinToNet(io_pins[id].GetName(), net_name);
+  std::vector<Block>& blocks = design_.Blocks();
+  std::vector<IoPin>& iopins = design_.iopins_;
+  auto& components = phy_db_design.GetComponentsRef();
+  int component_count = static_cast<int>(components.size());
+  int iopin_count = static_cast<int>(iopins.size());
+  DaliExpects(design_.nets_.empty() &&
+                  static_cast<int>(blocks.size()) >= component_count &&
+                  phy_db_design.GetIoPinsRef().size() == iopins.size(),
+              "Nets are loaded after components and I/O pins");
+
+  // pre-placed I/O pins have dummy blocks connected to nets
+  std::vector<Block*> iopin_blocks(iopin_count, nullptr);
+  for (int i = 0; i < iopin_count; ++i) {
+    if (iopins[i].IsPrePlaced()) {
+      iopin_blocks[i] = GetBlockPtr(iopins[i].Name());
     }
-    int sz = (int)net_pins.size();
-    for (int i = 0; i < sz; ++i) {
-      int comp_id = net_pins[i].InstanceId();
-      std::string const& comp_name = components[comp_id].GetName();
-      int pin_id = net_pins[i].PinId();
-      std::string const& pin_name = components[comp_id].GetPinName(pin_id);
-      AddBlkPinToNet(comp_name, pin_name, net_name);
+  }
+
+  DaliExpects(nets.size() < INT_MAX,
+              "Cannot add more nets, the limit is INT_MAX");
+  NameIndex& net_names = design_.net_name_index_;
+  size_t duplicate = net_names.BulkInsert(
+      nets.size(),
+      [&nets](size_t i) -> decltype(auto) { return nets[i].GetName(); });
+  DaliExpects(duplicate == NameIndex::kNotFound,
+              "Net exists, cannot create this net again: "
+                  << nets[duplicate].GetName());
+  int net_count = static_cast<int>(nets.size());
+  std::vector<Net>& dali_nets = design_.nets_;
+  dali_nets.reserve(net_count);
+  for (int i = 0; i < net_count; ++i) {
+    size_t net_capacity =
+        nets[i].GetPinsRef().size() + nets[i].GetIoPinIdsRef().size();
+    dali_nets.emplace_back(&net_names.Name(i), i, net_capacity,
+                           design_.normal_signal_weight_);
+  }
+
+#pragma omp parallel for num_threads(num_threads) default(none)      \
+    shared(nets, dali_nets, blocks, iopins, iopin_blocks, net_count, \
+               component_count, iopin_count) schedule(dynamic, 1024)
+  for (int i = 0; i < net_count; ++i) {
+    Net& net = dali_nets[i];
+    for (int id : nets[i].GetIoPinIdsRef()) {
+      DaliExpects(id >= 0 && id < iopin_count,
+                  "Unknown I/O pin in net: " + net.Name());
+      iopins[id].SetNetPtr(&net);
+      net.AddIoPin(&iopins[id]);
+      if (iopin_blocks[id] != nullptr) {
+        Block* blk_ptr = iopin_blocks[id];
+        Pin* pin = &(blk_ptr->TypePtr()->PinList()[0]);
+        net.AddBlkPinPairWithoutBlockNetList(blk_ptr, pin);
+      }
+    }
+    for (auto& net_pin : nets[i].GetPinsRef()) {
+      int comp_id = net_pin.InstanceId();
+      DaliExpects(comp_id >= 0 && comp_id < component_count,
+                  "Unknown component in net: " + net.Name());
+      Block& block = blocks[comp_id];
+      std::vector<Pin>& pins = block.TypePtr()->PinList();
+      int pin_id = net_pin.PinId();
+      DaliExpects(pin_id >= 0 && pin_id < static_cast<int>(pins.size()),
+                  "Unknown pin of component in net: " + net.Name());
+      net.AddBlkPinPairWithoutBlockNetList(&block, &pins[pin_id]);
+    }
+  }
+
+  // net lists of blocks in CSR form, ids of each block are in net order
+  std::vector<size_t> block_net_offsets(blocks.size() + 1, 0);
+  for (auto& net : dali_nets) {
+    for (auto& blk_pin : net.BlockPins()) {
+      ++block_net_offsets[blk_pin.BlkId() + 1];
+    }
+  }
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    block_net_offsets[i + 1] += block_net_offsets[i];
+  }
+  std::vector<int> block_net_ids(block_net_offsets.back());
+  for (auto& net : dali_nets) {
+    int net_id = net.Id();
+    for (auto& blk_pin : net.BlockPins()) {
+      block_net_ids[block_net_offsets[blk_pin.BlkId()]++] = net_id;
     }
   }
+  // each offset now points to the end of its block
+  std::copy_backward(block_net_offsets.begin(), block_net_offsets.end() - 1,
+                     block_net_offsets.end());
+  block_net_offsets[0] = 0;
+  SetBlockNetLists(block_net_offsets, std::move(block_net_ids), num_threads);
 }
 
-void Circuit::LoadDesign() {
+void Circuit::LoadDesign(int num_threads) {
   ReserveSpaceForDesign();
   LoadUnits();
   LoadDieArea();
-  LoadComponents();
-  LoadIoPins();
+  RunLoadPhase("components", [&]() { LoadComponents(); });
+  RunLoadPhase("io_pins", [&]() { LoadIoPins(); });
   LoadPlacementBlockages();
-  LoadNets();
+  RunLoadPhase("nets", [&]() { LoadNets(num_threads); });
 
   design().BlockCollection().Freeze();
 }
@@ -24,6 +24,8 @@
 #include <phydb/phydb.h>
 
 #include <boost/functional/hash.hpp>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -37,16 +39,35 @@
 #include "io_pin.h"
 #include "layer.h"
 #include "net.h"
+#include "netlist_view.h"
 #include "tech.h"
 
 namespace dali {
 
+class CheckpointReader;
+class CheckpointWriter;
+
 /** Tunable constants shared across Circuit computations. */
 struct CircuitConstants {
   double normal_net_weight = 1.0;
   double epsilon = 1e-6;
 };
 
+/**
+ * One DEF file written by Circuit::SaveDefFiles(). Options of COMPONENTS, PINS
+ * and NETS are the same as those of Circuit::SaveDefFile().
+ */
+struct DefFileOptions {
+  std::string file_name;
+  // name prefix of the well and n/p-plus cover cells, save_cell 3 and 4
+  std::string base_name;
+  int save_cell = 1;
+  int save_iopin = 1;
+  int save_net = 1;
+  // only replace COMPONENTS, everything else is copied from the input DEF
+  bool is_component_only = false;
+};
+
 /**
  * Top-level circuit model joining technology data and design data.
  *
@@ -63,8 +84,12 @@ class Circuit {
  public:
   Circuit();
 
-  /** Initialize from PhyDB. The PhyDB object must outlive this Circuit. */
-  void InitializeFromPhyDB(phydb::PhyDB* phy_db_ptr);
+  /**
+   * Initialize from PhyDB. The PhyDB object must outlive this Circuit. Nets are
+   * built by num_threads threads, and the time of every loading phase is
+   * reported.
+   */
+  void InitializeFromPhyDB(phydb::PhyDB* phy_db_ptr, int num_threads = 1);
 
   /** Convert length from microns to LEF/DEF database units. */
   int Micron2DatabaseUnit(double x) const;
@@ -255,13 +280,13 @@ class Circuit {
   std::vector<Block>& Blocks();
 
   // check if a block with the given name exists or not
-  bool IsBlockExisting(std::string const& block_name);
+  bool IsBlockExisting(std::string_view block_name);
 
   // returns the internal index of a block with a given name
-  int GetBlockId(std::string const& block_name);
+  int GetBlockId(std::string_view block_name);
 
   // returns a pointer to the block with a given name
-  Block* GetBlockPtr(std::string const& block_name);
+  Block* GetBlockPtr(std::string_view block_name);
 
   // create a block instance using the name of its type
   void AddBlock(std::string const& block_name,
@@ -309,13 +334,13 @@ class Circuit {
   std::vector<Net>& Nets();
 
   // check if a Net with a given name exists or not
-  bool IsNetExisting(std::string const& net_name);
+  bool IsNetExisting(std::string_view net_name);
 
   // returns the index of the Net with a given name
-  int GetNetId(std::string const& net_name);
+  int GetNetId(std::string_view net_name);
 
   // returns a pointer to the Net with a given name
-  Net* GetNetPtr(std::string const& net_name);
+  Net* GetNetPtr(std::string_view net_name);
 
   // add a net with given name and capacity (number of cell pins)
   Net* AddNet(std::string const& net_name, size_t capacity, double weight = -1);
@@ -346,6 +371,20 @@ class Circuit {
   // report brief summary of this circuit
   void ReportBriefSummary();
 
+  // move net lists of blocks into one array if they are not borrowed from it
+  // yet, and release unused capacity of nets, no net or block pin can be
+  // added afterwards
+  void CompactStorage();
+
+  // check if CompactStorage() has been called
+  bool IsStorageCompact() const { return design_.is_storage_compact_; }
+
+  // returns estimated memory of each container of this circuit
+  std::vector<ContainerMemory> MemoryUsage();
+
+  // report estimated memory of each container of this circuit
+  void ReportMemoryUsage();
+
   /************************************************
    * The following APIs are for in CELL
    * ************************************************/
@@ -436,6 +475,17 @@ class Circuit {
   // returns total HPWL, considering cell pin offsets, unit in micron
   double WeightedHPWL();
 
+  // builds a view of nets and blocks for batched wirelength kernels, it needs
+  // to be built again after nets or block orientations change
+  void BuildNetlistView(NetlistView& netlist_view);
+
+  // same as WeightedHPWLX(), but uses the batched kernels of a view built by
+  // BuildNetlistView(), does not update max/min pins of nets
+  double WeightedHPWLX(NetlistView& netlist_view, int num_threads = 1);
+
+  // same as WeightedHPWLY(), but uses the batched kernels of a view
+  double WeightedHPWLY(NetlistView& netlist_view, int num_threads = 1);
+
   // simple function to report HPWL
   void ReportHPWL();
 
@@ -501,6 +551,24 @@ class Circuit {
   void SaveDefFileComponent(std::string const& name_of_file,
                             std::string const& def_file_name);
 
+  // save many DEF files with one read of the input DEF file, files can be
+  // formatted and written by many threads
+  void SaveDefFiles(std::vector<DefFileOptions> const& def_files,
+                    std::string const& def_file_name, int num_threads = 1);
+
+  /**** Save and load binary checkpoints, see circuit_checkpoint.h ****/
+  // save block types, blocks, I/O pins, nets, rows and blockages, the name of
+  // the last finished placement stage is saved with them
+  void SaveCheckpoint(std::string const& file_name, std::string const& stage);
+
+  // load a checkpoint into a Circuit which has not loaded anything yet, and
+  // return the name of the last finished stage. A PhyDB is optional, it is
+  // only needed by exporters. Blocks and nets are filled by num_threads
+  // threads.
+  std::string LoadCheckpoint(std::string const& file_name,
+                             phydb::PhyDB* phy_db_ptr = nullptr,
+                             int num_threads = 1);
+
   /**** Save results in Bookshelf formats ****/
   void SaveBookshelfNode(std::string const& name_of_file);
 
@@ -558,6 +626,20 @@ class Circuit {
                 PlaceStatus place_status = UNPLACED, BlockOrient orient = N,
                 bool is_real_cel = true);
 
+  // set the type, location, status and orientation of a new block
+  void SetUpBlock(Block& block, BlockType* block_type_ptr, double llx,
+                  double lly, PlaceStatus place_status, BlockOrient orient,
+                  bool is_real_cel);
+
+  // update statistics of blocks with a newly added real block
+  void UpdateRealBlockStatistics(Block& block);
+
+  // move a block-to-net array in CSR form into the design, and let blocks
+  // borrow their net lists from it, net ids of block i are
+  // net_ids[offsets[i]], ..., net_ids[offsets[i + 1] - 1]
+  void SetBlockNetLists(std::vector<size_t> const& offsets,
+                        std::vector<int>&& net_ids, int num_threads);
+
   // create a dummy BlockType for I/O pins
   void AddDummyIOPinBlockType();
 
@@ -584,39 +666,32 @@ class Circuit {
   void LoadComponents();
   void LoadIoPins();
   void LoadPlacementBlockages();
-  void LoadNets();
-  void LoadDesign();
+  void LoadNets(int num_threads);
+  void LoadDesign(int num_threads);
 
   // load information in CELL
   void LoadCell(phydb::PhyDB* phy_db_ptr);
 
-  // export cells/components to an output stream
-  void SaveCell(std::ofstream& ost, Block& blk) const;
-  void SaveNormalCells(std::ofstream& ost,
-                       std::unordered_set<PlaceStatus>* filter = nullptr);
-  void SaveWellTapCells(std::ofstream& ost);
-  void SaveEndCapCells(std::ofstream& ost);
-  void SaveCircuitWellCoverCell(std::ofstream& ost,
-                                std::string const& base_name) const;
-  void SaveCircuitPpnpCoverCell(std::ofstream& ost,
-                                std::string const& base_name) const;
-  void ExportNormalCells(std::ofstream& ost);
-  void ExportWellTapCells(std::ofstream& ost);
-  void ExportNormalAndWellTapCells(std::ofstream& ost,
-                                   std::string const& base_name);
-  void ExportNormalWellTapAndCoverCells(std::ofstream& ost,
-                                        std::string const& base_name);
-  void ExportCellsExcept(std::ofstream& ost,
-                         std::unordered_set<PlaceStatus>* filter = nullptr);
-  void ExportCells(std::ofstream& ost, std::string const& base_name, int mode);
-  void SaveIoPin(std::ofstream& ost, IoPin& iopin, bool after_io_place) const;
-  void ExportIoPinsInfoAfterIoPlacement(std::ofstream& ost);
-  void ExportIoPinsInfoBeforeIoPlacement(std::ofstream& ost);
-  void ExportIoPins(std::ofstream& ost, int mode);
-  void ExportAllNets(std::ofstream& ost);
-  void ExportPowerNetsForWellTapCells(std::ofstream& ost);
-  void ExportNets(std::ofstream& ost, int mode);
+  // format sections of DEF files into a buffer
+  void AppendCell(std::string& buf, Block& blk) const;
+  void AppendNormalCells(std::string& buf, bool is_unplaced_skipped = false);
+  void AppendWellTapCells(std::string& buf);
+  void AppendEndCapCells(std::string& buf);
+  void AppendCoverCell(std::string& buf, std::string const& cell_name,
+                       std::string const& type_name) const;
+  void AppendCells(std::string& buf, std::string const& base_name, int mode);
+  void AppendIoPin(std::string& buf, IoPin& iopin, bool after_io_place) const;
+  void AppendIoPins(std::string& buf, int mode);
+  void AppendAllNets(std::string& buf);
+  void AppendPowerNetsForWellTapCells(std::string& buf);
+  void AppendNets(std::string& buf, int mode);
   void ExportEndCapCells(std::ofstream& ost);
+
+  // save and load sections of a checkpoint
+  void SaveCheckpointTech(CheckpointWriter& writer);
+  void SaveCheckpointDesign(CheckpointWriter& writer);
+  void LoadCheckpointTech(CheckpointReader const& reader);
+  void LoadCheckpointDesign(CheckpointReader const& reader, int num_threads);
 };
 
 }  // namespace dali
@@ -0,0 +1,958 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "circuit_checkpoint.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#include "dali/circuit/circuit.h"
+#include "dali/common/elapsed_time.h"
+
+namespace dali {
+
+namespace {
+
+constexpr size_t kSectionAlignment = 8;
+
+/****
+ * Records of checkpoint sections. Coordinates are in grid units, and lengths
+ * of technology data are in microns, as in Circuit.
+ * ****/
+struct TechRecord {
+  double manufacturing_grid;
+  double grid_value_x;
+  double grid_value_y;
+  double row_height;
+  double same_diff_spacing;
+  double any_diff_spacing;
+  // N-well and then P-well: width, spacing, opposite spacing, max plug
+  // distance, overhang
+  double well_params[2][5];
+  // min width, min P-well height, min N-well height of pre and post end caps
+  double end_cap_sizes[6];
+  int32_t database_microns;
+  int32_t pre_end_cap_type_id;
+  int32_t post_end_cap_type_id;
+  uint8_t is_grid_set;
+  uint8_t is_row_height_set;
+  uint8_t is_well_set[2];
+  uint8_t is_end_cap_size_set[6];
+  uint8_t is_block_type_frozen;
+  uint8_t is_end_cap_type_frozen;
+};
+
+struct MetalLayerRecord {
+  double width;
+  double spacing;
+  double min_area;
+  double pitch_x;
+  double pitch_y;
+  int32_t direction;
+};
+
+enum BlockTypeKind : uint8_t {
+  REGULAR_TYPE,
+  IO_DUMMY_TYPE,
+  WELL_TAP_TYPE,
+  FILLER_TYPE,
+  END_CAP_TYPE,
+};
+
+// pins and well rects of block types are in PINS and WELL_RECTS in the order
+// of block types, N-well rects before P-well rects
+struct BlockTypeRecord {
+  int32_t width;
+  int32_t height;
+  int32_t pin_count;
+  int32_t n_rect_count;
+  int32_t p_rect_count;
+  uint8_t kind;
+};
+
+struct PinRecord {
+  double offset_x;
+  double offset_y;
+  double half_bbox_width;
+  double half_bbox_height;
+  uint8_t is_input;
+};
+
+struct RectRecord {
+  int32_t llx;
+  int32_t lly;
+  int32_t urx;
+  int32_t ury;
+};
+
+// end-cap cell types are numbered after regular block types
+struct BlockRecord {
+  double llx;
+  double lly;
+  int32_t type_id;
+  int32_t height;
+  uint8_t place_status;
+  uint8_t orient;
+};
+
+struct DesignRecord {
+  double reset_signal_weight;
+  double normal_signal_weight;
+  int32_t distance_microns;
+  int32_t distance_scale_factor_x;
+  int32_t distance_scale_factor_y;
+  int32_t region_left;
+  int32_t region_right;
+  int32_t region_bottom;
+  int32_t region_top;
+  int32_t die_area_offset_x;
+  int32_t die_area_offset_x_residual;
+  int32_t die_area_offset_y;
+  int32_t die_area_offset_y_residual;
+  int32_t pre_placed_io_count;
+  uint8_t is_die_area_set;
+  // blocks, well tap cells, filler cells, end-cap cells
+  uint8_t is_frozen[4];
+};
+
+struct IoPinRecord {
+  double x;
+  double y;
+  double shape[4];
+  int32_t final_x;
+  int32_t final_y;
+  int32_t layer_id;
+  uint8_t direction;
+  uint8_t use;
+  uint8_t init_place_status;
+  uint8_t place_status;
+  uint8_t orient;
+  uint8_t is_shape_set;
+};
+
+struct NetPinRecord {
+  int32_t block_id;
+  int32_t pin_id;
+};
+
+struct RowRecord {
+  int32_t ly;
+  int32_t height;
+  int32_t p_well_height;
+  int32_t n_well_height;
+  int32_t segment_count;
+  uint8_t is_orient_N;
+};
+
+struct RowSegmentRecord {
+  int32_t lx;
+  int32_t width;
+};
+
+struct PointRecord {
+  int32_t x;
+  int32_t y;
+};
+
+RectRecord MakeRectRecord(RectI const& rect) {
+  return {rect.LLX(), rect.LLY(), rect.URX(), rect.URY()};
+}
+
+// the block collections of a design, in the order of DesignRecord::is_frozen
+constexpr CheckpointSection kBlockSections[4] = {
+    CheckpointSection::BLOCKS, CheckpointSection::WELL_TAPS,
+    CheckpointSection::FILLERS, CheckpointSection::END_CAPS};
+constexpr CheckpointSection kBlockNameSections[4] = {
+    CheckpointSection::BLOCK_NAMES, CheckpointSection::WELL_TAP_NAMES,
+    CheckpointSection::FILLER_NAMES, CheckpointSection::END_CAP_NAMES};
+
+}  // namespace
+
+CheckpointWriter::CheckpointWriter(std::string const& file_name)
+    : ost_(file_name, std::ios::binary) {
+  DaliExpects(ost_.is_open(), "Cannot open file " + file_name);
+  CheckpointHeader header{};
+  ost_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  offset_ = sizeof(header);
+}
+
+void CheckpointWriter::AddRawSection(CheckpointSection id, size_t record_size,
+                                     void const* data, size_t count) {
+  static const char padding[kSectionAlignment] = {};
+  size_t padding_size = (kSectionAlignment - offset_ % kSectionAlignment) %
+                        kSectionAlignment;
+  ost_.write(padding, static_cast<std::streamsize>(padding_size));
+  offset_ += padding_size;
+  sections_.push_back({static_cast<uint32_t>(id),
+                       static_cast<uint32_t>(record_size), offset_, count});
+  size_t size = record_size * count;
+  if (size > 0) {
+    ost_.write(static_cast<char const*>(data),
+               static_cast<std::streamsize>(size));
+  }
+  offset_ += size;
+}
+
+void CheckpointWriter::AddStrings(CheckpointSection id,
+                                  CheckpointStrings const& strings) {
+  AddSection(id, strings.Offsets());
+  auto chars_id =
+      static_cast<CheckpointSection>(static_cast<uint32_t>(id) + 1);
+  AddRawSection(chars_id, 1, strings.Chars().data(), strings.Chars().size());
+}
+
+void CheckpointWriter::Close() {
+  // the section table is a section without an id
+  CheckpointHeader header{};
+  std::memcpy(header.magic, kCheckpointMagic, sizeof(header.magic));
+  header.version = kCheckpointVersion;
+  header.endian_tag = kCheckpointEndianTag;
+  header.section_count = sections_.size();
+  std::vector<CheckpointSectionEntry> sections = sections_;
+  AddSection(static_cast<CheckpointSection>(0), sections);
+  header.section_table_offset = sections_.back().offset;
+  header.file_size = offset_;
+  ost_.seekp(0);
+  ost_.write(reinterpret_cast<char const*>(&header), sizeof(header));
+  ost_.close();
+  DaliExpects(!ost_.fail(), "Cannot write checkpoint file");
+}
+
+CheckpointReader::CheckpointReader(std::string const& file_name)
+    : file_name_(file_name), file_(file_name) {
+  DaliExpects(file_.Size() >= sizeof(CheckpointHeader),
+              "Not a Dali checkpoint: " + file_name);
+  auto header = reinterpret_cast<CheckpointHeader const*>(file_.Data());
+  DaliExpects(std::memcmp(header->magic, kCheckpointMagic,
+                          sizeof(kCheckpointMagic)) == 0,
+              "Not a Dali checkpoint: " + file_name);
+  DaliExpects(header->endian_tag == kCheckpointEndianTag,
+              "Checkpoint is saved on a machine with another byte order: " +
+                  file_name);
+  DaliExpects(header->version == kCheckpointVersion,
+              "Checkpoint version " << header->version << " of " << file_name
+                                    << " is not supported, expected version "
+                                    << kCheckpointVersion);
+  DaliExpects(header->file_size == file_.Size(),
+              "Checkpoint is truncated: " + file_name);
+  uint64_t table_size = header->section_count * sizeof(CheckpointSectionEntry);
+  DaliExpects(header->section_table_offset % kSectionAlignment == 0 &&
+                  header->section_table_offset <= file_.Size() &&
+                  table_size <= file_.Size() - header->section_table_offset,
+              "Corrupted checkpoint section table: " + file_name);
+  sections_ = CheckpointArray<CheckpointSectionEntry>(
+      reinterpret_cast<CheckpointSectionEntry const*>(
+          file_.Data() + header->section_table_offset),
+      header->section_count);
+  for (auto& entry : sections_) {
+    uint64_t size = entry.count * entry.record_size;
+    bool is_valid = entry.offset % kSectionAlignment == 0 &&
+                    entry.offset <= file_.Size() &&
+                    (entry.record_size == 0 ||
+                     entry.count <= file_.Size() / entry.record_size) &&
+                    size <= file_.Size() - entry.offset;
+    DaliExpects(is_valid, "Corrupted checkpoint section " << entry.id << " in "
+                                                          << file_name);
+  }
+}
+
+CheckpointSectionEntry const& CheckpointReader::FindSection(
+    CheckpointSection id) const {
+  for (auto& entry : sections_) {
+    if (entry.id == static_cast<uint32_t>(id)) return entry;
+  }
+  DaliExpects(false, "Cannot find checkpoint section "
+                         << static_cast<uint32_t>(id) << " in " << file_name_);
+  return sections_[0];
+}
+
+CheckpointStringArray CheckpointReader::Strings(CheckpointSection id) const {
+  auto offsets = Section<uint64_t>(id);
+  auto chars = Section<char>(
+      static_cast<CheckpointSection>(static_cast<uint32_t>(id) + 1));
+  DaliExpects(!offsets.empty() && offsets[0] == 0 &&
+                  offsets[offsets.size() - 1] == chars.size(),
+              "Corrupted checkpoint strings " << static_cast<uint32_t>(id)
+                                              << " in " << file_name_);
+  for (size_t i = 1; i < offsets.size(); ++i) {
+    DaliExpects(offsets[i - 1] <= offsets[i],
+                "Corrupted checkpoint strings " << static_cast<uint32_t>(id)
+                                                << " in " << file_name_);
+  }
+  return {offsets, chars};
+}
+
+void Circuit::SaveCheckpoint(std::string const& file_name,
+                             std::string const& stage) {
+  ElapsedTime elapsed_time;
+  elapsed_time.RecordStartTime();
+  LOG(info) << "Save checkpoint after stage " << stage << ": " << file_name
+            << "\n";
+
+  CheckpointWriter writer(file_name);
+  CheckpointStrings stage_strings;
+  stage_strings.Add(stage);
+  writer.AddStrings(CheckpointSection::STAGE, stage_strings);
+  SaveCheckpointTech(writer);
+  SaveCheckpointDesign(writer);
+  writer.Close();
+
+  elapsed_time.RecordEndTime();
+  elapsed_time.PrintTimeElapsed();
+}
+
+void Circuit::SaveCheckpointTech(CheckpointWriter& writer) {
+  std::vector<BlockType>& block_types = tech_.BlockTypes();
+  std::vector<BlockType>& end_cap_types =
+      tech_.end_cap_cell_type_collection_.Instances();
+  auto type_id = [&](BlockType const* type_ptr) -> int32_t {
+    if (type_ptr == nullptr) return -1;
+    return static_cast<int32_t>(type_ptr - block_types.data());
+  };
+
+  TechRecord tech{};
+  tech.manufacturing_grid = tech_.manufacturing_grid_;
+  tech.grid_value_x = tech_.grid_value_x_;
+  tech.grid_value_y = tech_.grid_value_y_;
+  tech.row_height = tech_.row_height_;
+  tech.same_diff_spacing = tech_.same_diff_spacing_;
+  tech.any_diff_spacing = tech_.any_diff_spacing_;
+  WellLayer const* wells[2] = {&tech_.nwell_layer_, &tech_.pwell_layer_};
+  for (int i = 0; i < 2; ++i) {
+    tech.well_params[i][0] = wells[i]->Width();
+    tech.well_params[i][1] = wells[i]->Spacing();
+    tech.well_params[i][2] = wells[i]->OppositeSpacing();
+    tech.well_params[i][3] = wells[i]->MaxPlugDist();
+    tech.well_params[i][4] = wells[i]->Overhang();
+  }
+  std::optional<double> const* end_cap_sizes[6] = {
+      &tech_.pre_end_cap_min_width_,  &tech_.pre_end_cap_min_p_height_,
+      &tech_.pre_end_cap_min_n_height_, &tech_.post_end_cap_min_width_,
+      &tech_.post_end_cap_min_p_height_, &tech_.post_end_cap_min_n_height_};
+  for (int i = 0; i < 6; ++i) {
+    tech.is_end_cap_size_set[i] = end_cap_sizes[i]->has_value();
+    tech.end_cap_sizes[i] = end_cap_sizes[i]->value_or(0);
+  }
+  tech.database_microns = tech_.database_microns_;
+  tech.pre_end_cap_type_id = type_id(tech_.pre_end_cap_cell_ptr_);
+  tech.post_end_cap_type_id = type_id(tech_.post_end_cap_cell_ptr_);
+  tech.is_grid_set = tech_.is_grid_set_;
+  tech.is_row_height_set = tech_.row_height_set_;
+  tech.is_well_set[0] = tech_.n_set_;
+  tech.is_well_set[1] = tech_.p_set_;
+  tech.is_block_type_frozen = tech_.block_type_collection_.IsFrozen();
+  tech.is_end_cap_type_frozen =
+      tech_.end_cap_cell_type_collection_.IsFrozen();
+  writer.AddSection(CheckpointSection::TECH, std::vector<TechRecord>{tech});
+
+  std::vector<MetalLayerRecord> metal_layers;
+  CheckpointStrings metal_layer_names;
+  for (auto& metal_layer : tech_.metal_list_) {
+    metal_layers.push_back({metal_layer.Width(), metal_layer.Spacing(),
+                            metal_layer.MinArea(), metal_layer.PitchX(),
+                            metal_layer.PitchY(),
+                            static_cast<int32_t>(metal_layer.Direction())});
+    metal_layer_names.Add(metal_layer.Name());
+  }
+  writer.AddSection(CheckpointSection::METAL_LAYERS, metal_layers);
+  writer.AddStrings(CheckpointSection::METAL_LAYER_NAMES, metal_layer_names);
+
+  std::vector<uint8_t> kinds(block_types.size(), REGULAR_TYPE);
+  // the constructor of Circuit creates the I/O pin type first
+  kinds[0] = IO_DUMMY_TYPE;
+  for (int id : tech_.well_tap_cell_type_ids_) {
+    kinds[id] = WELL_TAP_TYPE;
+  }
+  for (auto& filler_ptr : tech_.filler_ptrs_) {
+    int32_t id = type_id(filler_ptr.get());
+    if (id >= 0 && id < static_cast<int32_t>(block_types.size())) {
+      kinds[id] = FILLER_TYPE;
+    }
+  }
+  kinds.resize(block_types.size() + end_cap_types.size(), END_CAP_TYPE);
+
+  std::vector<BlockTypeRecord> type_records;
+  CheckpointStrings type_names;
+  std::vector<PinRecord> pins;
+  CheckpointStrings pin_names;
+  std::vector<RectRecord> well_rects;
+  for (size_t i = 0; i < kinds.size(); ++i) {
+    BlockType& block_type = i < block_types.size()
+                                ? block_types[i]
+                                : end_cap_types[i - block_types.size()];
+    type_records.push_back({block_type.Width(), block_type.Height(),
+                            static_cast<int32_t>(block_type.PinList().size()),
+                            static_cast<int32_t>(block_type.Nrects().size()),
+                            static_cast<int32_t>(block_type.Prects().size()),
+                            kinds[i]});
+    type_names.Add(block_type.Name());
+    for (auto& pin : block_type.PinList()) {
+      pins.push_back({pin.OffsetX(), pin.OffsetY(), pin.HalfBboxWidth(),
+                      pin.HalfBboxHeight(), pin.IsInput()});
+      pin_names.Add(pin.Name());
+    }
+    for (auto& rect : block_type.Nrects()) {
+      well_rects.push_back(MakeRectRecord(rect));
+    }
+    for (auto& rect : block_type.Prects()) {
+      well_rects.push_back(MakeRectRecord(rect));
+    }
+  }
+  writer.AddSection(CheckpointSection::BLOCK_TYPES, type_records);
+  writer.AddStrings(CheckpointSection::BLOCK_TYPE_NAMES, type_names);
+  writer.AddSection(CheckpointSection::PINS, pins);
+  writer.AddStrings(CheckpointSection::PIN_NAMES, pin_names);
+  writer.AddSection(CheckpointSection::WELL_RECTS, well_rects);
+}
+
+void Circuit::SaveCheckpointDesign(CheckpointWriter& writer) {
+  std::vector<BlockType>& block_types = tech_.BlockTypes();
+  std::vector<BlockType>& end_cap_types =
+      tech_.end_cap_cell_type_collection_.Instances();
+  auto type_id = [&](BlockType const* type_ptr) -> int32_t {
+    if (type_ptr >= block_types.data() &&
+        type_ptr < block_types.data() + block_types.size()) {
+      return static_cast<int32_t>(type_ptr - block_types.data());
+    }
+    return static_cast<int32_t>(block_types.size() +
+                                (type_ptr - end_cap_types.data()));
+  };
+
+  NamedInstanceCollection<Block>* collections[4] = {
+      &design_.block_collection_, &design_.well_tap_cell_collection_,
+      &design_.filler_cell_collection_, &design_.end_cap_cell_collection_};
+
+  DieArea& die_area = design_.die_area_;
+  DesignRecord design{};
+  design.reset_signal_weight = design_.reset_signal_weight_;
+  design.normal_signal_weight = design_.normal_signal_weight_;
+  design.distance_microns = design_.distance_microns_;
+  design.distance_scale_factor_x = die_area.distance_scale_factor_x_;
+  design.distance_scale_factor_y = die_area.distance_scale_factor_y_;
+  design.region_left = die_area.region_left_;
+  design.region_right = die_area.region_right_;
+  design.region_bottom = die_area.region_bottom_;
+  design.region_top = die_area.region_top_;
+  design.die_area_offset_x = die_area.die_area_offset_x_;
+  design.die_area_offset_x_residual = die_area.die_area_offset_x_residual_;
+  design.die_area_offset_y = die_area.die_area_offset_y_;
+  design.die_area_offset_y_residual = die_area.die_area_offset_y_residual_;
+  design.pre_placed_io_count = design_.pre_placed_io_count_;
+  design.is_die_area_set = die_area.die_area_set_;
+  for (int i = 0; i < 4; ++i) {
+    design.is_frozen[i] = collections[i]->IsFrozen();
+  }
+  writer.AddSection(CheckpointSection::DESIGN,
+                    std::vector<DesignRecord>{design});
+  CheckpointStrings design_name;
+  design_name.Add(design_.name_);
+  writer.AddStrings(CheckpointSection::DESIGN_NAME, design_name);
+
+  std::vector<PointRecord> points;
+  for (auto& point : die_area.rectilinear_die_area_) {
+    points.push_back({point.x, point.y});
+  }
+  writer.AddSection(CheckpointSection::DIE_AREA_POINTS, points);
+  std::vector<RectRecord> rects;
+  for (auto& rect : die_area.placement_blockages_) {
+    rects.push_back(MakeRectRecord(rect));
+  }
+  writer.AddSection(CheckpointSection::DIE_AREA_BLOCKAGES, rects);
+  rects.clear();
+  for (auto& blockage : design_.intrinsic_blockages_) {
+    rects.push_back(MakeRectRecord(blockage.GetRect()));
+  }
+  writer.AddSection(CheckpointSection::INTRINSIC_BLOCKAGES, rects);
+
+  for (int i = 0; i < 4; ++i) {
+    std::vector<Block>& blocks = collections[i]->Instances();
+    std::vector<BlockRecord> block_records;
+    block_records.reserve(blocks.size());
+    CheckpointStrings block_names;
+    block_names.Reserve(blocks.size());
+    for (auto& block : blocks) {
+      block_records.push_back({block.LLX(), block.LLY(),
+                               type_id(block.TypePtr()), block.Height(),
+                               static_cast<uint8_t>(block.Status()),
+                               static_cast<uint8_t>(block.Orient())});
+      block_names.Add(block.Name());
+    }
+    writer.AddSection(kBlockSections[i], block_records);
+    writer.AddStrings(kBlockNameSections[i], block_names);
+  }
+
+  std::vector<IoPinRecord> iopins;
+  CheckpointStrings iopin_names;
+  for (auto& iopin : design_.iopins_) {
+    RectD& shape = iopin.GetShape();
+    iopins.push_back(
+        {iopin.X(),
+         iopin.Y(),
+         {shape.LLX(), shape.LLY(), shape.URX(), shape.URY()},
+         iopin.FinalX(),
+         iopin.FinalY(),
+         iopin.LayerPtr() == nullptr ? -1 : iopin.LayerPtr()->Id(),
+         static_cast<uint8_t>(iopin.SigDirection()),
+         static_cast<uint8_t>(iopin.SigUse()),
+         static_cast<uint8_t>(iopin.InitPlaceStatus()),
+         static_cast<uint8_t>(iopin.GetPlaceStatus()),
+         static_cast<uint8_t>(iopin.GetOrient()),
+         iopin.IsShapeSet()});
+    iopin_names.Add(iopin.Name());
+  }
+  writer.AddSection(CheckpointSection::IOPINS, iopins);
+  writer.AddStrings(CheckpointSection::IOPIN_NAMES, iopin_names);
+
+  // nets in compressed sparse rows
+  std::vector<Net>& nets = design_.nets_;
+  std::vector<double> weights;
+  weights.reserve(nets.size());
+  CheckpointStrings net_names;
+  net_names.Reserve(nets.size());
+  std::vector<uint64_t> pin_offsets(1, 0);
+  pin_offsets.reserve(nets.size() + 1);
+  std::vector<NetPinRecord> net_pins;
+  std::vector<uint64_t> iopin_offsets(1, 0);
+  iopin_offsets.reserve(nets.size() + 1);
+  std::vector<int32_t> net_iopins;
+  for (auto& net : nets) {
+    weights.push_back(net.Weight());
+    net_names.Add(net.Name());
+    for (auto& net_pin : net.BlockPins()) {
+      net_pins.push_back({net_pin.BlkId(), net_pin.PinId()});
+    }
+    pin_offsets.push_back(net_pins.size());
+    for (IoPin* iopin_ptr : net.IoPinPtrs()) {
+      net_iopins.push_back(iopin_ptr->Id());
+    }
+    iopin_offsets.push_back(net_iopins.size());
+  }
+  writer.AddSection(CheckpointSection::NET_WEIGHTS, weights);
+  writer.AddStrings(CheckpointSection::NET_NAMES, net_names);
+  writer.AddSection(CheckpointSection::NET_PIN_OFFSETS, pin_offsets);
+  writer.AddSection(CheckpointSection::NET_PINS, net_pins);
+  writer.AddSection(CheckpointSection::NET_IOPIN_OFFSETS, iopin_offsets);
+  writer.AddSection(CheckpointSection::NET_IOPINS, net_iopins);
+
+  // blocks in row segments are not saved, legalizers assign them again
+  std::vector<RowRecord> rows;
+  std::vector<RowSegmentRecord> segments;
+  for (auto& row : design_.rows_) {
+    rows.push_back({row.LY(), row.Height(), row.PwellHeight(),
+                    row.NwellHeight(),
+                    static_cast<int32_t>(row.RowSegments().size()),
+                    row.IsOrientN()});
+    for (auto& segment : row.RowSegments()) {
+      segments.push_back({segment.LX(), segment.Width()});
+    }
+  }
+  writer.AddSection(CheckpointSection::ROWS, rows);
+  writer.AddSection(CheckpointSection::ROW_SEGMENTS, segments);
+}
+
+std::string Circuit::LoadCheckpoint(std::string const& file_name,
+                                    phydb::PhyDB* phy_db_ptr,
+                                    int num_threads) {
+  DaliExpects(tech_.metal_list_.empty() && tech_.BlockTypes().size() == 1 &&
+                  design_.Blocks().empty() && design_.iopins_.empty() &&
+                  design_.nets_.empty(),
+              "Cannot load a checkpoint into a non-empty Circuit");
+  ElapsedTime elapsed_time;
+  elapsed_time.RecordStartTime();
+  if (phy_db_ptr != nullptr) {
+    SetPhyDB(phy_db_ptr);
+  }
+
+  CheckpointReader reader(file_name);
+  auto stage_strings = reader.Strings(CheckpointSection::STAGE);
+  DaliExpects(stage_strings.size() == 1,
+              "Corrupted checkpoint stage: " + file_name);
+  std::string stage(stage_strings[0]);
+  LOG(info) << "Load checkpoint saved after stage " << stage << ": "
+            << file_name << "\n";
+  LoadCheckpointTech(reader);
+  LoadCheckpointDesign(reader, num_threads);
+  UpdateTotalBlkArea();
+
+  elapsed_time.RecordEndTime();
+  elapsed_time.PrintTimeElapsed();
+  return stage;
+}
+
+void Circuit::LoadCheckpointTech(CheckpointReader const& reader) {
+  auto techs = reader.Section<TechRecord>(CheckpointSection::TECH);
+  DaliExpects(techs.size() == 1, "Corrupted checkpoint technology");
+  TechRecord const& tech = techs[0];
+  tech_.manufacturing_grid_ = tech.manufacturing_grid;
+  tech_.database_microns_ = tech.database_microns;
+  tech_.is_grid_set_ = tech.is_grid_set;
+  tech_.grid_value_x_ = tech.grid_value_x;
+  tech_.grid_value_y_ = tech.grid_value_y;
+  tech_.row_height_ = tech.row_height;
+  tech_.row_height_set_ = tech.is_row_height_set;
+  tech_.same_diff_spacing_ = tech.same_diff_spacing;
+  tech_.any_diff_spacing_ = tech.any_diff_spacing;
+  WellLayer* wells[2] = {&tech_.nwell_layer_, &tech_.pwell_layer_};
+  for (int i = 0; i < 2; ++i) {
+    if (!tech.is_well_set[i]) continue;
+    double const* params = tech.well_params[i];
+    wells[i]->SetParams(params[0], params[1], params[2], params[3], params[4]);
+  }
+  tech_.n_set_ = tech.is_well_set[0];
+  tech_.p_set_ = tech.is_well_set[1];
+  std::optional<double>* end_cap_sizes[6] = {
+      &tech_.pre_end_cap_min_width_,  &tech_.pre_end_cap_min_p_height_,
+      &tech_.pre_end_cap_min_n_height_, &tech_.post_end_cap_min_width_,
+      &tech_.post_end_cap_min_p_height_, &tech_.post_end_cap_min_n_height_};
+  for (int i = 0; i < 6; ++i) {
+    if (tech.is_end_cap_size_set[i]) {
+      *end_cap_sizes[i] = tech.end_cap_sizes[i];
+    }
+  }
+
+  auto metal_layers =
+      reader.Section<MetalLayerRecord>(CheckpointSection::METAL_LAYERS);
+  auto metal_layer_names =
+      reader.Strings(CheckpointSection::METAL_LAYER_NAMES);
+  DaliExpects(metal_layers.size() == metal_layer_names.size(),
+              "Corrupted checkpoint metal layers");
+  tech_.metal_list_.reserve(metal_layers.size());
+  for (size_t i = 0; i < metal_layers.size(); ++i) {
+    MetalLayerRecord const& layer = metal_layers[i];
+    AddMetalLayer(std::string(metal_layer_names[i]), layer.width,
+                  layer.spacing, layer.min_area, layer.pitch_x, layer.pitch_y,
+                  static_cast<MetalDirection>(layer.direction));
+  }
+
+  auto types = reader.Section<BlockTypeRecord>(CheckpointSection::BLOCK_TYPES);
+  auto type_names = reader.Strings(CheckpointSection::BLOCK_TYPE_NAMES);
+  auto pins = reader.Section<PinRecord>(CheckpointSection::PINS);
+  auto pin_names = reader.Strings(CheckpointSection::PIN_NAMES);
+  auto well_rects = reader.Section<RectRecord>(CheckpointSection::WELL_RECTS);
+  DaliExpects(types.size() == type_names.size() &&
+                  pins.size() == pin_names.size() && !types.empty() &&
+                  types[0].kind == IO_DUMMY_TYPE &&
+                  type_names[0] == tech_.BlockTypes()[0].Name(),
+              "Corrupted checkpoint block types");
+  size_t pin_id = 0;
+  size_t rect_id = 0;
+  for (size_t i = 0; i < types.size(); ++i) {
+    BlockTypeRecord const& type = types[i];
+    size_t rect_count = type.n_rect_count + type.p_rect_count;
+    DaliExpects(type.pin_count >= 0 && type.n_rect_count >= 0 &&
+                    type.p_rect_count >= 0 &&
+                    pin_id + type.pin_count <= pins.size() &&
+                    rect_id + rect_count <= well_rects.size(),
+                "Corrupted checkpoint block types");
+    std::string name(type_names[i]);
+    BlockType* block_type = nullptr;
+    if (type.kind == IO_DUMMY_TYPE) {
+      // created by the constructor of Circuit
+      pin_id += type.pin_count;
+      rect_id += rect_count;
+      continue;
+    } else if (type.kind == WELL_TAP_TYPE) {
+      int id = AddWellTapBlockTypeWithGridUnit(name, type.width, type.height);
+      block_type = &tech_.BlockTypes()[id];
+    } else if (type.kind == FILLER_TYPE) {
+      block_type =
+          AddFillerBlockTypeWithGridUnit(name, type.width, type.height);
+    } else if (type.kind == END_CAP_TYPE) {
+      block_type = &tech_.end_cap_cell_type_collection_.CreateInstance(name);
+      block_type->SetSize(type.width, type.height);
+    } else {
+      block_type = AddBlockTypeWithGridUnit(name, type.width, type.height);
+    }
+    for (int j = 0; j < type.pin_count; ++j, ++pin_id) {
+      PinRecord const& pin = pins[pin_id];
+      Pin* pin_ptr =
+          block_type->AddPin(std::string(pin_names[pin_id]), pin.is_input);
+      pin_ptr->SetOffset(pin.offset_x, pin.offset_y);
+      pin_ptr->SetBoundingBoxSize(2 * pin.half_bbox_width,
+                                  2 * pin.half_bbox_height);
+    }
+    for (size_t j = 0; j < rect_count; ++j, ++rect_id) {
+      RectRecord const& rect = well_rects[rect_id];
+      bool is_n = static_cast<int>(j) < type.n_rect_count;
+      block_type->AddWellRect(is_n, rect.llx, rect.lly, rect.urx, rect.ury);
+    }
+  }
+
+  // block types are not added anymore, pointers to them are stable now
+  int type_count = static_cast<int>(tech_.BlockTypes().size());
+  if (tech.pre_end_cap_type_id >= 0) {
+    DaliExpects(tech.pre_end_cap_type_id < type_count,
+                "Corrupted checkpoint technology");
+    tech_.pre_end_cap_cell_ptr_ =
+        &tech_.BlockTypes()[tech.pre_end_cap_type_id];
+  }
+  if (tech.post_end_cap_type_id >= 0) {
+    DaliExpects(tech.post_end_cap_type_id < type_count,
+                "Corrupted checkpoint technology");
+    tech_.post_end_cap_cell_ptr_ =
+        &tech_.BlockTypes()[tech.post_end_cap_type_id];
+  }
+  if (tech.is_block_type_frozen) {
+    tech_.block_type_collection_.Freeze();
+  }
+  if (tech.is_end_cap_type_frozen) {
+    tech_.end_cap_cell_type_collection_.Freeze();
+  }
+}
+
+void Circuit::LoadCheckpointDesign(CheckpointReader const& reader,
+                                   int num_threads) {
+  auto designs = reader.Section<DesignRecord>(CheckpointSection::DESIGN);
+  DaliExpects(designs.size() == 1, "Corrupted checkpoint design");
+  DesignRecord const& design = designs[0];
+  auto design_name = reader.Strings(CheckpointSection::DESIGN_NAME);
+  DaliExpects(design_name.size() == 1, "Corrupted checkpoint design");
+  design_.name_ = design_name[0];
+  design_.reset_signal_weight_ = design.reset_signal_weight;
+  design_.normal_signal_weight_ = design.normal_signal_weight;
+  design_.distance_microns_ = design.distance_microns;
+  design_.pre_placed_io_count_ = design.pre_placed_io_count;
+
+  DieArea& die_area = design_.die_area_;
+  die_area.distance_scale_factor_x_ = design.distance_scale_factor_x;
+  die_area.distance_scale_factor_y_ = design.distance_scale_factor_y;
+  die_area.region_left_ = design.region_left;
+  die_area.region_right_ = design.region_right;
+  die_area.region_bottom_ = design.region_bottom;
+  die_area.region_top_ = design.region_top;
+  die_area.die_area_set_ = design.is_die_area_set;
+  die_area.die_area_offset_x_ = design.die_area_offset_x;
+  die_area.die_area_offset_x_residual_ = design.die_area_offset_x_residual;
+  die_area.die_area_offset_y_ = design.die_area_offset_y;
+  die_area.die_area_offset_y_residual_ = design.die_area_offset_y_residual;
+  for (auto& point :
+       reader.Section<PointRecord>(CheckpointSection::DIE_AREA_POINTS)) {
+    die_area.rectilinear_die_area_.emplace_back(point.x, point.y);
+  }
+  for (auto& rect :
+       reader.Section<RectRecord>(CheckpointSection::DIE_AREA_BLOCKAGES)) {
+    die_area.placement_blockages_.emplace_back(rect.llx, rect.lly, rect.urx,
+                                               rect.ury);
+  }
+  design_.UpdateDieAreaPlacementBlockages();
+  for (auto& rect :
+       reader.Section<RectRecord>(CheckpointSection::INTRINSIC_BLOCKAGES)) {
+    design_.intrinsic_blockages_.emplace_back(rect.llx, rect.lly, rect.urx,
+                                              rect.ury);
+  }
+
+  std::vector<BlockType>& block_types = tech_.BlockTypes();
+  std::vector<BlockType>& end_cap_types =
+      tech_.end_cap_cell_type_collection_.Instances();
+  size_t type_count = block_types.size() + end_cap_types.size();
+  NamedInstanceCollection<Block>* collections[4] = {
+      &design_.block_collection_, &design_.well_tap_cell_collection_,
+      &design_.filler_cell_collection_, &design_.end_cap_cell_collection_};
+  for (int i = 0; i < 4; ++i) {
+    auto blocks = reader.Section<BlockRecord>(kBlockSections[i]);
+    auto block_names = reader.Strings(kBlockNameSections[i]);
+    DaliExpects(blocks.size() == block_names.size() && blocks.size() < INT_MAX,
+                "Corrupted checkpoint blocks");
+    NamedInstanceCollection<Block>& collection = *collections[i];
+    collection.CreateInstances(
+        blocks.size(), [&block_names](size_t id) { return block_names[id]; });
+    std::vector<Block>& instances = collection.Instances();
+    int block_count = static_cast<int>(blocks.size());
+#pragma omp parallel for num_threads(num_threads) default(none)        \
+    shared(blocks, instances, block_types, end_cap_types, type_count, \
+               block_count) schedule(static)
+    for (int id = 0; id < block_count; ++id) {
+      BlockRecord const& record = blocks[id];
+      DaliExpects(record.type_id >= 0 &&
+                      static_cast<size_t>(record.type_id) < type_count,
+                  "Corrupted checkpoint blocks");
+      BlockType* type_ptr =
+          static_cast<size_t>(record.type_id) < block_types.size()
+              ? &block_types[record.type_id]
+              : &end_cap_types[record.type_id - block_types.size()];
+      Block& block = instances[id];
+      block.SetType(type_ptr);
+      block.SetId(id);
+      block.SetLLX(record.llx);
+      block.SetLLY(record.lly);
+      block.SetPlacementStatus(static_cast<PlaceStatus>(record.place_status));
+      block.SetOrient(static_cast<BlockOrient>(record.orient));
+      if (record.height != type_ptr->Height()) {
+        block.SetHeight(record.height);
+      }
+    }
+    // AddPlacedIOPin() adds the only blocks which are not real
+    for (int id = 0; i == 0 && id < block_count; ++id) {
+      if (blocks[id].type_id != 0) {
+        UpdateRealBlockStatistics(instances[id]);
+      }
+    }
+    if (design.is_frozen[i]) {
+      collection.Freeze();
+    }
+  }
+
+  auto iopins = reader.Section<IoPinRecord>(CheckpointSection::IOPINS);
+  auto iopin_names = reader.Strings(CheckpointSection::IOPIN_NAMES);
+  DaliExpects(iopins.size() == iopin_names.size() && iopins.size() < INT_MAX,
+              "Corrupted checkpoint I/O pins");
+  std::vector<IoPin>& dali_iopins = design_.iopins_;
+  dali_iopins.reserve(iopins.size());
+  design_.iopin_name_id_map_.reserve(iopins.size());
+  for (size_t id = 0; id < iopins.size(); ++id) {
+    auto ret = design_.iopin_name_id_map_.emplace(iopin_names[id],
+                                                  static_cast<int>(id));
+    DaliExpects(ret.second, "Corrupted checkpoint I/O pins");
+    dali_iopins.emplace_back(&(*ret.first));
+  }
+  int iopin_count = static_cast<int>(iopins.size());
+  std::vector<MetalLayer>& metal_layers = tech_.metal_list_;
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(iopins, dali_iopins, metal_layers, iopin_count) schedule(static)
+  for (int id = 0; id < iopin_count; ++id) {
+    IoPinRecord const& record = iopins[id];
+    IoPin& iopin = dali_iopins[id];
+    iopin.SetSigDirection(static_cast<SignalDirection>(record.direction));
+    iopin.SetSigUse(static_cast<SignalUse>(record.use));
+    if (record.layer_id >= 0) {
+      DaliExpects(static_cast<size_t>(record.layer_id) < metal_layers.size(),
+                  "Corrupted checkpoint I/O pins");
+      iopin.SetLayerPtr(&metal_layers[record.layer_id]);
+    }
+    if (record.is_shape_set) {
+      iopin.SetShape(record.shape[0], record.shape[1], record.shape[2],
+                     record.shape[3]);
+    }
+    iopin.SetInitPlaceStatus(
+        static_cast<PlaceStatus>(record.init_place_status));
+    iopin.SetLoc(record.x, record.y,
+                 static_cast<PlaceStatus>(record.place_status));
+    iopin.SetFinalX(record.final_x);
+    iopin.SetFinalY(record.final_y);
+    iopin.SetOrient(static_cast<BlockOrient>(record.orient));
+  }
+
+  auto weights = reader.Section<double>(CheckpointSection::NET_WEIGHTS);
+  auto net_names = reader.Strings(CheckpointSection::NET_NAMES);
+  auto pin_offsets =
+      reader.Section<uint64_t>(CheckpointSection::NET_PIN_OFFSETS);
+  auto net_pins = reader.Section<NetPinRecord>(CheckpointSection::NET_PINS);
+  auto iopin_offsets =
+      reader.Section<uint64_t>(CheckpointSection::NET_IOPIN_OFFSETS);
+  auto net_iopins = reader.Section<int32_t>(CheckpointSection::NET_IOPINS);
+  size_t net_count = weights.size();
+  DaliExpects(net_names.size() == net_count && net_count < INT_MAX &&
+                  pin_offsets.size() == net_count + 1 &&
+                  iopin_offsets.size() == net_count + 1 &&
+                  pin_offsets[net_count] == net_pins.size() &&
+                  iopin_offsets[net_count] == net_iopins.size(),
+              "Corrupted checkpoint nets");
+  for (size_t id = 0; id < net_count; ++id) {
+    DaliExpects(pin_offsets[id] <= pin_offsets[id + 1] &&
+                    iopin_offsets[id] <= iopin_offsets[id + 1],
+                "Corrupted checkpoint nets");
+  }
+  NameIndex& names = design_.net_name_index_;
+  size_t duplicate = names.BulkInsert(
+      net_count, [&net_names](size_t id) { return net_names[id]; });
+  DaliExpects(duplicate == NameIndex::kNotFound, "Corrupted checkpoint nets");
+  // pins are added concurrently, so nets are created without capacity here
+  std::vector<Net>& nets = design_.nets_;
+  nets.reserve(net_count);
+  for (size_t id = 0; id < net_count; ++id) {
+    nets.emplace_back(&names.Name(id), static_cast<int>(id), 0, weights[id]);
+  }
+
+  std::vector<Block>& blocks = design_.Blocks();
+  int net_size = static_cast<int>(net_count);
+#pragma omp parallel for num_threads(num_threads) default(none)             \
+    shared(nets, blocks, dali_iopins, pin_offsets, net_pins, iopin_offsets, \
+               net_iopins, net_size, iopin_count) schedule(dynamic, 1024)
+  for (int id = 0; id < net_size; ++id) {
+    Net& net = nets[id];
+    net.BlockPins().reserve(pin_offsets[id + 1] - pin_offsets[id]);
+    for (uint64_t j = pin_offsets[id]; j < pin_offsets[id + 1]; ++j) {
+      NetPinRecord const& net_pin = net_pins[j];
+      DaliExpects(net_pin.block_id >= 0 &&
+                      static_cast<size_t>(net_pin.block_id) < blocks.size(),
+                  "Corrupted checkpoint nets");
+      Block& block = blocks[net_pin.block_id];
+      std::vector<Pin>& pin_list = block.TypePtr()->PinList();
+      DaliExpects(net_pin.pin_id >= 0 &&
+                      static_cast<size_t>(net_pin.pin_id) < pin_list.size(),
+                  "Corrupted checkpoint nets");
+      net.AddBlkPinPairWithoutBlockNetList(&block, &pin_list[net_pin.pin_id]);
+    }
+    for (uint64_t j = iopin_offsets[id]; j < iopin_offsets[id + 1]; ++j) {
+      int32_t iopin_id = net_iopins[j];
+      DaliExpects(iopin_id >= 0 && iopin_id < iopin_count,
+                  "Corrupted checkpoint nets");
+      IoPin& iopin = dali_iopins[iopin_id];
+      iopin.SetNetPtr(&net);
+      net.AddIoPin(&iopin);
+    }
+  }
+
+  // net lists of blocks in CSR form, ids of each block are in net order
+  std::vector<size_t> block_net_offsets(blocks.size() + 1, 0);
+  for (auto& net_pin : net_pins) {
+    ++block_net_offsets[net_pin.block_id + 1];
+  }
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    block_net_offsets[i + 1] += block_net_offsets[i];
+  }
+  std::vector<int> block_net_ids(net_pins.size());
+  for (size_t id = 0; id < net_count; ++id) {
+    for (uint64_t j = pin_offsets[id]; j < pin_offsets[id + 1]; ++j) {
+      block_net_ids[block_net_offsets[net_pins[j].block_id]++] =
+          static_cast<int>(id);
+    }
+  }
+  // each offset now points to the end of its block
+  std::copy_backward(block_net_offsets.begin(), block_net_offsets.end() - 1,
+                     block_net_offsets.end());
+  block_net_offsets[0] = 0;
+  SetBlockNetLists(block_net_offsets, std::move(block_net_ids), num_threads);
+
+  auto rows = reader.Section<RowRecord>(CheckpointSection::ROWS);
+  auto segments =
+      reader.Section<RowSegmentRecord>(CheckpointSection::ROW_SEGMENTS);
+  size_t segment_id = 0;
+  design_.rows_.reserve(rows.size());
+  for (auto& record : rows) {
+    DaliExpects(record.segment_count >= 0 &&
+                    segment_id + record.segment_count <= segments.size(),
+                "Corrupted checkpoint rows");
+    GeneralRow& row = design_.rows_.emplace_back();
+    row.SetLY(record.ly);
+    row.SetHeight(record.height);
+    row.SetPwellHeight(record.p_well_height);
+    row.SetNwellHeight(record.n_well_height);
+    row.SetOrient(record.is_orient_N);
+    for (int j = 0; j < record.segment_count; ++j, ++segment_id) {
+      GeneralRowSegment& segment = row.RowSegments().emplace_back();
+      segment.SetLX(segments[segment_id].lx);
+      segment.SetWidth(segments[segment_id].width);
+    }
+  }
+}
+
+}  // namespace dali
@@ -0,0 +1,227 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#ifndef DALI_CIRCUIT_CIRCUIT_CHECKPOINT_H_
+#define DALI_CIRCUIT_CIRCUIT_CHECKPOINT_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dali/common/logging.h"
+#include "dali/common/mapped_file.h"
+
+namespace dali {
+
+/****
+ * Binary checkpoint of a Circuit, written by Circuit::SaveCheckpoint() and read
+ * by Circuit::LoadCheckpoint().
+ *
+ * A checkpoint starts with a CheckpointHeader, then come sections, and a table
+ * of CheckpointSectionEntry at the end. A section is a packed array of POD
+ * records, which starts at an 8-byte aligned offset. Records are read in place
+ * from a memory mapping of the file, so nothing is parsed. A list of strings
+ * is stored as two sections: offsets of the strings, one more than the number
+ * of strings, and characters of all strings.
+ *
+ * The version is bumped whenever a record or a section changes. The endian tag
+ * and the record sizes of the table are checked by the reader, so checkpoints
+ * are only read on machines with the same byte order and record layout.
+ * ****/
+
+// "DALICKPT"
+constexpr char kCheckpointMagic[8] = {'D', 'A', 'L', 'I', 'C', 'K', 'P', 'T'};
+constexpr uint32_t kCheckpointVersion = 1;
+constexpr uint32_t kCheckpointEndianTag = 0x01020304;
+
+enum class CheckpointSection : uint32_t {
+  STAGE = 1,
+  STAGE_CHARS,
+  TECH,
+  DESIGN,
+  DESIGN_NAME,
+  DESIGN_NAME_CHARS,
+  METAL_LAYERS,
+  METAL_LAYER_NAMES,
+  METAL_LAYER_NAME_CHARS,
+  BLOCK_TYPES,
+  BLOCK_TYPE_NAMES,
+  BLOCK_TYPE_NAME_CHARS,
+  PINS,
+  PIN_NAMES,
+  PIN_NAME_CHARS,
+  WELL_RECTS,
+  BLOCKS,
+  BLOCK_NAMES,
+  BLOCK_NAME_CHARS,
+  WELL_TAPS,
+  WELL_TAP_NAMES,
+  WELL_TAP_NAME_CHARS,
+  FILLERS,
+  FILLER_NAMES,
+  FILLER_NAME_CHARS,
+  END_CAPS,
+  END_CAP_NAMES,
+  END_CAP_NAME_CHARS,
+  IOPINS,
+  IOPIN_NAMES,
+  IOPIN_NAME_CHARS,
+  NET_WEIGHTS,
+  NET_NAMES,
+  NET_NAME_CHARS,
+  NET_PIN_OFFSETS,
+  NET_PINS,
+  NET_IOPIN_OFFSETS,
+  NET_IOPINS,
+  ROWS,
+  ROW_SEGMENTS,
+  INTRINSIC_BLOCKAGES,
+  DIE_AREA_POINTS,
+  DIE_AREA_BLOCKAGES,
+};
+
+struct CheckpointHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t endian_tag;
+  uint64_t file_size;
+  uint64_t section_table_offset;
+  uint64_t section_count;
+};
+
+struct CheckpointSectionEntry {
+  uint32_t id;
+  uint32_t record_size;
+  uint64_t offset;
+  uint64_t count;
+};
+
+/** A list of strings to be written as two checkpoint sections. */
+class CheckpointStrings {
+ public:
+  CheckpointStrings() : offsets_(1, 0) {}
+  void Reserve(size_t count) { offsets_.reserve(count + 1); }
+  void Add(std::string_view str) {
+    chars_.append(str);
+    offsets_.push_back(chars_.size());
+  }
+  std::vector<uint64_t> const& Offsets() const { return offsets_; }
+  std::string const& Chars() const { return chars_; }
+
+ private:
+  std::vector<uint64_t> offsets_;
+  std::string chars_;
+};
+
+/** Writes sections one after another to a checkpoint file. */
+class CheckpointWriter {
+ public:
+  explicit CheckpointWriter(std::string const& file_name);
+
+  template <typename T>
+  void AddSection(CheckpointSection id, std::vector<T> const& records) {
+    AddRawSection(id, sizeof(T), records.data(), records.size());
+  }
+
+  /** Add the offsets to id, and the characters to the section after id. */
+  void AddStrings(CheckpointSection id, CheckpointStrings const& strings);
+
+  /** Write the section table and the header. */
+  void Close();
+
+ private:
+  std::ofstream ost_;
+  uint64_t offset_ = 0;
+  std::vector<CheckpointSectionEntry> sections_;
+
+  void AddRawSection(CheckpointSection id, size_t record_size,
+                     void const* data, size_t count);
+};
+
+/** An array of records of a section, read in place. */
+template <typename T>
+class CheckpointArray {
+ public:
+  CheckpointArray() = default;
+  CheckpointArray(T const* data, size_t size) : data_(data), size_(size) {}
+  T const& operator[](size_t i) const { return data_[i]; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T const* begin() const { return data_; }
+  T const* end() const { return data_ + size_; }
+
+ private:
+  T const* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/** A list of strings of a checkpoint, read in place. */
+class CheckpointStringArray {
+ public:
+  CheckpointStringArray() = default;
+  CheckpointStringArray(CheckpointArray<uint64_t> offsets,
+                        CheckpointArray<char> chars)
+      : offsets_(offsets), chars_(chars) {}
+  size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+  std::string_view operator[](size_t i) const {
+    return {chars_.begin() + offsets_[i], offsets_[i + 1] - offsets_[i]};
+  }
+
+ private:
+  CheckpointArray<uint64_t> offsets_;
+  CheckpointArray<char> chars_;
+};
+
+/**
+ * Maps a checkpoint file into memory. The header and the section table are
+ * checked when the file is opened, and every section is checked against the
+ * file size and the record size of its type when it is accessed. Exits when a
+ * check fails.
+ */
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(std::string const& file_name);
+
+  template <typename T>
+  CheckpointArray<T> Section(CheckpointSection id) const {
+    CheckpointSectionEntry const& entry = FindSection(id);
+    DaliExpects(entry.record_size == sizeof(T),
+                "Unexpected record size of checkpoint section "
+                    << static_cast<uint32_t>(id) << " in " << file_name_);
+    return {reinterpret_cast<T const*>(file_.Data() + entry.offset),
+            static_cast<size_t>(entry.count)};
+  }
+
+  /** Return strings whose offsets are in id, and characters after id. */
+  CheckpointStringArray Strings(CheckpointSection id) const;
+
+ private:
+  std::string file_name_;
+  MappedFile file_;
+  CheckpointArray<CheckpointSectionEntry> sections_;
+
+  CheckpointSectionEntry const& FindSection(CheckpointSection id) const;
+};
+
+}  // namespace dali
+
+#endif  // DALI_CIRCUIT_CIRCUIT_CHECKPOINT_H_
@@ -95,7 +95,7 @@ class Design {
   std::vector<Block>& Blocks() { return block_collection_.Instances(); }
 
   /** Return regular block name-to-id lookup. */
-  std::unordered_map<std::string, size_t>& BlockNameIdMap() {
+  NameIndex const& BlockNameIdMap() const {
     return block_collection_.NameToIdMap();
   }
 
@@ -108,7 +108,7 @@ class Design {
   }
 
   /** Return well tap cell name-to-id lookup. */
-  std::unordered_map<std::string, size_t>& TapNameIdMap() {
+  NameIndex const& TapNameIdMap() const {
     return well_tap_cell_collection_.NameToIdMap();
   };
 
@@ -116,7 +116,7 @@ class Design {
   std::vector<Block>& Fillers() { return filler_cell_collection_.Instances(); }
 
   /** Return filler cell name-to-id lookup. */
-  std::unordered_map<std::string, size_t>& FillerNameIdMap() {
+  NameIndex const& FillerNameIdMap() const {
     return filler_cell_collection_.NameToIdMap();
   };
 
@@ -214,8 +214,13 @@ class Design {
   std::vector<Net> nets_;
   int added_net_count_ = 0;
   int net_count_limit_ = 0;
-  std::unordered_map<std::string, int> net_name_id_map_;
+  NameIndex net_name_index_;
   NetHistogram net_histogram_;
+  // net ids of all regular blocks in block id order, filled when nets are
+  // loaded in bulk or by Circuit::CompactStorage(), net lists of blocks are
+  // borrowed from it
+  std::vector<int> block_net_ids_;
+  bool is_storage_compact_ = false;
 
   /****rows***/
   std::vector<GeneralRow> rows_;
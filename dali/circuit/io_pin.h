@@ -99,6 +99,9 @@ class IoPin {
   /** Set placement status before Dali modifies this pin. */
   void SetInitPlaceStatus(PlaceStatus init_place_status);
 
+  /** Return placement status before Dali modifies this pin. */
+  PlaceStatus InitPlaceStatus() const { return init_place_status_; }
+
   /** Return true when the pin was already placed before Dali. */
   bool IsPrePlaced() const;
 
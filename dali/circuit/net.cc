@@ -27,9 +27,8 @@
 
 namespace dali {
 
-Net::Net(std::pair<const std::string, int>* name_id_pair_ptr, size_t capacity,
-         double weight)
-    : name_id_pair_ptr_(name_id_pair_ptr), weight_(weight) {
+Net::Net(std::string const* name_ptr, int id, size_t capacity, double weight)
+    : name_ptr_(name_ptr), id_(id), weight_(weight) {
   cnt_fixed_ = 0;
   max_x_pin_id_ = -1;
   min_x_pin_id_ = -1;
@@ -40,21 +39,25 @@ Net::Net(std::pair<const std::string, int>* name_id_pair_ptr, size_t capacity,
   blk_pins_.reserve(capacity);
 }
 
-const std::string& Net::Name() const { return name_id_pair_ptr_->first; }
+const std::string& Net::Name() const { return *name_ptr_; }
 
-int Net::Id() const { return name_id_pair_ptr_->second; }
+int Net::Id() const { return id_; }
 
 void Net::AddBlkPinPair(Block* block_ptr, Pin* pin_ptr) {
+  AddBlkPinPairWithoutBlockNetList(block_ptr, pin_ptr);
+  // because net list is stored as a vector, so the location of a net will
+  // change, thus here, we have to use Num() to find a net, although a pointer
+  // to this net is more convenient.
+  block_ptr->NetList().push_back(Id());
+}
+
+void Net::AddBlkPinPairWithoutBlockNetList(Block* block_ptr, Pin* pin_ptr) {
   if (blk_pins_.size() < blk_pins_.capacity()) {
     blk_pins_.emplace_back(block_ptr, pin_ptr);
     if (!(pin_ptr->IsInput())) driver_pin_index = int(blk_pins_.size()) - 1;
     if (!block_ptr->IsMovable()) {
       ++cnt_fixed_;
     }
-    // because net list is stored as a vector, so the location of a net will
-    // change, thus here, we have to use Num() to find a net, although a pointer
-    // to this net is more convenient.
-    block_ptr->NetList().push_back(Id());
     int p_minus_one = int(blk_pins_.size()) - 1;
     inv_p_ = p_minus_one > 0 ? 1.0 * weight_ / p_minus_one : 0;
   } else {
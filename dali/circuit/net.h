@@ -38,8 +38,7 @@ class IoPin;
 /** Electrical net with connected block pins, I/O pins, and HPWL helpers. */
 class Net {
  public:
-  Net(std::pair<const std::string, int>* name_id_pair_ptr, size_t capacity,
-      double weight);
+  Net(std::string const* name_ptr, int id, size_t capacity, double weight);
 
   /** Return the net name. */
   const std::string& Name() const;
@@ -50,6 +49,13 @@ class Net {
   /** Add a connected block/pin pair. */
   void AddBlkPinPair(Block* block_ptr, Pin* pin_ptr);
 
+  /**
+   * Add a connected block/pin pair, but leave the net list of the block
+   * unchanged. Nets can be filled in parallel this way, and the caller adds
+   * net ids to blocks afterwards.
+   */
+  void AddBlkPinPairWithoutBlockNetList(Block* block_ptr, Pin* pin_ptr);
+
   /** Return connected block pins. */
   std::vector<NetPin>& BlockPins();
 
@@ -170,7 +176,8 @@ class Net {
   double HPWLCtoC();
 
  protected:
-  std::pair<const std::string, int>* name_id_pair_ptr_;
+  std::string const* name_ptr_;
+  int id_;
   double weight_;
   int cnt_fixed_;
   std::vector<NetPin> blk_pins_;
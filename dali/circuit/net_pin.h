@@ -31,7 +31,8 @@ namespace dali {
  *
  * The class stores raw pointers for speed. Circuit construction must reserve
  * block and pin storage before creating net pins so vector growth does not
- * invalidate these pointers.
+ * invalidate these pointers. Circuit::CompactStorage() keeps this layout, since
+ * 32-bit block and pin ids would need the block array on every access.
  */
 class NetPin {
  public:
@@ -0,0 +1,453 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "netlist_kernels.h"
+
+#include <cfloat>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DALI_HAS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace dali {
+
+namespace {
+
+// nets with more pins are scanned by all lanes instead of one lane
+constexpr int kMaxBatchedNetSize = 16;
+
+void ComputePinLocationsScalar(int const* pin_blk_ids,
+                               double const* pin_offsets, double const* blk_loc,
+                               int pin_begin, int pin_end, double* pin_loc) {
+  for (int i = pin_begin; i < pin_end; ++i) {
+    pin_loc[i] = pin_offsets[i] + blk_loc[pin_blk_ids[i]];
+  }
+}
+
+/****
+ * @brief Find max/min pins of pins in [begin, end) starting from the given
+ * state, the same comparisons as Net::UpdateMaxMinIdX().
+ */
+void ScanPinsScalar(double const* pin_loc, int begin, int end, int first_pin,
+                    double& max_loc, double& min_loc, int& max_pin,
+                    int& min_pin) {
+  for (int i = begin; i < end; ++i) {
+    if (max_loc < pin_loc[i]) {
+      max_loc = pin_loc[i];
+      max_pin = i - first_pin;
+    }
+    if (min_loc > pin_loc[i]) {
+      min_loc = pin_loc[i];
+      min_pin = i - first_pin;
+    }
+  }
+}
+
+/****
+ * @brief Write the max/min pins of a net with @param sz pins, handling nets
+ * with at most one pin and nets whose pins are all at the same location.
+ */
+void FinalizeMaxMinPins(int sz, double max_loc, double min_loc, int& max_pin,
+                        int& min_pin) {
+  if (sz <= 1) {
+    max_pin = 0;
+    min_pin = 0;
+  } else if (max_loc == min_loc) {
+    max_pin = 0;
+    min_pin = 1;
+  }
+}
+
+void FindMaxMinPinsOfNetScalar(int const* net_pin_begin, int net_id,
+                               double const* pin_loc, int* max_pin,
+                               int* min_pin) {
+  int begin = net_pin_begin[net_id];
+  int end = net_pin_begin[net_id + 1];
+  double max_loc = -DBL_MAX;
+  double min_loc = DBL_MAX;
+  max_pin[net_id] = 0;
+  min_pin[net_id] = 0;
+  ScanPinsScalar(pin_loc, begin, end, begin, max_loc, min_loc,
+                 max_pin[net_id], min_pin[net_id]);
+  FinalizeMaxMinPins(end - begin, max_loc, min_loc, max_pin[net_id],
+                     min_pin[net_id]);
+}
+
+#if DALI_HAS_X86_KERNELS
+
+/****
+ * @brief Merge per-lane results of a net scanned by all lanes. Lane l has the
+ * first occurrence of its extreme among pins l, l+w, l+2w..., so the lane with
+ * the extreme value and the smallest pin index has the first occurrence.
+ */
+void ReduceLanes(int num_lanes, double const* lane_max,
+                 double const* lane_max_pin, double const* lane_min,
+                 double const* lane_min_pin, double& max_loc, double& min_loc,
+                 int& max_pin, int& min_pin) {
+  max_loc = lane_max[0];
+  min_loc = lane_min[0];
+  max_pin = static_cast<int>(lane_max_pin[0]);
+  min_pin = static_cast<int>(lane_min_pin[0]);
+  for (int l = 1; l < num_lanes; ++l) {
+    int lane_max_id = static_cast<int>(lane_max_pin[l]);
+    if (lane_max[l] > max_loc ||
+        (lane_max[l] == max_loc && lane_max_id < max_pin)) {
+      max_loc = lane_max[l];
+      max_pin = lane_max_id;
+    }
+    int lane_min_id = static_cast<int>(lane_min_pin[l]);
+    if (lane_min[l] < min_loc ||
+        (lane_min[l] == min_loc && lane_min_id < min_pin)) {
+      min_loc = lane_min[l];
+      min_pin = lane_min_id;
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void ComputePinLocationsAvx2(
+    int const* pin_blk_ids, double const* pin_offsets, double const* blk_loc,
+    int pin_begin, int pin_end, double* pin_loc) {
+  int i = pin_begin;
+  for (; i + 4 <= pin_end; i += 4) {
+    __m128i ids = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(pin_blk_ids + i));
+    __m256d loc = _mm256_mask_i32gather_pd(
+        _mm256_setzero_pd(), blk_loc, ids,
+        _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8);
+    __m256d offsets = _mm256_loadu_pd(pin_offsets + i);
+    _mm256_storeu_pd(pin_loc + i, _mm256_add_pd(offsets, loc));
+  }
+  ComputePinLocationsScalar(pin_blk_ids, pin_offsets, blk_loc, i, pin_end,
+                            pin_loc);
+}
+
+__attribute__((target("avx2"))) void FindMaxMinPinsOfLargeNetAvx2(
+    int const* net_pin_begin, int net_id, double const* pin_loc, int* max_pin,
+    int* min_pin) {
+  int begin = net_pin_begin[net_id];
+  int end = net_pin_begin[net_id + 1];
+  __m256d max_v = _mm256_set1_pd(-DBL_MAX);
+  __m256d min_v = _mm256_set1_pd(DBL_MAX);
+  __m256d max_id = _mm256_setzero_pd();
+  __m256d min_id = _mm256_setzero_pd();
+  __m256d id = _mm256_setr_pd(0, 1, 2, 3);
+  __m256d step = _mm256_set1_pd(4);
+  int i = begin;
+  for (; i + 4 <= end; i += 4) {
+    __m256d loc = _mm256_loadu_pd(pin_loc + i);
+    __m256d is_greater = _mm256_cmp_pd(loc, max_v, _CMP_GT_OQ);
+    __m256d is_less = _mm256_cmp_pd(loc, min_v, _CMP_LT_OQ);
+    max_v = _mm256_blendv_pd(max_v, loc, is_greater);
+    max_id = _mm256_blendv_pd(max_id, id, is_greater);
+    min_v = _mm256_blendv_pd(min_v, loc, is_less);
+    min_id = _mm256_blendv_pd(min_id, id, is_less);
+    id = _mm256_add_pd(id, step);
+  }
+  alignas(32) double lane_max[4], lane_max_pin[4], lane_min[4],
+      lane_min_pin[4];
+  _mm256_store_pd(lane_max, max_v);
+  _mm256_store_pd(lane_max_pin, max_id);
+  _mm256_store_pd(lane_min, min_v);
+  _mm256_store_pd(lane_min_pin, min_id);
+  double max_loc, min_loc;
+  ReduceLanes(4, lane_max, lane_max_pin, lane_min, lane_min_pin, max_loc,
+              min_loc, max_pin[net_id], min_pin[net_id]);
+  // remaining pins have larger indices, so the scalar scan keeps first
+  // occurrences
+  ScanPinsScalar(pin_loc, i, end, begin, max_loc, min_loc, max_pin[net_id],
+                 min_pin[net_id]);
+  FinalizeMaxMinPins(end - begin, max_loc, min_loc, max_pin[net_id],
+                     min_pin[net_id]);
+}
+
+/****
+ * @brief Find max/min pins of 4 consecutive nets starting from
+ * @param net_id, one net per lane. Nets with more than kMaxBatchedNetSize pins
+ * are skipped, the caller handles them.
+ */
+__attribute__((target("avx2"))) void FindMaxMinPinsOfBatchAvx2(
+    int const* net_pin_begin, int net_id, double const* pin_loc, int* max_pin,
+    int* min_pin) {
+  alignas(16) int begins[4], sizes[4];
+  int max_size = 0;
+  for (int l = 0; l < 4; ++l) {
+    begins[l] = net_pin_begin[net_id + l];
+    int sz = net_pin_begin[net_id + l + 1] - begins[l];
+    sizes[l] = sz <= kMaxBatchedNetSize ? sz : 0;
+    max_size = sizes[l] > max_size ? sizes[l] : max_size;
+  }
+  __m128i pin_ids = _mm_load_si128(reinterpret_cast<__m128i const*>(begins));
+  __m128i net_sizes = _mm_load_si128(reinterpret_cast<__m128i const*>(sizes));
+  __m256d max_v = _mm256_set1_pd(-DBL_MAX);
+  __m256d min_v = _mm256_set1_pd(DBL_MAX);
+  __m256d max_id = _mm256_setzero_pd();
+  __m256d min_id = _mm256_setzero_pd();
+  __m128i one = _mm_set1_epi32(1);
+  for (int k = 0; k < max_size; ++k) {
+    __m128i k_v = _mm_set1_epi32(k);
+    __m256d is_active =
+        _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm_cmpgt_epi32(net_sizes,
+                                                                  k_v)));
+    __m256d loc = _mm256_mask_i32gather_pd(max_v, pin_loc, pin_ids, is_active,
+                                           8);
+    __m256d id = _mm256_set1_pd(k);
+    __m256d is_greater =
+        _mm256_and_pd(_mm256_cmp_pd(loc, max_v, _CMP_GT_OQ), is_active);
+    __m256d is_less =
+        _mm256_and_pd(_mm256_cmp_pd(loc, min_v, _CMP_LT_OQ), is_active);
+    max_v = _mm256_blendv_pd(max_v, loc, is_greater);
+    max_id = _mm256_blendv_pd(max_id, id, is_greater);
+    min_v = _mm256_blendv_pd(min_v, loc, is_less);
+    min_id = _mm256_blendv_pd(min_id, id, is_less);
+    pin_ids = _mm_add_epi32(pin_ids, one);
+  }
+  alignas(32) double lane_max[4], lane_min[4];
+  alignas(16) int lane_max_pin[4], lane_min_pin[4];
+  _mm256_store_pd(lane_max, max_v);
+  _mm256_store_pd(lane_min, min_v);
+  _mm_store_si128(reinterpret_cast<__m128i*>(lane_max_pin),
+                  _mm256_cvttpd_epi32(max_id));
+  _mm_store_si128(reinterpret_cast<__m128i*>(lane_min_pin),
+                  _mm256_cvttpd_epi32(min_id));
+  for (int l = 0; l < 4; ++l) {
+    int sz = net_pin_begin[net_id + l + 1] - begins[l];
+    if (sz > kMaxBatchedNetSize) {
+      FindMaxMinPinsOfLargeNetAvx2(net_pin_begin, net_id + l, pin_loc,
+                                   max_pin, min_pin);
+      continue;
+    }
+    max_pin[net_id + l] = lane_max_pin[l];
+    min_pin[net_id + l] = lane_min_pin[l];
+    FinalizeMaxMinPins(sz, lane_max[l], lane_min[l], max_pin[net_id + l],
+                       min_pin[net_id + l]);
+  }
+}
+
+void FindMaxMinPinsAvx2(int const* net_pin_begin, int net_begin, int net_end,
+                        double const* pin_loc, int* max_pin, int* min_pin) {
+  int i = net_begin;
+  for (; i + 4 <= net_end; i += 4) {
+    FindMaxMinPinsOfBatchAvx2(net_pin_begin, i, pin_loc, max_pin, min_pin);
+  }
+  for (; i < net_end; ++i) {
+    FindMaxMinPinsOfNetScalar(net_pin_begin, i, pin_loc, max_pin, min_pin);
+  }
+}
+
+__attribute__((target("avx512f"))) void ComputePinLocationsAvx512(
+    int const* pin_blk_ids, double const* pin_offsets, double const* blk_loc,
+    int pin_begin, int pin_end, double* pin_loc) {
+  int i = pin_begin;
+  for (; i + 8 <= pin_end; i += 8) {
+    __m256i ids = _mm256_loadu_si256(
+        reinterpret_cast<__m256i const*>(pin_blk_ids + i));
+    __m512d loc =
+        _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, ids, blk_loc, 8);
+    __m512d offsets = _mm512_loadu_pd(pin_offsets + i);
+    _mm512_storeu_pd(pin_loc + i, _mm512_add_pd(offsets, loc));
+  }
+  ComputePinLocationsScalar(pin_blk_ids, pin_offsets, blk_loc, i, pin_end,
+                            pin_loc);
+}
+
+__attribute__((target("avx512f"))) void FindMaxMinPinsOfLargeNetAvx512(
+    int const* net_pin_begin, int net_id, double const* pin_loc, int* max_pin,
+    int* min_pin) {
+  int begin = net_pin_begin[net_id];
+  int end = net_pin_begin[net_id + 1];
+  __m512d max_v = _mm512_set1_pd(-DBL_MAX);
+  __m512d min_v = _mm512_set1_pd(DBL_MAX);
+  __m512d max_id = _mm512_setzero_pd();
+  __m512d min_id = _mm512_setzero_pd();
+  __m512d id = _mm512_setr_pd(0, 1, 2, 3, 4, 5, 6, 7);
+  __m512d step = _mm512_set1_pd(8);
+  int i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m512d loc = _mm512_loadu_pd(pin_loc + i);
+    __mmask8 is_greater = _mm512_cmp_pd_mask(loc, max_v, _CMP_GT_OQ);
+    __mmask8 is_less = _mm512_cmp_pd_mask(loc, min_v, _CMP_LT_OQ);
+    max_v = _mm512_mask_blend_pd(is_greater, max_v, loc);
+    max_id = _mm512_mask_blend_pd(is_greater, max_id, id);
+    min_v = _mm512_mask_blend_pd(is_less, min_v, loc);
+    min_id = _mm512_mask_blend_pd(is_less, min_id, id);
+    id = _mm512_add_pd(id, step);
+  }
+  alignas(64) double lane_max[8], lane_max_pin[8], lane_min[8],
+      lane_min_pin[8];
+  _mm512_store_pd(lane_max, max_v);
+  _mm512_store_pd(lane_max_pin, max_id);
+  _mm512_store_pd(lane_min, min_v);
+  _mm512_store_pd(lane_min_pin, min_id);
+  double max_loc, min_loc;
+  ReduceLanes(8, lane_max, lane_max_pin, lane_min, lane_min_pin, max_loc,
+              min_loc, max_pin[net_id], min_pin[net_id]);
+  ScanPinsScalar(pin_loc, i, end, begin, max_loc, min_loc, max_pin[net_id],
+                 min_pin[net_id]);
+  FinalizeMaxMinPins(end - begin, max_loc, min_loc, max_pin[net_id],
+                     min_pin[net_id]);
+}
+
+/****
+ * @brief Find max/min pins of 8 consecutive nets starting from
+ * @param net_id, the AVX-512 version of FindMaxMinPinsOfBatchAvx2().
+ */
+__attribute__((target("avx512f"))) void FindMaxMinPinsOfBatchAvx512(
+    int const* net_pin_begin, int net_id, double const* pin_loc, int* max_pin,
+    int* min_pin) {
+  alignas(32) int begins[8], sizes[8];
+  int max_size = 0;
+  for (int l = 0; l < 8; ++l) {
+    begins[l] = net_pin_begin[net_id + l];
+    int sz = net_pin_begin[net_id + l + 1] - begins[l];
+    sizes[l] = sz <= kMaxBatchedNetSize ? sz : 0;
+    max_size = sizes[l] > max_size ? sizes[l] : max_size;
+  }
+  // AVX-512F implies AVX2, so 8 indices and sizes fit in 256-bit registers
+  __m256i pin_ids =
+      _mm256_load_si256(reinterpret_cast<__m256i const*>(begins));
+  __m256i net_sizes =
+      _mm256_load_si256(reinterpret_cast<__m256i const*>(sizes));
+  __m512d max_v = _mm512_set1_pd(-DBL_MAX);
+  __m512d min_v = _mm512_set1_pd(DBL_MAX);
+  __m512d max_id = _mm512_setzero_pd();
+  __m512d min_id = _mm512_setzero_pd();
+  __m256i one = _mm256_set1_epi32(1);
+  for (int k = 0; k < max_size; ++k) {
+    __m256i is_active_v = _mm256_cmpgt_epi32(net_sizes, _mm256_set1_epi32(k));
+    __mmask8 is_active = static_cast<__mmask8>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(is_active_v)));
+    __m512d loc =
+        _mm512_mask_i32gather_pd(max_v, is_active, pin_ids, pin_loc, 8);
+    __m512d id = _mm512_set1_pd(k);
+    __mmask8 is_greater =
+        _mm512_mask_cmp_pd_mask(is_active, loc, max_v, _CMP_GT_OQ);
+    __mmask8 is_less =
+        _mm512_mask_cmp_pd_mask(is_active, loc, min_v, _CMP_LT_OQ);
+    max_v = _mm512_mask_blend_pd(is_greater, max_v, loc);
+    max_id = _mm512_mask_blend_pd(is_greater, max_id, id);
+    min_v = _mm512_mask_blend_pd(is_less, min_v, loc);
+    min_id = _mm512_mask_blend_pd(is_less, min_id, id);
+    pin_ids = _mm256_add_epi32(pin_ids, one);
+  }
+  alignas(64) double lane_max[8], lane_min[8];
+  alignas(32) int lane_max_pin[8], lane_min_pin[8];
+  _mm512_store_pd(lane_max, max_v);
+  _mm512_store_pd(lane_min, min_v);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lane_max_pin),
+                     _mm512_maskz_cvttpd_epi32(0xFF, max_id));
+  _mm256_store_si256(reinterpret_cast<__m256i*>(lane_min_pin),
+                     _mm512_maskz_cvttpd_epi32(0xFF, min_id));
+  for (int l = 0; l < 8; ++l) {
+    int sz = net_pin_begin[net_id + l + 1] - begins[l];
+    if (sz > kMaxBatchedNetSize) {
+      FindMaxMinPinsOfLargeNetAvx512(net_pin_begin, net_id + l, pin_loc,
+                                     max_pin, min_pin);
+      continue;
+    }
+    max_pin[net_id + l] = lane_max_pin[l];
+    min_pin[net_id + l] = lane_min_pin[l];
+    FinalizeMaxMinPins(sz, lane_max[l], lane_min[l], max_pin[net_id + l],
+                       min_pin[net_id + l]);
+  }
+}
+
+void FindMaxMinPinsAvx512(int const* net_pin_begin, int net_begin,
+                          int net_end, double const* pin_loc, int* max_pin,
+                          int* min_pin) {
+  int i = net_begin;
+  for (; i + 8 <= net_end; i += 8) {
+    FindMaxMinPinsOfBatchAvx512(net_pin_begin, i, pin_loc, max_pin, min_pin);
+  }
+  for (; i < net_end; ++i) {
+    FindMaxMinPinsOfNetScalar(net_pin_begin, i, pin_loc, max_pin, min_pin);
+  }
+}
+
+#endif  // DALI_HAS_X86_KERNELS
+
+}  // namespace
+
+SimdLevel DetectSimdLevel() {
+#if DALI_HAS_X86_KERNELS
+  static SimdLevel simd_level = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    return SimdLevel::SCALAR;
+  }();
+  return simd_level;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+std::string SimdLevelStr(SimdLevel simd_level) {
+  switch (simd_level) {
+    case SimdLevel::AVX2:
+      return "avx2";
+    case SimdLevel::AVX512:
+      return "avx512";
+    default:
+      return "scalar";
+  }
+}
+
+void ComputePinLocations(SimdLevel simd_level, int const* pin_blk_ids,
+                         double const* pin_offsets, double const* blk_loc,
+                         int pin_begin, int pin_end, double* pin_loc) {
+#if DALI_HAS_X86_KERNELS
+  if (simd_level == SimdLevel::AVX512) {
+    ComputePinLocationsAvx512(pin_blk_ids, pin_offsets, blk_loc, pin_begin,
+                              pin_end, pin_loc);
+    return;
+  }
+  if (simd_level == SimdLevel::AVX2) {
+    ComputePinLocationsAvx2(pin_blk_ids, pin_offsets, blk_loc, pin_begin,
+                            pin_end, pin_loc);
+    return;
+  }
+#endif
+  ComputePinLocationsScalar(pin_blk_ids, pin_offsets, blk_loc, pin_begin,
+                            pin_end, pin_loc);
+}
+
+void FindMaxMinPins(SimdLevel simd_level, int const* net_pin_begin,
+                    int net_begin, int net_end, double const* pin_loc,
+                    int* max_pin, int* min_pin) {
+#if DALI_HAS_X86_KERNELS
+  if (simd_level == SimdLevel::AVX512) {
+    FindMaxMinPinsAvx512(net_pin_begin, net_begin, net_end, pin_loc, max_pin,
+                         min_pin);
+    return;
+  }
+  if (simd_level == SimdLevel::AVX2) {
+    FindMaxMinPinsAvx2(net_pin_begin, net_begin, net_end, pin_loc, max_pin,
+                       min_pin);
+    return;
+  }
+#endif
+  for (int i = net_begin; i < net_end; ++i) {
+    FindMaxMinPinsOfNetScalar(net_pin_begin, i, pin_loc, max_pin, min_pin);
+  }
+}
+
+}  // namespace dali
@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef DALI_CIRCUIT_NETLIST_KERNELS_H_
+#define DALI_CIRCUIT_NETLIST_KERNELS_H_
+
+#include <string>
+
+namespace dali {
+
+/** Instruction sets of the batched netlist kernels. */
+enum class SimdLevel { SCALAR = 0, AVX2 = 1, AVX512 = 2 };
+
+/** Return the widest instruction set supported by this processor. */
+SimdLevel DetectSimdLevel();
+
+/** Return the name of a SIMD level. */
+std::string SimdLevelStr(SimdLevel simd_level);
+
+/**
+ * Compute @param pin_loc[j] = @param pin_offsets[j] +
+ * @param blk_loc[@param pin_blk_ids[j]] for pins in [pin_begin, pin_end).
+ */
+void ComputePinLocations(SimdLevel simd_level, int const* pin_blk_ids,
+                         double const* pin_offsets, double const* blk_loc,
+                         int pin_begin, int pin_end, double* pin_loc);
+
+/**
+ * For nets in [net_begin, net_end), find the pins with the maximum and
+ * minimum location in @param pin_loc. Pins of net i are in
+ * [net_pin_begin[i], net_pin_begin[i+1]), and the pin indices written to
+ * @param max_pin[i] and @param min_pin[i] are relative to the first pin of
+ * net i. Ties are resolved the same as Net::UpdateMaxMinIdX(), so every SIMD
+ * level gives the same indices.
+ *
+ * The vectorized kernels handle one net per SIMD lane, and nets with many
+ * pins are scanned with all lanes.
+ */
+void FindMaxMinPins(SimdLevel simd_level, int const* net_pin_begin,
+                    int net_begin, int net_end, double const* pin_loc,
+                    int* max_pin, int* min_pin);
+
+}  // namespace dali
+
+#endif  // DALI_CIRCUIT_NETLIST_KERNELS_H_
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#include "netlist_view.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace dali {
+
+namespace {
+
+// pins and nets are split into chunks of these sizes among threads
+constexpr int kPinChunkSize = 4096;
+constexpr int kNetChunkSize = 1024;
+
+}  // namespace
+
+void NetlistView::Build(std::vector<Net>& nets, std::vector<Block>& blocks) {
+  size_t num_pins = 0;
+  for (auto& net : nets) {
+    num_pins += net.BlockPins().size();
+  }
+
+  net_pin_begin_.clear();
+  net_pin_begin_.reserve(nets.size() + 1);
+  net_weights_.clear();
+  net_weights_.reserve(nets.size());
+  pin_blk_ids_.clear();
+  pin_blk_ids_.reserve(num_pins);
+  pin_offsets_x_.clear();
+  pin_offsets_x_.reserve(num_pins);
+  pin_offsets_y_.clear();
+  pin_offsets_y_.reserve(num_pins);
+  for (auto& net : nets) {
+    net_pin_begin_.push_back(static_cast<int>(pin_blk_ids_.size()));
+    net_weights_.push_back(net.Weight());
+    for (auto& blk_pin : net.BlockPins()) {
+      pin_blk_ids_.push_back(blk_pin.BlkId());
+      pin_offsets_x_.push_back(blk_pin.OffsetX());
+      pin_offsets_y_.push_back(blk_pin.OffsetY());
+    }
+  }
+  net_pin_begin_.push_back(static_cast<int>(pin_blk_ids_.size()));
+
+  blk_is_movable_.resize(blocks.size());
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    blk_is_movable_[i] = blocks[i].IsMovable();
+  }
+  blk_x_.resize(blocks.size());
+  blk_y_.resize(blocks.size());
+  UpdateBlockLocationsX(blocks);
+  UpdateBlockLocationsY(blocks);
+}
+
+void NetlistView::UpdateBlockLocationsX(std::vector<Block> const& blocks,
+                                        int num_threads) {
+  int sz = static_cast<int>(blk_x_.size());
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(blocks, sz)
+  for (int i = 0; i < sz; ++i) {
+    blk_x_[i] = blocks[i].LLX();
+  }
+}
+
+void NetlistView::UpdateBlockLocationsY(std::vector<Block> const& blocks,
+                                        int num_threads) {
+  int sz = static_cast<int>(blk_y_.size());
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(blocks, sz)
+  for (int i = 0; i < sz; ++i) {
+    blk_y_[i] = blocks[i].LLY();
+  }
+}
+
+void NetlistView::FindMaxMinPins(int net_id, bool is_x, double const* blk_loc,
+                                 int& max_pin, int& min_pin) const {
+  int begin = net_pin_begin_[net_id];
+  int sz = net_pin_begin_[net_id + 1] - begin;
+  max_pin = 0;
+  min_pin = 0;
+  if (sz <= 1) return;
+
+  double const* offsets = PinOffsets(is_x).data() + begin;
+  int const* blk_ids = pin_blk_ids_.data() + begin;
+  double max_loc = -DBL_MAX;
+  double min_loc = DBL_MAX;
+  for (int i = 0; i < sz; ++i) {
+    double pin_loc = offsets[i] + blk_loc[blk_ids[i]];
+    if (max_loc < pin_loc) {
+      max_loc = pin_loc;
+      max_pin = i;
+    }
+    if (min_loc > pin_loc) {
+      min_loc = pin_loc;
+      min_pin = i;
+    }
+  }
+  // make sure the two pins are different, as in Net::UpdateMaxMinIdX()
+  if (max_loc == min_loc) {
+    max_pin = 0;
+    min_pin = 1;
+  }
+}
+
+double NetlistView::WeightedHpwl(int net_id, bool is_x,
+                                 double const* blk_loc) const {
+  int begin = net_pin_begin_[net_id];
+  int end = net_pin_begin_[net_id + 1];
+  if (end - begin <= 1) return 0;
+
+  double const* offsets = PinOffsets(is_x).data();
+  double max_loc = -DBL_MAX;
+  double min_loc = DBL_MAX;
+  for (int i = begin; i < end; ++i) {
+    double pin_loc = offsets[i] + blk_loc[pin_blk_ids_[i]];
+    max_loc = std::max(max_loc, pin_loc);
+    min_loc = std::min(min_loc, pin_loc);
+  }
+  return (max_loc - min_loc) * net_weights_[net_id];
+}
+
+void NetlistView::SetSimdLevel(SimdLevel simd_level) {
+  simd_level_ = std::min(simd_level, DetectSimdLevel());
+}
+
+void NetlistView::ComputePinLocations(bool is_x, double const* blk_loc,
+                                      std::vector<double>& pin_loc,
+                                      int num_threads) const {
+  int num_pins = NumPins();
+  pin_loc.resize(num_pins);
+  int num_chunks = (num_pins + kPinChunkSize - 1) / kPinChunkSize;
+  int chunk_size = kPinChunkSize;
+  SimdLevel simd_level = simd_level_;
+  int const* blk_ids = pin_blk_ids_.data();
+  double const* offsets = PinOffsets(is_x).data();
+  double* locations = pin_loc.data();
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(num_pins, num_chunks, chunk_size, simd_level, blk_ids, offsets, \
+           blk_loc, locations)
+  for (int i = 0; i < num_chunks; ++i) {
+    int begin = i * chunk_size;
+    int end = std::min(begin + chunk_size, num_pins);
+    dali::ComputePinLocations(simd_level, blk_ids, offsets, blk_loc, begin,
+                              end, locations);
+  }
+}
+
+void NetlistView::FindMaxMinPins(std::vector<double> const& pin_loc,
+                                 std::vector<int>& max_pin,
+                                 std::vector<int>& min_pin,
+                                 int num_threads) const {
+  int num_nets = NumNets();
+  max_pin.resize(num_nets);
+  min_pin.resize(num_nets);
+  int num_chunks = (num_nets + kNetChunkSize - 1) / kNetChunkSize;
+  int chunk_size = kNetChunkSize;
+  SimdLevel simd_level = simd_level_;
+  int const* pin_begin = net_pin_begin_.data();
+  double const* locations = pin_loc.data();
+  int* max_pins = max_pin.data();
+  int* min_pins = min_pin.data();
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(num_nets, num_chunks, chunk_size, simd_level, pin_begin, \
+           locations, max_pins, min_pins) schedule(dynamic)
+  for (int i = 0; i < num_chunks; ++i) {
+    int begin = i * chunk_size;
+    int end = std::min(begin + chunk_size, num_nets);
+    dali::FindMaxMinPins(simd_level, pin_begin, begin, end, locations,
+                         max_pins, min_pins);
+  }
+}
+
+double NetlistView::TotalWeightedHpwl(bool is_x, int num_threads) {
+  double const* blk_loc = is_x ? blk_x_.data() : blk_y_.data();
+  ComputePinLocations(is_x, blk_loc, pin_loc_, num_threads);
+  FindMaxMinPins(pin_loc_, max_pin_, min_pin_, num_threads);
+  double hpwl = 0;
+  int num_nets = NumNets();
+  for (int i = 0; i < num_nets; ++i) {
+    int begin = net_pin_begin_[i];
+    if (net_pin_begin_[i + 1] - begin <= 1) continue;
+    double max_loc = pin_loc_[begin + max_pin_[i]];
+    double min_loc = pin_loc_[begin + min_pin_[i]];
+    hpwl += (max_loc - min_loc) * net_weights_[i];
+  }
+  return hpwl;
+}
+
+}  // namespace dali
@@ -0,0 +1,173 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+
+#ifndef DALI_CIRCUIT_NETLIST_VIEW_H_
+#define DALI_CIRCUIT_NETLIST_VIEW_H_
+
+#include <vector>
+
+#include "block.h"
+#include "net.h"
+#include "netlist_kernels.h"
+
+namespace dali {
+
+/**
+ * Read-only structure-of-arrays view of the block pins of all nets.
+ *
+ * Pins of net i are stored in [NetPinBegin(i), NetPinBegin(i+1)), in the same
+ * order as Net::BlockPins(). For each pin, the id of its block and its offsets
+ * for the current block orientation are resolved when the view is built, so
+ * wirelength kernels scan contiguous arrays instead of going through NetPin,
+ * Block and Pin objects. Block locations are copied into contiguous arrays by
+ * UpdateBlockLocationsX/Y(), kernels can also run on any other location array
+ * indexed by block id, such as the solution of a linear solver.
+ *
+ * The batched kernels ComputePinLocations(), FindMaxMinPins() and
+ * TotalWeightedHpwl() process all nets with the widest SIMD instruction set
+ * supported by the processor, unless a narrower one is set by SetSimdLevel().
+ *
+ * The view needs to be built again if nets, pins or block orientations change.
+ */
+class NetlistView {
+ public:
+  NetlistView() = default;
+
+  /** Build the view from @param nets and @param blocks. */
+  void Build(std::vector<Net>& nets, std::vector<Block>& blocks);
+
+  /** Copy lower left x of @param blocks into BlockX(). */
+  void UpdateBlockLocationsX(std::vector<Block> const& blocks,
+                             int num_threads = 1);
+
+  /** Copy lower left y of @param blocks into BlockY(). */
+  void UpdateBlockLocationsY(std::vector<Block> const& blocks,
+                             int num_threads = 1);
+
+  /** Return the number of nets. */
+  int NumNets() const { return static_cast<int>(net_weights_.size()); }
+
+  /** Return the number of block pins of all nets. */
+  int NumPins() const { return static_cast<int>(pin_blk_ids_.size()); }
+
+  /** Return the number of blocks. */
+  int NumBlocks() const { return static_cast<int>(blk_x_.size()); }
+
+  /** Return the index of the first pin of net @param net_id. */
+  int NetPinBegin(int net_id) const { return net_pin_begin_[net_id]; }
+
+  /** Return one past the index of the last pin of net @param net_id. */
+  int NetPinEnd(int net_id) const { return net_pin_begin_[net_id + 1]; }
+
+  /** Return the weight of net @param net_id. */
+  double NetWeight(int net_id) const { return net_weights_[net_id]; }
+
+  /** Return the block id of pin @param pin_id. */
+  int PinBlkId(int pin_id) const { return pin_blk_ids_[pin_id]; }
+
+  /** Return the orientation-aware x offset of pin @param pin_id. */
+  double PinOffsetX(int pin_id) const { return pin_offsets_x_[pin_id]; }
+
+  /** Return the orientation-aware y offset of pin @param pin_id. */
+  double PinOffsetY(int pin_id) const { return pin_offsets_y_[pin_id]; }
+
+  /** Return the pin offsets in x if @param is_x, otherwise in y. */
+  std::vector<double> const& PinOffsets(bool is_x) const {
+    return is_x ? pin_offsets_x_ : pin_offsets_y_;
+  }
+
+  /** Return whether block @param blk_id is movable. */
+  bool IsBlkMovable(int blk_id) const { return blk_is_movable_[blk_id] != 0; }
+
+  /** Return lower left x of blocks of the last UpdateBlockLocationsX(). */
+  std::vector<double> const& BlockX() const { return blk_x_; }
+
+  /** Return lower left y of blocks of the last UpdateBlockLocationsY(). */
+  std::vector<double> const& BlockY() const { return blk_y_; }
+
+  /**
+   * Find the pins of net @param net_id with the maximum and minimum location
+   * when block i is at @param blk_loc[i], using x offsets if @param is_x.
+   * Pin indices are relative to the first pin of the net, and ties are
+   * resolved the same as Net::UpdateMaxMinIdX().
+   */
+  void FindMaxMinPins(int net_id, bool is_x, double const* blk_loc,
+                      int& max_pin, int& min_pin) const;
+
+  /**
+   * Return the weighted HPWL of net @param net_id when block i is at
+   * @param blk_loc[i], the same as Net::WeightedHPWLX() or WeightedHPWLY().
+   */
+  double WeightedHpwl(int net_id, bool is_x, double const* blk_loc) const;
+
+  /**
+   * Use at most @param simd_level in batched kernels, levels not supported by
+   * this processor fall back to the widest supported one.
+   */
+  void SetSimdLevel(SimdLevel simd_level);
+
+  /** Return the instruction set used by batched kernels. */
+  SimdLevel GetSimdLevel() const { return simd_level_; }
+
+  /**
+   * Compute the location of every pin into @param pin_loc when block i is at
+   * @param blk_loc[i], using x offsets if @param is_x.
+   */
+  void ComputePinLocations(bool is_x, double const* blk_loc,
+                           std::vector<double>& pin_loc,
+                           int num_threads = 1) const;
+
+  /**
+   * Find the max/min pins of every net from @param pin_loc computed by
+   * ComputePinLocations(), the same as FindMaxMinPins() of each net.
+   */
+  void FindMaxMinPins(std::vector<double> const& pin_loc,
+                      std::vector<int>& max_pin, std::vector<int>& min_pin,
+                      int num_threads = 1) const;
+
+  /**
+   * Return the total weighted HPWL of all nets in x if @param is_x, otherwise
+   * in y, at the locations of the last UpdateBlockLocationsX/Y(). Nets are
+   * summed in order, so the result is the same as Circuit::WeightedHPWLX() or
+   * WeightedHPWLY() before multiplying the grid value.
+   */
+  double TotalWeightedHpwl(bool is_x, int num_threads = 1);
+
+ private:
+  std::vector<int> net_pin_begin_;
+  std::vector<double> net_weights_;
+  std::vector<int> pin_blk_ids_;
+  std::vector<double> pin_offsets_x_;
+  std::vector<double> pin_offsets_y_;
+  std::vector<char> blk_is_movable_;
+  std::vector<double> blk_x_;
+  std::vector<double> blk_y_;
+
+  SimdLevel simd_level_ = DetectSimdLevel();
+  // buffers of TotalWeightedHpwl()
+  std::vector<double> pin_loc_;
+  std::vector<int> max_pin_;
+  std::vector<int> min_pin_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_CIRCUIT_NETLIST_VIEW_H_
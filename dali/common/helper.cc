@@ -248,6 +248,36 @@ void ReportMemory() {
             << " current memory: " << (curr_mem >> 20u) << "MB)\n";
 }
 
+size_t HeapAllocationBytes(size_t size) {
+  if (size == 0) return 0;
+  constexpr size_t kChunkHeader = 8;
+  constexpr size_t kMinChunk = 32;
+  return std::max(kMinChunk, (size + kChunkHeader + 15) & ~size_t(15));
+}
+
+size_t StringHeapBytes(std::string const& str) {
+  // a short string is stored inside the string object
+  auto object = reinterpret_cast<char const*>(&str);
+  if (str.data() >= object && str.data() < object + sizeof(str)) {
+    return 0;
+  }
+  return HeapAllocationBytes(str.capacity() + 1);
+}
+
+void ReportContainerMemory(std::string const& title,
+                           std::vector<ContainerMemory> const& containers) {
+  size_t total_bytes = 0;
+  LOG(info) << title << ":\n";
+  for (auto const& container : containers) {
+    LOG(info) << "  " << container.name << ": " << container.count
+              << " elements, " << (container.bytes >> 10u) << "KB\n";
+    total_bytes += container.bytes;
+  }
+  LOG(info) << "  total: " << (total_bytes >> 10u) << "KB "
+            << "(peak memory: " << (getPeakRSS() >> 20u) << "MB, "
+            << "current memory: " << (getCurrentRSS() >> 20u) << "MB)\n";
+}
+
 void MergeIntervals(std::vector<SegI>& intervals) {
   size_t sz = intervals.size();
   if (sz <= 1) return;
@@ -23,6 +23,7 @@
 
 #include <fstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "logging.h"
@@ -65,6 +66,44 @@ bool IsExecutableExisting(std::string const& executable_path);
 /** Log peak and current resident memory usage in megabytes. */
 void ReportMemory();
 
+/** Estimated memory of one container of a data structure. */
+struct ContainerMemory {
+  std::string name;
+  size_t count = 0;  // number of elements
+  size_t bytes = 0;  // bytes of elements, unused capacity, and heap data
+};
+
+/**
+ * Return estimated bytes taken by a heap allocation of size bytes, with the
+ * chunk header and the 16-byte alignment of common allocators.
+ */
+size_t HeapAllocationBytes(size_t size);
+
+/** Return bytes allocated by a string, 0 if it fits in the small buffer. */
+size_t StringHeapBytes(std::string const& str);
+
+/**
+ * Return estimated bytes of an unordered_map keyed by strings: a node per
+ * entry with a next pointer and a cached hash, the bucket array, and the
+ * characters of keys too long for the small buffer.
+ */
+template <typename Value>
+size_t StringMapBytes(std::unordered_map<std::string, Value> const& map) {
+  size_t node_bytes = sizeof(void*) +
+                      sizeof(std::pair<const std::string, Value>) +
+                      sizeof(size_t);
+  size_t bytes = map.size() * HeapAllocationBytes(node_bytes) +
+                 HeapAllocationBytes(map.bucket_count() * sizeof(void*));
+  for (auto const& [key, value] : map) {
+    bytes += StringHeapBytes(key);
+  }
+  return bytes;
+}
+
+/** Log bytes of each container, their total, and current and peak RSS. */
+void ReportContainerMemory(std::string const& title,
+                           std::vector<ContainerMemory> const& containers);
+
 /** Sort and merge overlapping integer intervals in place. */
 void MergeIntervals(std::vector<SegI>& intervals);
 
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#ifndef DALI_COMMON_MAPPED_FILE_H_
+#define DALI_COMMON_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace dali {
+
+/**
+ * A read-only memory mapping of a whole file. Pages are loaded by the kernel
+ * on first access, so opening a large file is cheap. The mapping is page
+ * aligned. Exits if the file cannot be opened or mapped; an empty file has
+ * empty content.
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(std::string const& file_name);
+  ~MappedFile();
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  /** Return the first byte of the file, nullptr for an empty file. */
+  char const* Data() const { return static_cast<char const*>(data_); }
+
+  /** Return the size of the file in bytes. */
+  size_t Size() const { return size_; }
+
+  /** Return the whole file. */
+  std::string_view Content() const {
+    if (data_ == nullptr) return {};
+    return {Data(), size_};
+  }
+
+ private:
+  void* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_COMMON_MAPPED_FILE_H_
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "name_index.h"
+
+#include "dali/common/helper.h"
+#include "dali/common/logging.h"
+
+namespace dali {
+
+size_t NameIndex::Find(std::string_view name) const {
+  if (slots_.empty()) return kNotFound;
+  uint32_t hash = Hash(name);
+  size_t mask = slots_.size() - 1;
+  for (size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+    Slot const& slot = slots_[pos];
+    if (slot.id == kEmpty) return kNotFound;
+    if (slot.hash == hash && Name(slot.id) == name) return slot.id;
+  }
+}
+
+std::pair<size_t, bool> NameIndex::Insert(std::string_view name) {
+  Reserve(size_ + 1);
+  return InsertWithHash(name, Hash(name));
+}
+
+/****
+ * The table has a power-of-two number of slots, and at most 3/4 of them are
+ * used, so a probe sequence always ends at an empty slot.
+ * ****/
+void NameIndex::Reserve(size_t count) {
+  DaliExpects(count < kEmpty, "Too many names for NameIndex: " << count);
+  if (count * 4 <= slots_.size() * 3) return;
+  size_t slot_count = 16;
+  while (slot_count * 3 < count * 4) {
+    slot_count *= 2;
+  }
+  Rehash(slot_count);
+}
+
+void NameIndex::Clear() {
+  chunks_.clear();
+  slots_.clear();
+  size_ = 0;
+}
+
+size_t NameIndex::HeapBytes() const {
+  // new[] keeps the number of strings before the array
+  size_t chunk_bytes =
+      HeapAllocationBytes(kChunkSize * sizeof(std::string) + sizeof(size_t));
+  size_t bytes = HeapAllocationBytes(chunks_.capacity() * sizeof(void*)) +
+                 chunks_.size() * chunk_bytes +
+                 HeapAllocationBytes(slots_.capacity() * sizeof(Slot));
+  for (size_t id = 0; id < size_; ++id) {
+    bytes += StringHeapBytes(Name(id));
+  }
+  return bytes;
+}
+
+std::pair<size_t, bool> NameIndex::InsertWithHash(std::string_view name,
+                                                  uint32_t hash) {
+  size_t mask = slots_.size() - 1;
+  size_t pos = hash & mask;
+  for (; slots_[pos].id != kEmpty; pos = (pos + 1) & mask) {
+    Slot const& slot = slots_[pos];
+    if (slot.hash == hash && Name(slot.id) == name) {
+      return {slot.id, false};
+    }
+  }
+
+  size_t id = size_;
+  if ((id & (kChunkSize - 1)) == 0) {
+    chunks_.push_back(std::make_unique<std::string[]>(kChunkSize));
+  }
+  chunks_.back()[id & (kChunkSize - 1)].assign(name);
+  slots_[pos] = {hash, static_cast<uint32_t>(id)};
+  ++size_;
+  return {id, true};
+}
+
+void NameIndex::Rehash(size_t slot_count) {
+  std::vector<Slot> slots(slot_count, Slot{0, kEmpty});
+  size_t mask = slot_count - 1;
+  for (Slot const& slot : slots_) {
+    if (slot.id == kEmpty) continue;
+    size_t pos = slot.hash & mask;
+    while (slots[pos].id != kEmpty) {
+      pos = (pos + 1) & mask;
+    }
+    slots[pos] = slot;
+  }
+  slots_.swap(slots);
+}
+
+}  // namespace dali
@@ -0,0 +1,124 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#ifndef DALI_COMMON_NAME_INDEX_H_
+#define DALI_COMMON_NAME_INDEX_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dali {
+
+/**
+ * Maps names to dense ids 0, 1, 2, ... in the order names are inserted.
+ *
+ * Names are stored in chunks of strings, so the reference returned by Name()
+ * stays valid until Clear(). The hash table uses open addressing with linear
+ * probing. A slot keeps the 32-bit hash and the id of a name, and the name is
+ * only compared when the hashes are equal. Growing the table reuses the kept
+ * hashes. Lookups take a std::string_view, so no std::string is created for a
+ * query.
+ */
+class NameIndex {
+ public:
+  static constexpr size_t kNotFound = SIZE_MAX;
+
+  NameIndex() = default;
+  NameIndex(NameIndex const&) = delete;
+  NameIndex& operator=(NameIndex const&) = delete;
+  NameIndex(NameIndex&&) noexcept = default;
+  NameIndex& operator=(NameIndex&&) noexcept = default;
+
+  /** Return the number of names. */
+  size_t Size() const { return size_; }
+
+  /** Return the name with the given id. */
+  std::string const& Name(size_t id) const {
+    return chunks_[id >> kChunkBits][id & (kChunkSize - 1)];
+  }
+
+  /** Return the id of name, or kNotFound. */
+  size_t Find(std::string_view name) const;
+
+  /**
+   * Insert name if it is not in the index. Return the id of name, and true if
+   * it is inserted.
+   */
+  std::pair<size_t, bool> Insert(std::string_view name);
+
+  /**
+   * Insert count names, name_of(i) returns the i-th name. The table is sized
+   * once and hashes are computed before any insertion. Return the position i
+   * of the first name already in the index, or kNotFound. Names before this
+   * position are inserted.
+   */
+  template <typename NameOf>
+  size_t BulkInsert(size_t count, NameOf&& name_of) {
+    std::vector<uint32_t> hashes(count);
+    for (size_t i = 0; i < count; ++i) {
+      hashes[i] = Hash(name_of(i));
+    }
+    Reserve(size_ + count);
+    for (size_t i = 0; i < count; ++i) {
+      if (!InsertWithHash(name_of(i), hashes[i]).second) return i;
+    }
+    return kNotFound;
+  }
+
+  /** Make room for count names in total without growing the table. */
+  void Reserve(size_t count);
+
+  /** Remove all names. */
+  void Clear();
+
+  /** Return bytes allocated for names and the table. */
+  size_t HeapBytes() const;
+
+ private:
+  static constexpr uint32_t kEmpty = UINT32_MAX;
+  static constexpr size_t kChunkBits = 10;
+  static constexpr size_t kChunkSize = size_t(1) << kChunkBits;
+
+  struct Slot {
+    uint32_t hash;
+    uint32_t id;
+  };
+
+  std::vector<std::unique_ptr<std::string[]>> chunks_;
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+
+  static uint32_t Hash(std::string_view name) {
+    uint64_t hash = std::hash<std::string_view>{}(name);
+    return static_cast<uint32_t>(hash ^ (hash >> 32u));
+  }
+  std::pair<size_t, bool> InsertWithHash(std::string_view name,
+                                         uint32_t hash);
+  void Rehash(size_t slot_count);
+};
+
+}  // namespace dali
+
+#endif  // DALI_COMMON_NAME_INDEX_H_
@@ -22,10 +22,11 @@
 #define DALI_DALI_COMMON_NAMED_INSTANCE_COLLECTION_H_
 
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 #include "dali/common/logging.h"
+#include "dali/common/name_index.h"
 
 namespace dali {
 
@@ -33,42 +34,57 @@ namespace dali {
  * Owns a vector of named instances and provides stable name-to-id lookup.
  *
  * T must be constructible from a pointer to the stored name string. Creation
- * can be frozen after setup to catch accidental late mutations.
+ * can be frozen after setup to catch accidental late mutations. Names are
+ * looked up by std::string_view, see NameIndex.
  */
 template <typename T>
 class NamedInstanceCollection {
  public:
   /** Create and return a new named instance. */
-  T& CreateInstance(std::string const& name) {
+  T& CreateInstance(std::string_view name) {
     DaliExpects(!frozen_, "Cannot create new instance: collection is frozen.");
 
-    // Check if the name already exists
-    auto it = name_to_id_map_.find(name);
-    DaliExpects(it == name_to_id_map_.end(),
+    // one lookup checks whether the name already exists and inserts it
+    auto [id, is_inserted] = name_index_.Insert(name);
+    DaliExpects(is_inserted,
                 "An instance with this name already exists: " << name);
-    name_to_id_map_[name] = instances_.size();
 
     // instance contains a pointer to its name
-    it = name_to_id_map_.find(name);
-    instances_.emplace_back(T(&(it->first)));
+    instances_.emplace_back(T(&name_index_.Name(id)));
     return instances_.back();
   }
 
+  /**
+   * Create count instances at once, name_of(i) returns the name of the i-th
+   * one. Return the id of the first new instance, the others follow it.
+   */
+  template <typename NameOf>
+  size_t CreateInstances(size_t count, NameOf&& name_of) {
+    DaliExpects(!frozen_, "Cannot create new instance: collection is frozen.");
+    size_t first_id = instances_.size();
+    size_t duplicate = name_index_.BulkInsert(count, name_of);
+    DaliExpects(duplicate == NameIndex::kNotFound,
+                "An instance with this name already exists: "
+                    << name_of(duplicate));
+    instances_.reserve(first_id + count);
+    for (size_t id = first_id; id < first_id + count; ++id) {
+      instances_.emplace_back(T(&name_index_.Name(id)));
+    }
+    return first_id;
+  }
+
   /** Return the instance with the given name. Exits if the name is unknown. */
-  T* GetInstanceByName(std::string const& name) {
-    auto it = name_to_id_map_.find(name);
-    DaliExpects(it != name_to_id_map_.end(),
-                "Cannot find instance by name: " << name);
-    return &instances_[it->second];
+  T* GetInstanceByName(std::string_view name) {
+    return &instances_[GetInstanceIdByName(name)];
   }
 
   /** Return the instance id for the given name. Exits if the name is unknown.
    */
-  size_t GetInstanceIdByName(std::string const& name) {
-    auto it = name_to_id_map_.find(name);
-    DaliExpects(it != name_to_id_map_.end(),
+  size_t GetInstanceIdByName(std::string_view name) {
+    size_t id = name_index_.Find(name);
+    DaliExpects(id != NameIndex::kNotFound,
                 "Cannot find instance by name: " << name);
-    return it->second;
+    return id;
   }
 
   /** Return the instance at id. Exits if id is out of range. */
@@ -79,17 +95,15 @@ class NamedInstanceCollection {
   }
 
   /** Return true when name exists in the collection. */
-  [[nodiscard]] bool NameExists(std::string const& name) const {
-    return name_to_id_map_.find(name) != name_to_id_map_.end();
+  [[nodiscard]] bool NameExists(std::string_view name) const {
+    return name_index_.Find(name) != NameIndex::kNotFound;
   }
 
   /** Return the number of stored instances. */
   [[nodiscard]] size_t GetSize() const { return instances_.size(); }
 
-  /** Return the mutable name-to-id map. */
-  std::unordered_map<std::string, size_t>& NameToIdMap() {
-    return name_to_id_map_;
-  }
+  /** Return the name-to-id index. */
+  NameIndex const& NameToIdMap() const { return name_index_; }
 
   /** Return the mutable instance storage. */
   std::vector<T>& Instances() { return instances_; }
@@ -105,16 +119,19 @@ class NamedInstanceCollection {
 
   /** Remove all instances, lookup entries, and the frozen state. */
   void Clear() {
-    name_to_id_map_.clear();
+    name_index_.Clear();
     instances_.clear();
     frozen_ = false;
   }
 
-  /** Reserve storage for instances. */
-  void Reserve(size_t size) { instances_.reserve(size); }
+  /** Reserve storage for instances and their name lookup entries. */
+  void Reserve(size_t size) {
+    instances_.reserve(size);
+    name_index_.Reserve(size);
+  }
 
  private:
-  std::unordered_map<std::string, size_t> name_to_id_map_;
+  NameIndex name_index_;
   std::vector<T> instances_;
   bool frozen_ = false;
 };
@@ -13,9 +13,11 @@
 #include <fstream>
 #include <iomanip>
 #include <string>
+#include <vector>
 
 #include "dali/common/git_version.h"
 #include "dali/common/logging.h"
+#include "dali/common/memory.h"
 
 namespace dali {
 namespace {
@@ -55,7 +57,14 @@ std::string JsonEscape(const std::string& text) {
 
 }  // namespace
 
-void PlacementMetrics::Clear() { metrics_.clear(); }
+void PlacementMetrics::Clear() {
+  metrics_.clear();
+  timers_.clear();
+  series_.clear();
+  for (auto& in_progress : timer_stack_) {
+    FindOrAddTimer(in_progress.name);
+  }
+}
 
 void PlacementMetrics::Record(const std::string& name, double value) {
   for (auto& [metric_name, metric_value] : metrics_) {
@@ -89,19 +98,133 @@ bool PlacementMetrics::WriteJson(const std::string& file_name,
     }
     ost << "\n";
   }
+  ost << "  },\n";
+  ost << "  \"timers\": {\n";
+  for (size_t i = 0; i < timers_.size(); ++i) {
+    const Timer& timer = timers_[i];
+    ost << "    \"" << JsonEscape(timer.name) << "\": {\"calls\": "
+        << timer.calls << ", \"wall_time\": " << timer.wall_time;
+    if (timer.is_scoped) {
+      ost << ", \"cpu_time\": " << timer.cpu_time
+          << ", \"peak_rss_delta_bytes\": " << timer.peak_rss_delta;
+    }
+    ost << "}";
+    if (i + 1 < timers_.size()) {
+      ost << ",";
+    }
+    ost << "\n";
+  }
+  ost << "  },\n";
+  ost << "  \"series\": {\n";
+  for (size_t i = 0; i < series_.size(); ++i) {
+    const auto& [name, values] = series_[i];
+    ost << "    \"" << JsonEscape(name) << "\": [";
+    for (size_t j = 0; j < values.size(); ++j) {
+      if (j > 0) {
+        ost << ", ";
+      }
+      ost << values[j];
+    }
+    ost << "]";
+    if (i + 1 < series_.size()) {
+      ost << ",";
+    }
+    ost << "\n";
+  }
   ost << "  }\n";
   ost << "}\n";
   return true;
 }
 
+std::string PlacementMetrics::NestedName(const std::string& name) const {
+  if (timer_stack_.empty()) {
+    return name;
+  }
+  return timer_stack_.back().name + "." + name;
+}
+
+PlacementMetrics::Timer& PlacementMetrics::FindOrAddTimer(
+    const std::string& name) {
+  for (auto& timer : timers_) {
+    if (timer.name == name) {
+      return timer;
+    }
+  }
+  timers_.emplace_back();
+  timers_.back().name = name;
+  return timers_.back();
+}
+
+/****
+ * @brief Start a nested timer. The timer is added to the list of timers when
+ * it starts, so that a timer always comes before the timers nested in it.
+ */
+void PlacementMetrics::BeginTimer(const std::string& name) {
+  std::string nested_name = NestedName(name);
+  FindOrAddTimer(nested_name);
+  timer_stack_.push_back({nested_name, std::chrono::steady_clock::now(),
+                          std::clock(), getPeakRSS()});
+}
+
+void PlacementMetrics::EndTimer() {
+  DaliExpects(!timer_stack_.empty(), "No placement timer in progress");
+  TimerInProgress const& in_progress = timer_stack_.back();
+  std::chrono::duration<double> wall_time =
+      std::chrono::steady_clock::now() - in_progress.start_wall_time;
+  Timer& timer = FindOrAddTimer(in_progress.name);
+  ++timer.calls;
+  timer.wall_time += wall_time.count();
+  timer.is_scoped = true;
+  timer.cpu_time +=
+      static_cast<double>(std::clock() - in_progress.start_cpu_time) /
+      CLOCKS_PER_SEC;
+  timer.peak_rss_delta += static_cast<long long>(getPeakRSS()) -
+                          static_cast<long long>(in_progress.start_peak_rss);
+  timer_stack_.pop_back();
+}
+
+void PlacementMetrics::AddTime(const std::string& name, double wall_time,
+                               int calls) {
+  Timer& timer = FindOrAddTimer(NestedName(name));
+  timer.calls += calls;
+  timer.wall_time += wall_time;
+}
+
+void PlacementMetrics::AppendSeries(const std::string& name, double value) {
+  for (auto& [series_name, values] : series_) {
+    if (series_name == name) {
+      values.push_back(value);
+      return;
+    }
+  }
+  series_.emplace_back(name, std::vector<double>{value});
+}
+
 void ClearPlacementMetrics() { GlobalPlacementMetrics().Clear(); }
 
 void RecordPlacementMetric(const std::string& name, double value) {
   GlobalPlacementMetrics().Record(name, value);
 }
 
+void RecordPlacementTime(const std::string& name, double wall_time,
+                         int calls) {
+  GlobalPlacementMetrics().AddTime(name, wall_time, calls);
+}
+
+void AppendPlacementSeries(const std::string& name, double value) {
+  GlobalPlacementMetrics().AppendSeries(name, value);
+}
+
 bool WritePlacementMetricsJson(const std::string& file_name, bool completed) {
   return GlobalPlacementMetrics().WriteJson(file_name, completed);
 }
 
+ScopedPlacementTimer::ScopedPlacementTimer(const std::string& name) {
+  GlobalPlacementMetrics().BeginTimer(name);
+}
+
+ScopedPlacementTimer::~ScopedPlacementTimer() {
+  GlobalPlacementMetrics().EndTimer();
+}
+
 }  // namespace dali
@@ -11,21 +11,74 @@
 #ifndef DALI_COMMON_PLACEMENT_METRICS_H_
 #define DALI_COMMON_PLACEMENT_METRICS_H_
 
+#include <chrono>
+#include <ctime>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace dali {
 
-/** Collects named placement metrics and writes them in Dali's JSON format. */
+/**
+ * Collects named placement metrics and writes them in Dali's JSON format.
+ *
+ * Besides one value per stage, it keeps hierarchical timers and per-iteration
+ * series. A timer is named by the names of all enclosing timers joined by
+ * '.', e.g., "placement.global_placement.look_ahead_legalization". Calls of
+ * the same timer are accumulated. Timers measure wall time, process CPU time,
+ * and how much the peak resident memory of the process grows in between.
+ * Timers and series are not thread-safe, use them outside of OpenMP parallel
+ * regions.
+ */
 class PlacementMetrics {
  public:
+  struct Timer {
+    std::string name;
+    int calls = 0;
+    double wall_time = 0;
+    // CPU time and peak memory are only measured by BeginTimer()/EndTimer()
+    bool is_scoped = false;
+    double cpu_time = 0;
+    long long peak_rss_delta = 0;
+  };
+
+  /** Remove all metrics, timers and series, timers in progress are kept. */
   void Clear();
   void Record(const std::string& name, double value);
   bool WriteJson(const std::string& file_name, bool completed) const;
 
+  /** Start a timer nested in the innermost timer in progress. */
+  void BeginTimer(const std::string& name);
+
+  /** Stop the innermost timer in progress and accumulate its measurements. */
+  void EndTimer();
+
+  /**
+   * Accumulate wall time measured elsewhere, e.g., by a worker thread, to a
+   * timer nested in the innermost timer in progress.
+   */
+  void AddTime(const std::string& name, double wall_time, int calls);
+
+  /** Append one value to the named per-iteration series. */
+  void AppendSeries(const std::string& name, double value);
+
+  std::vector<Timer> const& Timers() const { return timers_; }
+
  private:
+  struct TimerInProgress {
+    std::string name;
+    std::chrono::steady_clock::time_point start_wall_time;
+    clock_t start_cpu_time;
+    size_t start_peak_rss;
+  };
+
+  Timer& FindOrAddTimer(const std::string& name);
+  std::string NestedName(const std::string& name) const;
+
   std::vector<std::pair<std::string, double>> metrics_;
+  std::vector<Timer> timers_;
+  std::vector<TimerInProgress> timer_stack_;
+  std::vector<std::pair<std::string, std::vector<double>>> series_;
 };
 
 /** Clear all placement metrics recorded for the current process. */
@@ -34,9 +87,28 @@ void ClearPlacementMetrics();
 /** Record or update one named placement metric. */
 void RecordPlacementMetric(const std::string& name, double value);
 
+/** Accumulate externally measured wall time to a nested placement timer. */
+void RecordPlacementTime(const std::string& name, double wall_time,
+                         int calls = 1);
+
+/** Append one value to a named per-iteration placement series. */
+void AppendPlacementSeries(const std::string& name, double value);
+
 /** Write collected placement metrics as JSON. */
 bool WritePlacementMetricsJson(const std::string& file_name, bool completed);
 
+/**
+ * Times the enclosing scope with a nested placement timer of the global
+ * placement metrics.
+ */
+class ScopedPlacementTimer {
+ public:
+  explicit ScopedPlacementTimer(const std::string& name);
+  ~ScopedPlacementTimer();
+  ScopedPlacementTimer(const ScopedPlacementTimer&) = delete;
+  ScopedPlacementTimer& operator=(const ScopedPlacementTimer&) = delete;
+};
+
 }  // namespace dali
 
 #endif  // DALI_COMMON_PLACEMENT_METRICS_H_
@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "dali/common/git_version.h"
 #include "dali/common/helper.h"
@@ -68,6 +69,17 @@ void LoadStringConfig(const std::string& name, std::string* value) {
   }
 }
 
+// stages of Dali::StartPlacement(), in the order they run
+const std::vector<std::string> kPlacementStages = {
+    "global_placement", "legalization", "filler_cell_placement",
+    "io_pin_placement"};
+
+int PlacementStageIndex(const std::string& stage) {
+  auto it = std::find(kPlacementStages.begin(), kPlacementStages.end(), stage);
+  if (it == kPlacementStages.end()) return -1;
+  return static_cast<int>(it - kPlacementStages.begin());
+}
+
 }  // namespace
 
 Dali::Dali(phydb::PhyDB* phy_db_ptr, const std::string& severity_level,
@@ -110,7 +122,13 @@ void Dali::ShowParamsList() {
             << "  enable_end_cap_cell: " << enable_end_cap_cell_ << "\n"
             << "  enable_shrink_off_grid_die_area: "
             << enable_shrink_off_grid_die_area_ << "\n"
-            << "  output_name: " << output_name_ << "\n";
+            << "  output_name: " << output_name_ << "\n"
+            << "  save_checkpoint_stage: " << save_checkpoint_stage_ << "\n"
+            << "  save_checkpoint_file: " << save_checkpoint_file_ << "\n"
+            << "  load_checkpoint_file: " << load_checkpoint_file_ << "\n"
+            << "  compact_storage: " << compact_storage_ << "\n"
+            << "  row_band_legalization: " << row_band_legalization_ << "\n"
+            << "  parallel_local_reorder: " << parallel_local_reorder_ << "\n";
 }
 
 void Dali::LoadParamsFromConfig() {
@@ -159,6 +177,20 @@ void Dali::LoadParamsFromConfig() {
   LoadBoolConfig(ConfigName(prefix_, "enable_shrink_off_grid_die_area"),
                  &enable_shrink_off_grid_die_area_);
   LoadStringConfig(ConfigName(prefix_, "output_name"), &output_name_);
+  LoadStringConfig(ConfigName(prefix_, "save_checkpoint_stage"),
+                   &save_checkpoint_stage_);
+  LoadStringConfig(ConfigName(prefix_, "save_checkpoint_file"),
+                   &save_checkpoint_file_);
+  LoadStringConfig(ConfigName(prefix_, "load_checkpoint_file"),
+                   &load_checkpoint_file_);
+  LoadBoolConfig(ConfigName(prefix_, "compact_storage"), &compact_storage_);
+  LoadBoolConfig(ConfigName(prefix_, "row_band_legalization"),
+                 &row_band_legalization_);
+  LoadBoolConfig(ConfigName(prefix_, "parallel_local_reorder"),
+                 &parallel_local_reorder_);
+
+  // dali.global_placer.* parameters
+  gb_placer_.LoadParamsFromConfig();
 }
 
 void Dali::SetLogPrefix(bool disable_log_prefix) {
@@ -172,6 +204,8 @@ void Dali::SetNumThreads(int num_threads) {
 
 Circuit& Dali::GetCircuit() { return circuit_; }
 
+GlobalPlacer const& Dali::GetGlobalPlacer() const { return gb_placer_; }
+
 phydb::PhyDB* Dali::GetPhyDBPtr() { return phy_db_ptr_; }
 
 Dali::RuntimeOptions Dali::GetRuntimeOptions() const {
@@ -194,6 +228,12 @@ Dali::RuntimeOptions Dali::GetRuntimeOptions() const {
       enable_end_cap_cell_,
       enable_shrink_off_grid_die_area_,
       output_name_,
+      save_checkpoint_stage_,
+      save_checkpoint_file_,
+      load_checkpoint_file_,
+      compact_storage_,
+      row_band_legalization_,
+      parallel_local_reorder_,
   };
 }
 
@@ -329,14 +369,35 @@ void Dali::ApplyPlacementOverrides(double density, int number_of_threads) {
   if (number_of_threads >= 1) {
     num_threads_ = number_of_threads;
   }
+  DaliExpects(save_checkpoint_stage_.empty() ||
+                  IsPlacementStage(save_checkpoint_stage_),
+              "Unknown stage to save a checkpoint after: " +
+                  save_checkpoint_stage_);
 }
 
 void Dali::InitializeMainPlacementCircuit() {
+  // cleared before loading, so the timers of loading phases are kept
+  ClearPlacementMetrics();
   circuit_.SetEnableShrinkOffGridDieArea(enable_shrink_off_grid_die_area_);
-  circuit_.InitializeFromPhyDB(phy_db_ptr_);
+  if (load_checkpoint_file_.empty()) {
+    circuit_.InitializeFromPhyDB(phy_db_ptr_, num_threads_);
+  } else {
+    restored_stage_ =
+        circuit_.LoadCheckpoint(load_checkpoint_file_, phy_db_ptr_,
+                                num_threads_);
+    DaliExpects(IsPlacementStage(restored_stage_),
+                "Unknown stage of checkpoint: " + restored_stage_);
+    if (!is_standard_cell_ && IsStageRestored("legalization")) {
+      LOG(warning) << "Well legalization results are not in checkpoints, "
+                      "wells and NP/PP layers are not exported\n";
+    }
+  }
+  if (compact_storage_) {
+    circuit_.CompactStorage();
+  }
   is_circuit_initialized_ = true;
   circuit_.ReportBriefSummary();
-  ClearPlacementMetrics();
+  circuit_.ReportMemoryUsage();
   RecordPlacementMetric("input", circuit_.WeightedHPWL());
 }
 
@@ -350,9 +411,10 @@ void Dali::ResolveTargetDensity() {
 }
 
 bool Dali::RunGlobalPlacementStage() {
+  ScopedPlacementTimer timer("global_placement");
   gb_placer_.SetCircuit(&circuit_);
   gb_placer_.SetNumThreads(num_threads_);
-  if (!disable_global_place_) {
+  if (!disable_global_place_ && !IsStageRestored("global_placement")) {
     gb_placer_.SetPlacementDensity(target_density_);
     if (!gb_placer_.StartPlacement()) {
       LOG(error) << "Global placement failed\n";
@@ -368,6 +430,8 @@ bool Dali::RunGlobalPlacementStage() {
 bool Dali::RunStandardCellLegalization() {
   legalizer_.CopyPlacementContextFrom(&gb_placer_);
   legalizer_.disable_cell_flip_ = disable_cell_flip_;
+  legalizer_.SetNumThreads(num_threads_);
+  legalizer_.SetRowBandMode(row_band_legalization_);
   if (!legalizer_.StartPlacement()) {
     LOG(error) << "Standard-cell legalization failed\n";
     return false;
@@ -383,6 +447,8 @@ bool Dali::RunWellLegalization() {
   well_legalizer_.SetMaxRowWidth(max_row_width_);
   well_legalizer_.SetStripePartitionMode(
       static_cast<int>(well_legalization_mode_));
+  well_legalizer_.SetNumThreads(num_threads_);
+  well_legalizer_.SetParallelLocalReorder(parallel_local_reorder_);
   if (!well_legalizer_.StartPlacement()) {
     LOG(error) << "Well legalization failed\n";
     return false;
@@ -396,7 +462,8 @@ bool Dali::RunWellLegalization() {
 }
 
 bool Dali::RunLegalizationStage() {
-  if (!disable_legalization_) {
+  ScopedPlacementTimer timer("legalization");
+  if (!disable_legalization_ && !IsStageRestored("legalization")) {
     if (is_standard_cell_) {
       if (!RunStandardCellLegalization()) {
         return false;
@@ -412,9 +479,10 @@ bool Dali::RunLegalizationStage() {
 }
 
 bool Dali::RunFillerCellPlacement() {
-  if (!enable_filler_cell_) {
+  if (!enable_filler_cell_ || IsStageRestored("filler_cell_placement")) {
     return true;
   }
+  ScopedPlacementTimer timer("filler_cell_placement");
   filler_cell_placer_.CopyPlacementContextFrom(&gb_placer_);
   filler_cell_placer_.phy_db_ptr_ = phy_db_ptr_;
   filler_cell_placer_.CreateFillerCellTypes(2);
@@ -426,9 +494,10 @@ bool Dali::RunFillerCellPlacement() {
 }
 
 bool Dali::RunIoPinPlacementStage() {
-  if (disable_io_place_) {
+  if (disable_io_place_ || IsStageRestored("io_pin_placement")) {
     return true;
   }
+  ScopedPlacementTimer timer("io_pin_placement");
   auto io_placer = std::make_unique<IoPlacer>(phy_db_ptr_, &circuit_);
   bool is_io_placer_config_success =
       io_placer->SetGlobalMetalLayer(io_metal_layer_);
@@ -442,14 +511,20 @@ bool Dali::RunIoPinPlacementStage() {
 }
 
 bool Dali::StartPlacement(double density, int number_of_threads) {
+  // metrics cleared by InitializeMainPlacementCircuit() keep this timer
+  ScopedPlacementTimer timer("placement");
   ApplyPlacementOverrides(density, number_of_threads);
   InitializeMainPlacementCircuit();
   ResolveTargetDensity();
 
-  if (!RunGlobalPlacementStage() || !RunLegalizationStage() ||
-      !RunFillerCellPlacement() || !RunIoPinPlacementStage()) {
-    return false;
-  }
+  if (!RunGlobalPlacementStage()) return false;
+  MaybeSaveCheckpoint("global_placement");
+  if (!RunLegalizationStage()) return false;
+  MaybeSaveCheckpoint("legalization");
+  if (!RunFillerCellPlacement()) return false;
+  MaybeSaveCheckpoint("filler_cell_placement");
+  if (!RunIoPinPlacementStage()) return false;
+  MaybeSaveCheckpoint("io_pin_placement");
 
   LOG(debug) << "dali git commit: " << get_git_version_short() << "\n";
   RecordPlacementMetric("final", circuit_.WeightedHPWL());
@@ -457,6 +532,22 @@ bool Dali::StartPlacement(double density, int number_of_threads) {
   return true;
 }
 
+bool Dali::IsPlacementStage(std::string const& stage) {
+  return PlacementStageIndex(stage) >= 0;
+}
+
+bool Dali::IsStageRestored(std::string const& stage) const {
+  if (restored_stage_.empty()) return false;
+  return PlacementStageIndex(stage) <= PlacementStageIndex(restored_stage_);
+}
+
+void Dali::MaybeSaveCheckpoint(std::string const& stage) {
+  if (save_checkpoint_stage_ != stage) return;
+  DaliExpects(!save_checkpoint_file_.empty(),
+              "No file name for the checkpoint after stage " + stage);
+  circuit_.SaveCheckpoint(save_checkpoint_file_, stage);
+}
+
 void Dali::AddWellTaps(phydb::Macro* cell, double cell_interval_microns,
                        bool is_checker_board) {
   well_tap_placer_ = std::make_unique<WellTapPlacer>(phy_db_ptr_);
@@ -553,6 +644,7 @@ bool Dali::GlobalPlace(double density, int num_threads) {
 bool Dali::UnifiedLegalization() {
   well_legalizer_.CopyPlacementContextFrom(&gb_placer_);
   well_legalizer_.SetStripePartitionMode(int(DefaultPartitionMode::SCAVENGE));
+  well_legalizer_.SetNumThreads(num_threads_);
   well_legalizer_.is_dump = false;
   return well_legalizer_.StartPlacement();
 }
@@ -612,14 +704,14 @@ void Dali::MaybeExportToLEF(std::string const& input_lef_file_full_name,
 
 void Dali::ExportToDEF(std::string const& input_def_file_full_name,
                        std::string const& output_def_name) {
-  circuit_.SaveDefFile(output_def_name, "", input_def_file_full_name, 1, 1, 2,
-                       1);
-  circuit_.SaveDefFile(output_def_name, "_io", input_def_file_full_name, 1, 1,
-                       1, 1);
-  circuit_.SaveDefFile(output_def_name, "_filling", input_def_file_full_name, 1,
-                       4, 2, 0);
-  circuit_.SaveDefFileComponent(output_def_name + "_comp.def",
-                                input_def_file_full_name);
+  // the input DEF file is read once, and shared sections are formatted once
+  std::vector<DefFileOptions> def_files = {
+      {output_def_name + ".def", output_def_name, 1, 2, 1, false},
+      {output_def_name + "_io.def", output_def_name, 1, 1, 1, false},
+      {output_def_name + "_filling.def", output_def_name, 4, 2, 0, false},
+      {output_def_name + "_comp.def", "", 1, 0, 0, true},
+  };
+  circuit_.SaveDefFiles(def_files, input_def_file_full_name, num_threads_);
   circuit_.InitNetFanoutHistogram();
   circuit_.ReportNetFanoutHistogram();
   circuit_.ReportHPWLHistogramLinear();
@@ -638,7 +730,10 @@ void Dali::InitializeCircuitFromPhyDBIfNeeded() {
     return;
   }
   circuit_.SetEnableShrinkOffGridDieArea(enable_shrink_off_grid_die_area_);
-  circuit_.InitializeFromPhyDB(phy_db_ptr_);
+  circuit_.InitializeFromPhyDB(phy_db_ptr_, num_threads_);
+  if (compact_storage_) {
+    circuit_.CompactStorage();
+  }
   is_circuit_initialized_ = true;
 }
 
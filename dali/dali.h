@@ -55,6 +55,12 @@ class Dali {
     bool enable_end_cap_cell = false;
     bool enable_shrink_off_grid_die_area = false;
     std::string output_name = "dali_out";
+    std::string save_checkpoint_stage;
+    std::string save_checkpoint_file;
+    std::string load_checkpoint_file;
+    bool compact_storage = false;
+    bool row_band_legalization = false;
+    bool parallel_local_reorder = false;
   };
 
   Dali(phydb::PhyDB* phy_db_ptr, const std::string& severity_level,
@@ -71,6 +77,7 @@ class Dali {
   void SetNumThreads(int num_threads);
 
   Circuit& GetCircuit();
+  GlobalPlacer const& GetGlobalPlacer() const;
   phydb::PhyDB* GetPhyDBPtr();
   RuntimeOptions GetRuntimeOptions() const;
 
@@ -94,6 +101,13 @@ class Dali {
   /** Run the default placement pipeline used by the main `dali` app. */
   bool StartPlacement(double density = -1, int number_of_threads = -1);
 
+  /**
+   * Return true if stage is a stage of StartPlacement(), after which a
+   * checkpoint can be saved: global_placement, legalization,
+   * filler_cell_placement, or io_pin_placement.
+   */
+  static bool IsPlacementStage(std::string const& stage);
+
   void AddWellTaps(phydb::Macro* cell, double cell_interval_microns,
                    bool is_checker_board);
   bool AddWellTaps(int argc, char** argv);
@@ -137,6 +151,19 @@ class Dali {
   bool enable_end_cap_cell_ = false;
   bool enable_shrink_off_grid_die_area_ = false;
   std::string output_name_ = "dali_out";
+  // save a checkpoint of the circuit after a stage of StartPlacement()
+  std::string save_checkpoint_stage_;
+  std::string save_checkpoint_file_;
+  // start from a checkpoint instead of the circuit in PhyDB
+  std::string load_checkpoint_file_;
+  // compact net lists of blocks after the circuit is loaded
+  bool compact_storage_ = false;
+  // legalize standard cells in row bands concurrently, the result differs
+  // from the serial legalizer, so this is not tied to the number of threads
+  bool row_band_legalization_ = false;
+  // reorder clusters in well legalization concurrently, opt-in for the same
+  // reason as row_band_legalization_
+  bool parallel_local_reorder_ = false;
 
   // circuit and placer
   Circuit circuit_;
@@ -180,8 +207,14 @@ class Dali {
   bool RunWellLegalization();
   bool RunFillerCellPlacement();
   bool RunIoPinPlacementStage();
+  /** Return true if the loaded checkpoint was saved after this stage. */
+  bool IsStageRestored(std::string const& stage) const;
+  /** Save a checkpoint if it is requested after this stage. */
+  void MaybeSaveCheckpoint(std::string const& stage);
 
   bool is_circuit_initialized_ = false;
+  // the last stage finished before the loaded checkpoint was saved
+  std::string restored_stage_;
 };
 
 }  // namespace dali
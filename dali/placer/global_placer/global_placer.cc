@@ -56,10 +56,56 @@ void GlobalPlacer::SetShouldSaveIntermediateResult(
  * @brief Load a configuration file for this placer.
  *
  * @param config_file: name of the configuration file.
+ *
+ * All global placer parameters are optional:
+ *   dali.global_placer.max_iteration: maximum global placement iterations
+ *   dali.global_placer.linear_solver: "diagonal", "ic" or "amg"
+ *   dali.global_placer.cg_iteration_max_num: CG iteration cap of each solve
+ *   dali.global_placer.hpwl_update_threshold: distance in grid units a block
+ *     moves before its nets are evaluated again during CG rounds
+ *   dali.global_placer.strong_scaling_report: 1 to report the speedup of the
+ *     x/y solves with 1 to 32 threads when global placement finishes
  */
 void GlobalPlacer::LoadConf(std::string const& config_file) {
   config_read(config_file.c_str());
-  DaliFatal("This function is not fully implemented");
+  LoadParamsFromConfig();
+  LOG(info) << "Global placer linear solver: "
+            << LinearSolverTypeStr(linear_solver_type_)
+            << ", CG iteration cap: " << cg_iteration_max_num_ << "\n";
+}
+
+/****
+ * @brief Load global placer parameters from the ACT config database, which
+ * is already read. See LoadConf() for the parameters.
+ */
+void GlobalPlacer::LoadParamsFromConfig() {
+  std::string prefix = "dali.global_placer.";
+
+  std::string param_name = prefix + "max_iteration";
+  if (config_exists(param_name.c_str())) {
+    SetMaxIteration(config_get_int(param_name.c_str()));
+  }
+  param_name = prefix + "linear_solver";
+  if (config_exists(param_name.c_str())) {
+    linear_solver_type_ =
+        StrToLinearSolverType(config_get_string(param_name.c_str()));
+  }
+  param_name = prefix + "cg_iteration_max_num";
+  if (config_exists(param_name.c_str())) {
+    cg_iteration_max_num_ = config_get_int(param_name.c_str());
+    DaliExpects(cg_iteration_max_num_ > 0,
+                "cg_iteration_max_num must be positive");
+  }
+  param_name = prefix + "hpwl_update_threshold";
+  if (config_exists(param_name.c_str())) {
+    hpwl_update_threshold_ = config_get_real(param_name.c_str());
+    DaliExpects(hpwl_update_threshold_ >= 0,
+                "hpwl_update_threshold cannot be negative");
+  }
+  param_name = prefix + "strong_scaling_report";
+  if (config_exists(param_name.c_str())) {
+    should_report_strong_scaling_ = config_get_int(param_name.c_str()) == 1;
+  }
 }
 
 /****
@@ -68,13 +114,19 @@ void GlobalPlacer::LoadConf(std::string const& config_file) {
  */
 void GlobalPlacer::InitializeOptimizerAndLegalizer() {
   delete optimizer_;
-  optimizer_ = new B2BHpwlOptimizer(ckt_ptr_, num_threads_);
+  auto* b2b_optimizer = new B2BHpwlOptimizer(ckt_ptr_, num_threads_);
+  b2b_optimizer->SetCgIterationMaxNum(cg_iteration_max_num_);
+  b2b_optimizer->SetHpwlUpdateThreshold(hpwl_update_threshold_);
+  optimizer_ = b2b_optimizer;
   optimizer_->SetShouldSaveIntermediateResult(should_save_intermediate_result_);
+  optimizer_->SetLinearSolverType(linear_solver_type_);
+  optimizer_->SetShouldReportStrongScaling(should_report_strong_scaling_);
   optimizer_->Initialize();
 
   delete legalizer_;
   legalizer_ = new LookAheadLegalizer(ckt_ptr_);
   legalizer_->SetShouldSaveIntermediateResult(should_save_intermediate_result_);
+  legalizer_->SetNumThreads(num_threads_);
   legalizer_->Initialize(PlacementDensity());
 }
 
@@ -130,6 +182,7 @@ void GlobalPlacer::InitializeBlockLocation() {
 }
 
 void GlobalPlacer::PreparePlacement() {
+  ScopedPlacementTimer timer("initialization");
   SanityCheck();
   InitializeBlockLocation();
   InitializeOptimizerAndLegalizer();
@@ -138,8 +191,18 @@ void GlobalPlacer::PreparePlacement() {
 void GlobalPlacer::RunPlacementIterations() {
   for (cur_iter_ = 0; cur_iter_ < max_iter_; ++cur_iter_) {
     optimizer_->SetIteration(cur_iter_);
-    optimizer_->OptimizeHpwl();
-    legalizer_->RemoveCellOverlap();
+    {
+      ScopedPlacementTimer timer("hpwl_optimization");
+      optimizer_->OptimizeHpwl();
+    }
+    {
+      ScopedPlacementTimer timer("look_ahead_legalization");
+      legalizer_->RemoveCellOverlap();
+    }
+    AppendPlacementSeries("global_placement.lower_hpwl",
+                          optimizer_->GetHpwls().back());
+    AppendPlacementSeries("global_placement.upper_hpwl",
+                          legalizer_->GetHpwls().back());
     PrintHpwl();
     if (IsPlacementConverged()) break;
   }
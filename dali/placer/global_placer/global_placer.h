@@ -45,6 +45,15 @@ class GlobalPlacer : public Placer {
   /** Load global placer configuration. */
   void LoadConf(std::string const& config_file) override;
 
+  /** Load global placer parameters from the ACT config database. */
+  void LoadParamsFromConfig();
+
+  /** Return the linear solver of the HPWL optimizer. */
+  LinearSolverType LinearSolver() const { return linear_solver_type_; }
+
+  /** Return the CG iteration cap of each solve. */
+  int CgIterationMaxNum() const { return cg_iteration_max_num_; }
+
   /** Create optimizer and rough legalizer instances. */
   void InitializeOptimizerAndLegalizer();
 
@@ -68,6 +77,13 @@ class GlobalPlacer : public Placer {
   // Save intermediate result for debugging and/or visualization.
   bool should_save_intermediate_result_ = false;
 
+  // Linear solver controls of the HPWL optimizer.
+  LinearSolverType linear_solver_type_ = LinearSolverType::DIAGONAL_CG;
+  int cg_iteration_max_num_ = 1000;
+  double hpwl_update_threshold_ = 0;
+  // Print a strong-scaling report of the x/y solves when placement finishes.
+  bool should_report_strong_scaling_ = false;
+
   bool IsBlockListOrNetListEmpty() const;
   static bool IsSeriesConverged(std::vector<double>& series, int window_size,
                                 double tolerance);
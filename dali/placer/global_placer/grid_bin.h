@@ -22,7 +22,6 @@
 #define DALI_PLACER_GLOBAL_PLACER_GRID_BIN_H_
 
 #include <boost/functional/hash.hpp>
-#include <set>
 #include <vector>
 
 #include "dali/circuit/block.h"
@@ -78,22 +77,16 @@ struct GridBinIndexHasher {
   }
 };
 
-/** Connected overfilled-bin cluster used by look-ahead legalization. */
+/**
+ * Connected overfilled-bin cluster used by look-ahead legalization. Its bins
+ * are a range of the bin array of GridBinClusterQueue.
+ */
 struct GridBinCluster {
  public:
-  GridBinCluster() : total_cell_area(0), total_white_space(0) {}
-  unsigned long long total_cell_area;
-  unsigned long long total_white_space;
-  std::set<GridBinIndex> bin_set;
-  bool operator<(const GridBinCluster& rhs) const {
-    return (total_cell_area < rhs.total_cell_area);
-  }
-  bool operator>(const GridBinCluster& rhs) const {
-    return (total_cell_area > rhs.total_cell_area);
-  }
-  bool operator==(const GridBinCluster& rhs) const {
-    return (total_cell_area == rhs.total_cell_area);
-  }
+  unsigned long long total_cell_area = 0;
+  unsigned long long total_white_space = 0;
+  int bin_begin = 0;
+  int bin_end = 0;
 };
 
 /** Mesh bin storing local cell area, whitespace, blockages, and neighbors. */
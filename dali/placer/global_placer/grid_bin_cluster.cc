@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "grid_bin_cluster.h"
+
+#include <algorithm>
+
+namespace dali {
+
+void GridBinClusterQueue::Build(
+    std::vector<std::vector<GridBin>>& grid_bin_mesh,
+    int cluster_upper_size) {
+  clusters_.clear();
+  bins_.clear();
+  heap_.clear();
+
+  int m = static_cast<int>(grid_bin_mesh.size());     // number of rows
+  int n = static_cast<int>(grid_bin_mesh[0].size());  // number of columns
+  num_bins_y_ = n;
+  stamp_ = 0;
+  member_stamps_.assign(static_cast<size_t>(m) * n, 0);
+  visited_stamps_.assign(static_cast<size_t>(m) * n, 0);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) grid_bin_mesh[i][j].cluster_visited = false;
+  }
+
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      if (grid_bin_mesh[i][j].cluster_visited || !grid_bin_mesh[i][j].over_fill)
+        continue;
+      int bin_begin = static_cast<int>(bins_.size());
+      bins_.emplace_back(i, j);
+      grid_bin_mesh[i][j].cluster_visited = true;
+      // bins of the cluster are also the queue of the breadth-first search
+      int cnt = 0;
+      bool is_full = false;
+      for (size_t head = bin_begin; head < bins_.size() && !is_full; ++head) {
+        GridBinIndex b = bins_[head];
+        for (auto& index : grid_bin_mesh[b.x][b.y].adjacent_bin_index) {
+          GridBin& bin = grid_bin_mesh[index.x][index.y];
+          if (!bin.cluster_visited && bin.over_fill) {
+            if (cnt > cluster_upper_size) {
+              is_full = true;
+              break;
+            }
+            bin.cluster_visited = true;
+            bins_.push_back(index);
+            ++cnt;
+          }
+        }
+      }
+      Push(grid_bin_mesh, bin_begin);
+    }
+  }
+}
+
+void GridBinClusterQueue::SplitPlacedClusters(
+    std::vector<std::vector<GridBin>> const& grid_bin_mesh,
+    int cluster_upper_size) {
+  while (!heap_.empty()) {
+    // if no grid bin has been roughly legalized, then this cluster is the
+    // largest one for sure
+    GridBinCluster cluster = Top();
+    bool has_placed_bin = false;
+    for (int k = cluster.bin_begin; k < cluster.bin_end; ++k) {
+      if (grid_bin_mesh[bins_[k].x][bins_[k].y].global_placed) {
+        has_placed_bin = true;
+        break;
+      }
+    }
+    if (!has_placed_bin) break;
+    Pop();
+
+    // new clusters are grown from remaining bins in (x, y) order
+    sorted_bins_.assign(bins_.begin() + cluster.bin_begin,
+                        bins_.begin() + cluster.bin_end);
+    std::sort(sorted_bins_.begin(), sorted_bins_.end());
+    ++stamp_;
+    for (auto& index : sorted_bins_) {
+      member_stamps_[BinId(index)] = stamp_;
+    }
+    for (auto& grid_index : sorted_bins_) {
+      if (visited_stamps_[BinId(grid_index)] == stamp_) continue;
+      if (grid_bin_mesh[grid_index.x][grid_index.y].global_placed) continue;
+      int bin_begin = static_cast<int>(bins_.size());
+      bins_.push_back(grid_index);
+      visited_stamps_[BinId(grid_index)] = stamp_;
+      int cnt = 0;
+      bool is_full = false;
+      for (size_t head = bin_begin; head < bins_.size() && !is_full; ++head) {
+        GridBinIndex b = bins_[head];
+        for (auto& index : grid_bin_mesh[b.x][b.y].adjacent_bin_index) {
+          int bin_id = BinId(index);
+          // skip bins not in the cluster, visited, or roughly legalized
+          if (member_stamps_[bin_id] != stamp_) continue;
+          if (visited_stamps_[bin_id] == stamp_) continue;
+          if (grid_bin_mesh[index.x][index.y].global_placed) continue;
+          if (cnt > cluster_upper_size) {
+            is_full = true;
+            break;
+          }
+          visited_stamps_[bin_id] = stamp_;
+          bins_.push_back(index);
+          ++cnt;
+        }
+      }
+      Push(grid_bin_mesh, bin_begin);
+    }
+  }
+}
+
+/****
+ * @brief Return whether cluster @param cluster_id0 is processed after cluster
+ * @param cluster_id1, clusters with larger cell area go first, and clusters
+ * with the same cell area go in the order they are added.
+ */
+bool GridBinClusterQueue::IsLowerPriority(int cluster_id0,
+                                          int cluster_id1) const {
+  auto& cluster0 = clusters_[cluster_id0];
+  auto& cluster1 = clusters_[cluster_id1];
+  if (cluster0.total_cell_area != cluster1.total_cell_area) {
+    return cluster0.total_cell_area < cluster1.total_cell_area;
+  }
+  return cluster_id0 > cluster_id1;
+}
+
+/****
+ * @brief Add a cluster with bins from @param bin_begin to the end of the bin
+ * array.
+ */
+void GridBinClusterQueue::Push(
+    std::vector<std::vector<GridBin>> const& grid_bin_mesh, int bin_begin) {
+  GridBinCluster cluster;
+  cluster.bin_begin = bin_begin;
+  cluster.bin_end = static_cast<int>(bins_.size());
+  for (int k = cluster.bin_begin; k < cluster.bin_end; ++k) {
+    auto& bin = grid_bin_mesh[bins_[k].x][bins_[k].y];
+    cluster.total_cell_area += bin.cell_area;
+    cluster.total_white_space += bin.white_space;
+  }
+  clusters_.push_back(cluster);
+  heap_.push_back(static_cast<int>(clusters_.size()) - 1);
+  std::push_heap(heap_.begin(), heap_.end(), [this](int id0, int id1) {
+    return IsLowerPriority(id0, id1);
+  });
+}
+
+void GridBinClusterQueue::Pop() {
+  std::pop_heap(heap_.begin(), heap_.end(), [this](int id0, int id1) {
+    return IsLowerPriority(id0, id1);
+  });
+  heap_.pop_back();
+}
+
+}  // namespace dali
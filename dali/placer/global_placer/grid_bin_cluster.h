@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#ifndef DALI_PLACER_GLOBAL_PLACER_GRID_BIN_CLUSTER_H_
+#define DALI_PLACER_GLOBAL_PLACER_GRID_BIN_CLUSTER_H_
+
+#include <vector>
+
+#include "dali/placer/global_placer/grid_bin.h"
+
+namespace dali {
+
+/**
+ * Clusters of over-filled grid bins for look-ahead legalization, stored in
+ * flat arrays.
+ *
+ * Bins of all clusters are appended to one array, and each cluster refers to
+ * a range of it. Clusters are kept in a binary heap with the largest cell area
+ * on top, clusters with the same cell area are in the order they are added.
+ * Clusters are grown by breadth-first search from their first bin, and stop
+ * growing once more than cluster_upper_size bins are added to the first bin.
+ * All buffers keep their capacity, so rebuilding clusters in every iteration
+ * does not allocate once they are large enough.
+ */
+class GridBinClusterQueue {
+ public:
+  /**
+   * Find clusters of connected over-filled bins of @param grid_bin_mesh, first
+   * bins of clusters are in (x, y) order. Sets GridBin::cluster_visited.
+   */
+  void Build(std::vector<std::vector<GridBin>>& grid_bin_mesh,
+             int cluster_upper_size);
+
+  /**
+   * Until the cluster on top has no globally placed bin, replace the cluster
+   * on top with clusters of its bins which are not globally placed yet.
+   */
+  void SplitPlacedClusters(
+      std::vector<std::vector<GridBin>> const& grid_bin_mesh,
+      int cluster_upper_size);
+
+  /** Return whether there is no cluster. */
+  bool IsEmpty() const { return heap_.empty(); }
+
+  /** Return the number of clusters in the queue. */
+  int NumClusters() const { return static_cast<int>(heap_.size()); }
+
+  /** Return the cluster with the largest cell area. */
+  GridBinCluster const& Top() const { return clusters_[heap_.front()]; }
+
+  /** Return bins of all clusters, ranges of a cluster index this array. */
+  std::vector<GridBinIndex> const& Bins() const { return bins_; }
+
+ private:
+  int num_bins_y_ = 0;
+  std::vector<GridBinCluster> clusters_;
+  std::vector<GridBinIndex> bins_;
+  // indices of clusters in a max-heap, see IsLowerPriority()
+  std::vector<int> heap_;
+  // scratch of SplitPlacedClusters(), a bin is in the cluster being split or
+  // visited if its stamp equals the current stamp
+  int stamp_ = 0;
+  std::vector<int> member_stamps_;
+  std::vector<int> visited_stamps_;
+  std::vector<GridBinIndex> sorted_bins_;
+
+  int BinId(GridBinIndex const& index) const {
+    return index.x * num_bins_y_ + index.y;
+  }
+  bool IsLowerPriority(int cluster_id0, int cluster_id1) const;
+  void Push(std::vector<std::vector<GridBin>> const& grid_bin_mesh,
+            int bin_begin);
+  void Pop();
+};
+
+}  // namespace dali
+
+#endif  // DALI_PLACER_GLOBAL_PLACER_GRID_BIN_CLUSTER_H_
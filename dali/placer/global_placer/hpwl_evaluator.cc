@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "hpwl_evaluator.h"
+
+#include <cmath>
+
+#include "dali/common/logging.h"
+
+namespace dali {
+
+void HpwlEvaluator::Build(NetlistView const* netlist, bool is_x,
+                          double grid_value) {
+  DaliExpects(netlist != nullptr, "Netlist view is a nullptr?");
+  netlist_ = netlist;
+  is_x_ = is_x;
+  grid_value_ = grid_value;
+  net_hpwl_.assign(netlist->NumNets(), 0);
+  is_net_updated_.assign(netlist->NumNets(), 0);
+  ref_loc_.assign(netlist->NumBlocks(), 0);
+  is_blk_moved_.assign(netlist->NumBlocks(), 0);
+  is_cache_valid_ = false;
+}
+
+/****
+ * @brief Return the weighted HPWL when block i is at @param loc[i].
+ *
+ * Blocks moved by more than the update threshold are marked first, and their
+ * reference locations are updated. Then every net with a marked block is
+ * evaluated again. Both steps run in parallel, and the HPWL of nets is summed
+ * in net order, so the result does not depend on the number of threads.
+ */
+double HpwlEvaluator::Evaluate(Eigen::VectorXd const& loc) {
+  int num_blks = static_cast<int>(ref_loc_.size());
+  int num_nets = static_cast<int>(net_hpwl_.size());
+  DaliExpects(loc.size() == num_blks,
+              "Location vector size does not match the number of blocks");
+
+  bool is_cache_valid = is_cache_valid_;
+  double update_threshold = update_threshold_;
+#pragma omp parallel for num_threads(num_threads_) default(none) \
+    shared(loc, num_blks, is_cache_valid, update_threshold)
+  for (int i = 0; i < num_blks; ++i) {
+    bool is_moved =
+        !is_cache_valid || std::fabs(loc[i] - ref_loc_[i]) > update_threshold;
+    if (is_moved) {
+      ref_loc_[i] = loc[i];
+    }
+    is_blk_moved_[i] = is_moved;
+  }
+
+  NetlistView const& netlist = *netlist_;
+  double const* blk_loc = loc.data();
+#pragma omp parallel for schedule(dynamic, 1024) num_threads(num_threads_) \
+    default(none) shared(netlist, blk_loc, num_nets)
+  for (int i = 0; i < num_nets; ++i) {
+    bool is_net_moved = false;
+    for (int j = netlist.NetPinBegin(i); j < netlist.NetPinEnd(i); ++j) {
+      is_net_moved |= is_blk_moved_[netlist.PinBlkId(j)] != 0;
+    }
+    is_net_updated_[i] = is_net_moved;
+    if (is_net_moved) {
+      net_hpwl_[i] = netlist.WeightedHpwl(i, is_x_, blk_loc);
+    }
+  }
+  is_cache_valid_ = true;
+
+  double hpwl = 0;
+  num_updated_nets_ = 0;
+  for (int i = 0; i < num_nets; ++i) {
+    hpwl += net_hpwl_[i];
+    num_updated_nets_ += is_net_updated_[i];
+  }
+  return hpwl * grid_value_;
+}
+
+}  // namespace dali
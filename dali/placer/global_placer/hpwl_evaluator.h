@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#ifndef DALI_PLACER_GLOBAL_PLACER_HPWL_EVALUATOR_H_
+#define DALI_PLACER_GLOBAL_PLACER_HPWL_EVALUATOR_H_
+
+#include <Eigen/Core>
+#include <vector>
+
+#include "dali/circuit/netlist_view.h"
+
+namespace dali {
+
+/**
+ * Weighted HPWL of all nets in one dimension, evaluated on a vector of block
+ * locations, e.g., the solution of a CG solve, without writing blocks.
+ *
+ * Nets are evaluated on a NetlistView, so no Block or Pin object is touched.
+ * The HPWL of each net is cached, and only nets with a block moved by more
+ * than the update threshold since the last evaluation are evaluated again.
+ * With the default threshold 0, the result is the same as
+ * Circuit::WeightedHPWLX() or Circuit::WeightedHPWLY() after moving blocks to
+ * the given locations.
+ */
+class HpwlEvaluator {
+ public:
+  /**
+   * Evaluate nets of @param netlist in x if @param is_x, otherwise in y, and
+   * scale the result by @param grid_value. The netlist must outlive this
+   * evaluator.
+   */
+  void Build(NetlistView const* netlist, bool is_x, double grid_value);
+
+  /** Set number of threads used by Evaluate(). */
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
+  /** Set the distance a block needs to move before its nets are updated. */
+  void SetUpdateThreshold(double update_threshold) {
+    update_threshold_ = update_threshold;
+  }
+
+  /** Drop cached values, the next Evaluate() evaluates every net. */
+  void Reset() { is_cache_valid_ = false; }
+
+  /** Return the weighted HPWL when block i is at @param loc[i]. */
+  double Evaluate(Eigen::VectorXd const& loc);
+
+  /** Return the number of nets evaluated by the last Evaluate(). */
+  int NumUpdatedNets() const { return num_updated_nets_; }
+
+ private:
+  NetlistView const* netlist_ = nullptr;
+  bool is_x_ = true;
+  double grid_value_ = 1;
+
+  int num_threads_ = 1;
+  double update_threshold_ = 0;
+  bool is_cache_valid_ = false;
+  int num_updated_nets_ = 0;
+  std::vector<double> net_hpwl_;
+  // location of each block when its nets were evaluated
+  std::vector<double> ref_loc_;
+  std::vector<char> is_blk_moved_;
+  std::vector<char> is_net_updated_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PLACER_GLOBAL_PLACER_HPWL_EVALUATOR_H_
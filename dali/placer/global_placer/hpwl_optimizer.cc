@@ -21,11 +21,14 @@
 
 #include "hpwl_optimizer.h"
 
+#include <omp.h>
+
 #include <algorithm>
 #include <cfloat>
 
 #include "dali/common/elapsed_time.h"
 #include "dali/common/logging.h"
+#include "dali/common/placement_metrics.h"
 
 namespace dali {
 
@@ -84,10 +87,8 @@ void B2BHpwlOptimizer::Initialize() {
   x_anchor_weight.resize(eigen_sz);
   y_anchor_weight.resize(eigen_sz);
 
-  cg_x_.setMaxIterations(cg_iteration_);
-  cg_x_.setTolerance(cg_tolerance_);
-  cg_y_.setMaxIterations(cg_iteration_);
-  cg_y_.setTolerance(cg_tolerance_);
+  InitializeLinearSolvers();
+  InitializeNetlistView();
 
   size_t coefficient_size = 0;
   auto& nets = ckt_ptr_->Nets();
@@ -109,12 +110,93 @@ void B2BHpwlOptimizer::Initialize() {
   Ay.reserve(static_cast<EgId>(coefficient_size));
 }
 
+/****
+ * @brief Create the linear solvers of the x and y systems.
+ */
+void B2BHpwlOptimizer::InitializeLinearSolvers() {
+  cg_x_ = CreateLinearSolver(linear_solver_type_);
+  cg_y_ = CreateLinearSolver(linear_solver_type_);
+  cg_x_->SetMaxIterations(cg_iteration_);
+  cg_x_->SetTolerance(cg_tolerance_);
+  cg_y_->SetMaxIterations(cg_iteration_);
+  cg_y_->SetTolerance(cg_tolerance_);
+  LOG(debug) << "Linear solver: " << LinearSolverTypeStr(linear_solver_type_)
+             << " preconditioned CG\n";
+}
+
+/****
+ * @brief Build the netlist view used by net models and HPWL evaluation.
+ */
+void B2BHpwlOptimizer::InitializeNetlistView() {
+  netlist_view_.Build(ckt_ptr_->Nets(), ckt_ptr_->Blocks());
+  size_t num_nets = ckt_ptr_->Nets().size();
+  max_pin_x_.assign(num_nets, 0);
+  min_pin_x_.assign(num_nets, 0);
+  max_pin_y_.assign(num_nets, 0);
+  min_pin_y_.assign(num_nets, 0);
+  hpwl_evaluator_x_.Build(&netlist_view_, true, ckt_ptr_->GridValueX());
+  hpwl_evaluator_y_.Build(&netlist_view_, false, ckt_ptr_->GridValueY());
+  hpwl_evaluator_x_.SetUpdateThreshold(hpwl_update_threshold_);
+  hpwl_evaluator_y_.SetUpdateThreshold(hpwl_update_threshold_);
+}
+
+/****
+ * @brief Model all nets into @param coefficients and @param b.
+ *
+ * Nets are split into chunks of net_model_chunk_size_ nets, and each chunk is
+ * modeled by @param add_net_model into its own buffers. Buffers are merged in
+ * net order afterward, and right-hand-side contributions are accumulated in
+ * the same order as a serial loop over all nets, so the resulting linear
+ * system does not depend on the number of threads.
+ */
+void B2BHpwlOptimizer::BuildNetModel(
+    std::vector<NetModelChunk>& chunks, std::vector<T>& coefficients,
+    Eigen::VectorXd& b,
+    void (B2BHpwlOptimizer::*add_net_model)(Net&, NetModelChunk&)) {
+  std::vector<Net>& nets = ckt_ptr_->Nets();
+  int num_nets = static_cast<int>(nets.size());
+  int chunk_size = static_cast<int>(net_model_chunk_size_);
+  int num_chunks = (num_nets + chunk_size - 1) / chunk_size;
+  chunks.resize(num_chunks);
+  int num_threads = num_threads_;
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads) \
+    default(none)                                                    \
+    shared(chunks, nets, num_nets, chunk_size, num_chunks, add_net_model)
+  for (int c = 0; c < num_chunks; ++c) {
+    NetModelChunk& chunk = chunks[c];
+    chunk.coefficients.clear();
+    chunk.rhs.clear();
+    int end = std::min(num_nets, (c + 1) * chunk_size);
+    for (int i = c * chunk_size; i < end; ++i) {
+      (this->*add_net_model)(nets[i], chunk);
+    }
+  }
+
+  std::vector<size_t> offsets(num_chunks + 1, coefficients.size());
+  for (int c = 0; c < num_chunks; ++c) {
+    offsets[c + 1] = offsets[c] + chunks[c].coefficients.size();
+  }
+  coefficients.resize(offsets[num_chunks]);
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(chunks, coefficients, offsets, num_chunks)
+  for (int c = 0; c < num_chunks; ++c) {
+    std::copy(chunks[c].coefficients.begin(), chunks[c].coefficients.end(),
+              coefficients.begin() + static_cast<long>(offsets[c]));
+  }
+
+  for (auto& chunk : chunks) {
+    for (auto& rhs : chunk.rhs) {
+      b[rhs.col] += rhs.val;
+    }
+  }
+}
+
 void B2BHpwlOptimizer::BuildProblemX() {
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
   std::vector<Block>& blocks = ckt_ptr_->Blocks();
-  std::vector<Net>& nets = ckt_ptr_->Nets();
   size_t coefficients_capacity = coefficients_x_.capacity();
   coefficients_x_.resize(0);
   int sz = static_cast<int>(bx.size());
@@ -127,74 +209,8 @@ void B2BHpwlOptimizer::BuildProblemX() {
       (ckt_ptr_->RegionLLX() + ckt_ptr_->RegionURX()) / 2.0 * center_weight;
   // double decay_length = decay_factor * ckt_ptr_->AveBlkHeight();
 
-  for (auto& net : nets) {
-    if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) continue;
-    double inv_p = net.InvP();
-    net.UpdateMaxMinIdX();
-    int max_pin_index = net.MaxBlkPinIdX();
-    int min_pin_index = net.MinBlkPinIdX();
-
-    int blk_num_max = net.BlockPins()[max_pin_index].BlkId();
-    double pin_loc_max = net.BlockPins()[max_pin_index].AbsX();
-    bool is_movable_max = net.BlockPins()[max_pin_index].BlkPtr()->IsMovable();
-    double offset_max = net.BlockPins()[max_pin_index].OffsetX();
-
-    int blk_num_min = net.BlockPins()[min_pin_index].BlkId();
-    double pin_loc_min = net.BlockPins()[min_pin_index].AbsX();
-    bool is_movable_min = net.BlockPins()[min_pin_index].BlkPtr()->IsMovable();
-    double offset_min = net.BlockPins()[min_pin_index].OffsetX();
-
-    for (auto& pair : net.BlockPins()) {
-      int blk_num = pair.BlkId();
-      double pin_loc = pair.AbsX();
-      bool is_movable = pair.BlkPtr()->IsMovable();
-      double offset = pair.OffsetX();
-
-      if (blk_num != blk_num_max) {
-        double distance = std::fabs(pin_loc - pin_loc_max);
-        double weight = inv_p / (distance + width_epsilon_);
-        // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
-        // decay_length)); weight *= weight_adjust;
-        if (!is_movable && is_movable_max) {
-          bx[blk_num_max] += (pin_loc - offset_max) * weight;
-          coefficients_x_.emplace_back(blk_num_max, blk_num_max, weight);
-        } else if (is_movable && !is_movable_max) {
-          bx[blk_num] += (pin_loc_max - offset) * weight;
-          coefficients_x_.emplace_back(blk_num, blk_num, weight);
-        } else if (is_movable && is_movable_max) {
-          coefficients_x_.emplace_back(blk_num, blk_num, weight);
-          coefficients_x_.emplace_back(blk_num_max, blk_num_max, weight);
-          coefficients_x_.emplace_back(blk_num, blk_num_max, -weight);
-          coefficients_x_.emplace_back(blk_num_max, blk_num, -weight);
-          double offset_diff = (offset_max - offset) * weight;
-          bx[blk_num] += offset_diff;
-          bx[blk_num_max] -= offset_diff;
-        }
-      }
-
-      if ((blk_num != blk_num_max) && (blk_num != blk_num_min)) {
-        double distance = std::fabs(pin_loc - pin_loc_min);
-        double weight = inv_p / (distance + width_epsilon_);
-        // weight_adjust = adjust_factor * (1 - exp(-distance / decay_length));
-        // weight *= weight_adjust;
-        if (!is_movable && is_movable_min) {
-          bx[blk_num_min] += (pin_loc - offset_min) * weight;
-          coefficients_x_.emplace_back(blk_num_min, blk_num_min, weight);
-        } else if (is_movable && !is_movable_min) {
-          bx[blk_num] += (pin_loc_min - offset) * weight;
-          coefficients_x_.emplace_back(blk_num, blk_num, weight);
-        } else if (is_movable && is_movable_min) {
-          coefficients_x_.emplace_back(blk_num, blk_num, weight);
-          coefficients_x_.emplace_back(blk_num_min, blk_num_min, weight);
-          coefficients_x_.emplace_back(blk_num, blk_num_min, -weight);
-          coefficients_x_.emplace_back(blk_num_min, blk_num, -weight);
-          double offset_diff = (offset_min - offset) * weight;
-          bx[blk_num] += offset_diff;
-          bx[blk_num_min] -= offset_diff;
-        }
-      }
-    }
-  }
+  BuildNetModel(net_model_chunks_x_, coefficients_x_, bx,
+                &B2BHpwlOptimizer::AddNetModelX);
 
   for (int i = 0; i < sz; ++i) {
     if (blocks[i].IsFixed()) {
@@ -218,12 +234,85 @@ void B2BHpwlOptimizer::BuildProblemX() {
   tot_triplets_time_x += elapsed_time.GetWallTime();
 }
 
+void B2BHpwlOptimizer::AddNetModelX(Net& net, NetModelChunk& chunk) {
+  if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) return;
+  double inv_p = net.InvP();
+  NetlistView const& netlist = netlist_view_;
+  double const* blk_loc = netlist.BlockX().data();
+  int net_id = net.Id();
+  int begin = netlist.NetPinBegin(net_id);
+  int end = netlist.NetPinEnd(net_id);
+  if (begin == end) return;
+  int max_pin_index = begin + max_pin_x_[net_id];
+  int min_pin_index = begin + min_pin_x_[net_id];
+
+  int blk_num_max = netlist.PinBlkId(max_pin_index);
+  double offset_max = netlist.PinOffsetX(max_pin_index);
+  double pin_loc_max = offset_max + blk_loc[blk_num_max];
+  bool is_movable_max = netlist.IsBlkMovable(blk_num_max);
+
+  int blk_num_min = netlist.PinBlkId(min_pin_index);
+  double offset_min = netlist.PinOffsetX(min_pin_index);
+  double pin_loc_min = offset_min + blk_loc[blk_num_min];
+  bool is_movable_min = netlist.IsBlkMovable(blk_num_min);
+
+  for (int i = begin; i < end; ++i) {
+    int blk_num = netlist.PinBlkId(i);
+    double offset = netlist.PinOffsetX(i);
+    double pin_loc = offset + blk_loc[blk_num];
+    bool is_movable = netlist.IsBlkMovable(blk_num);
+
+    if (blk_num != blk_num_max) {
+      double distance = std::fabs(pin_loc - pin_loc_max);
+      double weight = inv_p / (distance + width_epsilon_);
+      // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
+      // decay_length)); weight *= weight_adjust;
+      if (!is_movable && is_movable_max) {
+        chunk.rhs.emplace_back(blk_num_max, (pin_loc - offset_max) * weight);
+        chunk.coefficients.emplace_back(blk_num_max, blk_num_max, weight);
+      } else if (is_movable && !is_movable_max) {
+        chunk.rhs.emplace_back(blk_num, (pin_loc_max - offset) * weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+      } else if (is_movable && is_movable_max) {
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+        chunk.coefficients.emplace_back(blk_num_max, blk_num_max, weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num_max, -weight);
+        chunk.coefficients.emplace_back(blk_num_max, blk_num, -weight);
+        double offset_diff = (offset_max - offset) * weight;
+        chunk.rhs.emplace_back(blk_num, offset_diff);
+        chunk.rhs.emplace_back(blk_num_max, -offset_diff);
+      }
+    }
+
+    if ((blk_num != blk_num_max) && (blk_num != blk_num_min)) {
+      double distance = std::fabs(pin_loc - pin_loc_min);
+      double weight = inv_p / (distance + width_epsilon_);
+      // weight_adjust = adjust_factor * (1 - exp(-distance / decay_length));
+      // weight *= weight_adjust;
+      if (!is_movable && is_movable_min) {
+        chunk.rhs.emplace_back(blk_num_min, (pin_loc - offset_min) * weight);
+        chunk.coefficients.emplace_back(blk_num_min, blk_num_min, weight);
+      } else if (is_movable && !is_movable_min) {
+        chunk.rhs.emplace_back(blk_num, (pin_loc_min - offset) * weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+      } else if (is_movable && is_movable_min) {
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+        chunk.coefficients.emplace_back(blk_num_min, blk_num_min, weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num_min, -weight);
+        chunk.coefficients.emplace_back(blk_num_min, blk_num, -weight);
+        double offset_diff = (offset_min - offset) * weight;
+        chunk.rhs.emplace_back(blk_num, offset_diff);
+        chunk.rhs.emplace_back(blk_num_min, -offset_diff);
+      }
+    }
+  }
+}
+
 void B2BHpwlOptimizer::BuildProblemY() {
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
   std::vector<Block>& blocks = ckt_ptr_->Blocks();
-  std::vector<Net>& nets = ckt_ptr_->Nets();
   size_t coefficients_capacity = coefficients_y_.capacity();
   coefficients_y_.resize(0);
   int sz = static_cast<int>(by.size());
@@ -236,74 +325,8 @@ void B2BHpwlOptimizer::BuildProblemY() {
       (ckt_ptr_->RegionLLY() + ckt_ptr_->RegionURY()) / 2.0 * center_weight;
   // double decay_length = decay_factor * ckt_ptr_->AveBlkHeight();
 
-  for (auto& net : nets) {
-    if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) continue;
-    double inv_p = net.InvP();
-    net.UpdateMaxMinIdY();
-    int max_pin_index = net.MaxBlkPinIdY();
-    int min_pin_index = net.MinBlkPinIdY();
-
-    int blk_num_max = net.BlockPins()[max_pin_index].BlkId();
-    double pin_loc_max = net.BlockPins()[max_pin_index].AbsY();
-    bool is_movable_max = net.BlockPins()[max_pin_index].BlkPtr()->IsMovable();
-    double offset_max = net.BlockPins()[max_pin_index].OffsetY();
-
-    int blk_num_min = net.BlockPins()[min_pin_index].BlkId();
-    double pin_loc_min = net.BlockPins()[min_pin_index].AbsY();
-    bool is_movable_min = net.BlockPins()[min_pin_index].BlkPtr()->IsMovable();
-    double offset_min = net.BlockPins()[min_pin_index].OffsetY();
-
-    for (auto& pair : net.BlockPins()) {
-      int blk_num = pair.BlkId();
-      double pin_loc = pair.AbsY();
-      bool is_movable = pair.BlkPtr()->IsMovable();
-      double offset = pair.OffsetY();
-
-      if (blk_num != blk_num_max) {
-        double distance = std::fabs(pin_loc - pin_loc_max);
-        double weight = inv_p / (distance + height_epsilon_);
-        // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
-        // decay_length)); weight *= weight_adjust;
-        if (!is_movable && is_movable_max) {
-          by[blk_num_max] += (pin_loc - offset_max) * weight;
-          coefficients_y_.emplace_back(blk_num_max, blk_num_max, weight);
-        } else if (is_movable && !is_movable_max) {
-          by[blk_num] += (pin_loc_max - offset) * weight;
-          coefficients_y_.emplace_back(blk_num, blk_num, weight);
-        } else if (is_movable && is_movable_max) {
-          coefficients_y_.emplace_back(blk_num, blk_num, weight);
-          coefficients_y_.emplace_back(blk_num_max, blk_num_max, weight);
-          coefficients_y_.emplace_back(blk_num, blk_num_max, -weight);
-          coefficients_y_.emplace_back(blk_num_max, blk_num, -weight);
-          double offset_diff = (offset_max - offset) * weight;
-          by[blk_num] += offset_diff;
-          by[blk_num_max] -= offset_diff;
-        }
-      }
-
-      if ((blk_num != blk_num_max) && (blk_num != blk_num_min)) {
-        double distance = std::fabs(pin_loc - pin_loc_min);
-        double weight = inv_p / (distance + height_epsilon_);
-        // weight_adjust = adjust_factor * (1 - exp(-distance / decay_length));
-        // weight *= weight_adjust;
-        if (!is_movable && is_movable_min) {
-          by[blk_num_min] += (pin_loc - offset_min) * weight;
-          coefficients_y_.emplace_back(blk_num_min, blk_num_min, weight);
-        } else if (is_movable && !is_movable_min) {
-          by[blk_num] += (pin_loc_min - offset) * weight;
-          coefficients_y_.emplace_back(blk_num, blk_num, weight);
-        } else if (is_movable && is_movable_min) {
-          coefficients_y_.emplace_back(blk_num, blk_num, weight);
-          coefficients_y_.emplace_back(blk_num_min, blk_num_min, weight);
-          coefficients_y_.emplace_back(blk_num, blk_num_min, -weight);
-          coefficients_y_.emplace_back(blk_num_min, blk_num, -weight);
-          double offset_diff = (offset_min - offset) * weight;
-          by[blk_num] += offset_diff;
-          by[blk_num_min] -= offset_diff;
-        }
-      }
-    }
-  }
+  BuildNetModel(net_model_chunks_y_, coefficients_y_, by,
+                &B2BHpwlOptimizer::AddNetModelY);
   // add the diagonal non-zero element for fixed blocks
   for (int i = 0; i < sz; ++i) {
     if (blocks[i].IsFixed()) {
@@ -327,6 +350,80 @@ void B2BHpwlOptimizer::BuildProblemY() {
   tot_triplets_time_y += elapsed_time.GetWallTime();
 }
 
+void B2BHpwlOptimizer::AddNetModelY(Net& net, NetModelChunk& chunk) {
+  if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) return;
+  double inv_p = net.InvP();
+  NetlistView const& netlist = netlist_view_;
+  double const* blk_loc = netlist.BlockY().data();
+  int net_id = net.Id();
+  int begin = netlist.NetPinBegin(net_id);
+  int end = netlist.NetPinEnd(net_id);
+  if (begin == end) return;
+  int max_pin_index = begin + max_pin_y_[net_id];
+  int min_pin_index = begin + min_pin_y_[net_id];
+
+  int blk_num_max = netlist.PinBlkId(max_pin_index);
+  double offset_max = netlist.PinOffsetY(max_pin_index);
+  double pin_loc_max = offset_max + blk_loc[blk_num_max];
+  bool is_movable_max = netlist.IsBlkMovable(blk_num_max);
+
+  int blk_num_min = netlist.PinBlkId(min_pin_index);
+  double offset_min = netlist.PinOffsetY(min_pin_index);
+  double pin_loc_min = offset_min + blk_loc[blk_num_min];
+  bool is_movable_min = netlist.IsBlkMovable(blk_num_min);
+
+  for (int i = begin; i < end; ++i) {
+    int blk_num = netlist.PinBlkId(i);
+    double offset = netlist.PinOffsetY(i);
+    double pin_loc = offset + blk_loc[blk_num];
+    bool is_movable = netlist.IsBlkMovable(blk_num);
+
+    if (blk_num != blk_num_max) {
+      double distance = std::fabs(pin_loc - pin_loc_max);
+      double weight = inv_p / (distance + height_epsilon_);
+      // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
+      // decay_length)); weight *= weight_adjust;
+      if (!is_movable && is_movable_max) {
+        chunk.rhs.emplace_back(blk_num_max, (pin_loc - offset_max) * weight);
+        chunk.coefficients.emplace_back(blk_num_max, blk_num_max, weight);
+      } else if (is_movable && !is_movable_max) {
+        chunk.rhs.emplace_back(blk_num, (pin_loc_max - offset) * weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+      } else if (is_movable && is_movable_max) {
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+        chunk.coefficients.emplace_back(blk_num_max, blk_num_max, weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num_max, -weight);
+        chunk.coefficients.emplace_back(blk_num_max, blk_num, -weight);
+        double offset_diff = (offset_max - offset) * weight;
+        chunk.rhs.emplace_back(blk_num, offset_diff);
+        chunk.rhs.emplace_back(blk_num_max, -offset_diff);
+      }
+    }
+
+    if ((blk_num != blk_num_max) && (blk_num != blk_num_min)) {
+      double distance = std::fabs(pin_loc - pin_loc_min);
+      double weight = inv_p / (distance + height_epsilon_);
+      // weight_adjust = adjust_factor * (1 - exp(-distance / decay_length));
+      // weight *= weight_adjust;
+      if (!is_movable && is_movable_min) {
+        chunk.rhs.emplace_back(blk_num_min, (pin_loc - offset_min) * weight);
+        chunk.coefficients.emplace_back(blk_num_min, blk_num_min, weight);
+      } else if (is_movable && !is_movable_min) {
+        chunk.rhs.emplace_back(blk_num, (pin_loc_min - offset) * weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+      } else if (is_movable && is_movable_min) {
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+        chunk.coefficients.emplace_back(blk_num_min, blk_num_min, weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num_min, -weight);
+        chunk.coefficients.emplace_back(blk_num_min, blk_num, -weight);
+        double offset_diff = (offset_min - offset) * weight;
+        chunk.rhs.emplace_back(blk_num, offset_diff);
+        chunk.rhs.emplace_back(blk_num_min, -offset_diff);
+      }
+    }
+  }
+}
+
 bool B2BHpwlOptimizer::IsSeriesConverged(std::vector<double>& data,
                                          int window_size, double tolerance) {
   int sz = (int)data.size();
@@ -394,20 +491,19 @@ double B2BHpwlOptimizer::OptimizeQuadraticMetricX(double cg_stop_criterion) {
   elapsed_time.RecordEndTime();
   tot_matrix_from_triplets_x += elapsed_time.GetWallTime();
 
-  int sz = static_cast<int>(vx.size());
-  std::vector<Block>& blocks = ckt_ptr_->Blocks();
-
   elapsed_time.RecordStartTime();
   std::vector<double> eval_history;
   int max_rounds = cg_iteration_max_num_ / cg_iteration_;
-  cg_x_.compute(Ax);  // Ax * vx = bx
+  cg_x_->SetNumThreads(num_threads_);
+  hpwl_evaluator_x_.SetNumThreads(num_threads_);
+  cg_x_->Compute(Ax);  // Ax * vx = bx
+  DaliWarns(!cg_x_->IsComputeSuccessful(),
+            "Preconditioner setup failed for the x system");
+  int cg_iterations = 0;
   for (int i = 0; i < max_rounds; ++i) {
-    vx = cg_x_.solveWithGuess(bx, vx);
-    // #pragma omp for
-    for (int num = 0; num < sz; ++num) {
-      blocks[num].SetLLX(vx[num]);
-    }
-    double evaluate_result = ckt_ptr_->WeightedHPWLX();
+    cg_x_->SolveWithGuess(bx, vx);
+    cg_iterations += cg_x_->Iterations();
+    double evaluate_result = hpwl_evaluator_x_.Evaluate(vx);
     eval_history.push_back(evaluate_result);
     if (evaluate_result < hpwl_early_stop_threshold_) {
       break;
@@ -427,15 +523,14 @@ double B2BHpwlOptimizer::OptimizeQuadraticMetricX(double cg_stop_criterion) {
     }
   }
   LOG(trace) << "      Metric optimization in X, sequence: " << eval_history
-             << "\n";
+             << ", CG iterations: " << cg_iterations << "\n";
+  tot_cg_iterations_x += cg_iterations;
+  ++tot_cg_solves_x;
   elapsed_time.RecordEndTime();
   tot_cg_solver_time_x += elapsed_time.GetWallTime();
 
   elapsed_time.RecordStartTime();
-  // #pragma omp for
-  for (int num = 0; num < sz; ++num) {
-    blocks[num].SetLLX(vx[num]);
-  }
+  UpdateBlockLocationX();
   elapsed_time.RecordEndTime();
   tot_loc_update_time_x += elapsed_time.GetWallTime();
 
@@ -452,20 +547,19 @@ double B2BHpwlOptimizer::OptimizeQuadraticMetricY(double cg_stop_criterion) {
   elapsed_time.RecordEndTime();
   tot_matrix_from_triplets_y += elapsed_time.GetWallTime();
 
-  int sz = static_cast<int>(vy.size());
-  std::vector<Block>& block_list = ckt_ptr_->Blocks();
-
   elapsed_time.RecordStartTime();
   std::vector<double> eval_history;
   int max_rounds = cg_iteration_max_num_ / cg_iteration_;
-  cg_y_.compute(Ay);
+  cg_y_->SetNumThreads(num_threads_);
+  hpwl_evaluator_y_.SetNumThreads(num_threads_);
+  cg_y_->Compute(Ay);
+  DaliWarns(!cg_y_->IsComputeSuccessful(),
+            "Preconditioner setup failed for the y system");
+  int cg_iterations = 0;
   for (int i = 0; i < max_rounds; ++i) {
-    vy = cg_y_.solveWithGuess(by, vy);
-    // #pragma omp for
-    for (int num = 0; num < sz; ++num) {
-      block_list[num].SetLLY(vy[num]);
-    }
-    double evaluate_result = ckt_ptr_->WeightedHPWLY();
+    cg_y_->SolveWithGuess(by, vy);
+    cg_iterations += cg_y_->Iterations();
+    double evaluate_result = hpwl_evaluator_y_.Evaluate(vy);
     eval_history.push_back(evaluate_result);
     if (evaluate_result < hpwl_early_stop_threshold_) {
       break;
@@ -485,15 +579,14 @@ double B2BHpwlOptimizer::OptimizeQuadraticMetricY(double cg_stop_criterion) {
     }
   }
   LOG(trace) << "      Metric optimization in Y, sequence: " << eval_history
-             << "\n";
+             << ", CG iterations: " << cg_iterations << "\n";
+  tot_cg_iterations_y += cg_iterations;
+  ++tot_cg_solves_y;
   elapsed_time.RecordEndTime();
   tot_cg_solver_time_y += elapsed_time.GetWallTime();
 
   elapsed_time.RecordStartTime();
-  // #pragma omp for
-  for (int num = 0; num < sz; ++num) {
-    block_list[num].SetLLY(vy[num]);
-  }
+  UpdateBlockLocationY();
   elapsed_time.RecordEndTime();
   tot_loc_update_time_y += elapsed_time.GetWallTime();
 
@@ -575,21 +668,47 @@ void B2BHpwlOptimizer::UpdateAnchorAlpha() {
   alpha += alpha_step;
 }
 
+/****
+ * @brief Copy block locations into the netlist view, and find the pins of
+ * each net with the maximum and minimum location with the batched kernels.
+ * Net models read both.
+ */
 void B2BHpwlOptimizer::UpdateMaxMinX() {
-  std::vector<Net>& net_list = ckt_ptr_->Nets();
-  size_t sz = net_list.size();
-  // #pragma omp parallel for
-  for (size_t i = 0; i < sz; ++i) {
-    net_list[i].UpdateMaxMinIdX();
-  }
+  netlist_view_.UpdateBlockLocationsX(ckt_ptr_->Blocks(), num_threads_);
+  netlist_view_.ComputePinLocations(true, netlist_view_.BlockX().data(),
+                                    pin_loc_x_, num_threads_);
+  netlist_view_.FindMaxMinPins(pin_loc_x_, max_pin_x_, min_pin_x_,
+                               num_threads_);
 }
 
 void B2BHpwlOptimizer::UpdateMaxMinY() {
-  std::vector<Net>& net_list = ckt_ptr_->Nets();
-  size_t sz = net_list.size();
-  // #pragma omp parallel for
-  for (size_t i = 0; i < sz; ++i) {
-    net_list[i].UpdateMaxMinIdY();
+  netlist_view_.UpdateBlockLocationsY(ckt_ptr_->Blocks(), num_threads_);
+  netlist_view_.ComputePinLocations(false, netlist_view_.BlockY().data(),
+                                    pin_loc_y_, num_threads_);
+  netlist_view_.FindMaxMinPins(pin_loc_y_, max_pin_y_, min_pin_y_,
+                               num_threads_);
+}
+
+/****
+ * @brief Copy vx to the lower left x of blocks.
+ */
+void B2BHpwlOptimizer::UpdateBlockLocationX() {
+  std::vector<Block>& blocks = ckt_ptr_->Blocks();
+  int sz = static_cast<int>(vx.size());
+#pragma omp parallel for num_threads(num_threads_) default(none) \
+    shared(blocks, sz)
+  for (int i = 0; i < sz; ++i) {
+    blocks[i].SetLLX(vx[i]);
+  }
+}
+
+void B2BHpwlOptimizer::UpdateBlockLocationY() {
+  std::vector<Block>& blocks = ckt_ptr_->Blocks();
+  int sz = static_cast<int>(vy.size());
+#pragma omp parallel for num_threads(num_threads_) default(none) \
+    shared(blocks, sz)
+  for (int i = 0; i < sz; ++i) {
+    blocks[i].SetLLY(vy[i]);
   }
 }
 
@@ -751,12 +870,9 @@ void B2BHpwlOptimizer::OptimizeHpwlYWithAnchor(int num_threads) {
 
 double B2BHpwlOptimizer::OptimizeHpwl() {
   omp_set_dynamic(0);
-  int avail_threads_num = num_threads_ / 2;
-  if (avail_threads_num == 0) {
-    avail_threads_num = 1;
-  }
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
+  long cg_iterations = tot_cg_iterations_x + tot_cg_iterations_y;
 
   UpdateAnchorLocation();
   UpdateAnchorAlpha();
@@ -764,18 +880,14 @@ double B2BHpwlOptimizer::OptimizeHpwl() {
   LOG(trace) << "alpha: " << alpha << "\n";
   LOG(trace) << "OpenMP threads, " << num_threads_ << "\n";
 
-#pragma omp parallel num_threads(std::min(num_threads_, 2)) default(none) \
-    shared(avail_threads_num)
-  {
-    if (omp_get_thread_num() == 0) {
-      OptimizeHpwlXWithAnchor(avail_threads_num);
-    }
-    if (omp_get_thread_num() == 1 || omp_get_num_threads() == 1) {
-      OptimizeHpwlYWithAnchor(avail_threads_num);
-    }
-  }
+  // x and y are optimized one after the other, each with all threads
+  OptimizeHpwlXWithAnchor(num_threads_);
+  OptimizeHpwlYWithAnchor(num_threads_);
 
   PullBlockBackToRegion();
+  cg_iterations = tot_cg_iterations_x + tot_cg_iterations_y - cg_iterations;
+  AppendPlacementSeries("global_placement.cg_iterations",
+                        static_cast<double>(cg_iterations));
 
   LOG(trace) << "Quadratic Placement With Anchor Complete\n";
 
@@ -805,6 +917,9 @@ void B2BHpwlOptimizer::Close() {
   LOG(debug) << "total cg solver time: " << tot_cg_solver_time_x << "s, "
              << tot_cg_solver_time_y << "s, "
              << tot_cg_solver_time_x + tot_cg_solver_time_y << "s\n";
+  LOG(debug) << "total cg iterations: " << tot_cg_iterations_x << ", "
+             << tot_cg_iterations_y << ", solves: " << tot_cg_solves_x << ", "
+             << tot_cg_solves_y << "\n";
   LOG(debug) << "total loc update time: " << tot_loc_update_time_x << "s, "
              << tot_loc_update_time_y << "s, "
              << tot_loc_update_time_x + tot_loc_update_time_y << "s\n";
@@ -814,331 +929,279 @@ void B2BHpwlOptimizer::Close() {
                       tot_cg_solver_time_y + tot_loc_update_time_y;
   LOG(debug) << "total x/y time: " << tot_time_x << "s, " << tot_time_y << "s, "
              << tot_time_x + tot_time_y << "s\n";
-}
 
-void StarHpwlOptimizer::BuildProblemX() {
-  ElapsedTime elapsed_time;
-  elapsed_time.RecordStartTime();
+  // sub-stages of the x and y solves are timed by these totals instead of
+  // nested placement timers
+  RecordPlacementTime("hpwl_optimization.build_problem_x", tot_triplets_time_x,
+                      tot_cg_solves_x);
+  RecordPlacementTime("hpwl_optimization.build_problem_y", tot_triplets_time_y,
+                      tot_cg_solves_y);
+  RecordPlacementTime("hpwl_optimization.assemble_matrix_x",
+                      tot_matrix_from_triplets_x, tot_cg_solves_x);
+  RecordPlacementTime("hpwl_optimization.assemble_matrix_y",
+                      tot_matrix_from_triplets_y, tot_cg_solves_y);
+  RecordPlacementTime("hpwl_optimization.cg_solve_x", tot_cg_solver_time_x,
+                      tot_cg_solves_x);
+  RecordPlacementTime("hpwl_optimization.cg_solve_y", tot_cg_solver_time_y,
+                      tot_cg_solves_y);
+  RecordPlacementTime("hpwl_optimization.update_location_x",
+                      tot_loc_update_time_x, tot_cg_solves_x);
+  RecordPlacementTime("hpwl_optimization.update_location_y",
+                      tot_loc_update_time_y, tot_cg_solves_y);
+
+  // totals above are reported already, samples will not skew them
+  if (should_report_strong_scaling_) {
+    ReportStrongScaling();
+  }
+}
 
+/****
+ * @brief Time one net model update and quadratic metric optimization of both
+ * x and y with 1, 2, 4, ..., 32 threads, and print the speedup over one
+ * thread. Every sample starts from the current placement, and the placement
+ * is restored afterward. Thread counts beyond the number of processors are
+ * skipped.
+ */
+void B2BHpwlOptimizer::ReportStrongScaling() {
   std::vector<Block>& blocks = ckt_ptr_->Blocks();
-  std::vector<Net>& nets = ckt_ptr_->Nets();
-  size_t coefficients_capacity = coefficients_x_.capacity();
-  coefficients_x_.resize(0);
-
-  int sz = static_cast<int>(bx.size());
+  int sz = static_cast<int>(blocks.size());
+  std::vector<double> llx(sz), lly(sz);
   for (int i = 0; i < sz; ++i) {
-    bx[i] = 0;
+    llx[i] = blocks[i].LLX();
+    lly[i] = blocks[i].LLY();
   }
+  int saved_num_threads = num_threads_;
 
-  double center_weight = 0.03 / std::sqrt(sz);
-  double weight_center_x =
-      (ckt_ptr_->RegionLLX() + ckt_ptr_->RegionURX()) / 2.0 * center_weight;
-  // double decay_length = decay_factor * ckt_ptr_->AveBlkHeight();
-
-  for (auto& net : nets) {
-    if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) continue;
-    double inv_p = net.InvP();
-
-    // assuming the 0-th pin in the net is the driver pin
-    int driver_blk_num = net.BlockPins()[0].BlkId();
-    double driver_pin_loc = net.BlockPins()[0].AbsX();
-    bool driver_is_movable = net.BlockPins()[0].BlkPtr()->IsMovable();
-    double driver_offset = net.BlockPins()[0].OffsetX();
-
-    for (auto& pair : net.BlockPins()) {
-      int blk_num = pair.BlkId();
-      double pin_loc = pair.AbsX();
-      bool is_movable = pair.BlkPtr()->IsMovable();
-
-      if (blk_num != driver_blk_num) {
-        double distance = std::fabs(pin_loc - driver_pin_loc);
-        // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
-        // decay_length)); weight = inv_p / (distance + width_epsilon_) *
-        // weight_adjust;
-        double weight = inv_p / (distance + width_epsilon_);
-        if (!is_movable && driver_is_movable) {
-          bx[0] += (pin_loc - driver_offset) * weight;
-          coefficients_x_.emplace_back(driver_blk_num, driver_blk_num, weight);
-        } else if (is_movable && !driver_is_movable) {
-          bx[blk_num] += (driver_pin_loc - driver_offset) * weight;
-          coefficients_x_.emplace_back(blk_num, blk_num, weight);
-        } else if (is_movable && driver_is_movable) {
-          coefficients_x_.emplace_back(blk_num, blk_num, weight);
-          coefficients_x_.emplace_back(driver_blk_num, driver_blk_num, weight);
-          coefficients_x_.emplace_back(blk_num, driver_blk_num, -weight);
-          coefficients_x_.emplace_back(driver_blk_num, blk_num, -weight);
-          double offset_diff = (driver_offset - pair.OffsetX()) * weight;
-          bx[blk_num] += offset_diff;
-          bx[driver_blk_num] -= offset_diff;
-        }
-      }
+  std::vector<int> thread_counts;
+  std::vector<double> wall_times;
+  int max_threads = omp_get_num_procs();
+  for (int num_threads = 1; num_threads <= 32; num_threads *= 2) {
+    if (num_threads > max_threads) break;
+    for (int i = 0; i < sz; ++i) {
+      blocks[i].SetLoc(llx[i], lly[i]);
+      vx[i] = llx[i];
+      vy[i] = lly[i];
     }
+    num_threads_ = num_threads;
+    ElapsedTime elapsed_time;
+    elapsed_time.RecordStartTime();
+    BuildProblemWithAnchorX();
+    OptimizeQuadraticMetricX(cg_stop_criterion_);
+    BuildProblemWithAnchorY();
+    OptimizeQuadraticMetricY(cg_stop_criterion_);
+    elapsed_time.RecordEndTime();
+    thread_counts.push_back(num_threads);
+    wall_times.push_back(elapsed_time.GetWallTime());
   }
 
   for (int i = 0; i < sz; ++i) {
-    if (blocks[i].IsFixed()) {
-      coefficients_x_.emplace_back(i, i, 1);
-      bx[i] = blocks[i].LLX();
-    } else {
-      if (blocks[i].LLX() < ckt_ptr_->RegionLLX() ||
-          blocks[i].URX() > ckt_ptr_->RegionURX()) {
-        coefficients_x_.emplace_back(i, i, center_weight);
-        bx[i] += weight_center_x;
-      }
-    }
+    blocks[i].SetLoc(llx[i], lly[i]);
+    vx[i] = llx[i];
+    vy[i] = lly[i];
   }
-
-  DaliWarns(coefficients_capacity != coefficients_x_.capacity(),
-            "WARNING: x coefficients capacity changed!\n"
-                << "\told capacity: " << coefficients_capacity << "\n"
-                << "\tnew capacity: " << coefficients_x_.size());
-
-  elapsed_time.RecordEndTime();
-  tot_triplets_time_x += elapsed_time.GetWallTime();
-}
-
-void StarHpwlOptimizer::BuildProblemY() {
-  ElapsedTime elapsed_time;
-  elapsed_time.RecordStartTime();
-
-  std::vector<Block>& blocks = ckt_ptr_->Blocks();
-  std::vector<Net>& nets = ckt_ptr_->Nets();
-  size_t coefficients_capacity = coefficients_y_.capacity();
-  coefficients_y_.resize(0);
-
-  int sz = static_cast<int>(by.size());
-  for (int i = 0; i < sz; ++i) {
-    by[i] = 0;
+  num_threads_ = saved_num_threads;
+
+  LOG(info) << "Strong scaling of x/y quadratic placement, "
+            << "threads, time, speedup, efficiency:\n";
+  size_t buffer_size = 1024;
+  for (size_t i = 0; i < thread_counts.size(); ++i) {
+    double speedup = wall_times[0] / wall_times[i];
+    std::string buffer(buffer_size, '\0');
+    int written_length = snprintf(
+        &buffer[0], buffer_size, "  %3d  %.4fs  %6.2fx  %5.1f%%\n",
+        thread_counts[i], wall_times[i], speedup,
+        100 * speedup / thread_counts[i]);
+    buffer.resize(written_length);
+    LOG(info) << buffer;
   }
-
-  double center_weight = 0.03 / std::sqrt(sz);
-  double weight_center_y =
-      (ckt_ptr_->RegionLLY() + ckt_ptr_->RegionURY()) / 2.0 * center_weight;
-  // double decay_length = decay_factor * ckt_ptr_->AveBlkHeight();
-
-  for (auto& net : nets) {
-    if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) continue;
-    double inv_p = net.InvP();
-
-    // assuming the 0-th pin in the net is the driver pin
-    int driver_blk_num = net.BlockPins()[0].BlkId();
-    double driver_pin_loc = net.BlockPins()[0].AbsY();
-    bool driver_is_movable = net.BlockPins()[0].BlkPtr()->IsMovable();
-    double driver_offset = net.BlockPins()[0].OffsetY();
-
-    for (auto& pair : net.BlockPins()) {
-      int blk_num = pair.BlkId();
-      double pin_loc = pair.AbsY();
-      bool is_movable = pair.BlkPtr()->IsMovable();
-
-      if (blk_num != driver_blk_num) {
-        double distance = std::fabs(pin_loc - driver_pin_loc);
-        // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
-        // decay_length)); weight = inv_p / (distance + height_epsilon_) *
-        // weight_adjust;
-        double weight = inv_p / (distance + height_epsilon_);
-        if (!is_movable && driver_is_movable) {
-          by[0] += (pin_loc - driver_offset) * weight;
-          coefficients_y_.emplace_back(driver_blk_num, driver_blk_num, weight);
-        } else if (is_movable && !driver_is_movable) {
-          by[blk_num] += (driver_pin_loc - driver_offset) * weight;
-          coefficients_y_.emplace_back(blk_num, blk_num, weight);
-        } else if (is_movable && driver_is_movable) {
-          coefficients_y_.emplace_back(blk_num, blk_num, weight);
-          coefficients_y_.emplace_back(driver_blk_num, driver_blk_num, weight);
-          coefficients_y_.emplace_back(blk_num, driver_blk_num, -weight);
-          coefficients_y_.emplace_back(driver_blk_num, blk_num, -weight);
-          double offset_diff = (driver_offset - pair.OffsetY()) * weight;
-          by[blk_num] += offset_diff;
-          by[driver_blk_num] -= offset_diff;
-        }
-      }
-    }
+  if (max_threads < 32) {
+    LOG(info) << "  thread counts above " << max_threads
+              << " processors are skipped\n";
   }
+}
 
-  // add the diagonal non-zero element for fixed blocks
-  for (int i = 0; i < sz; ++i) {
-    if (blocks[i].IsFixed()) {
-      coefficients_y_.emplace_back(i, i, 1);
-      by[i] = blocks[i].LLY();
-    } else {
-      if (blocks[i].LLY() < ckt_ptr_->RegionLLY() ||
-          blocks[i].URY() > ckt_ptr_->RegionURY()) {
-        coefficients_y_.emplace_back(i, i, center_weight);
-        by[i] += weight_center_y;
+void StarHpwlOptimizer::AddNetModelX(Net& net, NetModelChunk& chunk) {
+  if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) return;
+  double inv_p = net.InvP();
+  NetlistView const& netlist = netlist_view_;
+  double const* blk_loc = netlist.BlockX().data();
+  int begin = netlist.NetPinBegin(net.Id());
+  int end = netlist.NetPinEnd(net.Id());
+  if (begin == end) return;
+
+  // assuming the 0-th pin in the net is the driver pin
+  int driver_blk_num = netlist.PinBlkId(begin);
+  double driver_offset = netlist.PinOffsetX(begin);
+  double driver_pin_loc = driver_offset + blk_loc[driver_blk_num];
+  bool driver_is_movable = netlist.IsBlkMovable(driver_blk_num);
+
+  for (int i = begin; i < end; ++i) {
+    int blk_num = netlist.PinBlkId(i);
+    double offset = netlist.PinOffsetX(i);
+    double pin_loc = offset + blk_loc[blk_num];
+    bool is_movable = netlist.IsBlkMovable(blk_num);
+
+    if (blk_num != driver_blk_num) {
+      double distance = std::fabs(pin_loc - driver_pin_loc);
+      // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
+      // decay_length)); weight = inv_p / (distance + width_epsilon_) *
+      // weight_adjust;
+      double weight = inv_p / (distance + width_epsilon_);
+      if (!is_movable && driver_is_movable) {
+        chunk.rhs.emplace_back(0, (pin_loc - driver_offset) * weight);
+        chunk.coefficients.emplace_back(driver_blk_num, driver_blk_num, weight);
+      } else if (is_movable && !driver_is_movable) {
+        chunk.rhs.emplace_back(blk_num,
+                               (driver_pin_loc - driver_offset) * weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+      } else if (is_movable && driver_is_movable) {
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+        chunk.coefficients.emplace_back(driver_blk_num, driver_blk_num, weight);
+        chunk.coefficients.emplace_back(blk_num, driver_blk_num, -weight);
+        chunk.coefficients.emplace_back(driver_blk_num, blk_num, -weight);
+        double offset_diff = (driver_offset - offset) * weight;
+        chunk.rhs.emplace_back(blk_num, offset_diff);
+        chunk.rhs.emplace_back(driver_blk_num, -offset_diff);
       }
     }
   }
-
-  DaliWarns(coefficients_capacity != coefficients_y_.capacity(),
-            "WARNING: y coefficients capacity changed!\n"
-                << "\told capacity: " << coefficients_capacity << "\n"
-                << "\tnew capacity: " << coefficients_y_.size());
-
-  elapsed_time.RecordEndTime();
-  tot_triplets_time_y += elapsed_time.GetWallTime();
 }
 
-void StarHpwlOptimizer::UpdateAnchorAlpha() { alpha = 0.002 * cur_iter_; }
-
-void HpwlHpwlOptimizer::BuildProblemX() {
-  ElapsedTime elapsed_time;
-  elapsed_time.RecordStartTime();
-
-  std::vector<Block>& blocks = ckt_ptr_->Blocks();
-  std::vector<Net>& nets = ckt_ptr_->Nets();
-  size_t coefficients_capacity = coefficients_x_.capacity();
-  coefficients_x_.resize(0);
-
-  int sz = static_cast<int>(bx.size());
-  for (int i = 0; i < sz; ++i) {
-    bx[i] = 0;
-  }
-
-  double center_weight = 0.03 / std::sqrt(sz);
-  double weight_center_x =
-      (ckt_ptr_->RegionLLX() + ckt_ptr_->RegionURX()) / 2.0 * center_weight;
-  // double decay_length = decay_factor * ckt_ptr_->AveBlkHeight();
-
-  for (auto& net : nets) {
-    if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) continue;
-    double inv_p = net.InvP();
-    net.UpdateMaxMinIdX();
-    int max_pin_index = net.MaxBlkPinIdX();
-    int min_pin_index = net.MinBlkPinIdX();
-
-    int blk_num_max = net.BlockPins()[max_pin_index].BlkId();
-    double pin_loc_max = net.BlockPins()[max_pin_index].AbsX();
-    bool is_movable_max = net.BlockPins()[max_pin_index].BlkPtr()->IsMovable();
-    double offset_max = net.BlockPins()[max_pin_index].OffsetX();
-
-    int blk_num_min = net.BlockPins()[min_pin_index].BlkId();
-    double pin_loc_min = net.BlockPins()[min_pin_index].AbsX();
-    bool is_movable_min = net.BlockPins()[min_pin_index].BlkPtr()->IsMovable();
-    double offset_min = net.BlockPins()[min_pin_index].OffsetX();
-
-    double distance = std::fabs(pin_loc_min - pin_loc_max);
-    // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
-    // decay_length)); weight = inv_p / (distance + width_epsilon_) *
-    // weight_adjust;
-    double weight = inv_p / (distance + width_epsilon_);
-    if (!is_movable_min && is_movable_max) {
-      bx[blk_num_max] += (pin_loc_min - offset_max) * weight;
-      coefficients_x_.emplace_back(blk_num_max, blk_num_max, weight);
-    } else if (is_movable_min && !is_movable_max) {
-      bx[blk_num_min] += (pin_loc_max - offset_min) * weight;
-      coefficients_x_.emplace_back(blk_num_min, blk_num_min, weight);
-    } else if (is_movable_min && is_movable_max) {
-      coefficients_x_.emplace_back(blk_num_min, blk_num_min, weight);
-      coefficients_x_.emplace_back(blk_num_max, blk_num_max, weight);
-      coefficients_x_.emplace_back(blk_num_min, blk_num_max, -weight);
-      coefficients_x_.emplace_back(blk_num_max, blk_num_min, -weight);
-      double offset_diff = (offset_max - offset_min) * weight;
-      bx[blk_num_min] += offset_diff;
-      bx[blk_num_max] -= offset_diff;
-    }
-  }
-
-  for (int i = 0; i < sz; ++i) {
-    if (blocks[i].IsFixed()) {
-      coefficients_x_.emplace_back(i, i, 1);
-      bx[i] = blocks[i].LLX();
-    } else {
-      if (blocks[i].LLX() < ckt_ptr_->RegionLLX() ||
-          blocks[i].URX() > ckt_ptr_->RegionURX()) {
-        coefficients_x_.emplace_back(i, i, center_weight);
-        bx[i] += weight_center_x;
+void StarHpwlOptimizer::AddNetModelY(Net& net, NetModelChunk& chunk) {
+  if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) return;
+  double inv_p = net.InvP();
+  NetlistView const& netlist = netlist_view_;
+  double const* blk_loc = netlist.BlockY().data();
+  int begin = netlist.NetPinBegin(net.Id());
+  int end = netlist.NetPinEnd(net.Id());
+  if (begin == end) return;
+
+  // assuming the 0-th pin in the net is the driver pin
+  int driver_blk_num = netlist.PinBlkId(begin);
+  double driver_offset = netlist.PinOffsetY(begin);
+  double driver_pin_loc = driver_offset + blk_loc[driver_blk_num];
+  bool driver_is_movable = netlist.IsBlkMovable(driver_blk_num);
+
+  for (int i = begin; i < end; ++i) {
+    int blk_num = netlist.PinBlkId(i);
+    double offset = netlist.PinOffsetY(i);
+    double pin_loc = offset + blk_loc[blk_num];
+    bool is_movable = netlist.IsBlkMovable(blk_num);
+
+    if (blk_num != driver_blk_num) {
+      double distance = std::fabs(pin_loc - driver_pin_loc);
+      // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
+      // decay_length)); weight = inv_p / (distance + height_epsilon_) *
+      // weight_adjust;
+      double weight = inv_p / (distance + height_epsilon_);
+      if (!is_movable && driver_is_movable) {
+        chunk.rhs.emplace_back(0, (pin_loc - driver_offset) * weight);
+        chunk.coefficients.emplace_back(driver_blk_num, driver_blk_num, weight);
+      } else if (is_movable && !driver_is_movable) {
+        chunk.rhs.emplace_back(blk_num,
+                               (driver_pin_loc - driver_offset) * weight);
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+      } else if (is_movable && driver_is_movable) {
+        chunk.coefficients.emplace_back(blk_num, blk_num, weight);
+        chunk.coefficients.emplace_back(driver_blk_num, driver_blk_num, weight);
+        chunk.coefficients.emplace_back(blk_num, driver_blk_num, -weight);
+        chunk.coefficients.emplace_back(driver_blk_num, blk_num, -weight);
+        double offset_diff = (driver_offset - offset) * weight;
+        chunk.rhs.emplace_back(blk_num, offset_diff);
+        chunk.rhs.emplace_back(driver_blk_num, -offset_diff);
       }
     }
   }
-
-  DaliWarns(coefficients_capacity != coefficients_x_.capacity(),
-            "WARNING: x coefficients capacity changed!\n"
-                << "\told capacity: " << coefficients_capacity << "\n"
-                << "\tnew capacity: " << coefficients_x_.size());
-
-  elapsed_time.RecordEndTime();
-  tot_triplets_time_x += elapsed_time.GetWallTime();
 }
 
-void HpwlHpwlOptimizer::BuildProblemY() {
-  ElapsedTime elapsed_time;
-  elapsed_time.RecordStartTime();
-
-  std::vector<Block>& blocks = ckt_ptr_->Blocks();
-  std::vector<Net>& nets = ckt_ptr_->Nets();
-  size_t coefficients_capacity = coefficients_y_.capacity();
-  coefficients_y_.resize(0);
+void StarHpwlOptimizer::UpdateAnchorAlpha() { alpha = 0.002 * cur_iter_; }
 
-  int sz = static_cast<int>(by.size());
-  for (int i = 0; i < sz; ++i) {
-    by[i] = 0;
+void HpwlHpwlOptimizer::AddNetModelX(Net& net, NetModelChunk& chunk) {
+  if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) return;
+  double inv_p = net.InvP();
+  NetlistView const& netlist = netlist_view_;
+  double const* blk_loc = netlist.BlockX().data();
+  int net_id = net.Id();
+  int begin = netlist.NetPinBegin(net_id);
+  int end = netlist.NetPinEnd(net_id);
+  if (begin == end) return;
+  int max_pin_index = begin + max_pin_x_[net_id];
+  int min_pin_index = begin + min_pin_x_[net_id];
+
+  int blk_num_max = netlist.PinBlkId(max_pin_index);
+  double offset_max = netlist.PinOffsetX(max_pin_index);
+  double pin_loc_max = offset_max + blk_loc[blk_num_max];
+  bool is_movable_max = netlist.IsBlkMovable(blk_num_max);
+
+  int blk_num_min = netlist.PinBlkId(min_pin_index);
+  double offset_min = netlist.PinOffsetX(min_pin_index);
+  double pin_loc_min = offset_min + blk_loc[blk_num_min];
+  bool is_movable_min = netlist.IsBlkMovable(blk_num_min);
+
+  double distance = std::fabs(pin_loc_min - pin_loc_max);
+  // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
+  // decay_length)); weight = inv_p / (distance + width_epsilon_) *
+  // weight_adjust;
+  double weight = inv_p / (distance + width_epsilon_);
+  if (!is_movable_min && is_movable_max) {
+    chunk.rhs.emplace_back(blk_num_max, (pin_loc_min - offset_max) * weight);
+    chunk.coefficients.emplace_back(blk_num_max, blk_num_max, weight);
+  } else if (is_movable_min && !is_movable_max) {
+    chunk.rhs.emplace_back(blk_num_min, (pin_loc_max - offset_min) * weight);
+    chunk.coefficients.emplace_back(blk_num_min, blk_num_min, weight);
+  } else if (is_movable_min && is_movable_max) {
+    chunk.coefficients.emplace_back(blk_num_min, blk_num_min, weight);
+    chunk.coefficients.emplace_back(blk_num_max, blk_num_max, weight);
+    chunk.coefficients.emplace_back(blk_num_min, blk_num_max, -weight);
+    chunk.coefficients.emplace_back(blk_num_max, blk_num_min, -weight);
+    double offset_diff = (offset_max - offset_min) * weight;
+    chunk.rhs.emplace_back(blk_num_min, offset_diff);
+    chunk.rhs.emplace_back(blk_num_max, -offset_diff);
   }
+}
 
-  double center_weight = 0.03 / std::sqrt(sz);
-  double weight_center_y =
-      (ckt_ptr_->RegionLLY() + ckt_ptr_->RegionURY()) / 2.0 * center_weight;
-  // double decay_length = decay_factor * ckt_ptr_->AveBlkHeight();
-
-  for (auto& net : nets) {
-    if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) continue;
-    double inv_p = net.InvP();
-    net.UpdateMaxMinIdY();
-    int max_pin_index = net.MaxBlkPinIdY();
-    int min_pin_index = net.MinBlkPinIdY();
-
-    int blk_num_max = net.BlockPins()[max_pin_index].BlkId();
-    double pin_loc_max = net.BlockPins()[max_pin_index].AbsY();
-    bool is_movable_max = net.BlockPins()[max_pin_index].BlkPtr()->IsMovable();
-    double offset_max = net.BlockPins()[max_pin_index].OffsetY();
-
-    int blk_num_min = net.BlockPins()[min_pin_index].BlkId();
-    double pin_loc_min = net.BlockPins()[min_pin_index].AbsY();
-    bool is_movable_min = net.BlockPins()[min_pin_index].BlkPtr()->IsMovable();
-    double offset_min = net.BlockPins()[min_pin_index].OffsetY();
-
-    double distance = std::fabs(pin_loc_min - pin_loc_max);
-    // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
-    // decay_length)); weight = inv_p / (distance + height_epsilon_) *
-    // weight_adjust;
-    double weight = inv_p / (distance + height_epsilon_);
-    if (!is_movable_min && is_movable_max) {
-      by[blk_num_max] += (pin_loc_min - offset_max) * weight;
-      coefficients_y_.emplace_back(blk_num_max, blk_num_max, weight);
-    } else if (is_movable_min && !is_movable_max) {
-      by[blk_num_min] += (pin_loc_max - offset_max) * weight;
-      coefficients_y_.emplace_back(blk_num_min, blk_num_min, weight);
-    } else if (is_movable_min && is_movable_max) {
-      coefficients_y_.emplace_back(blk_num_min, blk_num_min, weight);
-      coefficients_y_.emplace_back(blk_num_max, blk_num_max, weight);
-      coefficients_y_.emplace_back(blk_num_min, blk_num_max, -weight);
-      coefficients_y_.emplace_back(blk_num_max, blk_num_min, -weight);
-      double offset_diff = (offset_max - offset_min) * weight;
-      by[blk_num_min] += offset_diff;
-      by[blk_num_max] -= offset_diff;
-    }
+void HpwlHpwlOptimizer::AddNetModelY(Net& net, NetModelChunk& chunk) {
+  if (net.PinCnt() <= 1 || net.PinCnt() >= net_ignore_threshold_) return;
+  double inv_p = net.InvP();
+  NetlistView const& netlist = netlist_view_;
+  double const* blk_loc = netlist.BlockY().data();
+  int net_id = net.Id();
+  int begin = netlist.NetPinBegin(net_id);
+  int end = netlist.NetPinEnd(net_id);
+  if (begin == end) return;
+  int max_pin_index = begin + max_pin_y_[net_id];
+  int min_pin_index = begin + min_pin_y_[net_id];
+
+  int blk_num_max = netlist.PinBlkId(max_pin_index);
+  double offset_max = netlist.PinOffsetY(max_pin_index);
+  double pin_loc_max = offset_max + blk_loc[blk_num_max];
+  bool is_movable_max = netlist.IsBlkMovable(blk_num_max);
+
+  int blk_num_min = netlist.PinBlkId(min_pin_index);
+  double offset_min = netlist.PinOffsetY(min_pin_index);
+  double pin_loc_min = offset_min + blk_loc[blk_num_min];
+  bool is_movable_min = netlist.IsBlkMovable(blk_num_min);
+
+  double distance = std::fabs(pin_loc_min - pin_loc_max);
+  // weight_adjust = base_factor + adjust_factor * (1 - exp(-distance /
+  // decay_length)); weight = inv_p / (distance + height_epsilon_) *
+  // weight_adjust;
+  double weight = inv_p / (distance + height_epsilon_);
+  if (!is_movable_min && is_movable_max) {
+    chunk.rhs.emplace_back(blk_num_max, (pin_loc_min - offset_max) * weight);
+    chunk.coefficients.emplace_back(blk_num_max, blk_num_max, weight);
+  } else if (is_movable_min && !is_movable_max) {
+    chunk.rhs.emplace_back(blk_num_min, (pin_loc_max - offset_max) * weight);
+    chunk.coefficients.emplace_back(blk_num_min, blk_num_min, weight);
+  } else if (is_movable_min && is_movable_max) {
+    chunk.coefficients.emplace_back(blk_num_min, blk_num_min, weight);
+    chunk.coefficients.emplace_back(blk_num_max, blk_num_max, weight);
+    chunk.coefficients.emplace_back(blk_num_min, blk_num_max, -weight);
+    chunk.coefficients.emplace_back(blk_num_max, blk_num_min, -weight);
+    double offset_diff = (offset_max - offset_min) * weight;
+    chunk.rhs.emplace_back(blk_num_min, offset_diff);
+    chunk.rhs.emplace_back(blk_num_max, -offset_diff);
   }
-  for (int i = 0; i < sz;
-       ++i) {  // add the diagonal non-zero element for fixed blocks
-    if (blocks[i].IsFixed()) {
-      coefficients_y_.emplace_back(i, i, 1);
-      by[i] = blocks[i].LLY();
-    } else {
-      if (blocks[i].LLY() < ckt_ptr_->RegionLLY() ||
-          blocks[i].URY() > ckt_ptr_->RegionURY()) {
-        coefficients_y_.emplace_back(i, i, center_weight);
-        by[i] += weight_center_y;
-      }
-    }
-  }
-
-  DaliWarns(coefficients_capacity != coefficients_y_.capacity(),
-            "WARNING: coefficients capacity changed!\n"
-                << "\told capacity: " << coefficients_capacity << "\n"
-                << "\tnew capacity: " << coefficients_y_.size());
-
-  elapsed_time.RecordEndTime();
-  tot_triplets_time_y += elapsed_time.GetWallTime();
 }
 
 void HpwlHpwlOptimizer::UpdateAnchorAlpha() { alpha = 0.005 * cur_iter_; }
@@ -1293,10 +1356,8 @@ void StarHpwlHpwlOptimizer::Initialize() {
   x_anchor_weight.resize(eigen_sz);
   y_anchor_weight.resize(eigen_sz);
 
-  cg_x_.setMaxIterations(cg_iteration_);
-  cg_x_.setTolerance(cg_tolerance_);
-  cg_y_.setMaxIterations(cg_iteration_);
-  cg_y_.setTolerance(cg_tolerance_);
+  InitializeLinearSolvers();
+  InitializeNetlistView();
 
   size_t coefficient_size = 0;
   auto& nets = ckt_ptr_->Nets();
@@ -1333,38 +1394,40 @@ void StarHpwlHpwlOptimizer::BuildProblemX() {
   // double decay_length = decay_factor * ckt_ptr_->AveBlkHeight();
   std::vector<BlockPairNets>& blk_pair_net_list = blk_pair_net_list_;
   int pair_sz = blk_pair_net_list.size();
-  // #pragma omp parallel for
+  NetlistView const& netlist = netlist_view_;
+  double const* blk_loc = netlist.BlockX().data();
+  // each pair owns its off-diagonal entries, so pairs can be written in place
+#pragma omp parallel for num_threads(num_threads_) default(none) \
+    shared(blk_pair_net_list, pair_sz, netlist, blk_loc)
   for (int i = 0; i < pair_sz; ++i) {
     BlockPairNets& blk_pair = blk_pair_net_list[i];
     blk_pair.ClearX();
     for (auto& edge : blk_pair.edges) {
       Net& net = *(edge.net);
-      int d = edge.d;
-      int l = edge.l;
-      int driver_blk_num = net.BlockPins()[d].BlkId();
-      double driver_pin_loc = net.BlockPins()[d].AbsX();
-      bool driver_is_movable = net.BlockPins()[d].BlkPtr()->IsMovable();
-      double driver_offset = net.BlockPins()[d].OffsetX();
-
-      int load_blk_num = net.BlockPins()[l].BlkId();
-      double load_pin_loc = net.BlockPins()[l].AbsX();
-      bool load_is_movable = net.BlockPins()[l].BlkPtr()->IsMovable();
-      double load_offset = net.BlockPins()[l].OffsetX();
-
-      int max_pin_index = net.MaxBlkPinIdX();
-      int min_pin_index = net.MinBlkPinIdX();
-
-      int blk_num_max = net.BlockPins()[max_pin_index].BlkId();
-      double pin_loc_max = net.BlockPins()[max_pin_index].AbsX();
-      // bool is_movable_max =
-      // net.BlockPins()[max_pin_index].BlkPtr()->IsMovable(); double offset_max
-      // = net.BlockPins()[max_pin_index].OffsetX();
-
-      int blk_num_min = net.BlockPins()[min_pin_index].BlkId();
-      double pin_loc_min = net.BlockPins()[min_pin_index].AbsX();
-      // bool is_movable_min =
-      // net.BlockPins()[min_pin_index].BlkPtr()->IsMovable(); double offset_min
-      // = net.BlockPins()[min_pin_index].OffsetX();
+      int net_id = net.Id();
+      int begin = netlist.NetPinBegin(net_id);
+      int d = begin + edge.d;
+      int l = begin + edge.l;
+      int driver_blk_num = netlist.PinBlkId(d);
+      double driver_offset = netlist.PinOffsetX(d);
+      double driver_pin_loc = driver_offset + blk_loc[driver_blk_num];
+      bool driver_is_movable = netlist.IsBlkMovable(driver_blk_num);
+
+      int load_blk_num = netlist.PinBlkId(l);
+      double load_offset = netlist.PinOffsetX(l);
+      double load_pin_loc = load_offset + blk_loc[load_blk_num];
+      bool load_is_movable = netlist.IsBlkMovable(load_blk_num);
+
+      int max_pin_index = begin + max_pin_x_[net_id];
+      int min_pin_index = begin + min_pin_x_[net_id];
+
+      int blk_num_max = netlist.PinBlkId(max_pin_index);
+      double pin_loc_max =
+          netlist.PinOffsetX(max_pin_index) + blk_loc[blk_num_max];
+
+      int blk_num_min = netlist.PinBlkId(min_pin_index);
+      double pin_loc_min =
+          netlist.PinOffsetX(min_pin_index) + blk_loc[blk_num_min];
 
       double distance = std::fabs(load_pin_loc - driver_pin_loc);
       // double weight_adjust = base_factor + adjust_factor * (1 - exp(-distance
@@ -1430,7 +1493,8 @@ void StarHpwlHpwlOptimizer::BuildProblemX() {
   double weight_center_x =
       (ckt_ptr_->RegionLLX() + ckt_ptr_->RegionURX()) / 2.0 * center_weight;
   std::vector<Block>& blocks = ckt_ptr_->Blocks();
-  // #pragma omp parallel for
+#pragma omp parallel for num_threads(num_threads_) default(none) \
+    shared(blocks, sz, center_weight, weight_center_x)
   for (int i = 0; i < sz; ++i) {
     if (blocks[i].IsFixed()) {
       SpMat_diag_x[i].valueRef() = 1;
@@ -1474,38 +1538,40 @@ void StarHpwlHpwlOptimizer::BuildProblemY() {
   // double decay_length = decay_factor * ckt_ptr_->AveBlkHeight();
   std::vector<BlockPairNets>& blk_pair_net_list = blk_pair_net_list_;
   int pair_sz = blk_pair_net_list.size();
-  // #pragma omp parallel for
+  NetlistView const& netlist = netlist_view_;
+  double const* blk_loc = netlist.BlockY().data();
+  // each pair owns its off-diagonal entries, so pairs can be written in place
+#pragma omp parallel for num_threads(num_threads_) default(none) \
+    shared(blk_pair_net_list, pair_sz, netlist, blk_loc)
   for (int i = 0; i < pair_sz; ++i) {
     BlockPairNets& blk_pair = blk_pair_net_list[i];
     blk_pair.ClearY();
     for (auto& edge : blk_pair.edges) {
       Net& net = *(edge.net);
-      int d = edge.d;
-      int l = edge.l;
-      int driver_blk_num = net.BlockPins()[d].BlkId();
-      double driver_pin_loc = net.BlockPins()[d].AbsY();
-      bool driver_is_movable = net.BlockPins()[d].BlkPtr()->IsMovable();
-      double driver_offset = net.BlockPins()[d].OffsetY();
-
-      int load_blk_num = net.BlockPins()[l].BlkId();
-      double load_pin_loc = net.BlockPins()[l].AbsY();
-      bool load_is_movable = net.BlockPins()[l].BlkPtr()->IsMovable();
-      double load_offset = net.BlockPins()[l].OffsetY();
-
-      int max_pin_index = net.MaxBlkPinIdY();
-      int min_pin_index = net.MinBlkPinIdY();
-
-      int blk_num_max = net.BlockPins()[max_pin_index].BlkId();
-      double pin_loc_max = net.BlockPins()[max_pin_index].AbsY();
-      // bool is_movable_max =
-      // net.BlockPins()[max_pin_index].BlkPtr()->IsMovable(); double offset_max
-      // = net.BlockPins()[max_pin_index].OffsetY();
-
-      int blk_num_min = net.BlockPins()[min_pin_index].BlkId();
-      double pin_loc_min = net.BlockPins()[min_pin_index].AbsY();
-      // bool is_movable_min =
-      // net.BlockPins()[min_pin_index].BlkPtr()->IsMovable(); double offset_min
-      // = net.BlockPins()[min_pin_index].OffsetY();
+      int net_id = net.Id();
+      int begin = netlist.NetPinBegin(net_id);
+      int d = begin + edge.d;
+      int l = begin + edge.l;
+      int driver_blk_num = netlist.PinBlkId(d);
+      double driver_offset = netlist.PinOffsetY(d);
+      double driver_pin_loc = driver_offset + blk_loc[driver_blk_num];
+      bool driver_is_movable = netlist.IsBlkMovable(driver_blk_num);
+
+      int load_blk_num = netlist.PinBlkId(l);
+      double load_offset = netlist.PinOffsetY(l);
+      double load_pin_loc = load_offset + blk_loc[load_blk_num];
+      bool load_is_movable = netlist.IsBlkMovable(load_blk_num);
+
+      int max_pin_index = begin + max_pin_y_[net_id];
+      int min_pin_index = begin + min_pin_y_[net_id];
+
+      int blk_num_max = netlist.PinBlkId(max_pin_index);
+      double pin_loc_max =
+          netlist.PinOffsetY(max_pin_index) + blk_loc[blk_num_max];
+
+      int blk_num_min = netlist.PinBlkId(min_pin_index);
+      double pin_loc_min =
+          netlist.PinOffsetY(min_pin_index) + blk_loc[blk_num_min];
 
       double distance = std::fabs(load_pin_loc - driver_pin_loc);
       // double weight_adjust = base_factor + adjust_factor * (1 - exp(-distance
@@ -1571,7 +1637,8 @@ void StarHpwlHpwlOptimizer::BuildProblemY() {
   double weight_center_y =
       (ckt_ptr_->RegionLLY() + ckt_ptr_->RegionURY()) / 2.0 * center_weight;
   std::vector<Block>& blocks = ckt_ptr_->Blocks();
-  // #pragma omp parallel for
+#pragma omp parallel for num_threads(num_threads_) default(none) \
+    shared(blocks, sz, center_weight, weight_center_y)
   for (int i = 0; i < sz; ++i) {
     if (blocks[i].IsFixed()) {
       SpMat_diag_y[i].valueRef() = 1;
@@ -1655,18 +1722,18 @@ double StarHpwlHpwlOptimizer::OptimizeQuadraticMetricX(
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
-  int sz = vx.size();
-  std::vector<Block>& blocks = ckt_ptr_->Blocks();
-
   std::vector<double> eval_history;
   int max_rounds = cg_iteration_max_num_ / cg_iteration_;
-  cg_x_.compute(Ax);  // Ax * vx = bx
+  cg_x_->SetNumThreads(num_threads_);
+  hpwl_evaluator_x_.SetNumThreads(num_threads_);
+  cg_x_->Compute(Ax);  // Ax * vx = bx
+  DaliWarns(!cg_x_->IsComputeSuccessful(),
+            "Preconditioner setup failed for the x system");
+  int cg_iterations = 0;
   for (int i = 0; i < max_rounds; ++i) {
-    vx = cg_x_.solveWithGuess(bx, vx);
-    for (int num = 0; num < sz; ++num) {
-      blocks[num].SetLLX(vx[num]);
-    }
-    double evaluate_result = ckt_ptr_->WeightedHPWLX();
+    cg_x_->SolveWithGuess(bx, vx);
+    cg_iterations += cg_x_->Iterations();
+    double evaluate_result = hpwl_evaluator_x_.Evaluate(vx);
     eval_history.push_back(evaluate_result);
     // LOG(info)  <<"  %d WeightedHPWLX: %e\n", i,
     // evaluate_result);
@@ -1683,14 +1750,14 @@ double StarHpwlHpwlOptimizer::OptimizeQuadraticMetricX(
     }
   }
   LOG(trace) << "      Metric optimization in X, sequence: " << eval_history
-             << "\n";
+             << ", CG iterations: " << cg_iterations << "\n";
+  tot_cg_iterations_x += cg_iterations;
+  ++tot_cg_solves_x;
   elapsed_time.RecordEndTime();
   tot_cg_solver_time_x += elapsed_time.GetWallTime();
 
   elapsed_time.RecordStartTime();
-  for (int num = 0; num < sz; ++num) {
-    blocks[num].SetLLX(vx[num]);
-  }
+  UpdateBlockLocationX();
   elapsed_time.RecordEndTime();
   tot_loc_update_time_x += elapsed_time.GetWallTime();
 
@@ -1705,18 +1772,18 @@ double StarHpwlHpwlOptimizer::OptimizeQuadraticMetricY(
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
-  int sz = vx.size();
-  std::vector<Block>& block_list = ckt_ptr_->Blocks();
-
   std::vector<double> eval_history;
   int max_rounds = cg_iteration_max_num_ / cg_iteration_;
-  cg_y_.compute(Ay);
+  cg_y_->SetNumThreads(num_threads_);
+  hpwl_evaluator_y_.SetNumThreads(num_threads_);
+  cg_y_->Compute(Ay);
+  DaliWarns(!cg_y_->IsComputeSuccessful(),
+            "Preconditioner setup failed for the y system");
+  int cg_iterations = 0;
   for (int i = 0; i < max_rounds; ++i) {
-    vy = cg_y_.solveWithGuess(by, vy);
-    for (int num = 0; num < sz; ++num) {
-      block_list[num].SetLLY(vy[num]);
-    }
-    double evaluate_result = ckt_ptr_->WeightedHPWLY();
+    cg_y_->SolveWithGuess(by, vy);
+    cg_iterations += cg_y_->Iterations();
+    double evaluate_result = hpwl_evaluator_y_.Evaluate(vy);
     eval_history.push_back(evaluate_result);
     // LOG(info)  <<"  %d WeightedHPWLY: %e\n", i,
     // evaluate_result);
@@ -1733,14 +1800,14 @@ double StarHpwlHpwlOptimizer::OptimizeQuadraticMetricY(
     }
   }
   LOG(trace) << "      Metric optimization in Y, sequence: " << eval_history
-             << "\n";
+             << ", CG iterations: " << cg_iterations << "\n";
+  tot_cg_iterations_y += cg_iterations;
+  ++tot_cg_solves_y;
   elapsed_time.RecordEndTime();
   tot_cg_solver_time_y += elapsed_time.GetWallTime();
 
   elapsed_time.RecordStartTime();
-  for (int num = 0; num < sz; ++num) {
-    block_list[num].SetLLY(vy[num]);
-  }
+  UpdateBlockLocationY();
   elapsed_time.RecordEndTime();
   tot_loc_update_time_y += elapsed_time.GetWallTime();
 
@@ -22,10 +22,14 @@
 #define DALI_PLACER_GLOBAL_PLACER_HPWL_OPTIMIZER_H_
 #include <Eigen/IterativeLinearSolvers>
 #include <Eigen/Sparse>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "dali/circuit/circuit.h"
 #include "dali/placer/global_placer/block_pair_nets.h"
+#include "dali/placer/global_placer/hpwl_evaluator.h"
+#include "dali/placer/global_placer/linear_solver.h"
 
 namespace dali {
 
@@ -40,6 +44,18 @@ typedef Eigen::Triplet<double> T;
 // index, value, for a given row index.
 typedef IndexVal D;
 
+/**
+ * Triplets and right-hand-side contributions of a contiguous range of nets.
+ *
+ * Nets are split into chunks that can be modeled concurrently. Contributions
+ * are kept in emission order and merged chunk by chunk, so the assembled linear
+ * system is identical to a serial build for any number of threads.
+ */
+struct NetModelChunk {
+  std::vector<T> coefficients;
+  std::vector<D> rhs;
+};
+
 /** Abstract interface for global-placement HPWL optimizers. */
 class HpwlOptimizer {
  public:
@@ -76,6 +92,16 @@ class HpwlOptimizer {
   /** Enable or disable intermediate placement dumps. */
   void SetShouldSaveIntermediateResult(bool should_save_intermediate_result);
 
+  /** Set linear solver backend, must be called before Initialize(). */
+  void SetLinearSolverType(LinearSolverType linear_solver_type) {
+    linear_solver_type_ = linear_solver_type;
+  }
+
+  /** Print a strong-scaling report of the x/y solves in Close(). */
+  void SetShouldReportStrongScaling(bool should_report_strong_scaling) {
+    should_report_strong_scaling_ = should_report_strong_scaling;
+  }
+
  protected:
   Circuit* ckt_ptr_ = nullptr;
   int cur_iter_ = 0;
@@ -90,6 +116,9 @@ class HpwlOptimizer {
 
   // Save intermediate result for debugging and/or visualization.
   bool should_save_intermediate_result_ = false;
+
+  LinearSolverType linear_solver_type_ = LinearSolverType::DIAGONAL_CG;
+  bool should_report_strong_scaling_ = false;
 };
 
 /** Bound-to-bound quadratic HPWL optimizer. */
@@ -102,8 +131,21 @@ class B2BHpwlOptimizer : public HpwlOptimizer {
   void UpdateEpsilon();
   void Initialize() override;
 
+  /** Set maximum CG iterations of one quadratic metric optimization. */
+  void SetCgIterationMaxNum(int cg_iteration_max_num) {
+    cg_iteration_max_num_ = cg_iteration_max_num;
+  }
+
+  /** Set the distance a block moves before its nets are evaluated again. */
+  void SetHpwlUpdateThreshold(double hpwl_update_threshold) {
+    hpwl_update_threshold_ = hpwl_update_threshold;
+  }
+
+
   virtual void BuildProblemX();
   virtual void BuildProblemY();
+  virtual void AddNetModelX(Net& net, NetModelChunk& chunk);
+  virtual void AddNetModelY(Net& net, NetModelChunk& chunk);
   bool IsSeriesConverged(std::vector<double>& data, int window_size,
                          double tolerance);
   bool IsSeriesOscillate(std::vector<double>& data, int window_size);
@@ -115,6 +157,8 @@ class B2BHpwlOptimizer : public HpwlOptimizer {
   virtual void UpdateAnchorAlpha();
   void UpdateMaxMinX();
   void UpdateMaxMinY();
+  void UpdateBlockLocationX();
+  void UpdateBlockLocationY();
   virtual void BuildProblemWithAnchorX();
   virtual void BuildProblemWithAnchorY();
   void BackUpBlockLocation();
@@ -124,6 +168,7 @@ class B2BHpwlOptimizer : public HpwlOptimizer {
 
   double GetTime() override;
   void Close() override;
+  void ReportStrongScaling();
 
  protected:
   /**** parameters for CG solver optimization configuration ****/
@@ -168,8 +213,9 @@ class B2BHpwlOptimizer : public HpwlOptimizer {
   bool y_anchor_set = false;
   std::vector<T> coefficients_x_;
   std::vector<T> coefficients_y_;
-  Eigen::ConjugateGradient<SpMat, Eigen::Lower | Eigen::Upper> cg_x_;
-  Eigen::ConjugateGradient<SpMat, Eigen::Lower | Eigen::Upper> cg_y_;
+  std::unique_ptr<LinearSolver> cg_x_;
+  std::unique_ptr<LinearSolver> cg_y_;
+  void InitializeLinearSolvers();
   std::vector<std::vector<BlockPairNets*>> pair_connect;
   std::vector<BlockPairNets> diagonal_pair;
   std::vector<SpMat::InnerIterator> SpMat_diag_x;
@@ -178,6 +224,31 @@ class B2BHpwlOptimizer : public HpwlOptimizer {
   int b2b_update_max_iteration_ = 50;
   size_t net_ignore_threshold_ = 100;
 
+  // nets are modeled in chunks of this size when building the linear system
+  size_t net_model_chunk_size_ = 256;
+  std::vector<NetModelChunk> net_model_chunks_x_;
+  std::vector<NetModelChunk> net_model_chunks_y_;
+
+  // pins, offsets and block locations in contiguous arrays for net models
+  NetlistView netlist_view_;
+  // pin locations, and pins of each net with max/min location relative to
+  // the first pin
+  std::vector<double> pin_loc_x_;
+  std::vector<double> pin_loc_y_;
+  std::vector<int> max_pin_x_;
+  std::vector<int> min_pin_x_;
+  std::vector<int> max_pin_y_;
+  std::vector<int> min_pin_y_;
+  // evaluate HPWL on vx and vy during CG rounds
+  double hpwl_update_threshold_ = 0;
+  HpwlEvaluator hpwl_evaluator_x_;
+  HpwlEvaluator hpwl_evaluator_y_;
+  void InitializeNetlistView();
+  void BuildNetModel(std::vector<NetModelChunk>& chunks,
+                     std::vector<T>& coefficients, Eigen::VectorXd& b,
+                     void (B2BHpwlOptimizer::*add_net_model)(Net&,
+                                                             NetModelChunk&));
+
   double tot_triplets_time_x = 0;
   double tot_triplets_time_y = 0;
   double tot_matrix_from_triplets_x = 0;
@@ -187,6 +258,10 @@ class B2BHpwlOptimizer : public HpwlOptimizer {
   double tot_loc_update_time_x = 0;
   double tot_loc_update_time_y = 0;
   double tot_cg_time = 0;
+  long tot_cg_iterations_x = 0;
+  long tot_cg_iterations_y = 0;
+  int tot_cg_solves_x = 0;
+  int tot_cg_solves_y = 0;
 
   /**** anchor weight ****/
   // pseudo-net weight additional factor for anchor pseudo-net
@@ -201,8 +276,8 @@ class StarHpwlOptimizer : public B2BHpwlOptimizer {
       : B2BHpwlOptimizer(ckt_ptr, num_threads) {}
   ~StarHpwlOptimizer() override = default;
 
-  void BuildProblemX() override;
-  void BuildProblemY() override;
+  void AddNetModelX(Net& net, NetModelChunk& chunk) override;
+  void AddNetModelY(Net& net, NetModelChunk& chunk) override;
 
   void UpdateAnchorAlpha() override;
 };
@@ -214,8 +289,8 @@ class HpwlHpwlOptimizer : public B2BHpwlOptimizer {
       : B2BHpwlOptimizer(ckt_ptr, num_threads) {}
   ~HpwlHpwlOptimizer() override = default;
 
-  void BuildProblemX() override;
-  void BuildProblemY() override;
+  void AddNetModelX(Net& net, NetModelChunk& chunk) override;
+  void AddNetModelY(Net& net, NetModelChunk& chunk) override;
 
   void UpdateAnchorAlpha() override;
 };
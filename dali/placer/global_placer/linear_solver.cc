@@ -0,0 +1,436 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "linear_solver.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "dali/common/logging.h"
+
+namespace dali {
+
+namespace {
+
+// vector kernels work on segments of this size, which is also the granularity
+// of the fixed-order reduction of dot products
+constexpr Eigen::Index kSegmentSize = 4096;
+
+int NumSegments(Eigen::Index sz) {
+  return static_cast<int>((sz + kSegmentSize - 1) / kSegmentSize);
+}
+
+// do not start more threads than segments
+int NumTeamThreads(int num_threads, int num_segments) {
+  return std::max(1, std::min(num_threads, num_segments));
+}
+
+}  // namespace
+
+LinearSolverType StrToLinearSolverType(std::string const& str_solver_type) {
+  LinearSolverType solver_type = LinearSolverType::DIAGONAL_CG;
+  if (str_solver_type == "diagonal") {
+    solver_type = LinearSolverType::DIAGONAL_CG;
+  } else if (str_solver_type == "ic") {
+    solver_type = LinearSolverType::INCOMPLETE_CHOLESKY_CG;
+  } else if (str_solver_type == "amg") {
+    solver_type = LinearSolverType::AMG_CG;
+  } else {
+    DaliExpects(false, "Unknown linear solver type: " + str_solver_type);
+  }
+  return solver_type;
+}
+
+std::string LinearSolverTypeStr(LinearSolverType solver_type) {
+  std::string s;
+  switch (solver_type) {
+    case LinearSolverType::DIAGONAL_CG: {
+      s = "diagonal";
+    } break;
+    case LinearSolverType::INCOMPLETE_CHOLESKY_CG: {
+      s = "ic";
+    } break;
+    case LinearSolverType::AMG_CG: {
+      s = "amg";
+    } break;
+    default: {
+      DaliExpects(false, "Linear solver type error! This should never happen!");
+    }
+  }
+  return s;
+}
+
+void ParallelSpMV(SpMat const& A, Eigen::VectorXd const& x, Eigen::VectorXd& y,
+                  int num_threads) {
+  int sz = static_cast<int>(A.rows());
+  y.resize(sz);
+  int num_segments = NumSegments(sz);
+  num_threads = NumTeamThreads(num_threads, num_segments);
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(A, x, y, sz)
+  for (int i = 0; i < sz; ++i) {
+    double sum = 0;
+    for (SpMat::InnerIterator it(A, i); it; ++it) {
+      sum += it.value() * x[it.col()];
+    }
+    y[i] = sum;
+  }
+}
+
+double ParallelDot(Eigen::VectorXd const& a, Eigen::VectorXd const& b,
+                   int num_threads) {
+  Eigen::Index sz = a.size();
+  int num_segments = NumSegments(sz);
+  num_threads = NumTeamThreads(num_threads, num_segments);
+  if (num_segments <= 1) {
+    return a.dot(b);
+  }
+  std::vector<double> partial_sums(num_segments, 0);
+  Eigen::Index segment_size = kSegmentSize;
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(a, b, sz, num_segments, partial_sums, segment_size)
+  for (int k = 0; k < num_segments; ++k) {
+    Eigen::Index begin = k * segment_size;
+    Eigen::Index len = std::min(segment_size, sz - begin);
+    partial_sums[k] = a.segment(begin, len).dot(b.segment(begin, len));
+  }
+  double sum = 0;
+  for (auto& partial_sum : partial_sums) {
+    sum += partial_sum;
+  }
+  return sum;
+}
+
+void JacobiPreconditioner::Compute(SpMat const& A) {
+  Eigen::Index sz = A.rows();
+  inv_diag_.setOnes(sz);
+  for (Eigen::Index i = 0; i < sz; ++i) {
+    for (SpMat::InnerIterator it(A, i); it; ++it) {
+      if (it.col() == i) {
+        if (it.value() != 0) {
+          inv_diag_[i] = 1.0 / it.value();
+        }
+        break;
+      }
+    }
+  }
+}
+
+void JacobiPreconditioner::Apply(Eigen::VectorXd const& r,
+                                 Eigen::VectorXd& z) const {
+  int sz = static_cast<int>(r.size());
+  z.resize(sz);
+  int num_threads = NumTeamThreads(num_threads_, NumSegments(sz));
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(r, z, sz)
+  for (int i = 0; i < sz; ++i) {
+    z[i] = inv_diag_[i] * r[i];
+  }
+}
+
+void IncompleteCholeskyPreconditioner::Compute(SpMat const& A) {
+  ic_.compute(A);
+  is_compute_successful_ = ic_.info() == Eigen::Success;
+}
+
+void IncompleteCholeskyPreconditioner::Apply(Eigen::VectorXd const& r,
+                                             Eigen::VectorXd& z) const {
+  z = ic_.solve(r);
+}
+
+/****
+ * @brief Build the multigrid hierarchy of matrix @param A.
+ */
+void AmgPreconditioner::Setup(SpMat A) {
+  levels_.clear();
+  while (true) {
+    levels_.emplace_back();
+    Level& level = levels_.back();
+    level.A = std::move(A);
+    level.A.makeCompressed();
+    Eigen::Index sz = level.A.rows();
+    level.inv_diag.setOnes(sz);
+    for (Eigen::Index i = 0; i < sz; ++i) {
+      double diag = level.A.coeff(i, i);
+      if (diag > 0) {
+        level.inv_diag[i] = 1.0 / diag;
+      }
+    }
+
+    if (sz <= coarsest_size_ ||
+        static_cast<int>(levels_.size()) >= max_levels_) {
+      break;
+    }
+    level.num_aggregates = Aggregate(level);
+    // stop if aggregation does not reduce the problem size enough
+    if (level.num_aggregates > 0.8 * static_cast<double>(sz)) {
+      level.aggregates.clear();
+      level.num_aggregates = 0;
+      break;
+    }
+    A = GalerkinProduct(level);
+  }
+
+  // the coarsest level is singular if no block in a connected component is
+  // anchored, a small shift keeps the null space from being amplified
+  Eigen::SparseMatrix<double> coarsest_A = levels_.back().A;
+  double shift = 1e-6 * coarsest_A.diagonal().cwiseAbs().mean();
+  coarsest_solver_.setShift(shift);
+  coarsest_solver_.compute(coarsest_A);
+  info_ = coarsest_solver_.info();
+}
+
+/****
+ * @brief Group unknowns of @param level into aggregates, and return the number
+ * of aggregates.
+ *
+ * The first pass makes an aggregate from every unknown whose strongly
+ * connected neighbors are not aggregated yet. The second pass attaches every
+ * remaining unknown to the aggregate of its strongest neighbor.
+ */
+int AmgPreconditioner::Aggregate(Level& level) const {
+  SpMat const& A = level.A;
+  int sz = static_cast<int>(A.rows());
+  Eigen::VectorXd diag = A.diagonal().cwiseAbs();
+  auto is_strong = [&](int i, int j, double val) {
+    return i != j && std::fabs(val) >= strength_threshold_ *
+                                            std::sqrt(diag[i] * diag[j]);
+  };
+
+  std::vector<int>& aggregates = level.aggregates;
+  aggregates.assign(sz, -1);
+  int num_aggregates = 0;
+  for (int i = 0; i < sz; ++i) {
+    if (aggregates[i] >= 0) continue;
+    bool is_free = true;
+    for (SpMat::InnerIterator it(A, i); it; ++it) {
+      int j = static_cast<int>(it.col());
+      if (is_strong(i, j, it.value()) && aggregates[j] >= 0) {
+        is_free = false;
+        break;
+      }
+    }
+    if (!is_free) continue;
+    aggregates[i] = num_aggregates;
+    for (SpMat::InnerIterator it(A, i); it; ++it) {
+      int j = static_cast<int>(it.col());
+      if (is_strong(i, j, it.value())) {
+        aggregates[j] = num_aggregates;
+      }
+    }
+    ++num_aggregates;
+  }
+
+  std::vector<int> first_pass_aggregates = aggregates;
+  for (int i = 0; i < sz; ++i) {
+    if (aggregates[i] >= 0) continue;
+    int strongest_neighbor = -1;
+    double strongest_val = 0;
+    for (SpMat::InnerIterator it(A, i); it; ++it) {
+      int j = static_cast<int>(it.col());
+      if (first_pass_aggregates[j] >= 0 && is_strong(i, j, it.value()) &&
+          std::fabs(it.value()) > strongest_val) {
+        strongest_neighbor = j;
+        strongest_val = std::fabs(it.value());
+      }
+    }
+    if (strongest_neighbor >= 0) {
+      aggregates[i] = first_pass_aggregates[strongest_neighbor];
+    } else {
+      aggregates[i] = num_aggregates++;
+    }
+  }
+
+  return num_aggregates;
+}
+
+/****
+ * @brief Return P^T*A*P, where P maps each unknown of @param level to its
+ * aggregate.
+ */
+SpMat AmgPreconditioner::GalerkinProduct(Level const& level) const {
+  std::vector<Eigen::Triplet<double>> coefficients;
+  coefficients.reserve(level.A.nonZeros());
+  for (Eigen::Index i = 0; i < level.A.outerSize(); ++i) {
+    for (SpMat::InnerIterator it(level.A, i); it; ++it) {
+      coefficients.emplace_back(level.aggregates[i],
+                                level.aggregates[it.col()], it.value());
+    }
+  }
+  SpMat coarse_A(level.num_aggregates, level.num_aggregates);
+  coarse_A.setFromTriplets(coefficients.begin(), coefficients.end());
+  return coarse_A;
+}
+
+/****
+ * @brief Apply one damped Jacobi sweep on @param level to A*x = @param b.
+ */
+void AmgPreconditioner::Smooth(Level const& level, const Vector& b,
+                               Vector& x) const {
+  Vector product;
+  ParallelSpMV(level.A, x, product, num_threads_);
+  x += jacobi_weight_ * level.inv_diag.cwiseProduct(b - product);
+}
+
+/****
+ * @brief Apply one V-cycle on @param level_id to approximately solve
+ * A*x = @param b, the initial guess of @param x is zero.
+ */
+void AmgPreconditioner::VCycle(size_t level_id, const Vector& b,
+                               Vector& x) const {
+  if (level_id + 1 == levels_.size()) {
+    x = coarsest_solver_.solve(b);
+    return;
+  }
+
+  Level const& level = levels_[level_id];
+  x = jacobi_weight_ * level.inv_diag.cwiseProduct(b);
+  for (int i = 1; i < num_smoothing_sweeps_; ++i) {
+    Smooth(level, b, x);
+  }
+
+  Vector residual;
+  ParallelSpMV(level.A, x, residual, num_threads_);
+  residual = b - residual;
+  Vector coarse_residual = Vector::Zero(level.num_aggregates);
+  Eigen::Index sz = x.size();
+  for (Eigen::Index i = 0; i < sz; ++i) {
+    coarse_residual[level.aggregates[i]] += residual[i];
+  }
+  Vector coarse_x;
+  VCycle(level_id + 1, coarse_residual, coarse_x);
+  for (Eigen::Index i = 0; i < sz; ++i) {
+    x[i] += coarse_x[level.aggregates[i]];
+  }
+
+  for (int i = 0; i < num_smoothing_sweeps_; ++i) {
+    Smooth(level, b, x);
+  }
+}
+
+PreconditionedCgSolver::PreconditionedCgSolver(
+    std::unique_ptr<Preconditioner> preconditioner)
+    : preconditioner_(std::move(preconditioner)) {}
+
+void PreconditionedCgSolver::SetNumThreads(int num_threads) {
+  num_threads_ = std::max(num_threads, 1);
+  preconditioner_->SetNumThreads(num_threads_);
+}
+
+void PreconditionedCgSolver::Compute(SpMat const& A) {
+  A_ = &A;
+  preconditioner_->Compute(A);
+}
+
+/****
+ * @brief Run preconditioned CG on A*x = @param b from the initial guess
+ * @param x, following Eigen::internal::conjugate_gradient().
+ */
+void PreconditionedCgSolver::SolveWithGuess(Eigen::VectorXd const& b,
+                                            Eigen::VectorXd& x) {
+  DaliExpects(A_ != nullptr, "Compute() must be called before solving");
+  SpMat const& A = *A_;
+  int sz = static_cast<int>(b.size());
+  int num_threads = NumTeamThreads(num_threads_, NumSegments(sz));
+
+  Eigen::VectorXd& r = residual_;
+  Eigen::VectorXd& p = direction_;
+  Eigen::VectorXd& z = preconditioned_residual_;
+  Eigen::VectorXd& q = product_;
+  ParallelSpMV(A, x, q, num_threads);
+  r.resize(sz);
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(b, r, q, sz)
+  for (int i = 0; i < sz; ++i) {
+    r[i] = b[i] - q[i];
+  }
+
+  double rhs_norm2 = ParallelDot(b, b, num_threads);
+  if (rhs_norm2 == 0) {
+    x.setZero();
+    iterations_ = 0;
+    error_ = 0;
+    return;
+  }
+  double threshold = std::max(tolerance_ * tolerance_ * rhs_norm2, DBL_MIN);
+  double residual_norm2 = ParallelDot(r, r, num_threads);
+  if (residual_norm2 < threshold) {
+    iterations_ = 0;
+    error_ = std::sqrt(residual_norm2 / rhs_norm2);
+    return;
+  }
+
+  int max_iterations = max_iterations_ < 0 ? 2 * sz : max_iterations_;
+  preconditioner_->Apply(r, p);
+  double abs_new = ParallelDot(r, p, num_threads);
+  int i = 0;
+  while (i < max_iterations) {
+    ParallelSpMV(A, p, q, num_threads);
+    double alpha = abs_new / ParallelDot(p, q, num_threads);
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(x, r, p, q, sz, alpha)
+    for (int k = 0; k < sz; ++k) {
+      x[k] += alpha * p[k];
+      r[k] -= alpha * q[k];
+    }
+    residual_norm2 = ParallelDot(r, r, num_threads);
+    if (residual_norm2 < threshold) break;
+
+    preconditioner_->Apply(r, z);
+    double abs_old = abs_new;
+    abs_new = ParallelDot(r, z, num_threads);
+    double beta = abs_new / abs_old;
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(p, z, sz, beta)
+    for (int k = 0; k < sz; ++k) {
+      p[k] = z[k] + beta * p[k];
+    }
+    ++i;
+  }
+  error_ = std::sqrt(residual_norm2 / rhs_norm2);
+  iterations_ = i;
+}
+
+std::unique_ptr<LinearSolver> CreateLinearSolver(LinearSolverType solver_type) {
+  std::unique_ptr<Preconditioner> preconditioner(nullptr);
+  switch (solver_type) {
+    case LinearSolverType::DIAGONAL_CG: {
+      preconditioner = std::make_unique<JacobiPreconditioner>();
+      break;
+    }
+    case LinearSolverType::INCOMPLETE_CHOLESKY_CG: {
+      preconditioner = std::make_unique<IncompleteCholeskyPreconditioner>();
+      break;
+    }
+    case LinearSolverType::AMG_CG: {
+      preconditioner = std::make_unique<AmgPreconditioner>();
+      break;
+    }
+    default: {
+      DaliFatal("Unknown linear solver type");
+    }
+  }
+  return std::make_unique<PreconditionedCgSolver>(std::move(preconditioner));
+}
+
+}  // namespace dali
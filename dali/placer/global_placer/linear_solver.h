@@ -0,0 +1,235 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#ifndef DALI_PLACER_GLOBAL_PLACER_LINEAR_SOLVER_H_
+#define DALI_PLACER_GLOBAL_PLACER_LINEAR_SOLVER_H_
+
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dali {
+
+// Declares a row-major sparse matrix type of double.
+typedef Eigen::SparseMatrix<double, Eigen::RowMajor> SpMat;
+
+/** Available linear solver backends for quadratic placement. */
+enum class LinearSolverType {
+  DIAGONAL_CG = 0,
+  INCOMPLETE_CHOLESKY_CG = 1,
+  AMG_CG = 2
+};
+
+/** Convert "diagonal", "ic" or "amg" to a linear solver type. */
+LinearSolverType StrToLinearSolverType(std::string const& str_solver_type);
+
+/** Return the configuration name of a linear solver type. */
+std::string LinearSolverTypeStr(LinearSolverType solver_type);
+
+/**
+ * Return y = A*x. Rows are split among @param num_threads threads, and every
+ * row is computed by one thread in column order.
+ */
+void ParallelSpMV(SpMat const& A, Eigen::VectorXd const& x, Eigen::VectorXd& y,
+                  int num_threads);
+
+/**
+ * Return the dot product of @param a and @param b. Partial sums of fixed-size
+ * segments are added in segment order, so the result is the same for any
+ * number of threads.
+ */
+double ParallelDot(Eigen::VectorXd const& a, Eigen::VectorXd const& b,
+                   int num_threads);
+
+/** Interface of a preconditioner M used by PreconditionedCgSolver. */
+class Preconditioner {
+ public:
+  virtual ~Preconditioner() = default;
+
+  /** Set number of threads used by Apply(). */
+  void SetNumThreads(int num_threads) { num_threads_ = num_threads; }
+
+  /** Build the preconditioner of matrix @param A. */
+  virtual void Compute(SpMat const& A) = 0;
+
+  /** Compute @param z = M^-1 * @param r. */
+  virtual void Apply(Eigen::VectorXd const& r, Eigen::VectorXd& z) const = 0;
+
+  /** Return whether the last Compute() succeeded. */
+  virtual bool IsComputeSuccessful() const = 0;
+
+ protected:
+  int num_threads_ = 1;
+};
+
+/**
+ * Jacobi preconditioner, the inverse of the diagonal. A zero diagonal entry is
+ * treated as one, the same as Eigen::DiagonalPreconditioner.
+ */
+class JacobiPreconditioner : public Preconditioner {
+ public:
+  void Compute(SpMat const& A) override;
+  void Apply(Eigen::VectorXd const& r, Eigen::VectorXd& z) const override;
+  bool IsComputeSuccessful() const override { return true; }
+
+ private:
+  Eigen::VectorXd inv_diag_;
+};
+
+/** Incomplete Cholesky preconditioner, the triangular solves are serial. */
+class IncompleteCholeskyPreconditioner : public Preconditioner {
+ public:
+  void Compute(SpMat const& A) override;
+  void Apply(Eigen::VectorXd const& r, Eigen::VectorXd& z) const override;
+  bool IsComputeSuccessful() const override { return is_compute_successful_; }
+
+ private:
+  Eigen::IncompleteCholesky<double, Eigen::Lower> ic_;
+  bool is_compute_successful_ = false;
+};
+
+/**
+ * Aggregation-based algebraic multigrid preconditioner.
+ *
+ * Each level groups strongly connected unknowns into aggregates, and the next
+ * level is the Galerkin product P^T*A*P of the piecewise-constant prolongation
+ * P. One symmetric V-cycle with damped Jacobi smoothing is applied per solve,
+ * so the preconditioner is symmetric positive definite and can be used by CG.
+ * The coarsest level is solved with a sparse LDLT factorization.
+ */
+class AmgPreconditioner : public Preconditioner {
+ public:
+  typedef Eigen::VectorXd Vector;
+
+  void Compute(SpMat const& A) override { Setup(A); }
+  void Apply(Vector const& r, Vector& z) const override { VCycle(0, r, z); }
+  bool IsComputeSuccessful() const override { return info_ == Eigen::Success; }
+
+  /** Return the number of levels of the last setup. */
+  int NumLevels() const { return static_cast<int>(levels_.size()); }
+
+ private:
+  struct Level {
+    SpMat A;
+    Eigen::VectorXd inv_diag;
+    // aggregate id of each unknown, only used if there is a coarser level
+    std::vector<int> aggregates;
+    int num_aggregates = 0;
+  };
+
+  // stop coarsening if a level has at most this amount of unknowns
+  int coarsest_size_ = 1000;
+  int max_levels_ = 12;
+  // threshold of strong connections, relative to the diagonal
+  double strength_threshold_ = 0.08;
+  // damping factor and number of pre-/post-smoothing Jacobi sweeps
+  double jacobi_weight_ = 2.0 / 3.0;
+  int num_smoothing_sweeps_ = 1;
+
+  std::vector<Level> levels_;
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> coarsest_solver_;
+  Eigen::ComputationInfo info_ = Eigen::Success;
+
+  void Setup(SpMat A);
+  int Aggregate(Level& level) const;
+  SpMat GalerkinProduct(Level const& level) const;
+  void Smooth(Level const& level, const Vector& b, Vector& x) const;
+  void VCycle(size_t level_id, const Vector& b, Vector& x) const;
+};
+
+/** Interface of a linear solver for the quadratic placement systems. */
+class LinearSolver {
+ public:
+  virtual ~LinearSolver() = default;
+
+  /** Set maximum iterations of one call of SolveWithGuess(). */
+  virtual void SetMaxIterations(int max_iterations) = 0;
+
+  /** Set relative residual tolerance. */
+  virtual void SetTolerance(double tolerance) = 0;
+
+  /** Set number of threads, results do not depend on it. */
+  virtual void SetNumThreads(int num_threads) = 0;
+
+  /** Prepare the preconditioner for matrix @param A, A must outlive solves. */
+  virtual void Compute(SpMat const& A) = 0;
+
+  /** Improve solution @param x of A*x = @param b starting from x. */
+  virtual void SolveWithGuess(Eigen::VectorXd const& b,
+                              Eigen::VectorXd& x) = 0;
+
+  /** Return the number of iterations of the last SolveWithGuess(). */
+  virtual int Iterations() const = 0;
+
+  /** Return the relative residual after the last SolveWithGuess(). */
+  virtual double Error() const = 0;
+
+  /** Return whether the last Compute() succeeded. */
+  virtual bool IsComputeSuccessful() const = 0;
+};
+
+/**
+ * Preconditioned conjugate gradient solver.
+ *
+ * The iteration and stopping rule are the same as Eigen::ConjugateGradient.
+ * Sparse matrix-vector products, dot products and vector updates run on
+ * multiple threads, and dot products are reduced in a fixed order, so the
+ * solution is bit-identical for any number of threads.
+ */
+class PreconditionedCgSolver : public LinearSolver {
+ public:
+  explicit PreconditionedCgSolver(
+      std::unique_ptr<Preconditioner> preconditioner);
+
+  void SetMaxIterations(int max_iterations) override {
+    max_iterations_ = max_iterations;
+  }
+  void SetTolerance(double tolerance) override { tolerance_ = tolerance; }
+  void SetNumThreads(int num_threads) override;
+  void Compute(SpMat const& A) override;
+  void SolveWithGuess(Eigen::VectorXd const& b, Eigen::VectorXd& x) override;
+  int Iterations() const override { return iterations_; }
+  double Error() const override { return error_; }
+  bool IsComputeSuccessful() const override {
+    return preconditioner_->IsComputeSuccessful();
+  }
+
+ private:
+  std::unique_ptr<Preconditioner> preconditioner_;
+  SpMat const* A_ = nullptr;
+  int num_threads_ = 1;
+  // a negative value means twice the number of unknowns
+  int max_iterations_ = -1;
+  double tolerance_ = Eigen::NumTraits<double>::epsilon();
+  int iterations_ = 0;
+  double error_ = 0;
+  // work vectors, kept to avoid allocations in every solve
+  Eigen::VectorXd residual_, direction_, preconditioned_residual_, product_;
+};
+
+/** Create a linear solver of the given type. */
+std::unique_ptr<LinearSolver> CreateLinearSolver(LinearSolverType solver_type);
+
+}  // namespace dali
+
+#endif  // DALI_PLACER_GLOBAL_PLACER_LINEAR_SOLVER_H_
@@ -22,10 +22,12 @@
 #include "rough_legalizer.h"
 
 #include <algorithm>
+#include <climits>
 #include <cmath>
 
 #include "dali/common/elapsed_time.h"
 #include "dali/common/logging.h"
+#include "dali/common/placement_metrics.h"
 
 namespace dali {
 
@@ -39,6 +41,10 @@ void RoughLegalizer::SetShouldSaveIntermediateResult(
   should_save_intermediate_result_ = should_save_intermediate_result;
 }
 
+void RoughLegalizer::SetNumThreads(int num_threads) {
+  num_threads_ = num_threads;
+}
+
 /****
  * @brief determine the grid bin height and width
  * grid_bin_height and grid_bin_width is determined by the following formula:
@@ -191,6 +197,7 @@ void LookAheadLegalizer::InitGridBins() {
   InitializeGridBinSize();
   UpdateAttributesForAllGridBins();
   UpdatePlacementBlockagesInGridBins();
+  BuildBlockageIndex();
 
   // update white spaces in grid bins
   for (auto& grid_bin_column : grid_bin_mesh) {
@@ -252,6 +259,7 @@ void LookAheadLegalizer::Initialize(double placement_density) {
   upper_bound_hpwl_.clear();
   InitGridBins();
   InitWhiteSpaceLUT();
+  ckt_ptr_->BuildNetlistView(netlist_view_);
 }
 
 void LookAheadLegalizer::ClearGridBinFlag() {
@@ -260,61 +268,154 @@ void LookAheadLegalizer::ClearGridBinFlag() {
   }
 }
 
+/****
+ * @brief Index placement blockages of each grid bin in contiguous arrays, with
+ * the bounding box of blockages in each bin. Cells in a bin only need to be
+ * checked against blockages of the bin if they overlap the bounding box.
+ */
+void LookAheadLegalizer::BuildBlockageIndex() {
+  int num_bins = grid_cnt_x * grid_cnt_y;
+  blockage_rect_begin_.assign(num_bins + 1, 0);
+  blockage_rects_.clear();
+  blockage_bboxes_.assign(num_bins, RectI());
+  for (int i = 0; i < num_bins; ++i) {
+    GridBin& grid_bin = grid_bin_mesh[i / grid_cnt_y][i % grid_cnt_y];
+    blockage_rect_begin_[i] = static_cast<int>(blockage_rects_.size());
+    if (grid_bin.placement_blockages_.empty()) continue;
+    int llx = INT_MAX, lly = INT_MAX, urx = INT_MIN, ury = INT_MIN;
+    for (auto& blockage_ptr : grid_bin.placement_blockages_) {
+      auto& rect = blockage_ptr->GetRect();
+      blockage_rects_.push_back(rect);
+      llx = std::min(llx, rect.LLX());
+      lly = std::min(lly, rect.LLY());
+      urx = std::max(urx, rect.URX());
+      ury = std::max(ury, rect.URY());
+    }
+    blockage_bboxes_[i] = RectI(llx, lly, urx, ury);
+  }
+  blockage_rect_begin_[num_bins] = static_cast<int>(blockage_rects_.size());
+}
+
+/****
+ * @brief Return whether @param blk overlaps any placement blockage in grid bin
+ * @param bin_id, the same as checking every blockage of the bin.
+ */
+bool LookAheadLegalizer::IsOverlapWithBlockages(Block const& blk,
+                                                int bin_id) const {
+  int begin = blockage_rect_begin_[bin_id];
+  int end = blockage_rect_begin_[bin_id + 1];
+  if (begin == end || !blk.IsOverlap(blockage_bboxes_[bin_id])) return false;
+  for (int i = begin; i < end; ++i) {
+    if (blk.IsOverlap(blockage_rects_[i])) return true;
+  }
+  return false;
+}
+
 /****
  * this is a member function to update grid bin status, because the cell_list,
  * cell_area and over_fill state can be changed, so we need to update them when
  * necessary
+ *
+ * Cells are bucketed by a counting sort: each thread counts cells of a
+ * contiguous range of blocks per bin, a prefix sum over ranges gives where
+ * each range writes in the cell list of a bin, and cells are scattered to
+ * their slots. Cell lists keep their capacity among iterations, and cells in
+ * a bin are in block order for any number of threads.
  * ****/
 void LookAheadLegalizer::UpdateGridBinState() {
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
-  // clean the old data
-  for (auto& grid_bin_column : grid_bin_mesh) {
-    for (auto& grid_bin : grid_bin_column) {
-      grid_bin.cell_list.clear();
-      grid_bin.cell_area = 0;
-      grid_bin.over_fill = false;
-    }
-  }
-
   // for each cell, find the index of the grid bin it should be in.
   // note that in extreme cases, the index might be smaller than 0 or larger
   // than the maximum allowed index, because the cell is on the boundaries,
   // so we need to make some modifications for these extreme cases.
   std::vector<Block>& blocks = ckt_ptr_->Blocks();
   int sz = static_cast<int>(blocks.size());
-  int x_index = 0;
-  int y_index = 0;
-
-  for (int i = 0; i < sz; i++) {
-    if (blocks[i].IsFixed()) continue;
-    x_index = (int)std::floor((blocks[i].X() - ckt_ptr_->RegionLLX()) /
-                              grid_bin_width);
-    y_index = (int)std::floor((blocks[i].Y() - ckt_ptr_->RegionLLY()) /
-                              grid_bin_height);
-    if (x_index < 0) x_index = 0;
-    if (x_index > grid_cnt_x - 1) x_index = grid_cnt_x - 1;
-    if (y_index < 0) y_index = 0;
-    if (y_index > grid_cnt_y - 1) y_index = grid_cnt_y - 1;
-    grid_bin_mesh[x_index][y_index].cell_list.push_back(&(blocks[i]));
-    grid_bin_mesh[x_index][y_index].cell_area += blocks[i].Area();
-  }
+  int num_bins = grid_cnt_x * grid_cnt_y;
+  int num_ranges = std::max(1, std::min(num_threads_, sz));
+  cell_bin_ids_.resize(sz);
+  range_bin_offsets_.assign(static_cast<size_t>(num_ranges) * num_bins, 0);
+
+#pragma omp parallel num_threads(num_threads_) default(none) \
+    shared(blocks, sz, num_bins, num_ranges)
+  {
+#pragma omp for schedule(static)
+    for (int r = 0; r < num_ranges; ++r) {
+      int begin = static_cast<int>(static_cast<long long>(sz) * r / num_ranges);
+      int end =
+          static_cast<int>(static_cast<long long>(sz) * (r + 1) / num_ranges);
+      int* bin_counts = range_bin_offsets_.data() +
+                        static_cast<size_t>(r) * num_bins;
+      for (int i = begin; i < end; ++i) {
+        if (blocks[i].IsFixed()) {
+          cell_bin_ids_[i] = -1;
+          continue;
+        }
+        int x_index = (int)std::floor(
+            (blocks[i].X() - ckt_ptr_->RegionLLX()) / grid_bin_width);
+        int y_index = (int)std::floor(
+            (blocks[i].Y() - ckt_ptr_->RegionLLY()) / grid_bin_height);
+        if (x_index < 0) x_index = 0;
+        if (x_index > grid_cnt_x - 1) x_index = grid_cnt_x - 1;
+        if (y_index < 0) y_index = 0;
+        if (y_index > grid_cnt_y - 1) y_index = grid_cnt_y - 1;
+        int bin_id = x_index * grid_cnt_y + y_index;
+        cell_bin_ids_[i] = bin_id;
+        ++bin_counts[bin_id];
+      }
+    }
 
-  /**** below is the criterion to decide whether a grid bin is over_filled or
-   * not
-   * 1. if this bin if fully occupied by fixed blocks, but its cell_list is
-   *    non-empty, which means there is some cells overlap with this grid bin,
-   *    we say it is over_fill
-   * 2. if not fully occupied by fixed blocks, but filling_rate is larger than
-   *    the TARGET_FILLING_RATE, then set is to over_fill
-   * 3. if this bin is not overfilled, but cells in this bin overlaps with fixed
-   *    blocks in this bin, we also mark it as over_fill
-   * ****/
-  // TODO: the third criterion might be changed in the next
-  bool over_fill = false;
-  for (auto& grid_bin_column : grid_bin_mesh) {
-    for (auto& grid_bin : grid_bin_column) {
+    // turn counts into offsets of ranges in each bin, and size cell lists
+#pragma omp for schedule(static)
+    for (int b = 0; b < num_bins; ++b) {
+      int offset = 0;
+      for (int r = 0; r < num_ranges; ++r) {
+        int& range_offset =
+            range_bin_offsets_[static_cast<size_t>(r) * num_bins + b];
+        int count = range_offset;
+        range_offset = offset;
+        offset += count;
+      }
+      GridBin& grid_bin = grid_bin_mesh[b / grid_cnt_y][b % grid_cnt_y];
+      grid_bin.cell_list.resize(offset);
+      grid_bin.cell_area = 0;
+      grid_bin.over_fill = false;
+    }
+
+#pragma omp for schedule(static)
+    for (int r = 0; r < num_ranges; ++r) {
+      int begin = static_cast<int>(static_cast<long long>(sz) * r / num_ranges);
+      int end =
+          static_cast<int>(static_cast<long long>(sz) * (r + 1) / num_ranges);
+      int* bin_offsets = range_bin_offsets_.data() +
+                         static_cast<size_t>(r) * num_bins;
+      for (int i = begin; i < end; ++i) {
+        int bin_id = cell_bin_ids_[i];
+        if (bin_id < 0) continue;
+        GridBin& grid_bin =
+            grid_bin_mesh[bin_id / grid_cnt_y][bin_id % grid_cnt_y];
+        grid_bin.cell_list[bin_offsets[bin_id]++] = &blocks[i];
+      }
+    }
+
+    /**** below is the criterion to decide whether a grid bin is over_filled
+     * or not
+     * 1. if this bin if fully occupied by fixed blocks, but its cell_list is
+     *    non-empty, which means there is some cells overlap with this grid
+     *    bin, we say it is over_fill
+     * 2. if not fully occupied by fixed blocks, but filling_rate is larger
+     *    than the TARGET_FILLING_RATE, then set is to over_fill
+     * 3. if this bin is not overfilled, but cells in this bin overlaps with
+     *    fixed blocks in this bin, we also mark it as over_fill
+     * ****/
+    // TODO: the third criterion might be changed in the next
+#pragma omp for schedule(dynamic, 64)
+    for (int b = 0; b < num_bins; ++b) {
+      GridBin& grid_bin = grid_bin_mesh[b / grid_cnt_y][b % grid_cnt_y];
+      for (auto& blk_ptr : grid_bin.cell_list) {
+        grid_bin.cell_area += blk_ptr->Area();
+      }
       if (grid_bin.global_placed) {
         grid_bin.over_fill = false;
         continue;
@@ -332,156 +433,56 @@ void LookAheadLegalizer::UpdateGridBinState() {
       }
       if (!grid_bin.OverFill()) {
         for (auto& blk_ptr : grid_bin.cell_list) {
-          for (auto& blockage_ptr : grid_bin.placement_blockages_) {
-            auto& rect = blockage_ptr->GetRect();
-            over_fill = blk_ptr->IsOverlap(rect);
-            if (over_fill) {
-              grid_bin.over_fill = true;
-              break;
-            }
-          }
-          if (over_fill) {
+          if (IsOverlapWithBlockages(*blk_ptr, b)) {
+            grid_bin.over_fill = true;
             break;
           }
-          // two breaks have to be used to break two loops
         }
       }
     }
   }
   elapsed_time.RecordEndTime();
   update_grid_bin_state_time_ += elapsed_time.GetWallTime();
+  RecordPlacementTime("update_grid_bin_state", elapsed_time.GetWallTime());
 }
 
-void LookAheadLegalizer::UpdateClusterArea(GridBinCluster& cluster) {
-  cluster.total_cell_area = 0;
-  cluster.total_white_space = 0;
-  for (auto& index : cluster.bin_set) {
-    cluster.total_cell_area += grid_bin_mesh[index.x][index.y].cell_area;
-    cluster.total_white_space += grid_bin_mesh[index.x][index.y].white_space;
+/****
+ * @brief Return the area of cells beyond the target density of their grid
+ * bins, normalized by the area of all movable cells. It is computed from the
+ * grid bin state, so call it after UpdateGridBinState().
+ */
+double LookAheadLegalizer::Overflow() const {
+  double overflow_area = 0;
+  double tot_cell_area = 0;
+  for (auto& grid_bin_column : grid_bin_mesh) {
+    for (auto& grid_bin : grid_bin_column) {
+      auto cell_area = static_cast<double>(grid_bin.cell_area);
+      tot_cell_area += cell_area;
+      overflow_area += std::max(
+          0.0, cell_area - placement_density_ * grid_bin.white_space);
+    }
   }
+  return tot_cell_area > 0 ? overflow_area / tot_cell_area : 0;
 }
 
+/****
+ * @brief Find clusters of connected over-filled grid bins.
+ */
 void LookAheadLegalizer::UpdateClusterList() {
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
-  cluster_set.clear();
-
-  int m = (int)grid_bin_mesh.size();     // number of rows
-  int n = (int)grid_bin_mesh[0].size();  // number of columns
-  for (int i = 0; i < m; ++i) {
-    for (int j = 0; j < n; ++j) grid_bin_mesh[i][j].cluster_visited = false;
-  }
-  int cnt = 0;
-  for (int i = 0; i < m; ++i) {
-    for (int j = 0; j < n; ++j) {
-      if (grid_bin_mesh[i][j].cluster_visited || !grid_bin_mesh[i][j].over_fill)
-        continue;
-      GridBinIndex b(i, j);
-      GridBinCluster H;
-      H.bin_set.insert(b);
-      grid_bin_mesh[i][j].cluster_visited = true;
-      cnt = 0;
-      std::queue<GridBinIndex> Q;
-      Q.push(b);
-      while (!Q.empty()) {
-        b = Q.front();
-        Q.pop();
-        for (auto& index : grid_bin_mesh[b.x][b.y].adjacent_bin_index) {
-          GridBin& bin = grid_bin_mesh[index.x][index.y];
-          if (!bin.cluster_visited && bin.over_fill) {
-            if (cnt > cluster_upper_size) {
-              UpdateClusterArea(H);
-              cluster_set.insert(H);
-              break;
-            }
-            bin.cluster_visited = true;
-            H.bin_set.insert(index);
-            ++cnt;
-            Q.push(index);
-          }
-        }
-      }
-      UpdateClusterArea(H);
-      cluster_set.insert(H);
-    }
-  }
+  cluster_queue_.Build(grid_bin_mesh, cluster_upper_size);
   elapsed_time.RecordEndTime();
   update_cluster_list_time_ += elapsed_time.GetWallTime();
+  RecordPlacementTime("update_cluster_list", elapsed_time.GetWallTime());
 }
 
+/****
+ * @brief Make sure the largest cluster has no roughly legalized grid bin, by
+ * splitting clusters with roughly legalized bins.
+ */
 void LookAheadLegalizer::UpdateLargestCluster() {
-  if (cluster_set.empty()) return;
-
-  for (auto it = cluster_set.begin(); it != cluster_set.end();) {
-    bool is_contact = true;
-
-    // if there is no grid bin has been roughly legalized, then this cluster is
-    // the largest one for sure
-    for (auto& index : it->bin_set) {
-      if (grid_bin_mesh[index.x][index.y].global_placed) {
-        is_contact = false;
-      }
-    }
-    if (is_contact) break;
-
-    // initialize a list to store all indices in this cluster
-    // initialize a map to store the visited flag during bfs
-    std::vector<GridBinIndex> grid_bin_list;
-    grid_bin_list.reserve(it->bin_set.size());
-    std::unordered_map<GridBinIndex, bool, GridBinIndexHasher> grid_bin_visited;
-    for (auto& index : it->bin_set) {
-      grid_bin_list.push_back(index);
-      grid_bin_visited.insert({index, false});
-    }
-
-    std::sort(grid_bin_list.begin(), grid_bin_list.end(),
-              [](const GridBinIndex& index1, const GridBinIndex& index2) {
-                return (index1.x < index2.x) ||
-                       (index1.x == index2.x && index1.y < index2.y);
-              });
-
-    int cnt = 0;
-    for (auto& grid_index : grid_bin_list) {
-      int i = grid_index.x;
-      int j = grid_index.y;
-      if (grid_bin_visited[grid_index])
-        continue;  // if this grid bin has been visited continue
-      if (grid_bin_mesh[i][j].global_placed)
-        continue;  // if this grid bin has been roughly legalized
-      GridBinIndex b(i, j);
-      GridBinCluster H;
-      H.bin_set.insert(b);
-      grid_bin_visited[grid_index] = true;
-      cnt = 0;
-      std::queue<GridBinIndex> Q;
-      Q.push(b);
-      while (!Q.empty()) {
-        b = Q.front();
-        Q.pop();
-        for (auto& index : grid_bin_mesh[b.x][b.y].adjacent_bin_index) {
-          if (grid_bin_visited.find(index) == grid_bin_visited.end()) {
-            continue;  // this index is not in the cluster
-          }
-          if (grid_bin_visited[index]) continue;  // this index has been visited
-          if (grid_bin_mesh[index.x][index.y].global_placed)
-            continue;  // if this grid bin has been roughly legalized
-          if (cnt > cluster_upper_size) {
-            UpdateClusterArea(H);
-            cluster_set.insert(H);
-            break;
-          }
-          grid_bin_visited[index] = true;
-          H.bin_set.insert(index);
-          ++cnt;
-          Q.push(index);
-        }
-      }
-      UpdateClusterArea(H);
-      cluster_set.insert(H);
-    }
-
-    it = cluster_set.erase(it);
-  }
+  cluster_queue_.SplitPlacedClusters(grid_bin_mesh, cluster_upper_size);
 }
 
 uint32_t LookAheadLegalizer::LookUpWhiteSpace(GridBinIndex const& ll_index,
@@ -555,7 +556,7 @@ void LookAheadLegalizer::FindMinimumBoxForLargestCluster() {
 
   // clear the queue_box_bin
   while (!queue_box_bin.empty()) queue_box_bin.pop();
-  if (cluster_set.empty()) return;
+  if (cluster_queue_.IsEmpty()) return;
 
   // Part 1
   BoxBin R;
@@ -567,8 +568,10 @@ void LookAheadLegalizer::FindMinimumBoxForLargestCluster() {
   R.ur_index.y = 0;
   // initialize a box with y cut-direction
   // identify the bounding box of the initial cluster
-  auto it = cluster_set.begin();
-  for (auto& index : it->bin_set) {
+  GridBinCluster const& cluster = cluster_queue_.Top();
+  auto& cluster_bins = cluster_queue_.Bins();
+  for (int k = cluster.bin_begin; k < cluster.bin_end; ++k) {
+    auto& index = cluster_bins[k];
     R.ll_index.x = std::min(R.ll_index.x, index.x);
     R.ur_index.x = std::max(R.ur_index.x, index.x);
     R.ll_index.y = std::min(R.ll_index.y, index.y);
@@ -623,6 +626,8 @@ void LookAheadLegalizer::FindMinimumBoxForLargestCluster() {
 
   elapsed_time.RecordEndTime();
   find_minimum_box_for_largest_cluster_time_ += elapsed_time.GetWallTime();
+  RecordPlacementTime("find_minimum_box_for_largest_cluster",
+                      elapsed_time.GetWallTime());
 }
 
 /****
@@ -630,7 +635,8 @@ void LookAheadLegalizer::FindMinimumBoxForLargestCluster() {
  *
  * @param box: the BoxBin which needs to be further splitted into two sub-boxes
  */
-void LookAheadLegalizer::SplitGridBox(BoxBin& box) {
+void LookAheadLegalizer::SplitGridBox(BoxBin& box,
+                                      std::queue<BoxBin>& box_queue) {
   // 1. create two sub-boxes
   BoxBin box1, box2;
   // the first sub-box should have the same lower left corner as the original
@@ -664,7 +670,7 @@ void LookAheadLegalizer::SplitGridBox(BoxBin& box) {
       box2.cell_list = box.cell_list;
       box2.total_cell_area = box.total_cell_area;
       box2.UpdateObsBoundary();
-      queue_box_bin.push(box2);
+      box_queue.push(box2);
     } else if (double(box2.total_white_space) / (double)box.total_white_space <=
                0.01) {
       box1.ll_point = box.ll_point;
@@ -672,7 +678,7 @@ void LookAheadLegalizer::SplitGridBox(BoxBin& box) {
       box1.cell_list = box.cell_list;
       box1.total_cell_area = box.total_cell_area;
       box1.UpdateObsBoundary();
-      queue_box_bin.push(box1);
+      box_queue.push(box1);
     } else {
       box.update_cut_point_cell_list_low_high(box1.total_white_space,
                                               box2.total_white_space);
@@ -686,8 +692,8 @@ void LookAheadLegalizer::SplitGridBox(BoxBin& box) {
       box2.total_cell_area = box.total_cell_area_high;
       box1.UpdateObsBoundary();
       box2.UpdateObsBoundary();
-      queue_box_bin.push(box1);
-      queue_box_bin.push(box2);
+      box_queue.push(box1);
+      box_queue.push(box2);
     }
   } else {
     // box.Report();
@@ -706,7 +712,7 @@ void LookAheadLegalizer::SplitGridBox(BoxBin& box) {
       box2.cell_list = box.cell_list;
       box2.total_cell_area = box.total_cell_area;
       box2.UpdateObsBoundary();
-      queue_box_bin.push(box2);
+      box_queue.push(box2);
     } else if (double(box2.total_white_space) / (double)box.total_white_space <=
                0.01) {
       box1.ll_point = box.ll_point;
@@ -714,7 +720,7 @@ void LookAheadLegalizer::SplitGridBox(BoxBin& box) {
       box1.cell_list = box.cell_list;
       box1.total_cell_area = box.total_cell_area;
       box1.UpdateObsBoundary();
-      queue_box_bin.push(box1);
+      box_queue.push(box1);
     } else {
       box.update_cut_point_cell_list_low_high(box1.total_white_space,
                                               box2.total_white_space);
@@ -728,8 +734,8 @@ void LookAheadLegalizer::SplitGridBox(BoxBin& box) {
       box2.total_cell_area = box.total_cell_area_high;
       box1.UpdateObsBoundary();
       box2.UpdateObsBoundary();
-      queue_box_bin.push(box1);
-      queue_box_bin.push(box2);
+      box_queue.push(box1);
+      box_queue.push(box2);
     }
   }
 }
@@ -816,7 +822,8 @@ cell_box_bottom)/cell_box_height * (box.top - box.bottom) + box.bottom);
   }
 }
 
-void LookAheadLegalizer::SplitBox(BoxBin& box) {
+void LookAheadLegalizer::SplitBox(BoxBin& box,
+                                  std::queue<BoxBin>& box_queue) {
   bool flag_bisection_complete;
   int dominating_box_flag;  // indicate whether there is a dominating BoxBin
   BoxBin box1, box2;
@@ -917,8 +924,8 @@ if ((box2.left < LEFT) || (box2.bottom < BOTTOM)) {
 "\n"; LOG(info)   << box2.left << " " << box2.bottom << "\n";
 }*/
 
-    queue_box_bin.push(box1);
-    queue_box_bin.push(box2);
+    box_queue.push(box1);
+    box_queue.push(box2);
     // box1.write_box_boundary("first_bounding_box.txt", grid_bin_width,
     // grid_bin_height, LEFT, BOTTOM);
     // box2.write_box_boundary("first_bounding_box.txt", grid_bin_width,
@@ -940,7 +947,7 @@ if ((box2.left < LEFT) || (box2.bottom < BOTTOM)) {
 "\n"; LOG(info)   << box2.left << " " << box2.bottom << "\n";
 }*/
 
-    queue_box_bin.push(box2);
+    box_queue.push(box2);
     // box2.write_box_boundary("first_bounding_box.txt", grid_bin_width,
     // grid_bin_height, LEFT, BOTTOM);
     // box2.write_cell_region("first_cell_bounding_box.txt");
@@ -959,7 +966,7 @@ if ((box2.left < LEFT) || (box2.bottom < BOTTOM)) {
 "\n"; LOG(info)   << box1.left << " " << box1.bottom << "\n";
 }*/
 
-    queue_box_bin.push(box1);
+    box_queue.push(box1);
     // box1.write_box_boundary("first_bounding_box.txt", grid_bin_width,
     // grid_bin_height, LEFT, BOTTOM);
     // box1.write_cell_region("first_cell_bounding_box.txt");
@@ -967,18 +974,13 @@ if ((box2.left < LEFT) || (box2.bottom < BOTTOM)) {
 }
 
 /****
- * keep splitting the biggest box to many small boxes, and keep update the shape
- * of each box and cells should be assigned to the box
- * @return true if succeed, false if fail
+ * @brief Spread boxes in @param box_queue in first-in-first-out order until
+ * the queue is empty. Boxes of a single grid bin are placed, or split again if
+ * there are placement blockages inside, other boxes are bisected.
  */
-bool LookAheadLegalizer::RecursiveBisectionBlockSpreading() {
-  ElapsedTime elapsed_time;
-  elapsed_time.RecordStartTime();
-
-  while (!queue_box_bin.empty()) {
-    // std::cout << queue_box_bin.size() << "\n";
-    if (queue_box_bin.empty()) break;
-    BoxBin& box = queue_box_bin.front();
+void LookAheadLegalizer::SpreadBoxes(std::queue<BoxBin>& box_queue) {
+  while (!box_queue.empty()) {
+    BoxBin& box = box_queue.front();
     // start moving cells to the box, if
     // (a) the box is a grid bin box or a smaller box
     // (b) and with no fixed macros inside
@@ -986,8 +988,8 @@ bool LookAheadLegalizer::RecursiveBisectionBlockSpreading() {
       // UpdateGridBinBlocks(box);
       if (box.HasPlacementBlockages()) {  // if there is a fixed macro inside a
                                           // box, keep splitting the box
-        SplitGridBox(box);
-        queue_box_bin.pop();
+        SplitGridBox(box, box_queue);
+        box_queue.pop();
         continue;
       }
       /* if no terminals inside a box, do cell placement inside the box */
@@ -995,13 +997,69 @@ bool LookAheadLegalizer::RecursiveBisectionBlockSpreading() {
       PlaceBlkInBox(box);
       // RoughLegalBlkInBox(box);
     } else {
-      SplitBox(box);
+      SplitBox(box, box_queue);
     }
+    box_queue.pop();
+  }
+}
+
+/****
+ * @brief Spread @param box with OpenMP tasks, one task per sub-box.
+ *
+ * The two sub-boxes of SplitBox() cover disjoint grid bins and get disjoint
+ * cells, and a box only reads and writes grid bins and cells of its own. So
+ * sub-boxes can be spread in any order, and the placement is the same as
+ * SpreadBoxes() for any number of threads. Sub-boxes of SplitGridBox() share
+ * one grid bin, so boxes of a single grid bin are spread by SpreadBoxes() in
+ * one task, and so are small boxes to limit the overhead of tasks.
+ */
+void LookAheadLegalizer::SpreadBoxInParallel(BoxBin& box) {
+  if (box.ll_index == box.ur_index ||
+      static_cast<int>(box.cell_list.size()) < min_cells_per_task_) {
+    std::queue<BoxBin> box_queue;
+    box_queue.push(std::move(box));
+    SpreadBoxes(box_queue);
+    return;
+  }
+
+  std::queue<BoxBin> box_queue;
+  SplitBox(box, box_queue);
+  std::vector<BoxBin> sub_boxes;
+  while (!box_queue.empty()) {
+    sub_boxes.push_back(std::move(box_queue.front()));
+    box_queue.pop();
+  }
+  for (auto& sub_box : sub_boxes) {
+    BoxBin* sub_box_ptr = &sub_box;
+#pragma omp task default(none) firstprivate(sub_box_ptr)
+    SpreadBoxInParallel(*sub_box_ptr);
+  }
+#pragma omp taskwait
+}
+
+/****
+ * keep splitting the biggest box to many small boxes, and keep update the shape
+ * of each box and cells should be assigned to the box
+ * @return true if succeed, false if fail
+ */
+bool LookAheadLegalizer::RecursiveBisectionBlockSpreading() {
+  ElapsedTime elapsed_time;
+  elapsed_time.RecordStartTime();
+
+  if (num_threads_ > 1 && queue_box_bin.size() == 1) {
+    BoxBin box = std::move(queue_box_bin.front());
     queue_box_bin.pop();
+#pragma omp parallel num_threads(num_threads_) default(none) shared(box)
+#pragma omp single
+    SpreadBoxInParallel(box);
+  } else {
+    SpreadBoxes(queue_box_bin);
   }
 
   elapsed_time.RecordEndTime();
   recursive_bisection_block_spreading_time_ += elapsed_time.GetWallTime();
+  RecordPlacementTime("recursive_bisection_block_spreading",
+                      elapsed_time.GetWallTime());
   return true;
 }
 
@@ -1011,22 +1069,23 @@ double LookAheadLegalizer::RemoveCellOverlap() {
 
   ClearGridBinFlag();
   UpdateGridBinState();
+  AppendPlacementSeries("global_placement.overflow", Overflow());
   UpdateClusterList();
   do {
     UpdateLargestCluster();
     FindMinimumBoxForLargestCluster();
     RecursiveBisectionBlockSpreading();
-    // LOG(info) << "cluster count: " << cluster_set.size() <<
+    // LOG(info) << "cluster count: " << cluster_queue_.NumClusters() <<
     // "\n";
-  } while (!cluster_set.empty());
+  } while (!cluster_queue_.IsEmpty());
 
   // ExtendedTetrisLegalizer legalizer_;
   // legalizer_.TakeOver(this);
   // legalizer_.StartPlacement();
 
-  double evaluate_result_x = ckt_ptr_->WeightedHPWLX();
+  double evaluate_result_x = ckt_ptr_->WeightedHPWLX(netlist_view_);
   upper_bound_hpwl_x_.push_back(evaluate_result_x);
-  double evaluate_result_y = ckt_ptr_->WeightedHPWLY();
+  double evaluate_result_y = ckt_ptr_->WeightedHPWLY(netlist_view_);
   upper_bound_hpwl_y_.push_back(evaluate_result_y);
   LOG(debug) << "Look-ahead legalization complete\n";
 
@@ -22,11 +22,11 @@
 #define DALI_PLACER_GLOBAL_PLACER_ROUGH_LEGALIZER_H_
 
 #include <queue>
-#include <set>
 
 #include "dali/circuit/circuit.h"
 #include "dali/placer/global_placer/box_bin.h"
 #include "dali/placer/global_placer/grid_bin.h"
+#include "dali/placer/global_placer/grid_bin_cluster.h"
 
 namespace dali {
 
@@ -60,9 +60,13 @@ class RoughLegalizer {
   /** Enable or disable intermediate placement dumps. */
   void SetShouldSaveIntermediateResult(bool should_save_intermediate_result);
 
+  /** Set number of threads, the placement does not depend on it. */
+  void SetNumThreads(int num_threads);
+
  protected:
   Circuit* ckt_ptr_ = nullptr;
   double placement_density_ = 1.0;
+  int num_threads_ = 1;
   std::vector<double> upper_bound_hpwl_;
   std::vector<double> upper_bound_hpwl_x_;
   std::vector<double> upper_bound_hpwl_y_;
@@ -82,6 +86,8 @@ class LookAheadLegalizer : public RoughLegalizer {
   void InitializeGridBinSize();
   void UpdateAttributesForAllGridBins();
   void UpdatePlacementBlockagesInGridBins();
+  void BuildBlockageIndex();
+  bool IsOverlapWithBlockages(Block const& blk, int bin_id) const;
   void UpdateDummyPlacementBlockagesInGridBins();
   void UpdateWhiteSpaceInGridBin(GridBin& grid_bin);
   void InitGridBins();
@@ -90,25 +96,34 @@ class LookAheadLegalizer : public RoughLegalizer {
 
   void ClearGridBinFlag();
   void UpdateGridBinState();
-  void UpdateClusterArea(GridBinCluster& cluster);
+  double Overflow() const;
   void UpdateClusterList();
   void UpdateLargestCluster();
   uint32_t LookUpWhiteSpace(GridBinIndex const& ll_index,
                             GridBinIndex const& ur_index);
   uint32_t LookUpWhiteSpace(WindowQuadruple& window);
   void FindMinimumBoxForLargestCluster();
-  void SplitGridBox(BoxBin& box);
+  void SplitGridBox(BoxBin& box, std::queue<BoxBin>& box_queue);
   void PlaceBlkInBox(BoxBin& box);
-  void SplitBox(BoxBin& box);
+  void SplitBox(BoxBin& box, std::queue<BoxBin>& box_queue);
+  void SpreadBoxes(std::queue<BoxBin>& box_queue);
+  void SpreadBoxInParallel(BoxBin& box);
   bool RecursiveBisectionBlockSpreading();
   double RemoveCellOverlap() override;
 
+  /** Return grid bins, indexed by x and then y. */
+  std::vector<std::vector<GridBin>> const& GridBinMesh() const {
+    return grid_bin_mesh;
+  }
+
   double GetTime() override;
   void Close() override;
 
  private:
   int number_of_cell_in_bin_ = 30;
   int cluster_upper_size = 3;
+  // boxes with fewer cells are spread by one task without further tasks
+  int min_cells_per_task_ = 256;
 
   // look ahead legalization member function implemented below
   int grid_bin_height = 0;
@@ -117,8 +132,20 @@ class LookAheadLegalizer : public RoughLegalizer {
   int grid_cnt_y = 0;
   std::vector<std::vector<GridBin>> grid_bin_mesh;
   std::vector<std::vector<unsigned long long>> grid_bin_white_space_LUT;
-
-  std::multiset<GridBinCluster, std::greater<>> cluster_set;
+  // placement blockages of grid bin i, with i = x * grid_cnt_y + y, are in
+  // [blockage_rect_begin_[i], blockage_rect_begin_[i+1]) of blockage_rects_
+  std::vector<int> blockage_rect_begin_;
+  std::vector<RectI> blockage_rects_;
+  std::vector<RectI> blockage_bboxes_;
+  // buffers of UpdateGridBinState(), the grid bin of each cell and cell
+  // offsets of each block range in each grid bin
+  std::vector<int> cell_bin_ids_;
+  std::vector<int> range_bin_offsets_;
+
+  // evaluates upper-bound HPWL with the batched wirelength kernels
+  NetlistView netlist_view_;
+
+  GridBinClusterQueue cluster_queue_;
   std::queue<BoxBin> queue_box_bin;
 
   double update_grid_bin_state_time_ = 0;
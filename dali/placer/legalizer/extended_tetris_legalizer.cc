@@ -23,10 +23,13 @@
 #include <algorithm>
 #include <cfloat>
 #include <climits>
+#include <iterator>
 #include <list>
+#include <numeric>
 
 #include "dali/common/helper.h"
 #include "dali/common/misc.h"
+#include "dali/common/placement_metrics.h"
 
 namespace dali {
 
@@ -61,6 +64,10 @@ void ExtendedTetrisLegalizer::SetLeftBoundFactor(double k_left,
   k_left_step_ = k_left_step;
 }
 
+void ExtendedTetrisLegalizer::SetRowBandMode(bool is_row_band_mode) {
+  is_row_band_mode_ = is_row_band_mode;
+}
+
 void ExtendedTetrisLegalizer::InitializeFromGriddedRowLegalizer(
     GriddedRowLegalizer* grlg) {
   DaliExpects(grlg != nullptr,
@@ -91,8 +98,7 @@ void ExtendedTetrisLegalizer::InitializeFromGriddedRowLegalizer(
     }
   }
 
-  block_contour_.clear();
-  block_contour_.resize(tot_num_rows_, left_);
+  block_contour_.Assign(tot_num_rows_, left_);
 
   BlockInitialLocation tmp_index_loc_pair(nullptr, 0, 0);
   blk_inits_.clear();
@@ -108,7 +114,7 @@ void ExtendedTetrisLegalizer::SetRowInfoAuto() {
     }
   }
   tot_num_rows_ = (top_ - bottom_) / row_height_;
-  block_contour_.resize(tot_num_rows_, left_);
+  block_contour_.Assign(tot_num_rows_, left_);
 }
 
 void ExtendedTetrisLegalizer::DetectWhiteSpace() {
@@ -273,36 +279,70 @@ bool ExtendedTetrisLegalizer::IsSpaceLegal(int lo_x, int hi_x, int lo_row,
     return false;
   }
 
-  bool is_tmp_row_legal;
-  bool is_partial_cover_lo;
-  bool is_partial_cover_hi;
-  bool is_before_seg;
-  int seg_count = 0;
-
-  bool is_all_row_legal = true;
   for (int i = lo_row; i <= hi_row; ++i) {
-    seg_count = rows_[i].size();
-    is_tmp_row_legal = false;
-    for (int j = 0; j < seg_count; ++j) {
-      if (rows_[i][j].lo <= lo_x && rows_[i][j].hi >= hi_x) {
-        is_tmp_row_legal = true;
-        break;
-      }
-
-      is_partial_cover_lo = rows_[i][j].lo > lo_x && rows_[i][j].lo < hi_x;
-      is_partial_cover_hi = rows_[i][j].hi > lo_x && rows_[i][j].hi < hi_x;
-      is_before_seg = rows_[i][j].lo >= hi_x;
-      if (is_partial_cover_lo || is_partial_cover_hi || is_before_seg) {
-        break;
-      }
+    if (CoveringSegment(i, lo_x, hi_x) < 0) {
+      return false;
     }
+  }
+  return true;
+}
 
-    if (!is_tmp_row_legal) {
-      is_all_row_legal = false;
-      break;
+/****
+ * Segments in a row are sorted and do not overlap, so only the last segment
+ * starting at or before lo_x can cover [lo_x, hi_x].
+ * ****/
+int ExtendedTetrisLegalizer::CoveringSegment(int row_id, int lo_x,
+                                             int hi_x) const {
+  auto& segments = rows_[row_id];
+  auto it = std::upper_bound(
+      segments.begin(), segments.end(), lo_x,
+      [](int x, SegI const& seg) { return x < seg.lo; });
+  if (it == segments.begin()) return -1;
+  --it;
+  if (it->hi < hi_x) return -1;
+  return static_cast<int>(it - segments.begin());
+}
+
+/****
+ * The distance of a segment is the smallest |p - lo_x| + |p - hi_x| of its two
+ * end points p. This function is convex in p, and end points of sorted
+ * non-overlapping segments are sorted, so the nearest end point is either the
+ * last one before lo_x or the first one at or after lo_x. Ties go to the
+ * earlier end point, which belongs to the first segment with this distance,
+ * the same as a linear scan.
+ * ****/
+int ExtendedTetrisLegalizer::NearestSegment(int row_id, int lo_x, int hi_x,
+                                            int& distance) const {
+  auto& segments = rows_[row_id];
+  auto hi_at_or_after = [&segments](int x) {
+    return std::lower_bound(segments.begin(), segments.end(), x,
+                            [](SegI const& seg, int val) {
+                              return seg.hi < val;
+                            });
+  };
+  auto it = hi_at_or_after(lo_x);
+  int best_x = 0;
+  distance = INT_MAX;
+  // the last end point before lo_x
+  if (it != segments.end() && it->lo < lo_x) {
+    best_x = it->lo;
+    distance = abs(best_x - lo_x) + abs(best_x - hi_x);
+  } else if (it != segments.begin()) {
+    best_x = std::prev(it)->hi;
+    distance = abs(best_x - lo_x) + abs(best_x - hi_x);
+  }
+  // the first end point at or after lo_x
+  if (it != segments.end()) {
+    int x = it->lo >= lo_x ? it->lo : it->hi;
+    int tmp_distance = abs(x - lo_x) + abs(x - hi_x);
+    if (tmp_distance < distance) {
+      best_x = x;
+      distance = tmp_distance;
     }
   }
-  return is_all_row_legal;
+  if (distance == INT_MAX) return -1;
+  // the first segment with an end point at best_x
+  return static_cast<int>(hi_at_or_after(best_x) - segments.begin());
 }
 
 bool ExtendedTetrisLegalizer::IsFitToRow(int row_id, Block& block) const {
@@ -344,20 +384,26 @@ bool ExtendedTetrisLegalizer::ShouldOrientN(int row_id, Block& block) const {
 }
 
 void ExtendedTetrisLegalizer::InitBlockContourForward() {
-  block_contour_.assign(block_contour_.size(), left_);
+  block_contour_.Assign(block_contour_.Size(), left_);
 }
 
 void ExtendedTetrisLegalizer::InitAndSortBlockAscendingX() {
   blk_inits_.clear();
-  auto& blocks = ckt_ptr_->Blocks();
-  for (auto& blk : blocks) {
-    // skipp dummy blocks and fixed blocks
-    if (IsDummyBlock(blk)) continue;
-    if (blk.IsFixed()) continue;
+  auto add_block = [this](Block& blk) {
     double x_loc =
         blk.LLX() - k_width_ * blk.Width() - k_height_ * blk.Height();
     double y_loc = blk.LLY();
     blk_inits_.emplace_back(&blk, x_loc, y_loc);
+  };
+  if (is_row_band_) {
+    for (Block* blk_ptr : band_blks_) add_block(*blk_ptr);
+  } else {
+    for (auto& blk : ckt_ptr_->Blocks()) {
+      // skipp dummy blocks and fixed blocks
+      if (IsDummyBlock(blk)) continue;
+      if (blk.IsFixed()) continue;
+      add_block(blk);
+    }
   }
 
   std::sort(
@@ -381,9 +427,7 @@ void ExtendedTetrisLegalizer::UseSpaceLeft(Block const& block) {
   DaliExpects(start_row >= 0, "Out of bound?");
 
   int end_x = int(block.URX());
-  for (int i = start_row; i <= end_row; ++i) {
-    block_contour_[i] = end_x;
-  }
+  block_contour_.AssignRange(start_row, end_row, end_x);
 }
 
 /****
@@ -411,13 +455,7 @@ bool ExtendedTetrisLegalizer::IsCurrentLocLegalLeft(Value2D<int>& loc,
   }
 
   // is space not occupied by other cells?
-  for (int i = start_row; i <= end_row; ++i) {
-    if (block_contour_[i] > loc.x) {
-      return false;
-    }
-  }
-
-  return true;
+  return block_contour_.MaxInRange(start_row, end_row) <= loc.x;
 }
 
 /****
@@ -438,16 +476,15 @@ int ExtendedTetrisLegalizer::WhiteSpaceBoundLeft(int lo_x, int hi_x, int lo_row,
 
   for (int i = lo_row; i <= hi_row; ++i) {
     tmp_bound = left_;
-    for (auto& seg : rows_[i]) {
-      if (seg.lo <= lo_x && seg.hi >= hi_x) {
-        tmp_bound = seg.lo;
-        min_distance = 0;
-        break;
-      }
-      int tmp_distance = std::min(abs(seg.lo - lo_x) + abs(seg.lo - hi_x),
-                                  abs(seg.hi - lo_x) + abs(seg.hi - hi_x));
-      if (tmp_distance < min_distance) {
-        tmp_bound = seg.lo;
+    int seg_id = CoveringSegment(i, lo_x, hi_x);
+    if (seg_id >= 0) {
+      tmp_bound = rows_[i][seg_id].lo;
+      min_distance = 0;
+    } else {
+      int tmp_distance;
+      seg_id = NearestSegment(i, lo_x, hi_x, tmp_distance);
+      if (seg_id >= 0 && tmp_distance < min_distance) {
+        tmp_bound = rows_[i][seg_id].lo;
         min_distance = tmp_distance;
       }
     }
@@ -491,9 +528,8 @@ bool ExtendedTetrisLegalizer::FindLocLeft(Value2D<int>& loc, Block& block) {
 
     int tmp_x = std::max(left_white_space_bound, left_block_bound);
 
-    for (int n = tmp_start_row; n <= tmp_end_row; ++n) {
-      tmp_x = std::max(tmp_x, block_contour_[n]);
-    }
+    tmp_x = std::max(tmp_x,
+                     block_contour_.MaxInRange(tmp_start_row, tmp_end_row));
 
     int tmp_y = RowToLoc(tmp_start_row);
 
@@ -525,9 +561,8 @@ bool ExtendedTetrisLegalizer::FindLocLeft(Value2D<int>& loc, Block& block) {
           WhiteSpaceBoundLeft(loc.x, loc.x + width, tmp_start_row, tmp_end_row);
       int tmp_x = std::max(left_white_space_bound, left_block_bound);
 
-      for (int n = tmp_start_row; n <= tmp_end_row; ++n) {
-        tmp_x = std::max(tmp_x, block_contour_[n]);
-      }
+      tmp_x = std::max(tmp_x,
+                       block_contour_.MaxInRange(tmp_start_row, tmp_end_row));
 
       int tmp_y = RowToLoc(tmp_start_row);
       // double tmp_hpwl = EstimatedHPWL(block, tmp_x, tmp_y);
@@ -558,9 +593,8 @@ bool ExtendedTetrisLegalizer::FindLocLeft(Value2D<int>& loc, Block& block) {
           WhiteSpaceBoundLeft(loc.x, loc.x + width, tmp_start_row, tmp_end_row);
       int tmp_x = std::max(left_white_space_bound, left_block_bound);
 
-      for (int n = tmp_start_row; n <= tmp_end_row; ++n) {
-        tmp_x = std::max(tmp_x, block_contour_[n]);
-      }
+      tmp_x = std::max(tmp_x,
+                       block_contour_.MaxInRange(tmp_start_row, tmp_end_row));
 
       int tmp_y = RowToLoc(tmp_start_row);
       // double tmp_hpwl = EstimatedHPWL(block, tmp_x, tmp_y);
@@ -657,19 +691,25 @@ bool ExtendedTetrisLegalizer::LocalLegalizationLeft() {
 }
 
 void ExtendedTetrisLegalizer::InitBlockContourBackward() {
-  block_contour_.assign(block_contour_.size(), right_);
+  block_contour_.Assign(block_contour_.Size(), right_);
 }
 
 void ExtendedTetrisLegalizer::InitAndSortBlockDescendingX() {
   blk_inits_.clear();
-  auto& blocks = ckt_ptr_->Blocks();
-  for (auto& blk : blocks) {
-    if (IsDummyBlock(blk)) continue;
-    if (blk.IsFixed()) continue;
+  auto add_block = [this](Block& blk) {
     double x_loc =
         blk.URX() + k_width_ * blk.Width() + k_height_ * blk.Height();
     double y_loc = blk.LLY();
     blk_inits_.emplace_back(&blk, x_loc, y_loc);
+  };
+  if (is_row_band_) {
+    for (Block* blk_ptr : band_blks_) add_block(*blk_ptr);
+  } else {
+    for (auto& blk : ckt_ptr_->Blocks()) {
+      if (IsDummyBlock(blk)) continue;
+      if (blk.IsFixed()) continue;
+      add_block(blk);
+    }
   }
   std::sort(
       blk_inits_.begin(), blk_inits_.end(),
@@ -687,9 +727,7 @@ void ExtendedTetrisLegalizer::UseSpaceRight(Block const& block) {
   DaliExpects(start_row >= 0, "Out of bound?");
 
   int end_x = int(block.LLX());
-  for (int r = start_row; r <= end_row; ++r) {
-    block_contour_[r] = end_x;
-  }
+  block_contour_.AssignRange(start_row, end_row, end_x);
 }
 
 /****
@@ -716,15 +754,7 @@ bool ExtendedTetrisLegalizer::IsCurrentLocLegalRight(Value2D<int>& loc,
     return false;
   }
 
-  bool all_row_avail = true;
-  for (int i = start_row; i <= end_row; ++i) {
-    if (block_contour_[i] < loc.x) {
-      all_row_avail = false;
-      break;
-    }
-  }
-
-  return all_row_avail;
+  return block_contour_.MinInRange(start_row, end_row) >= loc.x;
 }
 
 /****
@@ -745,16 +775,15 @@ int ExtendedTetrisLegalizer::WhiteSpaceBoundRight(int lo_x, int hi_x,
 
   for (int i = lo_row; i <= hi_row; ++i) {
     tmp_bound = right_;
-    for (auto& seg : rows_[i]) {
-      if (seg.lo <= lo_x && seg.hi >= hi_x) {
-        tmp_bound = seg.hi;
-        min_distance = 0;
-        break;
-      }
-      int tmp_distance = std::min(abs(seg.lo - lo_x) + abs(seg.lo - hi_x),
-                                  abs(seg.hi - lo_x) + abs(seg.hi - hi_x));
-      if (tmp_distance < min_distance) {
-        tmp_bound = seg.hi;
+    int seg_id = CoveringSegment(i, lo_x, hi_x);
+    if (seg_id >= 0) {
+      tmp_bound = rows_[i][seg_id].hi;
+      min_distance = 0;
+    } else {
+      int tmp_distance;
+      seg_id = NearestSegment(i, lo_x, hi_x, tmp_distance);
+      if (seg_id >= 0 && tmp_distance < min_distance) {
+        tmp_bound = rows_[i][seg_id].hi;
         min_distance = tmp_distance;
       }
     }
@@ -810,9 +839,8 @@ bool ExtendedTetrisLegalizer::FindLocRight(Value2D<int>& loc, Block& block) {
     tmp_x = std::min(right_white_space_bound, right_block_bound);
     // tmp_x = std::min(right_, right_block_bound);
 
-    for (int n = tmp_start_row; n <= tmp_end_row; ++n) {
-      tmp_x = std::min(tmp_x, block_contour_[n]);
-    }
+    tmp_x = std::min(tmp_x,
+                     block_contour_.MinInRange(tmp_start_row, tmp_end_row));
 
     // if (tmp_x - width < left_) continue;
 
@@ -848,9 +876,8 @@ bool ExtendedTetrisLegalizer::FindLocRight(Value2D<int>& loc, Block& block) {
 
       tmp_x = std::min(right_white_space_bound, right_block_bound);
 
-      for (int n = tmp_start_row; n <= tmp_end_row; ++n) {
-        tmp_x = std::min(tmp_x, block_contour_[n]);
-      }
+      tmp_x = std::min(tmp_x,
+                       block_contour_.MinInRange(tmp_start_row, tmp_end_row));
 
       tmp_y = RowToLoc(tmp_start_row);
       // double tmp_hpwl = EstimatedHPWL(block, tmp_x, tmp_y);
@@ -882,9 +909,8 @@ bool ExtendedTetrisLegalizer::FindLocRight(Value2D<int>& loc, Block& block) {
 
       tmp_x = std::min(right_white_space_bound, right_block_bound);
 
-      for (int n = tmp_start_row; n <= tmp_end_row; ++n) {
-        tmp_x = std::min(tmp_x, block_contour_[n]);
-      }
+      tmp_x = std::min(tmp_x,
+                       block_contour_.MinInRange(tmp_start_row, tmp_end_row));
 
       tmp_y = RowToLoc(tmp_start_row);
       // double tmp_hpwl = EstimatedHPWL(block, tmp_x, tmp_y);
@@ -982,6 +1008,186 @@ void ExtendedTetrisLegalizer::UpdateLeftLimitFactor() {
   k_left_ += k_left_step_;
 }
 
+/****
+ * Legalize blocks from left and from right alternately, until all blocks are
+ * legal or the maximum number of iterations is reached.
+ * ****/
+bool ExtendedTetrisLegalizer::IterativeLocalLegalization(
+    bool is_hpwl_reported) {
+  ResetLeftLimitFactor();
+  bool is_success = false;
+  for (cur_iter_ = 0; cur_iter_ < max_iter_; ++cur_iter_) {
+    if (legalize_from_left_) {
+      is_success = LocalLegalizationLeft();
+    } else {
+      is_success = LocalLegalizationRight();
+    }
+    legalize_from_left_ = !legalize_from_left_;
+    UpdateLeftLimitFactor();
+    // GenMATLABTable("lg" + std::to_string(cur_iter_) + "_result.txt");
+    if (is_hpwl_reported) {
+      ReportHPWL();
+    }
+    if (is_success) {
+      break;
+    }
+  }
+  return is_success;
+}
+
+/****
+ * Make this legalizer a band of rows [lo_row, hi_row] of another legalizer.
+ * Row indices and the placement region become local to this band.
+ * ****/
+void ExtendedTetrisLegalizer::InitRowBand(
+    ExtendedTetrisLegalizer const& legalizer, int lo_row, int hi_row) {
+  ckt_ptr_ = legalizer.ckt_ptr_;
+  left_ = legalizer.left_;
+  right_ = legalizer.right_;
+  bottom_ = legalizer.RowToLoc(lo_row);
+  top_ = hi_row == legalizer.tot_num_rows_ - 1 ? legalizer.top_
+                                               : legalizer.RowToLoc(hi_row + 1);
+  row_height_ = legalizer.row_height_;
+  row_height_set_ = true;
+  tot_num_rows_ = hi_row - lo_row + 1;
+  is_first_row_N_ = ((lo_row & 1) == 0) == legalizer.is_first_row_N_;
+  rows_.assign(legalizer.rows_.begin() + lo_row,
+               legalizer.rows_.begin() + hi_row + 1);
+  block_contour_.Assign(tot_num_rows_, left_);
+
+  is_row_assignment_ = legalizer.is_row_assignment_;
+  legalize_from_left_ = legalizer.legalize_from_left_;
+  disable_cell_flip_ = legalizer.disable_cell_flip_;
+  max_iter_ = legalizer.max_iter_;
+  k_width_ = legalizer.k_width_;
+  k_height_ = legalizer.k_height_;
+  k_left_init_ = legalizer.k_left_init_;
+  k_left_step_ = legalizer.k_left_step_;
+  k_start = legalizer.k_start;
+  k_end = legalizer.k_end;
+  is_row_band_ = true;
+  band_blks_.clear();
+}
+
+/****
+ * Split rows into bands of about kRowsPerBand rows, assign each block to the
+ * band of its initial row, and legalize bands concurrently. Bands do not share
+ * rows, so blocks of different bands never overlap. A band only reads and
+ * writes its own blocks.
+ *
+ * A failed band is merged with its neighbor bands into a window, and windows
+ * are legalized concurrently again, starting from the results of their bands.
+ * Bands which are not in a window keep their results. A window which fails
+ * grows by one band on each side in the next round.
+ *
+ * Returns whether all bands are legalized. Returns false without legalizing a
+ * window if it would cover all rows.
+ * ****/
+bool ExtendedTetrisLegalizer::LegalizeRowBands() {
+  int max_blk_rows = 1;
+  std::vector<Block*> movable_blks;
+  for (auto& blk : ckt_ptr_->Blocks()) {
+    if (IsDummyBlock(blk)) continue;
+    if (blk.IsFixed()) continue;
+    movable_blks.push_back(&blk);
+    max_blk_rows = std::max(max_blk_rows, HeightToRow(blk.Height()));
+  }
+  // a band needs to hold a few of the tallest blocks on top of each other
+  int rows_per_band = std::max(kRowsPerBand, 4 * max_blk_rows);
+  int num_bands = tot_num_rows_ / rows_per_band;
+  if (num_bands < 2) {
+    return false;
+  }
+
+  // band b has rows [band_begin[b], band_begin[b + 1])
+  std::vector<int> band_begin(num_bands + 1);
+  for (int b = 0; b <= num_bands; ++b) {
+    band_begin[b] = static_cast<int>(
+        static_cast<long long>(b) * tot_num_rows_ / num_bands);
+  }
+  std::vector<std::vector<Block*>> band_blks(num_bands);
+  for (Block* blk_ptr : movable_blks) {
+    int row = LocToRow(AlignLocToRowLoc(blk_ptr->LLY()));
+    row = std::min(row, tot_num_rows_ - HeightToRow(blk_ptr->Height()));
+    row = std::max(row, 0);
+    int b = static_cast<int>(std::upper_bound(band_begin.begin(),
+                                              band_begin.end(), row) -
+                             band_begin.begin()) -
+            1;
+    band_blks[b].push_back(blk_ptr);
+  }
+
+  std::vector<char> is_band_legal(num_bands, 0);
+  std::vector<int> bands_to_legalize(num_bands);
+  std::iota(bands_to_legalize.begin(), bands_to_legalize.end(), 0);
+  for (int round = 0;; ++round) {
+    int num_runs = static_cast<int>(bands_to_legalize.size());
+    std::vector<ExtendedTetrisLegalizer> bands(num_runs);
+    for (int i = 0; i < num_runs; ++i) {
+      int b = bands_to_legalize[i];
+      bands[i].InitRowBand(*this, band_begin[b], band_begin[b + 1] - 1);
+      bands[i].band_blks_.swap(band_blks[b]);
+    }
+#pragma omp parallel for num_threads(num_threads_) default(none) \
+    shared(bands, bands_to_legalize, is_band_legal, num_runs)    \
+        schedule(dynamic, 1)
+    for (int i = 0; i < num_runs; ++i) {
+      is_band_legal[bands_to_legalize[i]] =
+          bands[i].IterativeLocalLegalization(false);
+    }
+    for (int i = 0; i < num_runs; ++i) {
+      band_blks[bands_to_legalize[i]].swap(bands[i].band_blks_);
+    }
+
+    int num_illegal_bands = static_cast<int>(
+        std::count(is_band_legal.begin(), is_band_legal.end(), 0));
+    if (round == 0) {
+      LOG(info) << "Legalized " << num_runs << " row bands, "
+                << num_illegal_bands << " of them failed\n";
+    } else {
+      LOG(info) << "Legalized " << num_runs << " windows around failed row "
+                << "bands, " << num_illegal_bands << " of them failed\n";
+    }
+    if (num_illegal_bands == 0) {
+      return true;
+    }
+
+    // a window is a run of consecutive failed bands and their neighbors
+    num_bands = static_cast<int>(is_band_legal.size());
+    std::vector<char> is_in_window(num_bands, 0);
+    for (int b = 0; b < num_bands; ++b) {
+      if (is_band_legal[b]) continue;
+      for (int n = std::max(b - 1, 0); n <= std::min(b + 1, num_bands - 1);
+           ++n) {
+        is_in_window[n] = 1;
+      }
+    }
+    if (std::count(is_in_window.begin(), is_in_window.end(), 0) == 0) {
+      return false;
+    }
+    std::vector<int> window_begin;
+    std::vector<std::vector<Block*>> window_blks;
+    std::vector<char> is_window_legal;
+    bands_to_legalize.clear();
+    for (int b = 0; b < num_bands; ++b) {
+      if (!is_in_window[b] || b == 0 || !is_in_window[b - 1]) {
+        if (is_in_window[b]) {
+          bands_to_legalize.push_back(static_cast<int>(window_begin.size()));
+        }
+        window_begin.push_back(band_begin[b]);
+        window_blks.emplace_back();
+        is_window_legal.push_back(is_band_legal[b]);
+      }
+      std::vector<Block*>& blks = window_blks.back();
+      blks.insert(blks.end(), band_blks[b].begin(), band_blks[b].end());
+    }
+    window_begin.push_back(tot_num_rows_);
+    band_begin.swap(window_begin);
+    band_blks.swap(window_blks);
+    is_band_legal.swap(is_window_legal);
+  }
+}
+
 double ExtendedTetrisLegalizer::EstimatedHPWL(Block& block, int x, int y) {
   double max_x = x;
   double max_y = y;
@@ -1053,22 +1259,22 @@ bool ExtendedTetrisLegalizer::StartPlacement() {
 
   is_row_assignment_ = false;
   InitLegalizer();
-  ResetLeftLimitFactor();
 
   bool is_success = false;
-  for (cur_iter_ = 0; cur_iter_ < max_iter_; ++cur_iter_) {
-    if (legalize_from_left_) {
-      is_success = LocalLegalizationLeft();
-    } else {
-      is_success = LocalLegalizationRight();
-    }
-    legalize_from_left_ = !legalize_from_left_;
-    UpdateLeftLimitFactor();
-    // GenMATLABTable("lg" + std::to_string(cur_iter_) + "_result.txt");
-    ReportHPWL();
+  is_row_band_fallback_used_ = false;
+  if (is_row_band_mode_) {
+    ScopedPlacementTimer timer("row_bands");
+    is_success = LegalizeRowBands();
     if (is_success) {
-      break;
+      ReportHPWL();
     }
+    is_row_band_fallback_used_ = !is_success;
+  }
+  // if windows around failed bands would cover all rows, blocks are fixed up
+  // here, starting from the result of all bands
+  if (!is_success) {
+    ScopedPlacementTimer timer("iterative_legalization");
+    is_success = IterativeLocalLegalization(true);
   }
 
   if (is_success) {
@@ -24,6 +24,7 @@
 #include "dali/circuit/block.h"
 #include "dali/common/misc.h"
 #include "dali/placer/displacement_viewer.h"
+#include "dali/placer/legalizer/row_contour.h"
 #include "dali/placer/placer.h"
 #include "dali/placer/well_legalizer/gridded_row_legalizer.h"
 
@@ -49,6 +50,20 @@ class ExtendedTetrisLegalizer : public Placer {
   /** Set left-bound search factors for iterative legalization. */
   void SetLeftBoundFactor(double k_left, double k_left_step);
 
+  /**
+   * Legalize horizontal bands of kRowsPerBand rows concurrently, each block
+   * stays in the band of its initial row. A band which cannot be legalized is
+   * legalized again with its neighbor bands, starting from their results.
+   * Only if this would cover all rows, the serial legalizer starts from the
+   * result of all bands. Results depend on the number of rows, not on the
+   * number of threads.
+   */
+  void SetRowBandMode(bool is_row_band_mode);
+  static constexpr int kRowsPerBand = 32;
+
+  /** Return true if the last row band legalization ran the serial legalizer. */
+  bool IsRowBandFallbackUsed() const { return is_row_band_fallback_used_; }
+
   /** Initialize row data from a gridded-row legalizer. */
   void InitializeFromGriddedRowLegalizer(GriddedRowLegalizer* grlg);
 
@@ -74,6 +89,16 @@ class ExtendedTetrisLegalizer : public Placer {
   int AlignLocToRowLoc(double y_loc) const;
   bool IsSpaceLegal(int lo_x, int hi_x, int lo_row, int hi_row) const;
 
+  /** Return the segment of a row covering [lo_x, hi_x], or -1 if none. */
+  int CoveringSegment(int row_id, int lo_x, int hi_x) const;
+
+  /**
+   * Return the first segment of a row with the smallest distance to
+   * [lo_x, hi_x], see WhiteSpaceBoundLeft() for the distance, and store the
+   * distance to @param distance. Return -1 if the row has no segments.
+   */
+  int NearestSegment(int row_id, int lo_x, int hi_x, int& distance) const;
+
   bool IsFitToRow(int row_id, Block& block) const;
   bool ShouldOrientN(int row_id, Block& block) const;
 
@@ -95,6 +120,11 @@ class ExtendedTetrisLegalizer : public Placer {
 
   void ResetLeftLimitFactor();
   void UpdateLeftLimitFactor();
+  bool IterativeLocalLegalization(bool is_hpwl_reported);
+
+  void InitRowBand(ExtendedTetrisLegalizer const& legalizer, int lo_row,
+                   int hi_row);
+  bool LegalizeRowBands();
   double EstimatedHPWL(Block& block, int x, int y);
 
   void ExportRowsToCircuit();
@@ -106,8 +136,10 @@ class ExtendedTetrisLegalizer : public Placer {
 
  protected:
   bool is_row_assignment_ = false;
+  // white space segments of each row, sorted and non-overlapping, so that
+  // segment queries are binary searches
   std::vector<std::vector<SegI>> rows_;
-  std::vector<int> block_contour_;
+  RowContour block_contour_;
   std::vector<BlockInitialLocation> blk_inits_;
 
   int row_height_;
@@ -134,6 +166,12 @@ class ExtendedTetrisLegalizer : public Placer {
   // cached data
   int tot_num_rows_;
 
+  // row band legalization, blocks of a band are in band_blks_
+  bool is_row_band_mode_ = false;
+  bool is_row_band_ = false;
+  bool is_row_band_fallback_used_ = false;
+  std::vector<Block*> band_blks_;
+
   // dump result
   bool is_dump = false;
   int dump_count = 0;
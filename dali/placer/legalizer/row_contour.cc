@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "row_contour.h"
+
+#include <algorithm>
+#include <climits>
+
+#include "dali/common/logging.h"
+
+namespace dali {
+
+void RowContour::Assign(int num_rows, int loc) {
+  DaliExpects(num_rows >= 0, "Negative number of rows?");
+  num_rows_ = num_rows;
+  max_.assign(2 * num_rows_, loc);
+  min_.assign(2 * num_rows_, loc);
+}
+
+void RowContour::AssignRange(int lo_row, int hi_row, int loc) {
+  for (int row = lo_row; row <= hi_row; ++row) {
+    int i = num_rows_ + row;
+    max_[i] = loc;
+    min_[i] = loc;
+    for (i >>= 1; i >= 1; i >>= 1) {
+      max_[i] = std::max(max_[2 * i], max_[2 * i + 1]);
+      min_[i] = std::min(min_[2 * i], min_[2 * i + 1]);
+    }
+  }
+}
+
+int RowContour::MaxInRange(int lo_row, int hi_row) const {
+  int res = INT_MIN;
+  int l = num_rows_ + lo_row;
+  int r = num_rows_ + hi_row + 1;
+  for (; l < r; l >>= 1, r >>= 1) {
+    if (l & 1) res = std::max(res, max_[l++]);
+    if (r & 1) res = std::max(res, max_[--r]);
+  }
+  return res;
+}
+
+int RowContour::MinInRange(int lo_row, int hi_row) const {
+  int res = INT_MAX;
+  int l = num_rows_ + lo_row;
+  int r = num_rows_ + hi_row + 1;
+  for (; l < r; l >>= 1, r >>= 1) {
+    if (l & 1) res = std::min(res, min_[l++]);
+    if (r & 1) res = std::min(res, min_[--r]);
+  }
+  return res;
+}
+
+}  // namespace dali
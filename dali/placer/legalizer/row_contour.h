@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#ifndef DALI_PLACER_LEGALIZER_ROW_CONTOUR_H_
+#define DALI_PLACER_LEGALIZER_ROW_CONTOUR_H_
+
+#include <vector>
+
+namespace dali {
+
+/**
+ * Contour of placed blocks in Tetris-like legalizers, one x location per row.
+ * A single row is read in O(1). The max or the min location of a range of rows
+ * is found in O(log R), and assigning k rows costs O(k log R), R being the
+ * number of rows. Locations are kept in a bottom-up segment tree, whose leaves
+ * are the per-row locations.
+ */
+class RowContour {
+ public:
+  /** Resize the contour to num_rows rows, all at location loc. */
+  void Assign(int num_rows, int loc);
+
+  int Size() const { return num_rows_; }
+
+  /** Return the location of a row. */
+  int operator[](int row) const { return max_[num_rows_ + row]; }
+
+  /** Set the location of rows [lo_row, hi_row] to loc. */
+  void AssignRange(int lo_row, int hi_row, int loc);
+
+  /** Return the max location of rows [lo_row, hi_row]. */
+  int MaxInRange(int lo_row, int hi_row) const;
+
+  /** Return the min location of rows [lo_row, hi_row]. */
+  int MinInRange(int lo_row, int hi_row) const;
+
+ private:
+  int num_rows_ = 0;
+  // node i has children 2i and 2i + 1, row r is the leaf num_rows_ + r
+  std::vector<int> max_;
+  std::vector<int> min_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PLACER_LEGALIZER_ROW_CONTOUR_H_
@@ -29,47 +29,28 @@
 
 namespace dali {
 
+/****
+ * A free interval [start, end) of a row. Segments are stored by value in a
+ * FreeSegmentList.
+ * ****/
 class FreeSegment {
  private:
   int start_;
   int end_;
-  FreeSegment* prev_ = nullptr;  // Pointer to previous free segment
-  FreeSegment* next_ = nullptr;  // Pointer to Next free segment
  public:
   explicit FreeSegment(int start = 0, int stop = 0);
-  bool SetPrev(FreeSegment* preFreeSeg_ptr);
-  bool SetNext(FreeSegment* nextFreeSeg_ptr);
-  bool LinkSingleSeg(FreeSegment* seg_ptr);
-  FreeSegment* Next();
-  FreeSegment* Prev();
   void SetSpan(int startLoc, int endLoc);
   int Start() const;
   int End() const;
   int Length() const;
-  bool IsOverlap(FreeSegment* seg) const;
-  bool IsTouch(FreeSegment* seg) const;
-  bool IsDominate(FreeSegment* seg) const;
-  bool IsContain(FreeSegment* seg) const;
-  bool IsSameStartEnd(FreeSegment* seg) const;
-  FreeSegment* SingleSegAnd(FreeSegment* seg);
-  FreeSegment* SingleSegOr(FreeSegment* seg);
-  void Clear();
+  bool IsOverlap(FreeSegment const& seg) const;
+  bool IsTouch(FreeSegment const& seg) const;
+  bool IsDominate(FreeSegment const& seg) const;
+  bool IsContain(FreeSegment const& seg) const;
+  bool IsSameStartEnd(FreeSegment const& seg) const;
+  bool SingleSegAnd(FreeSegment const& seg, FreeSegment& result) const;
 };
 
-inline bool FreeSegment::SetPrev(FreeSegment* preFreeSeg_ptr) {
-  prev_ = preFreeSeg_ptr;
-  return true;
-}
-
-inline bool FreeSegment::SetNext(FreeSegment* nextFreeSeg_ptr) {
-  next_ = nextFreeSeg_ptr;
-  return true;
-}
-
-inline FreeSegment* FreeSegment::Next() { return next_; }
-
-inline FreeSegment* FreeSegment::Prev() { return prev_; }
-
 inline void FreeSegment::SetSpan(int startLoc, int endLoc) {
   if (startLoc > endLoc) {
     LOG(info)
@@ -87,24 +68,24 @@ inline int FreeSegment::End() const { return end_; }
 
 inline int FreeSegment::Length() const { return end_ - start_; }
 
-inline bool FreeSegment::IsOverlap(FreeSegment* seg) const {
-  if ((Length() == 0) || (seg->Length() == 0)) {
+inline bool FreeSegment::IsOverlap(FreeSegment const& seg) const {
+  if ((Length() == 0) || (seg.Length() == 0)) {
     LOG(info) << "Length 0 segment?!\n";
     return false;
   }
-  bool notOverlap = (end_ <= seg->Start()) || (start_ >= seg->End());
+  bool notOverlap = (end_ <= seg.Start()) || (start_ >= seg.End());
   return !notOverlap;
 }
 
-inline bool FreeSegment::IsTouch(FreeSegment* seg) const {
-  if ((Length() == 0) || (seg->Length() == 0)) {
+inline bool FreeSegment::IsTouch(FreeSegment const& seg) const {
+  if ((Length() == 0) || (seg.Length() == 0)) {
     LOG(info) << "Length 0 segment?!\n";
     return false;
   }
-  return (end_ == seg->Start()) || (start_ == seg->End());
+  return (end_ == seg.Start()) || (start_ == seg.End());
 }
 
-inline bool FreeSegment::IsDominate(FreeSegment* seg) const {
+inline bool FreeSegment::IsDominate(FreeSegment const& seg) const {
   /****
    * If this FreeSegment is on the right hand side of seg, and has common
    * overlap length 0, return true
@@ -113,32 +94,38 @@ inline bool FreeSegment::IsDominate(FreeSegment* seg) const {
    * example: |---seg---|---this seg---|, return true
    * else return false
    * ****/
-  return (start_ >= seg->End());
+  return (start_ >= seg.End());
 }
 
-inline bool FreeSegment::IsContain(FreeSegment* seg) const {
+inline bool FreeSegment::IsContain(FreeSegment const& seg) const {
   /****
    * If this FreeSegment contains seg, return true
    * true condition:
-   *    start_ <= seg->Start() && end_ >= seg->End()
+   *    start_ <= seg.Start() && end_ >= seg.End()
    * example: |---this seg---|
    *          |---seg---|
    *          return true
    * ****/
-  return (start_ <= seg->Start()) && (end_ >= seg->End());
+  return (start_ <= seg.Start()) && (end_ >= seg.End());
 }
 
-inline bool FreeSegment::IsSameStartEnd(FreeSegment* seg) const {
-  return (start_ == seg->Start()) && (end_ == seg->End());
+inline bool FreeSegment::IsSameStartEnd(FreeSegment const& seg) const {
+  return (start_ == seg.Start()) && (end_ == seg.End());
 }
 
-inline FreeSegment* FreeSegment::SingleSegAnd(FreeSegment* seg) {
-  if (!IsOverlap(seg)) {
-    return nullptr;
-  }
-  auto* result = new FreeSegment(std::max(start_, seg->Start()),
-                                 std::min(end_, seg->End()));
-  return result;
+/****
+ * If this FreeSegment and seg have a common part of non-zero length, store it
+ * in result and return true, otherwise return false. Segments of length 0
+ * overlap with nothing.
+ * ****/
+inline bool FreeSegment::SingleSegAnd(FreeSegment const& seg,
+                                      FreeSegment& result) const {
+  int lo = std::max(start_, seg.Start());
+  int hi = std::min(end_, seg.End());
+  if (lo >= hi) return false;
+  result.start_ = lo;
+  result.end_ = hi;
+  return true;
 }
 
 }  // namespace dali
@@ -20,224 +20,129 @@
  ******************************************************************************/
 #include "free_segment_list.h"
 
+#include <algorithm>
+
 #include "dali/common/misc.h"
 
 namespace dali {
 
-FreeSegmentList::FreeSegmentList() {
-  head_ = nullptr;
-  tail_ = nullptr;
-  min_width_ = 0;
-  size_ = 0;
-}
+FreeSegmentList::FreeSegmentList() : min_width_(0) {}
 
 FreeSegmentList::FreeSegmentList(int start, int stop, int min_width)
     : min_width_(min_width) {
-  head_ = new FreeSegment(start, stop);
-  tail_ = head_;
-  size_ = 1;
+  segments_.emplace_back(start, stop);
 }
 
-FreeSegmentList::~FreeSegmentList() { Clear(); }
-
-void FreeSegmentList::Append(FreeSegment* segList) {
-  /****push a list of free segments into the linked list with some sanity
-   * check****/
-  if (segList == nullptr) {
-    LOG(info) << "push nullptr to linked list?\n";
-    assert(segList != nullptr);
-  } else {
-    if (head_ == nullptr) {
-      head_ = segList;
-      tail_ = segList;
-    } else {
-      segList->SetPrev(tail_);
-      tail_->SetNext(segList);
-      tail_ = segList;
-    }
-    ++size_;
-    while (tail_->Next() != nullptr) {
-      tail_ = tail_->Next();
-      ++size_;
-    }
-  }
+/****
+ * Reset this list to a single segment [start, stop), the capacity of the list
+ * is kept.
+ * ****/
+void FreeSegmentList::Assign(int start, int stop) {
+  segments_.clear();
+  segments_.emplace_back(start, stop);
 }
 
 bool FreeSegmentList::EmplaceBack(int start, int end) {
-  auto* seg_ptr = new FreeSegment(start, end);
-  if (head_ == nullptr) {
-    head_ = seg_ptr;
-    tail_ = seg_ptr;
-  } else {
-    if (start < Right()) {
-      LOG(info)
-          << "Illegal segment emplace back, Start: " << start
-          << " is required to be no less than the Right End of current linked "
-             "list: "
-          << Right() << "\n";
-      return false;
-    }
-    tail_->LinkSingleSeg(seg_ptr);
-    tail_ = seg_ptr;
+  if (!segments_.empty() && start < Right()) {
+    LOG(info)
+        << "Illegal segment emplace back, Start: " << start
+        << " is required to be no less than the Right End of current list: "
+        << Right() << "\n";
+    return false;
   }
-  ++size_;
+  segments_.emplace_back(start, end);
   return true;
 }
 
-void FreeSegmentList::PushBack(FreeSegment* seg) {
-  /****push a single free segment into the linked list****/
-  if (seg == nullptr) {
-    LOG(info) << "push nullptr to linked list?\n";
-    assert(seg != nullptr);
-  }
-  if (seg->Next() != nullptr) {
-    LOG(info) << "argument has more than one nodes inside, please use method "
-                 "Append() instead of PushBack\n";
-    assert(seg->Next() == nullptr);
-  }
+/****
+ * Push a single free segment into the list, it is merged with the last
+ * segment if they touch each other.
+ * ****/
+void FreeSegmentList::PushBack(FreeSegment const& seg) {
   if (Empty()) {
-    head_ = seg;
-    tail_ = seg;
-    ++size_;
-  } else {
-    if (Right() > seg->Start()) {
-      LOG(info)
-          << "Cannot push segment into list, because the Right of list is: "
-          << Right()
-          << " larger than the Start of segment to push: " << seg->Start()
-          << std::endl;
-      assert(Right() <= seg->Start());
-    }
-    if (Right() < seg->Start()) {
-      seg->SetPrev(tail_);
-      tail_->SetNext(seg);
-      tail_ = seg;
-      ++size_;
-    } else {
-      tail_->SetSpan(tail_->Start(), seg->End());
-    }
-  }
-}
-
-void FreeSegmentList::Insert(FreeSegment* insertPosition,
-                             FreeSegment* segToInsert) {
-  if (insertPosition == Tail()) {
-    PushBack(segToInsert);
+    segments_.push_back(seg);
+    return;
+  }
+  if (Right() > seg.Start()) {
+    LOG(info) << "Cannot push segment into list, because the Right of list is: "
+              << Right()
+              << " larger than the Start of segment to push: " << seg.Start()
+              << std::endl;
+    assert(Right() <= seg.Start());
+  }
+  if (Right() < seg.Start()) {
+    segments_.push_back(seg);
   } else {
-    FreeSegment* next = insertPosition->Next();
-    insertPosition->SetNext(segToInsert);
-    segToInsert->SetNext(next);
-    segToInsert->SetPrev(insertPosition);
-    next->SetPrev(segToInsert);
-    ++size_;
+    FreeSegment& tail = segments_.back();
+    tail.SetSpan(tail.Start(), seg.End());
   }
 }
 
-bool FreeSegmentList::Empty() const { return (size() == 0); }
+bool FreeSegmentList::Empty() const { return segments_.empty(); }
 
-void FreeSegmentList::CopyFrom(FreeSegmentList& originList) {
-  this->Clear();
-  if (!originList.Empty()) {
-    for (FreeSegment* current = originList.Head(); current != nullptr;
-         current = current->Next()) {
-      EmplaceBack(current->Start(), current->End());
-    }
-    min_width_ = originList.MinWidth();
-  }
+void FreeSegmentList::CopyFrom(FreeSegmentList const& originList) {
+  segments_ = originList.segments_;
+  min_width_ = originList.MinWidth();
 }
 
 void FreeSegmentList::Clear() {
-  // Clear the linked list
-  FreeSegment* current = head_;
-  FreeSegment* next = nullptr;
-  while (current != nullptr) {
-    next = current->Next();
-    delete current;
-    current = next;
-  }
-  head_ = nullptr;
-  tail_ = nullptr;
-  size_ = 0;
+  segments_.clear();
   min_width_ = 0;
 }
 
-void FreeSegmentList::RemoveSeg(
-    FreeSegment*
-        seg_in_list) {  // don't remove, traverse the linked list is good enough
-  /****
-   * remove a segment in the linked list
-   * 1. if the linked list is empty or the provided segment pointer is nullptr,
-   *assert fault;
-   * 2. if the linked list has length 1, clear this linked list;
-   * 3. if the linked list has length larger than 1:
-   *    a). if the segment to remove is the head, set the head to the next one;
-   *    b). if the segment to remove is the tail, set the tail to the prev one;
-   *    c). if the segment to remove has real prev and next, i.e., not nullptr,
-   *remove this segment, and connect its prev with its next
-   ****/
-  DaliExpects(seg_in_list != nullptr,
-              "Remove Empty pointer? Be careful, you can only remove nodes in "
-              "the linked list");
-  DaliExpects(!Empty(), "Nothing to remove from an Empty list!");
-  FreeSegment* current = seg_in_list;
-  if (size() == 1) {
-    head_ = nullptr;
-    tail_ = nullptr;
-  } else {
-    if (current == Head()) {
-      head_ = current->Next();
-      head_->SetPrev(nullptr);
-    } else if (current == Tail()) {
-      tail_ = current->Prev();
-      tail_->SetNext(nullptr);
-    } else {
-      FreeSegment* prev = current->Prev();
-      FreeSegment* next = current->Next();
-      prev->SetNext(next);
-      next->SetPrev(prev);
-    }
-  }
-  --size_;
-  delete current;
-}
-
-bool FreeSegmentList::ApplyMask(FreeSegmentList& maskRow) {
-  if (head_ == nullptr) {
+/****
+ * Keep the common part of this list and maskRow. Both lists are sorted, so
+ * one merge pass over them is enough. The result is built in buffer_ and then
+ * swapped in, so no memory is allocated once both vectors are large enough.
+ * ****/
+bool FreeSegmentList::ApplyMask(FreeSegmentList const& maskRow) {
+  if (Empty()) {
     return false;
   }
-  FreeSegmentList result;
-  for (FreeSegment* currentMaskSeg = maskRow.Head(); currentMaskSeg != nullptr;
-       currentMaskSeg = currentMaskSeg->Next()) {
-    for (FreeSegment* current = Head(); current != nullptr;
-         current = current->Next()) {
-      if (current->IsDominate(currentMaskSeg)) break;
-      FreeSegment* tmpSeg_ptr = currentMaskSeg->SingleSegAnd(current);
-      if (tmpSeg_ptr != nullptr) {
-        result.PushBack(tmpSeg_ptr);
+  buffer_.clear();
+  FreeSegment common;
+  size_t i = 0;
+  size_t j = 0;
+  auto const& mask = maskRow.segments_;
+  while (i < segments_.size() && j < mask.size()) {
+    if (segments_[i].SingleSegAnd(mask[j], common)) {
+      if (!buffer_.empty() && buffer_.back().End() == common.Start()) {
+        buffer_.back().SetSpan(buffer_.back().Start(), common.End());
+      } else {
+        buffer_.push_back(common);
       }
     }
+    if (segments_[i].End() < mask[j].End()) {
+      ++i;
+    } else {
+      ++j;
+    }
   }
-  CopyFrom(result);
+  segments_.swap(buffer_);
   return true;
 }
 
 void FreeSegmentList::RemoveShortSeg(int width) {
-  /****to understand this member function, one needs to understand member
-   * function removeSeg() the member function works in the following way:
-   * traverse the linked list
-   * 1. if the current segment has length less than the required length, remove
-   * it;
-   * 2. if the current segment has length no less than the required length,
-   * skip;
-   * 3. set current pointer to its next.****/
-  if (Empty()) return;
-  for (FreeSegment* current = Head(); current != nullptr;) {
-    FreeSegment* next = current->Next();
-    if (current->Length() < width) {
-      RemoveSeg(current);
-    }
-    current = next;
-  }
+  segments_.erase(std::remove_if(segments_.begin(), segments_.end(),
+                                 [width](FreeSegment const& seg) {
+                                   return seg.Length() < width;
+                                 }),
+                  segments_.end());
+}
+
+/****
+ * Return the index of the segment containing [start, end), or -1 if there is
+ * no such segment. Segments are disjoint, so only the last segment starting
+ * at or before start can contain it.
+ * ****/
+int FreeSegmentList::FindContainingSeg(int start, int end) const {
+  auto it = std::upper_bound(
+      segments_.begin(), segments_.end(), start,
+      [](int loc, FreeSegment const& seg) { return loc < seg.Start(); });
+  if (it == segments_.begin()) return -1;
+  --it;
+  if (it->End() < end) return -1;
+  return static_cast<int>(it - segments_.begin());
 }
 
 void FreeSegmentList::UseSpace(int start, int length) {
@@ -245,86 +150,59 @@ void FreeSegmentList::UseSpace(int start, int length) {
    * It is for sure that [start, start+length] sits in one of the segments
    * To use a segment of this segment list:
    *    1. use all free space, then we need to remove this segment from the
-   * linked list;
+   * list;
    *    2. use left part (shrink this segment from left side);
    *    3. use right part (shrink this segment from right side);
    *    4. use middle part (split this segment into two segments)
    * ****/
   int end_loc = start + length;
-  bool isSegFound = false;
-  FreeSegment target(start, end_loc);
-  for (auto* current = Head(); current != nullptr; current = current->Next()) {
-    if (current->IsContain(&target)) {
-      isSegFound = true;
-      if (current->IsSameStartEnd(&target)) {
-        RemoveSeg(current);
-      } else if ((start == current->Start()) && (end_loc < current->End())) {
-        current->SetSpan(end_loc, current->End());
-      } else if ((start > current->Start()) && (end_loc == current->End())) {
-        current->SetSpan(current->Start(), start);
-      } else {
-        auto* seg_ptr = new FreeSegment(end_loc, current->End());
-        current->SetSpan(current->Start(), start);
-        Insert(current, seg_ptr);
-      }
-    }
-    if (isSegFound) break;
-  }
-
-  if (!isSegFound) {
+  int index = FindContainingSeg(start, end_loc);
+  if (index < 0) {
     LOG(info)
         << "What? there are bugs in the code, the program should not reach here"
         << std::endl;
-    assert(isSegFound);
+    assert(index >= 0);
+    return;
+  }
+  FreeSegment& current = segments_[index];
+  FreeSegment target(start, end_loc);
+  if (current.IsSameStartEnd(target)) {
+    segments_.erase(segments_.begin() + index);
+  } else if ((start == current.Start()) && (end_loc < current.End())) {
+    current.SetSpan(end_loc, current.End());
+  } else if ((start > current.Start()) && (end_loc == current.End())) {
+    current.SetSpan(current.Start(), start);
+  } else {
+    FreeSegment right_part(end_loc, current.End());
+    current.SetSpan(current.Start(), start);
+    segments_.insert(segments_.begin() + index + 1, right_part);
   }
 }
 
-bool FreeSegmentList::IsSpaceAvail(int x_loc, int width) {
-  /****
-   * In order to know if interval [x_loc, x_loc + width] is available, we just
-   * need to check if this segment sits in a FreeSegment in the linked-list A
-   * speed-up algorithm is known, will implement it
-   * ****/
-  FreeSegment target(x_loc, x_loc + width);
-  bool is_avail = false;
-  // LOG(info)   << Head() << "\n";
-  for (auto* current = Head(); current != nullptr; current = current->Next()) {
-    if (current->IsContain(&target)) {
-      is_avail = true;
-      break;
-    }
-    if (current->IsDominate(&target)) {
-      break;
-    }
-  }
-  return is_avail;
+bool FreeSegmentList::IsSpaceAvail(int x_loc, int width) const {
+  return FindContainingSeg(x_loc, x_loc + width) >= 0;
 }
 
 /****
  * We assume any segment in this list has a length longer than block width
  * ****/
-int FreeSegmentList::MinDispLoc(int width) {
-  DaliExpects(Head()->Length() >= width,
+int FreeSegmentList::MinDispLoc(int width) const {
+  DaliExpects(segments_.front().Length() >= width,
               "Segment length should be longer than block width");
-  return Head()->Start();
+  return segments_.front().Start();
 }
 
-void FreeSegmentList::Show() {
-  if (head_ == nullptr) {
+void FreeSegmentList::Show() const {
+  if (Empty()) {
     LOG(info) << "Empty list, nothing to display" << std::endl;
   } else {
     LOG(info) << "MinWidth: " << min_width_ << "  ";
-    FreeSegment* current = head_;
-    size_t count = 0;
-    while (count < size_) {
-      LOG(info) << "( " << current->Start() << " " << current->End() << " )";
-      current = current->Next();
-      if (current != nullptr) {
+    for (size_t i = 0; i < segments_.size(); ++i) {
+      LOG(info) << "( " << segments_[i].Start() << " " << segments_[i].End()
+                << " )";
+      if (i + 1 < segments_.size()) {
         LOG(info) << " -> ";
-      } else {
-        break;
       }
-      ++count;
     }
     LOG(info) << std::endl;
   }
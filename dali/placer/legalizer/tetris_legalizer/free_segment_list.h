@@ -23,55 +23,57 @@
 
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "free_segment.h"
 
 namespace dali {
 
+/****
+ * Free segments of a row, sorted by their start locations and disjoint. The
+ * segments are stored in a flat vector, a list which is reused for many queries
+ * stops allocating memory once its capacity is large enough.
+ * ****/
 class FreeSegmentList {
  private:
-  FreeSegment* head_;
-  FreeSegment* tail_;
+  std::vector<FreeSegment> segments_;
+  // scratch space of ApplyMask()
+  std::vector<FreeSegment> buffer_;
   int min_width_;
-  size_t size_;
-  /***derived data entries***/
+  int FindContainingSeg(int start, int end) const;
  public:
   FreeSegmentList();
   FreeSegmentList(int start, int stop, int min_width);
-  ~FreeSegmentList();
-  size_t size() const { return size_; }
+  size_t size() const { return segments_.size(); }
   int Left() const {
-    if (head_ == nullptr) {
-      LOG(info) << "Empty linked list, Left() not available\n";
-      assert(head_ != nullptr);
+    if (segments_.empty()) {
+      LOG(info) << "Empty list, Left() not available\n";
+      assert(!segments_.empty());
     }
-    return head_->Start();
+    return segments_.front().Start();
   }
   int Right() const {
-    if (tail_ == nullptr) {
-      LOG(info) << "Empty linked list, Right() not available\n";
-      assert(tail_ != nullptr);
+    if (segments_.empty()) {
+      LOG(info) << "Empty list, Right() not available\n";
+      assert(!segments_.empty());
     }
-    return tail_->End();
+    return segments_.back().End();
   }
-  FreeSegment* Head() const { return head_; }
-  FreeSegment* Tail() const { return tail_; }
+  std::vector<FreeSegment> const& Segments() const { return segments_; }
   int MinWidth() const { return min_width_; }
   void SetMinWidth(int initMinWidth) { min_width_ = initMinWidth; }
-  void Append(FreeSegment* segList);
+  void Assign(int start, int stop);
   bool EmplaceBack(int start, int end);
-  void PushBack(FreeSegment* seg);
-  void Insert(FreeSegment* insertPosition, FreeSegment* segToInsert);
+  void PushBack(FreeSegment const& seg);
   bool Empty() const;
-  void CopyFrom(FreeSegmentList& originList);
+  void CopyFrom(FreeSegmentList const& originList);
   void Clear();
-  bool ApplyMask(FreeSegmentList& maskRow);
-  void RemoveSeg(FreeSegment* seg_in_list);
+  bool ApplyMask(FreeSegmentList const& maskRow);
   void RemoveShortSeg(int width);
   void UseSpace(int start, int length);
-  bool IsSpaceAvail(int x_loc, int width);
-  int MinDispLoc(int width);
-  void Show();
+  bool IsSpaceAvail(int x_loc, int width) const;
+  int MinDispLoc(int width) const;
+  void Show() const;
 };
 
 }  // namespace dali
@@ -36,14 +36,9 @@ TetrisSpace::TetrisSpace(int left, int right, int bottom, int top,
       min_width_(minWidth) {
   tot_num_row_ = (top_ - bottom_) / rowHeight;
   top_ -= (top_ - bottom_) % rowHeight;
+  free_segment_rows.reserve(tot_num_row_);
   for (int i = 0; i < tot_num_row_; ++i) {
-    FreeSegmentList tmpRow;
-    free_segment_rows.push_back(tmpRow);
-  }
-  for (auto& row : free_segment_rows) {
-    auto* seg_ptr = new FreeSegment(left_, right_);
-    row.PushBack(seg_ptr);
-    row.SetMinWidth(min_width_);
+    free_segment_rows.emplace_back(left_, right_, min_width_);
   }
 }
 
@@ -160,15 +155,16 @@ bool TetrisSpace::FindBlockLoc(int llx, int lly, int width, int height,
   int max_row =
       ToEndRow(std::min(top_, lly + 2 * height)) - height / row_height_;
 
+  candidate_list.reserve(std::max(0, max_row - min_row));
   for (int i = min_row; i < max_row; ++i) {
-    FreeSegmentList common_segments(scan_line_, right_, min_width_);
-    FindCommonSegments(i, i + effective_height, common_segments);
-    common_segments.RemoveShortSeg(width);
-    if (common_segments.Empty()) {
+    common_segments_.Assign(scan_line_, right_);
+    FindCommonSegments(i, i + effective_height, common_segments_);
+    common_segments_.RemoveShortSeg(width);
+    if (common_segments_.Empty()) {
       candidate_list.emplace_back(-1, -1);
     } else {
       all_row_fail = false;
-      min_disp_x = common_segments.MinDispLoc(width);
+      min_disp_x = common_segments_.MinDispLoc(width);
       candidate_list.emplace_back(min_disp_x, i);
     }
   }
@@ -180,14 +176,14 @@ bool TetrisSpace::FindBlockLoc(int llx, int lly, int width, int height,
     max_row = std::min(top_row_to_check, max_row + 2 * height);
     for (int i = min_row; i < max_row; ++i) {
       if (i >= old_min_row && i < old_max_row) continue;
-      FreeSegmentList common_segments(scan_line_, right_, min_width_);
-      FindCommonSegments(i, i + effective_height, common_segments);
-      common_segments.RemoveShortSeg(width);
-      if (common_segments.Empty()) {
+      common_segments_.Assign(scan_line_, right_);
+      FindCommonSegments(i, i + effective_height, common_segments_);
+      common_segments_.RemoveShortSeg(width);
+      if (common_segments_.Empty()) {
         candidate_list.emplace_back(-1, -1);
       } else {
         all_row_fail = false;
-        min_disp_x = common_segments.MinDispLoc(width);
+        min_disp_x = common_segments_.MinDispLoc(width);
         candidate_list.emplace_back(min_disp_x, i);
       }
     }
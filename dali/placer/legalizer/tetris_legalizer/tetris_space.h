@@ -39,6 +39,8 @@ class TetrisSpace {
   int row_height_;
   int min_width_;
   std::vector<FreeSegmentList> free_segment_rows;
+  // common segments of candidate rows in FindBlockLoc(), reused by every query
+  FreeSegmentList common_segments_;
   /****derived data entry****/
   int tot_num_row_;
 
@@ -595,9 +595,15 @@ void GriddedRow::InitializeBlockStretching() {
   }
 }
 
-size_t GriddedRow::AddWellTapCells(Circuit* p_ckt, BlockType* well_tap_type_ptr,
-                                   size_t start_id,
-                                   std::vector<SegI>& well_tap_cell_locs) {
+/****
+ * @brief place well-tap cells [start_id, start_id + well_tap_cell_locs.size())
+ * of the well-tap cell collection in this row, these instances must have been
+ * created. Returns the id of the first well-tap cell after this row.
+ */
+size_t GriddedRow::PlaceWellTapCells(Circuit* p_ckt,
+                                     BlockType* well_tap_type_ptr,
+                                     size_t start_id,
+                                     std::vector<SegI>& well_tap_cell_locs) {
   double y_loc = LLY();
   if (is_orient_N_) {
     y_loc += p_well_height_ - well_tap_type_ptr->PwellHeight(0, false);
@@ -605,14 +611,12 @@ size_t GriddedRow::AddWellTapCells(Circuit* p_ckt, BlockType* well_tap_type_ptr,
     y_loc += n_well_height_ - well_tap_type_ptr->NwellHeight(0, true);
   }
   BlockOrient orient = is_orient_N_ ? N : FS;
+  auto& tap_cell_collection = p_ckt->design().WellTapCellCollection();
   for (auto& [lo_x, hi_x] : well_tap_cell_locs) {
-    std::string block_name = "__well_tap__" + std::to_string(start_id++);
-    Block& tap_cell =
-        p_ckt->design().WellTapCellCollection().CreateInstance(block_name);
+    Block& tap_cell = *tap_cell_collection.GetInstanceById(start_id);
     tap_cell.SetPlacementStatus(PLACED);
     tap_cell.SetType(well_tap_type_ptr);
-    tap_cell.SetId(p_ckt->design().WellTapCellCollection().GetInstanceIdByName(
-        block_name));
+    tap_cell.SetId(start_id++);
     tap_cell.SetLLX(lo_x);
     tap_cell.SetLLY(y_loc);
     tap_cell.SetOrient(orient);
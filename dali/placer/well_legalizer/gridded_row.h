@@ -139,9 +139,9 @@ class GriddedRow {
   void RecomputeHeight(int p_well_height, int n_well_height);
   void InitializeBlockStretching();
 
-  size_t AddWellTapCells(Circuit* p_ckt, BlockType* well_tap_type_ptr,
-                         size_t start_id,
-                         std::vector<SegI>& well_tap_cell_locs);
+  size_t PlaceWellTapCells(Circuit* p_ckt, BlockType* well_tap_type_ptr,
+                           size_t start_id,
+                           std::vector<SegI>& well_tap_cell_locs);
 
   void SortBlockRegions();
 
@@ -218,7 +218,8 @@ void GriddedRowLegalizer::SetLegalizationMaxIteration(int max_iteration) {
 }
 
 bool GriddedRowLegalizer::StripeLegalizationUpward(Stripe& stripe,
-                                                   bool use_init_loc) {
+                                                   bool use_init_loc,
+                                                   int iteration) {
   stripe.gridded_rows_.clear();
   stripe.front_id_ = -1;
   stripe.is_bottom_up_ = true;
@@ -229,7 +230,7 @@ bool GriddedRowLegalizer::StripeLegalizationUpward(Stripe& stripe,
   while (processed_blk_cnt < stripe.blk_ptrs_vec_.size()) {
     stripe.UpdateFrontClusterUpward(tap_cell_p_height_, tap_cell_n_height_);
     processed_blk_cnt =
-        stripe.FitBlocksToFrontSpaceUpward(processed_blk_cnt, greedy_cur_iter_);
+        stripe.FitBlocksToFrontSpaceUpward(processed_blk_cnt, iteration);
     stripe.LegalizeFrontCluster(use_init_loc);
   }
   stripe.UpdateRemainingClusters(tap_cell_p_height_, tap_cell_n_height_, true);
@@ -240,7 +241,8 @@ bool GriddedRowLegalizer::StripeLegalizationUpward(Stripe& stripe,
 }
 
 bool GriddedRowLegalizer::StripeLegalizationDownward(Stripe& stripe,
-                                                     bool use_init_loc) {
+                                                     bool use_init_loc,
+                                                     int iteration) {
   stripe.gridded_rows_.clear();
   stripe.front_id_ = -1;
   stripe.is_bottom_up_ = false;
@@ -250,8 +252,8 @@ bool GriddedRowLegalizer::StripeLegalizationDownward(Stripe& stripe,
   size_t processed_blk_cnt = 0;
   while (processed_blk_cnt < stripe.blk_ptrs_vec_.size()) {
     stripe.UpdateFrontClusterDownward(tap_cell_p_height_, tap_cell_n_height_);
-    processed_blk_cnt = stripe.FitBlocksToFrontSpaceDownward(processed_blk_cnt,
-                                                             greedy_cur_iter_);
+    processed_blk_cnt =
+        stripe.FitBlocksToFrontSpaceDownward(processed_blk_cnt, iteration);
     stripe.LegalizeFrontCluster(use_init_loc);
   }
   stripe.UpdateRemainingClusters(tap_cell_p_height_, tap_cell_n_height_, false);
@@ -269,32 +271,56 @@ void GriddedRowLegalizer::CleanUpTemporaryRowSegments() {
   }
 }
 
+/****
+ * @brief legalize each stripe by alternating upward and downward passes until
+ * no rows spill out of the stripe. Stripes are disjoint in space and in cells,
+ * so they are legalized concurrently.
+ */
+bool GriddedRowLegalizer::UpwardDownwardLegalizeStripes(bool use_init_loc,
+                                                        bool is_disp_checked) {
+  std::vector<Stripe*> stripes = CollectStripes(col_list_);
+  int num_stripes = static_cast<int>(stripes.size());
+  std::vector<char> is_stripe_legal(num_stripes, 0);
+  double max_disp = ckt_ptr_->AveBlkWidth();
+#pragma omp parallel for num_threads(number_of_threads_) default(none) \
+    shared(stripes, num_stripes, is_stripe_legal, max_disp, use_init_loc, \
+               is_disp_checked) schedule(dynamic, 1)
+  for (int i = 0; i < num_stripes; ++i) {
+    Stripe& stripe = *stripes[i];
+    stripe.max_disp_ = max_disp;
+    bool is_success = true;
+    bool is_from_bottom = true;
+    for (int iter = 0; iter < greedy_max_iter_; ++iter) {
+      if (is_disp_checked) {
+        is_success =
+            is_from_bottom
+                ? StripeLegalizationUpwardWithDispCheck(stripe, use_init_loc,
+                                                        iter)
+                : StripeLegalizationDownwardWithDispCheck(stripe, use_init_loc,
+                                                          iter);
+      } else {
+        is_success =
+            is_from_bottom
+                ? StripeLegalizationUpward(stripe, use_init_loc, iter)
+                : StripeLegalizationDownward(stripe, use_init_loc, iter);
+      }
+      is_from_bottom = !is_from_bottom;
+      if (is_success) {
+        break;
+      }
+    }
+    is_stripe_legal[i] = is_success;
+  }
+  return std::all_of(is_stripe_legal.begin(), is_stripe_legal.end(),
+                     [](char is_legal) { return is_legal != 0; });
+}
+
 bool GriddedRowLegalizer::UpwardDownwardLegalization(bool use_init_loc) {
   LOG(info) << "Start upward-downward legalization\n";
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
-  bool res = true;
-  for (ClusterStripe& col : col_list_) {
-    bool is_success = true;
-    for (Stripe& stripe : col.stripe_list_) {
-      stripe.max_disp_ = ckt_ptr_->AveBlkWidth();
-      bool is_from_bottom = true;
-      for (greedy_cur_iter_ = 0; greedy_cur_iter_ < greedy_max_iter_;
-           ++greedy_cur_iter_) {
-        if (is_from_bottom) {
-          is_success = StripeLegalizationUpward(stripe, use_init_loc);
-        } else {
-          is_success = StripeLegalizationDownward(stripe, use_init_loc);
-        }
-        is_from_bottom = !is_from_bottom;
-        if (is_success) {
-          break;
-        }
-      }
-      res = res && is_success;
-    }
-  }
+  bool res = UpwardDownwardLegalizeStripes(use_init_loc, false);
   CleanUpTemporaryRowSegments();
   ReportDisplacement();
 
@@ -304,7 +330,7 @@ bool GriddedRowLegalizer::UpwardDownwardLegalization(bool use_init_loc) {
 }
 
 bool GriddedRowLegalizer::StripeLegalizationUpwardWithDispCheck(
-    Stripe& stripe, bool use_init_loc) {
+    Stripe& stripe, bool use_init_loc, int iteration) {
   stripe.gridded_rows_.clear();
   stripe.front_id_ = -1;
   stripe.is_bottom_up_ = true;
@@ -315,7 +341,7 @@ bool GriddedRowLegalizer::StripeLegalizationUpwardWithDispCheck(
   while (processed_blk_cnt < stripe.blk_ptrs_vec_.size()) {
     stripe.UpdateFrontClusterUpward(tap_cell_p_height_, tap_cell_n_height_);
     processed_blk_cnt = stripe.FitBlocksToFrontSpaceUpwardWithDispCheck(
-        processed_blk_cnt, greedy_cur_iter_);
+        processed_blk_cnt, iteration);
     stripe.LegalizeFrontCluster(use_init_loc);
   }
   stripe.UpdateRemainingClusters(tap_cell_p_height_, tap_cell_n_height_, true);
@@ -326,9 +352,10 @@ bool GriddedRowLegalizer::StripeLegalizationUpwardWithDispCheck(
 }
 
 bool GriddedRowLegalizer::StripeLegalizationDownwardWithDispCheck(
-    Stripe& stripe, bool use_init_loc) {
+    Stripe& stripe, bool use_init_loc, int iteration) {
   (void)stripe;
   (void)use_init_loc;
+  (void)iteration;
   DaliExpects(false, "to be implemented");
   return true;
 }
@@ -340,29 +367,7 @@ bool GriddedRowLegalizer::UpwardDownwardLegalizationWithDispCheck(
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
-  bool res = true;
-  for (ClusterStripe& col : col_list_) {
-    bool is_success = true;
-    for (Stripe& stripe : col.stripe_list_) {
-      stripe.max_disp_ = ckt_ptr_->AveBlkWidth();
-      bool is_from_bottom = true;
-      for (greedy_cur_iter_ = 0; greedy_cur_iter_ < greedy_max_iter_;
-           ++greedy_cur_iter_) {
-        if (is_from_bottom) {
-          is_success =
-              StripeLegalizationUpwardWithDispCheck(stripe, use_init_loc);
-        } else {
-          is_success =
-              StripeLegalizationDownwardWithDispCheck(stripe, use_init_loc);
-        }
-        is_from_bottom = !is_from_bottom;
-        if (is_success) {
-          break;
-        }
-      }
-      res = res && is_success;
-    }
-  }
+  bool res = UpwardDownwardLegalizeStripes(use_init_loc, true);
   CleanUpTemporaryRowSegments();
   ReportDisplacement();
 
@@ -433,11 +438,8 @@ bool GriddedRowLegalizer::IterativeDisplacementOptimization() {
   ElapsedTime elapsed_time;
   elapsed_time.RecordStartTime();
 
-  for (auto& col : col_list_) {
-    for (auto& stripe : col.stripe_list_) {
-      stripe.IterativeCellReordering(consensus_max_iter_, number_of_threads_);
-    }
-  }
+  IterativeCellReorderingInStripes(CollectStripes(col_list_),
+                                   consensus_max_iter_, number_of_threads_);
 
   elapsed_time.RecordEndTime();
   elapsed_time.PrintTimeElapsed();
@@ -450,27 +452,25 @@ bool GriddedRowLegalizer::IterativeDisplacementOptimization() {
 void GriddedRowLegalizer::EmbodyWellTapCells() {
   if (!is_well_tap_needed_) return;
 
-  // compute the number of well-tap cells and reserve space
-  size_t well_tap_cell_count_upper_limit = 0;
-  for (auto& col : col_list_) {
-    for (auto& stripe : col.stripe_list_) {
-      size_t upper_limit_per_row =
-          std::max(stripe.well_tap_cell_location_even_.size(),
-                   stripe.well_tap_cell_location_odd_.size());
-      well_tap_cell_count_upper_limit +=
-          upper_limit_per_row * stripe.gridded_rows_.size();
-    }
+  // well-tap cells of each stripe get consecutive ids, the same as creating
+  // them stripe by stripe
+  std::vector<Stripe*> stripes = CollectStripes(col_list_);
+  int num_stripes = static_cast<int>(stripes.size());
+  std::vector<size_t> start_ids(num_stripes + 1, 0);
+  for (int i = 0; i < num_stripes; ++i) {
+    start_ids[i + 1] = start_ids[i] + stripes[i]->WellTapCellCount();
   }
   auto& tap_cell_collection = ckt_ptr_->design().WellTapCellCollection();
   tap_cell_collection.Clear();
-  tap_cell_collection.Reserve(well_tap_cell_count_upper_limit);
+  tap_cell_collection.Reserve(start_ids.back());
+  for (size_t id = 0; id < start_ids.back(); ++id) {
+    tap_cell_collection.CreateInstance("__well_tap__" + std::to_string(id));
+  }
 
-  // create well-tap cells
-  size_t counter = 0;
-  for (auto& col : col_list_) {
-    for (auto& stripe : col.stripe_list_) {
-      counter = stripe.AddWellTapCells(ckt_ptr_, well_tap_type_ptr_, counter);
-    }
+#pragma omp parallel for num_threads(number_of_threads_) default(none) \
+    shared(stripes, num_stripes, start_ids) schedule(dynamic, 1)
+  for (int i = 0; i < num_stripes; ++i) {
+    stripes[i]->PlaceWellTapCells(ckt_ptr_, well_tap_type_ptr_, start_ids[i]);
   }
   tap_cell_collection.Freeze();
 }
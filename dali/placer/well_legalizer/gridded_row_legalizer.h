@@ -78,15 +78,20 @@ class GriddedRowLegalizer : public Placer {
   void RestoreConsensusLocX();
 
   void SetLegalizationMaxIteration(int max_iteration);
-  bool StripeLegalizationUpward(Stripe& stripe, bool use_init_loc);
-  bool StripeLegalizationDownward(Stripe& stripe, bool use_init_loc);
+  bool StripeLegalizationUpward(Stripe& stripe, bool use_init_loc,
+                                int iteration);
+  bool StripeLegalizationDownward(Stripe& stripe, bool use_init_loc,
+                                  int iteration);
   void CleanUpTemporaryRowSegments();
   bool UpwardDownwardLegalization(bool use_init_loc = true);
 
-  bool StripeLegalizationUpwardWithDispCheck(Stripe& stripe, bool use_init_loc);
+  bool StripeLegalizationUpwardWithDispCheck(Stripe& stripe, bool use_init_loc,
+                                             int iteration);
   bool StripeLegalizationDownwardWithDispCheck(Stripe& stripe,
-                                               bool use_init_loc);
+                                               bool use_init_loc,
+                                               int iteration);
   bool UpwardDownwardLegalizationWithDispCheck(bool use_init_loc);
+  bool UpwardDownwardLegalizeStripes(bool use_init_loc, bool is_disp_checked);
 
   bool IsLeftmostPlacementLegal();
   bool IsPlacementLegal();
@@ -132,7 +137,6 @@ class GriddedRowLegalizer : public Placer {
   int tap_cell_interval_grid_ = -1;
   BlockType* well_tap_type_ptr_ = nullptr;
 
-  int greedy_cur_iter_ = 0;
   int greedy_max_iter_ = 30;
 
   int consensus_max_iter_ = 1000;
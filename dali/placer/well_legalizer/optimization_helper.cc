@@ -249,28 +249,6 @@ void MinimizeLinearDisplacement(std::vector<BlockDisplacementVariable>& vars,
   }
 }
 
-struct AbacusSegment {
-  int first_id = -1;
-  int last_id = -1;
-  double x = 0;
-  double sum_e_ = 0;
-  double sum_es_ = 0;
-  int width = 0;
-
-  int CellCount() const { return last_id - first_id + 1; }
-  void UpdatePosition() { x = sum_es_ / sum_e_; }
-  void AddCell(BlockDisplacementVariable& var, int i);
-  void SetX(double init_x) { x = init_x; }
-  void SetFirstId(int i) { first_id = i; }
-  int LastId() { return last_id; }
-  int Width() { return width; }
-  double TotalWeight() { return sum_e_; }
-  double TotalWeightedLoc() { return sum_es_; }
-  double LX() const { return x; }
-  double UX() const { return x + width; }
-  void AddSegment(AbacusSegment& seg);
-};
-
 void AbacusSegment::AddCell(BlockDisplacementVariable& var, int i) {
   last_id = i;
   sum_e_ += var.Weight();
@@ -309,8 +287,15 @@ void CollapseSegment(std::vector<AbacusSegment>& segments, double lower_limit,
 
 void AbacusPlaceRow(std::vector<BlockDisplacementVariable>& vars,
                     double lower_limit, double upper_limit) {
-  if (vars.empty()) return;
   std::vector<AbacusSegment> segments;
+  AbacusPlaceRow(vars, segments, lower_limit, upper_limit);
+}
+
+void AbacusPlaceRow(std::vector<BlockDisplacementVariable>& vars,
+                    std::vector<AbacusSegment>& segments, double lower_limit,
+                    double upper_limit) {
+  segments.clear();
+  if (vars.empty()) return;
 
   int sz = static_cast<int>(vars.size());
   for (int i = 0; i < sz; ++i) {
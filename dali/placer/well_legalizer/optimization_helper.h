@@ -36,7 +36,41 @@ void MinimizeLinearDisplacement(std::vector<BlockDisplacementVariable>& vars,
                                 double lower_limit = -DBL_MAX,
                                 double upper_limit = DBL_MAX);
 
+/****
+ * @brief A cluster of abutting cells in the Abacus algorithm
+ */
+struct AbacusSegment {
+  int first_id = -1;
+  int last_id = -1;
+  double x = 0;
+  double sum_e_ = 0;
+  double sum_es_ = 0;
+  int width = 0;
+
+  int CellCount() const { return last_id - first_id + 1; }
+  void UpdatePosition() { x = sum_es_ / sum_e_; }
+  void AddCell(BlockDisplacementVariable& var, int i);
+  void SetX(double init_x) { x = init_x; }
+  void SetFirstId(int i) { first_id = i; }
+  int LastId() { return last_id; }
+  int Width() { return width; }
+  double TotalWeight() { return sum_e_; }
+  double TotalWeightedLoc() { return sum_es_; }
+  double LX() const { return x; }
+  double UX() const { return x + width; }
+  void AddSegment(AbacusSegment& seg);
+};
+
+void AbacusPlaceRow(std::vector<BlockDisplacementVariable>& vars,
+                    double lower_limit = -DBL_MAX,
+                    double upper_limit = DBL_MAX);
+
+/**
+ * Same as above, but clusters are kept in the given buffer, so that repeated
+ * calls do not allocate memory once the buffer is large enough.
+ */
 void AbacusPlaceRow(std::vector<BlockDisplacementVariable>& vars,
+                    std::vector<AbacusSegment>& segments,
                     double lower_limit = -DBL_MAX,
                     double upper_limit = DBL_MAX);
 
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <utility>
 
 #include "dali/common/helper.h"
 #include "dali/placer/well_legalizer/block_segment.h"
@@ -30,6 +31,16 @@
 
 namespace dali {
 
+namespace {
+
+bool IsLeftOf(BlockRegion const& br0, BlockRegion const& br1) {
+  return (br0.block->LLX() < br1.block->LLX()) ||
+         ((br0.block->LLX() == br1.block->LLX()) &&
+          (br0.block->Id() < br1.block->Id()));
+}
+
+}  // namespace
+
 void RowSegment::SetLLX(int lx) { lx_ = lx; }
 
 void RowSegment::SetURX(int ux) { lx_ = ux - width_; }
@@ -61,12 +72,7 @@ void RowSegment::AddBlockRegion(Block* blk_ptr, int region_id) {
 
 void RowSegment::MinDisplacementLegalization(bool use_init_loc) {
   if (blk_regions_.empty()) return;
-  std::sort(blk_regions_.begin(), blk_regions_.end(),
-            [](const BlockRegion& br0, const BlockRegion& br1) {
-              return (br0.block->LLX() < br1.block->LLX()) ||
-                     ((br0.block->LLX() == br1.block->LLX()) &&
-                      (br0.block->Id() < br1.block->Id()));
-            });
+  std::sort(blk_regions_.begin(), blk_regions_.end(), IsLeftOf);
 
   std::vector<BlockDisplacementVariable> vars;
   vars.reserve(blk_regions_.size());
@@ -177,14 +183,16 @@ void RowSegment::FindBestLocalOrder(
   }
 }
 
-void RowSegment::LocalReorder(std::vector<BlockDisplacementVariable>& vars,
-                              int range, int omit, bool is_linear) {
+void RowSegment::LocalReorder(
+    std::vector<BlockDisplacementVariable>& vars,
+    std::vector<BlockDisplacementVariable>& res_local_order, int range,
+    int omit, bool is_linear) {
   int sz = static_cast<int>(vars.size());
   if (sz < range) return;
 
   int last_segment = sz - range - omit;
   BlockDisplacementVariable tmp(0, 0, 0);
-  std::vector<BlockDisplacementVariable> res_local_order(range, tmp);
+  res_local_order.assign(range, tmp);
   for (int l = omit; l <= last_segment; ++l) {
     int tot_blk_width = 0;
     for (int j = 0; j < range; ++j) {
@@ -249,20 +257,51 @@ void RowSegment::LocalReorder2(std::vector<BlockDisplacementVariable>& vars) {
   }
 }
 
+/****
+ * @brief sort block regions based on their lower x location. Locations barely
+ * change between two consensus iterations, so the insertion sort is linear in
+ * most cases. It falls back to std::sort when too many regions move, e.g., in
+ * the first iteration.
+ */
+void RowSegment::SortBlockRegions() {
+  size_t sz = blk_regions_.size();
+  size_t max_shift_cnt = 4 * sz + 16;
+  size_t shift_cnt = 0;
+  for (size_t i = 1; i < sz; ++i) {
+    BlockRegion cur = blk_regions_[i];
+    size_t j = i;
+    while (j > 0 && IsLeftOf(cur, blk_regions_[j - 1])) {
+      blk_regions_[j] = blk_regions_[j - 1];
+      --j;
+    }
+    blk_regions_[j] = cur;
+    shift_cnt += i - j;
+    if (shift_cnt > max_shift_cnt) {
+      std::sort(blk_regions_.begin(), blk_regions_.end(), IsLeftOf);
+      return;
+    }
+  }
+}
+
 std::vector<BlockDisplacementVariable>
 RowSegment::OptimizeQuadraticDisplacement(double lambda,
                                           bool is_weighted_anchor,
                                           bool is_reorder) {
-  std::vector<BlockDisplacementVariable> vars;
-  if (blk_regions_.empty()) return vars;
+  RowSegmentWorkspace workspace;
+  OptimizeQuadraticDisplacement(lambda, is_weighted_anchor, is_reorder,
+                                workspace);
+  return std::move(workspace.vars);
+}
 
-  // sort cells based on their lower x location
-  std::sort(blk_regions_.begin(), blk_regions_.end(),
-            [](const BlockRegion& br0, const BlockRegion& br1) {
-              return (br0.block->LLX() < br1.block->LLX()) ||
-                     ((br0.block->LLX() == br1.block->LLX()) &&
-                      (br0.block->Id() < br1.block->Id()));
-            });
+void RowSegment::OptimizeQuadraticDisplacement(double lambda,
+                                               bool is_weighted_anchor,
+                                               bool is_reorder,
+                                               RowSegmentWorkspace& workspace) {
+  std::vector<BlockDisplacementVariable>& vars = workspace.vars;
+  vars.clear();
+  if (blk_regions_.empty()) return;
+
+  SortBlockRegions();
 
   // compute average discrepancy
   double ave_discrepancy = 1;
@@ -315,17 +354,15 @@ RowSegment::OptimizeQuadraticDisplacement(double lambda,
 
   // MinimizeQuadraticDisplacement(vars, LLX(), URX());
   // MinimizeQuadraticDisplacement(vars);
-  AbacusPlaceRow(vars);
+  AbacusPlaceRow(vars, workspace.abacus_segments);
 
   if (is_weighted_anchor) {
     FitInRange(vars);
     if (is_reorder) {
-      LocalReorder(vars, 3, 0, false);
+      LocalReorder(vars, workspace.local_order, 3, 0, false);
       // LocalReorder2(vars);
     }
   }
-
-  return vars;
 }
 
 std::vector<BlockDisplacementVariable> RowSegment::OptimizeLinearDisplacement(
@@ -334,12 +371,7 @@ std::vector<BlockDisplacementVariable> RowSegment::OptimizeLinearDisplacement(
   if (blk_regions_.empty()) return vars;
 
   // sort cells based on their lower x location
-  std::sort(blk_regions_.begin(), blk_regions_.end(),
-            [](const BlockRegion& br0, const BlockRegion& br1) {
-              return (br0.block->LLX() < br1.block->LLX()) ||
-                     ((br0.block->LLX() == br1.block->LLX()) &&
-                      (br0.block->Id() < br1.block->Id()));
-            });
+  std::sort(blk_regions_.begin(), blk_regions_.end(), IsLeftOf);
 
   // compute average discrepancy
   double ave_discrepancy = 1;
@@ -389,7 +421,10 @@ std::vector<BlockDisplacementVariable> RowSegment::OptimizeLinearDisplacement(
 
   if (is_weighted_anchor) {
     FitInRange(vars);
-    if (is_reorder) LocalReorder(vars, 3, 0, true);
+    if (is_reorder) {
+      std::vector<BlockDisplacementVariable> res_local_order;
+      LocalReorder(vars, res_local_order, 3, 0, true);
+    }
   }
 
   return vars;
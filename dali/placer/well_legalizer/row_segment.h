@@ -32,6 +32,17 @@
 
 namespace dali {
 
+/**
+ * Reusable buffers of displacement optimization in row segments. Each thread
+ * keeps its own workspace, buffers grow to the largest row segment and are
+ * reused by all later row segments and iterations.
+ */
+struct RowSegmentWorkspace {
+  std::vector<BlockDisplacementVariable> vars;
+  std::vector<AbacusSegment> abacus_segments;
+  std::vector<BlockDisplacementVariable> local_order;
+};
+
 class RowSegment {
  public:
   RowSegment() = default;
@@ -60,11 +71,19 @@ class RowSegment {
                           std::vector<BlockDisplacementVariable>& vars, int cur,
                           int l, int r, double left_bound, double right_bound,
                           double gap, int range, bool is_linear);
-  void LocalReorder(std::vector<BlockDisplacementVariable>& vars, int range = 3,
-                    int omit = 0, bool is_linear = false);
+  void LocalReorder(std::vector<BlockDisplacementVariable>& vars,
+                    std::vector<BlockDisplacementVariable>& res_local_order,
+                    int range = 3, int omit = 0, bool is_linear = false);
   void LocalReorder2(std::vector<BlockDisplacementVariable>& vars);
   std::vector<BlockDisplacementVariable> OptimizeQuadraticDisplacement(
       double lambda, bool is_weighted_anchor, bool is_reorder);
+  /**
+   * Same as above, but solutions are stored in workspace.vars, and no memory
+   * is allocated once buffers of the workspace are large enough.
+   */
+  void OptimizeQuadraticDisplacement(double lambda, bool is_weighted_anchor,
+                                     bool is_reorder,
+                                     RowSegmentWorkspace& workspace);
   std::vector<BlockDisplacementVariable> OptimizeLinearDisplacement(
       double lambda, bool is_weighted_anchor, bool is_reorder);
 
@@ -82,6 +101,8 @@ class RowSegment {
 
   /**** for iterative displacement optimization ****/
   double opt_anchor_weight_ = 0;
+
+  void SortBlockRegions();
 };
 
 }  // namespace dali
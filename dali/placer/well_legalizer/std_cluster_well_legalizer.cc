@@ -20,10 +20,11 @@
  ******************************************************************************/
 #include "std_cluster_well_legalizer.h"
 
+#include <omp.h>
+
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
-#include <set>
 
 #include "dali/common/helper.h"
 #include "dali/common/placement_metrics.h"
@@ -125,6 +126,15 @@ void StdClusterWellLegalizer::SetMaxRowWidth(double max_row_width_microns) {
   LOG(info) << "Max row width in grid unit : " << max_row_width_ << "\n";
 }
 
+void StdClusterWellLegalizer::SetLocalReorderRange(int range) {
+  DaliExpects(range >= 2, "Local reordering range must be at least 2");
+  local_reorder_range_ = range;
+}
+
+void StdClusterWellLegalizer::SetParallelLocalReorder(bool is_parallel) {
+  enable_parallel_local_reorder_ = is_parallel;
+}
+
 void StdClusterWellLegalizer::InitializeWellLegalizer(int cluster_width) {
   if (disable_welltap_) {
     num_of_tap_cell_ = 0;
@@ -533,55 +543,57 @@ bool StdClusterWellLegalizer::BlockClustering() {
 /****
  * Clustering blocks in each stripe
  * After clustering, leave clusters as they are
+ * Stripes are disjoint in space and in cells, so they are clustered
+ * concurrently, unless intermediate results are dumped.
  * ****/
 bool StdClusterWellLegalizer::BlockClusteringLoose() {
+  std::vector<Stripe*> stripes = CollectStripes(col_list_);
+  int num_stripes = static_cast<int>(stripes.size());
+  std::vector<char> is_stripe_legal(num_stripes, 0);
+  int num_threads = is_dump ? 1 : num_threads_;
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(stripes, num_stripes, is_stripe_legal) schedule(dynamic, 1)
+  for (int i = 0; i < num_stripes; ++i) {
+    is_stripe_legal[i] = StripeClusteringLoose(*stripes[i]);
+  }
+  return std::all_of(is_stripe_legal.begin(), is_stripe_legal.end(),
+                     [](char is_legal) { return is_legal != 0; });
+}
+
+bool StdClusterWellLegalizer::StripeClusteringLoose(Stripe& stripe) {
   int step = 50;
-  int count = 0;
-  bool res = true;
-  for (auto& col : col_list_) {
-    bool is_success = true;
-    for (auto& stripe : col.stripe_list_) {
-      int i = 0;
-      bool is_from_bottom = true;
-      for (i = 0; i < max_iter_; ++i) {
-        if (is_from_bottom) {
-          is_success = StripeLegalizationBottomUp(stripe);
-        } else {
-          is_success = StripeLegalizationTopDown(stripe);
-        }
-        if (!is_success) {
-          is_success = TrialClusterLegalization(stripe);
-        }
-        is_from_bottom = !is_from_bottom;
-        if (is_success) {
-          break;
-        }
-      }
-      res = res && is_success;
-      /*if (is_success) {
-        LOG(info)  <<"stripe legalization success, %d\n", i);
-      } else {
-        LOG(info)  <<"stripe legalization fail, %d\n", i);
-      }*/
+  bool is_success = true;
+  bool is_from_bottom = true;
+  for (int i = 0; i < max_iter_; ++i) {
+    if (is_from_bottom) {
+      is_success = StripeLegalizationBottomUp(stripe);
+    } else {
+      is_success = StripeLegalizationTopDown(stripe);
+    }
+    if (!is_success) {
+      is_success = TrialClusterLegalization(stripe);
+    }
+    is_from_bottom = !is_from_bottom;
+    if (is_success) {
+      break;
+    }
+  }
 
-      for (auto& row : stripe.gridded_rows_) {
-        row.UpdateBlockLocY();
-        row.MinDisplacementLegalization();
-        if (is_dump) {
-          if (count % step == 0) {
-            std::string tmp_file_name =
-                "wlg_result_" + std::to_string(dump_count) + ".txt";
-            ckt_ptr_->GenMATLABTable(tmp_file_name);
-            ++dump_count;
-          }
-          ++count;
-        }
+  for (auto& row : stripe.gridded_rows_) {
+    row.UpdateBlockLocY();
+    row.MinDisplacementLegalization();
+    if (is_dump) {
+      if (dump_row_count_ % step == 0) {
+        std::string tmp_file_name =
+            "wlg_result_" + std::to_string(dump_count) + ".txt";
+        ckt_ptr_->GenMATLABTable(tmp_file_name);
+        ++dump_count;
       }
-      stripe.MinDisplacementAdjustment();
+      ++dump_row_count_;
     }
   }
-
-  return res;
+  stripe.MinDisplacementAdjustment();
+  return is_success;
 }
 
 bool StdClusterWellLegalizer::BlockClusteringCompact() {
@@ -684,39 +696,13 @@ bool StdClusterWellLegalizer::TrialClusterLegalization(Stripe& stripe) {
 }
 
 /****
- * Returns the wire-length cost of the small group from l-th element to r-th
- * element in this cluster "for each order, we keep the left and right
- * boundaries of the group and evenly distribute the cells inside the group.
- * Since we have the Single-Segment Clustering technique to take care of the
- * cell positions, we do not pay much attention to the exact positions of the
- * cells during Local Re-ordering." from "An Efficient and Effective Detailed
- * Placement Algorithm"
- * ****/
-double StdClusterWellLegalizer::WireLengthCost(GriddedRow* cluster, int l,
-                                               int r) {
-  auto& net_list = ckt_ptr_->Nets();
-  std::set<Net*> net_involved;
-  for (int i = l; i <= r; ++i) {
-    auto* blk = cluster->Blocks()[i];
-    for (auto& net_num : blk->NetList()) {
-      if (net_list[net_num].PinCnt() < 100) {
-        net_involved.insert(&(net_list[net_num]));
-      }
-    }
-  }
-
-  double hpwl_x = 0;
-  double hpwl_y = 0;
-  for (auto& net : net_involved) {
-    hpwl_x += net->WeightedHPWLX();
-    hpwl_y += net->WeightedHPWLY();
-  }
-
-  return hpwl_x * ckt_ptr_->GridValueX() + hpwl_y * ckt_ptr_->GridValueY();
-}
-
-/****
- * Returns the best permutation in @param res
+ * Returns the best permutation in @param res. The wire-length cost of each
+ * order is evaluated by @param evaluator, "for each order, we keep the
+ * left and right boundaries of the group and evenly distribute the cells
+ * inside the group. Since we have the Single-Segment Clustering technique to
+ * take care of the cell positions, we do not pay much attention to the exact
+ * positions of the cells during Local Re-ordering." from "An Efficient and
+ * Effective Detailed Placement Algorithm"
  * @param cost records the cost function associated with the best permutation
  * @param l is the left bound of the range
  * @param r is the right bound of the range
@@ -724,8 +710,9 @@ double StdClusterWellLegalizer::WireLengthCost(GriddedRow* cluster, int l,
  * permutation of range [l,r]
  * ****/
 void StdClusterWellLegalizer::FindBestLocalOrder(
-    std::vector<Block*>& res, double& cost, GriddedRow* cluster, int cur, int l,
-    int r, int left_bound, int right_bound, int gap, int range) {
+    std::vector<Block*>& res, double& cost, GriddedRow* cluster,
+    WindowHpwlEvaluator const& evaluator, int cur, int l, int r, int left_bound,
+    int right_bound, int gap, int range) {
   // LOG(info)  <<"l : %d, r: %d\n", l, r);
   if (cur == r) {
     cluster->Blocks()[l]->SetLLX(left_bound);
@@ -738,7 +725,7 @@ void StdClusterWellLegalizer::FindBestLocalOrder(
       left_contour += blk->Width() + gap;
     }
 
-    double tmp_cost = WireLengthCost(cluster, l, r);
+    double tmp_cost = evaluator.Cost();
     if (tmp_cost < cost) {
       cost = tmp_cost;
       for (int j = 0; j < range; ++j) {
@@ -753,8 +740,8 @@ void StdClusterWellLegalizer::FindBestLocalOrder(
       std::swap(blk_list[cur], blk_list[i]);
 
       // Recursion called
-      FindBestLocalOrder(res, cost, cluster, cur + 1, l, r, left_bound,
-                         right_bound, gap, range);
+      FindBestLocalOrder(res, cost, cluster, evaluator, cur + 1, l, r,
+                         left_bound, right_bound, gap, range);
 
       // backtrack
       std::swap(blk_list[cur], blk_list[i]);
@@ -762,8 +749,8 @@ void StdClusterWellLegalizer::FindBestLocalOrder(
   }
 }
 
-void StdClusterWellLegalizer::LocalReorderInCluster(GriddedRow* cluster,
-                                                    int range) {
+void StdClusterWellLegalizer::LocalReorderInCluster(
+    GriddedRow* cluster, WindowHpwlEvaluator& evaluator, int range) {
   /****
    * Enumerate all local permutations, @param range determines how big the local
    * range is
@@ -793,8 +780,9 @@ void StdClusterWellLegalizer::LocalReorderInCluster(GriddedRow* cluster,
     int right_bound = (int)cluster->Blocks()[r]->URX();
     int gap = (right_bound - left_bound - tot_blk_width) / (r - l);
 
-    FindBestLocalOrder(res_local_order, best_cost, cluster, l, l, r, left_bound,
-                       right_bound, gap, range);
+    evaluator.SetWindow(&cluster->Blocks()[l], range);
+    FindBestLocalOrder(res_local_order, best_cost, cluster, evaluator, l, l, r,
+                       left_bound, right_bound, gap, range);
     for (int j = 0; j < range; ++j) {
       cluster->Blocks()[l + j] = res_local_order[j];
     }
@@ -834,11 +822,91 @@ void StdClusterWellLegalizer::LocalReorderAllClusters() {
                      (lhs->LLY() == rhs->LLY() && lhs->LLX() < rhs->LLX());
             });
 
-  for (auto& cluster_ptr : cluster_ptr_list) {
-    LocalReorderInCluster(cluster_ptr, 3);
+  int num_threads = enable_parallel_local_reorder_ ? num_threads_ : 1;
+  window_hpwl_evaluators_.resize(num_threads);
+  for (auto& evaluator : window_hpwl_evaluators_) {
+    evaluator.SetCircuit(ckt_ptr_);
+  }
+  if (!enable_parallel_local_reorder_) {
+    for (auto& cluster_ptr : cluster_ptr_list) {
+      LocalReorderInCluster(cluster_ptr, window_hpwl_evaluators_[0],
+                            local_reorder_range_);
+    }
+    return;
+  }
+
+  // clusters of the same color share no evaluated nets, so a cluster never
+  // reads a location written by another cluster reordered concurrently
+  std::vector<int> color_begin;
+  GroupClustersByColor(cluster_ptr_list, color_begin);
+  int num_colors = static_cast<int>(color_begin.size()) - 1;
+  for (int c = 0; c < num_colors; ++c) {
+    int begin = color_begin[c];
+    int end = color_begin[c + 1];
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(cluster_ptr_list, begin, end) schedule(dynamic, 1)
+    for (int i = begin; i < end; ++i) {
+      LocalReorderInCluster(cluster_ptr_list[i],
+                            window_hpwl_evaluators_[omp_get_thread_num()],
+                            local_reorder_range_);
+    }
   }
 }
 
+/****
+ * @brief Greedy coloring of clusters in their current order, two clusters get
+ * different colors if a net evaluated by local reordering connects them. The
+ * clusters are then stably grouped by color, clusters of color c are in
+ * [color_begin[c], color_begin[c + 1]). The result only depends on the input
+ * order, so the parallel reordering is deterministic.
+ * ****/
+void StdClusterWellLegalizer::GroupClustersByColor(
+    std::vector<GriddedRow*>& clusters, std::vector<int>& color_begin) {
+  auto& nets = ckt_ptr_->Nets();
+  int num_clusters = static_cast<int>(clusters.size());
+  std::vector<int> blk_cluster_ids(ckt_ptr_->Blocks().size(), -1);
+  for (int i = 0; i < num_clusters; ++i) {
+    for (Block* blk_ptr : clusters[i]->Blocks()) {
+      blk_cluster_ids[blk_ptr->Id()] = i;
+    }
+  }
+
+  std::vector<int> colors(num_clusters, -1);
+  // color_stamps[c] == i if a neighbor of the i-th cluster has color c
+  std::vector<int> color_stamps;
+  for (int i = 0; i < num_clusters; ++i) {
+    for (Block* blk_ptr : clusters[i]->Blocks()) {
+      for (int net_id : blk_ptr->NetList()) {
+        Net& net = nets[net_id];
+        size_t pin_cnt = net.PinCnt();
+        if (pin_cnt <= 1 || pin_cnt >= WindowHpwlEvaluator::kMaxNetPinCnt) {
+          continue;
+        }
+        for (auto& blk_pin : net.BlockPins()) {
+          int j = blk_cluster_ids[blk_pin.BlkPtr()->Id()];
+          if (j >= 0 && colors[j] >= 0) color_stamps[colors[j]] = i;
+        }
+      }
+    }
+    int color = 0;
+    int num_colors = static_cast<int>(color_stamps.size());
+    while (color < num_colors && color_stamps[color] == i) ++color;
+    if (color == num_colors) color_stamps.push_back(-1);
+    colors[i] = color;
+  }
+
+  int num_colors = static_cast<int>(color_stamps.size());
+  color_begin.assign(num_colors + 1, 0);
+  for (int color : colors) ++color_begin[color + 1];
+  for (int c = 0; c < num_colors; ++c) color_begin[c + 1] += color_begin[c];
+  std::vector<GriddedRow*> grouped_clusters(num_clusters, nullptr);
+  std::vector<int> offsets(color_begin.begin(), color_begin.end() - 1);
+  for (int i = 0; i < num_clusters; ++i) {
+    grouped_clusters[offsets[colors[i]]++] = clusters[i];
+  }
+  clusters.swap(grouped_clusters);
+}
+
 /*
 void StdClusterWellLegalizer::SingleSegmentClusteringOptimization() {
   LOG(info) << "Start single segment clustering\n";
@@ -1115,6 +1183,7 @@ bool StdClusterWellLegalizer::WellLegalize() {
 }
 
 bool StdClusterWellLegalizer::RunBlockClusteringStage() {
+  ScopedPlacementTimer timer("block_clustering");
   LOG(info) << "Form block clustering\n";
   bool is_success = BlockClusteringLoose();
   ReportHPWL();
@@ -1127,6 +1196,7 @@ void StdClusterWellLegalizer::RunClusterOrientationStage() {
     LOG(info) << "Skip flipping cluster orientation\n";
     return;
   }
+  ScopedPlacementTimer timer("orientation");
   LOG(info) << "Flip cluster orientation\n";
   UpdateClusterOrient();
   ReportHPWL();
@@ -1134,6 +1204,7 @@ void StdClusterWellLegalizer::RunClusterOrientationStage() {
 }
 
 void StdClusterWellLegalizer::RunLocalReorderingStage() {
+  ScopedPlacementTimer timer("local_reorder");
   LOG(info) << "Perform local reordering\n";
   for (int i = 0; i < 6; ++i) {
     LOG(info) << "reorder iteration: " << i << "\n";
@@ -1144,6 +1215,7 @@ void StdClusterWellLegalizer::RunLocalReorderingStage() {
 }
 
 void StdClusterWellLegalizer::RunWellTapStage() {
+  ScopedPlacementTimer timer("well_tap");
   if (disable_welltap_) {
     LOG(info) << "Skip inserting well tap cells\n";
   } else {
@@ -1154,6 +1226,7 @@ void StdClusterWellLegalizer::RunWellTapStage() {
 }
 
 void StdClusterWellLegalizer::RunEndCapStage() {
+  ScopedPlacementTimer timer("end_cap");
   if (enable_end_cap_cell_) {
     LOG(info) << "Create end cap cells\n";
     CreateEndCapCellTypes();
@@ -34,6 +34,7 @@
 #include "gridded_row.h"
 #include "space_partitioner.h"
 #include "stripe.h"
+#include "window_hpwl_evaluator.h"
 
 namespace dali {
 
@@ -56,6 +57,16 @@ class StdClusterWellLegalizer : public Placer {
   /** Set maximum legalized row width in microns. */
   void SetMaxRowWidth(double max_row_width_microns);
 
+  /** Set the number of consecutive cells permuted by local reordering. */
+  void SetLocalReorderRange(int range);
+
+  /**
+   * Reorder clusters sharing no nets concurrently with num_threads_ threads.
+   * The result is the same for any number of threads, but differs from the
+   * serial mode, which reorders clusters one at a time from the bottom left.
+   */
+  void SetParallelLocalReorder(bool is_parallel);
+
   /** Set the orientation of the first generated row. */
   void SetFirstRowOrientN(bool is_N) { is_first_row_orient_N_ = is_N; }
 
@@ -82,16 +93,21 @@ class StdClusterWellLegalizer : public Placer {
 
   bool BlockClustering();
   bool BlockClusteringLoose();
+  bool StripeClusteringLoose(Stripe& stripe);
   bool BlockClusteringCompact();
 
   bool TrialClusterLegalization(Stripe& stripe);
 
-  double WireLengthCost(GriddedRow* cluster, int l, int r);
   void FindBestLocalOrder(std::vector<Block*>& res, double& cost,
-                          GriddedRow* cluster, int cur, int l, int r,
-                          int left_bound, int right_bound, int gap, int range);
-  void LocalReorderInCluster(GriddedRow* cluster, int range = 3);
+                          GriddedRow* cluster,
+                          WindowHpwlEvaluator const& evaluator, int cur, int l,
+                          int r, int left_bound, int right_bound, int gap,
+                          int range);
+  void LocalReorderInCluster(GriddedRow* cluster,
+                             WindowHpwlEvaluator& evaluator, int range = 3);
   void LocalReorderAllClusters();
+  void GroupClustersByColor(std::vector<GriddedRow*>& clusters,
+                            std::vector<int>& color_begin);
 
   // void SingleSegmentClusteringOptimization();
 
@@ -140,6 +156,11 @@ class StdClusterWellLegalizer : public Placer {
   /**** cell orientation ****/
   bool disable_cell_flip_ = false;
 
+  /**** local reordering ****/
+  int local_reorder_range_ = 3;
+  bool enable_parallel_local_reorder_ = false;
+  std::vector<WindowHpwlEvaluator> window_hpwl_evaluators_;
+
   /**** end cap cell ****/
   bool enable_end_cap_cell_ = false;
   int pre_end_cap_min_width_ = 0;
@@ -177,6 +198,7 @@ class StdClusterWellLegalizer : public Placer {
   // dump result
   bool is_dump = false;
   int dump_count = 0;
+  int dump_row_count_ = 0;
 };
 
 }  // namespace dali
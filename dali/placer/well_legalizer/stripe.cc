@@ -20,8 +20,6 @@
  ******************************************************************************/
 #include "stripe.h"
 
-#include <omp.h>
-
 #include <algorithm>
 #include <cfloat>
 #include <climits>
@@ -528,15 +526,22 @@ void Stripe::CleanUpTemporaryRowSegments() {
   }
 }
 
-size_t Stripe::AddWellTapCells(Circuit* p_ckt, BlockType* well_tap_type_ptr,
-                               size_t start_id) {
+size_t Stripe::WellTapCellCount() const {
+  size_t row_cnt = gridded_rows_.size();
+  size_t odd_row_cnt = row_cnt / 2;
+  return (row_cnt - odd_row_cnt) * well_tap_cell_location_even_.size() +
+         odd_row_cnt * well_tap_cell_location_odd_.size();
+}
+
+size_t Stripe::PlaceWellTapCells(Circuit* p_ckt, BlockType* well_tap_type_ptr,
+                                 size_t start_id) {
   size_t row_cnt = gridded_rows_.size();
   for (size_t i = 0; i < row_cnt; ++i) {
     if (i & 1) {
-      start_id = gridded_rows_[i].AddWellTapCells(
+      start_id = gridded_rows_[i].PlaceWellTapCells(
           p_ckt, well_tap_type_ptr, start_id, well_tap_cell_location_odd_);
     } else {
-      start_id = gridded_rows_[i].AddWellTapCells(
+      start_id = gridded_rows_[i].PlaceWellTapCells(
           p_ckt, well_tap_type_ptr, start_id, well_tap_cell_location_even_);
     }
   }
@@ -588,63 +593,6 @@ void Stripe::UpdateSubCellLocs(std::vector<BlockDisplacementVariable>& vars) {
   }
 }
 
-void Stripe::OptimizeDisplacementInEachRowSegment(double lambda,
-                                                  bool is_weighted_anchor,
-                                                  bool is_reorder) {
-  size_t sz = row_seg_ptrs_.size();
-#pragma omp parallel for
-  for (size_t i = 0; i < sz; ++i) {
-    RowSegment* seg = row_seg_ptrs_[i];
-    std::vector<BlockDisplacementVariable> vars =
-        seg->OptimizeQuadraticDisplacement(lambda, is_weighted_anchor,
-                                           is_reorder);
-    // std::vector<BlockDisplacementVariable> vars =
-    //     seg->OptimizeLinearDisplacement(lambda, is_weighted_anchor,
-    //     is_reorder);
-    UpdateSubCellLocs(vars);
-  }
-}
-
-void Stripe::ComputeAverageLoc() {
-  size_t sz = blk_ptrs_vec_.size();
-#pragma omp parallel for
-  for (size_t i = 0; i < sz; ++i) {
-    Block* blk_ptr = blk_ptrs_vec_[i];
-    auto aux_ptr = static_cast<LegalizerBlockAux*>(blk_ptr->AuxPtr());
-    aux_ptr->ComputeAverageLoc();
-    blk_ptr->SetLLX(aux_ptr->AverageLoc());
-  }
-}
-
-void Stripe::ReportIterativeStatus(int i) {
-  double disp_x = 0;
-  double discrepancy = 0;
-  max_discrepancy_ = 0;
-  for (auto& blk_ptr : blk_ptrs_vec_) {
-    // compute displacement from init_x to average_x
-    auto aux_ptr = static_cast<LegalizerBlockAux*>(blk_ptr->AuxPtr());
-    double2d init_loc = aux_ptr->InitLoc();
-    double tmp_disp_x = std::fabs(aux_ptr->AverageLoc() - init_loc.x);
-    disp_x += tmp_disp_x;
-
-    // compute average discrepancy to the average location
-    int sz = static_cast<int>(aux_ptr->SubLocs().size());
-    double tmp_discrepancy = 0;
-    for (auto& loc_x : aux_ptr->SubLocs()) {
-      tmp_discrepancy += std::fabs(loc_x - aux_ptr->AverageLoc());
-    }
-    tmp_discrepancy = tmp_discrepancy / sz;
-    discrepancy += tmp_discrepancy;
-    max_discrepancy_ = std::max(max_discrepancy_, tmp_discrepancy);
-  }
-
-  displacements_.push_back(disp_x);
-  discrepancies_.push_back(discrepancy);
-
-  LOG(info) << "Iter " << i << ", displacement: " << disp_x
-            << ", discrepancy: " << discrepancy << "\n";
-}
-
 bool Stripe::IsDiscrepancyConverged() {
   if (discrepancies_.size() <= 1) return false;
   size_t sz = discrepancies_.size();
@@ -654,40 +602,10 @@ bool Stripe::IsDiscrepancyConverged() {
   return last_difference / discrepancies_[0] < threshold;
 }
 
-void Stripe::SetBlockLoc() {
-  size_t sz = blk_ptrs_vec_.size();
-#pragma omp parallel for
-  for (size_t i = 0; i < sz; ++i) {
-    Block* blk_ptr = blk_ptrs_vec_[i];
-    auto aux_ptr = static_cast<LegalizerBlockAux*>(blk_ptr->AuxPtr());
-    blk_ptr->SetLLX(std::round(aux_ptr->AverageLoc()));
-  }
-}
-
 void Stripe::ClearMultiRowCellBreaking() { row_seg_ptrs_.clear(); }
 
 void Stripe::IterativeCellReordering(int max_iter, int number_of_threads) {
-  CollectAllRowSegments();
-  omp_set_num_threads(number_of_threads);
-  bool is_weighted_anchor = false;
-  for (int i = 0; i < max_iter; ++i) {
-    // double decay = 30.0; // the bigger, the closer to CPLEX result
-    // double lambda = exp(-i / decay);
-    double lambda = 1 / double(i + 1);
-    OptimizeDisplacementInEachRowSegment(lambda, is_weighted_anchor,
-                                         i % 10 == 0);
-    ComputeAverageLoc();
-    ReportIterativeStatus(i);
-    if (!is_weighted_anchor) {
-      is_weighted_anchor = IsDiscrepancyConverged();
-    }
-    if (max_discrepancy_ < 0.1) break;
-  }
-  SetBlockLoc();
-  omp_set_num_threads(1);
-  ClearMultiRowCellBreaking();
-  LOG(info) << "displacement: " << displacements_ << "\n";
-  LOG(info) << "discrepancy : " << discrepancies_ << "\n";
+  IterativeCellReorderingInStripes({this}, max_iter, number_of_threads);
 }
 
 void Stripe::SortBlocksInEachRow() {
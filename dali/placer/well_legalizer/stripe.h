@@ -122,21 +122,16 @@ class Stripe {
   void UpdateBlockYLocation();
   void CleanUpTemporaryRowSegments();
 
-  size_t AddWellTapCells(Circuit* p_ckt, BlockType* well_tap_type_ptr,
-                         size_t start_id);
+  size_t WellTapCellCount() const;
+  size_t PlaceWellTapCells(Circuit* p_ckt, BlockType* well_tap_type_ptr,
+                           size_t start_id);
 
   bool IsLeftmostPlacementLegal();
   bool IsStripeLegal();
 
   void CollectAllRowSegments();
   void UpdateSubCellLocs(std::vector<BlockDisplacementVariable>& vars);
-  void OptimizeDisplacementInEachRowSegment(double lambda,
-                                            bool is_weighted_anchor,
-                                            bool is_reorder);
-  void ComputeAverageLoc();
-  void ReportIterativeStatus(int i);
   bool IsDiscrepancyConverged();
-  void SetBlockLoc();
   void ClearMultiRowCellBreaking();
   void IterativeCellReordering(int max_iter, int number_of_threads = 1);
 
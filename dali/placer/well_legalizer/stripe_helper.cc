@@ -21,10 +21,160 @@
 
 #include "stripe_helper.h"
 
+#include <omp.h>
+
 #include <algorithm>
+#include <cmath>
+
+#include "dali/placer/well_legalizer/legalizer_block_aux.h"
 
 namespace dali {
 
+std::vector<Stripe*> CollectStripes(std::vector<ClusterStripe>& col_list) {
+  std::vector<Stripe*> stripes;
+  for (auto& col : col_list) {
+    for (auto& stripe : col.stripe_list_) {
+      stripes.push_back(&stripe);
+    }
+  }
+  return stripes;
+}
+
+/****
+ * @brief each iteration solves all row segments of active stripes, then
+ * averages sub-cell locations of their blocks, then each active stripe reduces
+ * the displacement and discrepancy of its own blocks, in the same order as a
+ * serial pass, and checks its own convergence.
+ */
+void IterativeCellReorderingInStripes(std::vector<Stripe*> const& stripes,
+                                      int max_iter, int num_threads) {
+  for (Stripe* stripe : stripes) {
+    stripe->CollectAllRowSegments();
+  }
+  int num_stripes = static_cast<int>(stripes.size());
+  std::vector<char> is_weighted_anchor(num_stripes, 0);
+  std::vector<int> active_stripe_ids(num_stripes);
+  for (int s = 0; s < num_stripes; ++s) active_stripe_ids[s] = s;
+
+  // row segments and blocks of active stripes, blocks of the k-th active
+  // stripe are in [blk_begin[k], blk_begin[k + 1])
+  std::vector<RowSegment*> segments;
+  std::vector<int> seg_stripe_ids;
+  std::vector<Block*> blocks;
+  std::vector<int> blk_begin;
+  std::vector<double> blk_disp;
+  std::vector<double> blk_discrepancy;
+  std::vector<char> is_converged;
+  std::vector<RowSegmentWorkspace> workspaces(num_threads);
+  bool is_pool_stale = true;
+  for (int i = 0; i < max_iter && !active_stripe_ids.empty(); ++i) {
+    if (is_pool_stale) {
+      is_pool_stale = false;
+      segments.clear();
+      seg_stripe_ids.clear();
+      blocks.clear();
+      blk_begin.assign(1, 0);
+      for (int s : active_stripe_ids) {
+        for (RowSegment* segment : stripes[s]->row_seg_ptrs_) {
+          segments.push_back(segment);
+          seg_stripe_ids.push_back(s);
+        }
+        blocks.insert(blocks.end(), stripes[s]->blk_ptrs_vec_.begin(),
+                      stripes[s]->blk_ptrs_vec_.end());
+        blk_begin.push_back(static_cast<int>(blocks.size()));
+      }
+      blk_disp.resize(blocks.size());
+      blk_discrepancy.resize(blocks.size());
+    }
+
+    // double decay = 30.0; // the bigger, the closer to CPLEX result
+    // double lambda = exp(-i / decay);
+    double lambda = 1 / double(i + 1);
+    bool is_reorder = i % 10 == 0;
+    int num_segments = static_cast<int>(segments.size());
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(stripes, segments, seg_stripe_ids, is_weighted_anchor, lambda, \
+               is_reorder, num_segments, workspaces) schedule(dynamic, 4)
+    for (int k = 0; k < num_segments; ++k) {
+      RowSegmentWorkspace& workspace = workspaces[omp_get_thread_num()];
+      Stripe* stripe = stripes[seg_stripe_ids[k]];
+      segments[k]->OptimizeQuadraticDisplacement(
+          lambda, is_weighted_anchor[seg_stripe_ids[k]] != 0, is_reorder,
+          workspace);
+      stripe->UpdateSubCellLocs(workspace.vars);
+    }
+
+    int num_blocks = static_cast<int>(blocks.size());
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(blocks, blk_disp, blk_discrepancy, num_blocks)
+    for (int k = 0; k < num_blocks; ++k) {
+      Block* blk_ptr = blocks[k];
+      auto aux_ptr = static_cast<LegalizerBlockAux*>(blk_ptr->AuxPtr());
+      aux_ptr->ComputeAverageLoc();
+      double average_loc = aux_ptr->AverageLoc();
+      blk_ptr->SetLLX(average_loc);
+
+      // displacement from init_x to average_x, and average discrepancy to
+      // the average location
+      blk_disp[k] = std::fabs(average_loc - aux_ptr->InitLoc().x);
+      int sz = static_cast<int>(aux_ptr->SubLocs().size());
+      double tmp_discrepancy = 0;
+      for (auto& loc_x : aux_ptr->SubLocs()) {
+        tmp_discrepancy += std::fabs(loc_x - average_loc);
+      }
+      blk_discrepancy[k] = tmp_discrepancy / sz;
+    }
+
+    int num_active = static_cast<int>(active_stripe_ids.size());
+    is_converged.assign(num_active, 0);
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(stripes, active_stripe_ids, is_weighted_anchor, blk_begin, \
+               blk_disp, blk_discrepancy, is_converged, num_active, i)
+    for (int k = 0; k < num_active; ++k) {
+      int s = active_stripe_ids[k];
+      Stripe* stripe = stripes[s];
+      double disp_x = 0;
+      double discrepancy = 0;
+      stripe->max_discrepancy_ = 0;
+      for (int j = blk_begin[k]; j < blk_begin[k + 1]; ++j) {
+        disp_x += blk_disp[j];
+        discrepancy += blk_discrepancy[j];
+        stripe->max_discrepancy_ =
+            std::max(stripe->max_discrepancy_, blk_discrepancy[j]);
+      }
+      stripe->displacements_.push_back(disp_x);
+      stripe->discrepancies_.push_back(discrepancy);
+      LOG(debug) << "Iter " << i << ", displacement: " << disp_x
+                 << ", discrepancy: " << discrepancy << "\n";
+      if (!is_weighted_anchor[s]) {
+        is_weighted_anchor[s] = stripe->IsDiscrepancyConverged();
+      }
+      is_converged[k] = stripe->max_discrepancy_ < 0.1;
+    }
+
+    int cnt = 0;
+    for (int k = 0; k < num_active; ++k) {
+      if (!is_converged[k]) active_stripe_ids[cnt++] = active_stripe_ids[k];
+    }
+    is_pool_stale = cnt < num_active;
+    active_stripe_ids.resize(cnt);
+  }
+
+  for (Stripe* stripe : stripes) {
+    int num_blocks = static_cast<int>(stripe->blk_ptrs_vec_.size());
+#pragma omp parallel for num_threads(num_threads) default(none) \
+    shared(stripe, num_blocks)
+    for (int k = 0; k < num_blocks; ++k) {
+      Block* blk_ptr = stripe->blk_ptrs_vec_[k];
+      auto aux_ptr = static_cast<LegalizerBlockAux*>(blk_ptr->AuxPtr());
+      blk_ptr->SetLLX(std::round(aux_ptr->AverageLoc()));
+    }
+    stripe->ClearMultiRowCellBreaking();
+    LOG(info) << "displacement: " << stripe->displacements_ << "\n";
+    LOG(info) << "discrepancy : " << stripe->discrepancies_ << "\n";
+  }
+}
+
 void GenClusterTable(std::string const& name_of_file,
                      std::vector<ClusterStripe>& col_list_) {
   std::string cluster_file = name_of_file + "_cluster.txt";
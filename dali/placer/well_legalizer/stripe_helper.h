@@ -28,6 +28,18 @@
 
 namespace dali {
 
+/** Return pointers to stripes of all columns, in column order. */
+std::vector<Stripe*> CollectStripes(std::vector<ClusterStripe>& col_list);
+
+/**
+ * Consensus optimization of cell locations in all stripes together. Row
+ * segments and blocks of unconverged stripes form one pool of parallel work in
+ * each iteration, and each stripe stops independently once converged. Results
+ * are the same as optimizing stripes one by one, for any number of threads.
+ */
+void IterativeCellReorderingInStripes(std::vector<Stripe*> const& stripes,
+                                      int max_iter, int num_threads);
+
 void GenClusterTable(std::string const& name_of_file,
                      std::vector<ClusterStripe>& col_list_);
 
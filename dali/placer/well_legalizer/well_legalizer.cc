@@ -92,8 +92,8 @@ void WellLegalizer::MarkSpaceWellLeft(Block const& block, int p_row) {
 
   int end_x = int(block.URX());
 
+  block_contour_.AssignRange(lo_row, hi_row, end_x);
   for (int i = lo_row; i <= hi_row; ++i) {
-    block_contour_[i] = end_x;
     row_well_status_[i].is_n = (i > last_p_row);
   }
 }
@@ -143,10 +143,8 @@ bool WellLegalizer::FindLocation(Block& block, int2d& res) {
   for (int tmp_row = start_row; tmp_row <= end_row; ++tmp_row) {
     // 1. find the non-overlap location
     tmp_end_row = tmp_row + height - 1;
-    tmp_loc = RegionLeft();
-    for (int i = tmp_row; i <= tmp_end_row; ++i) {
-      tmp_loc = std::max(tmp_loc, block_contour_[i]);
-    }
+    tmp_loc = std::max(RegionLeft(),
+                       block_contour_.MaxInRange(tmp_row, tmp_end_row));
 
     // 2. legalize the location to respect well rules
 
@@ -438,13 +436,7 @@ bool WellLegalizer::IsCurrentLocLegalLeft(int loc_x, int width, int lo_row,
   }
 
   // 2. check if the space covers any placed blocks
-  is_current_loc_legal = true;
-  for (int i = lo_row; i <= hi_row; ++i) {
-    if (block_contour_[i] > loc_x) {
-      is_current_loc_legal = false;
-      break;
-    }
-  }
+  is_current_loc_legal = block_contour_.MaxInRange(lo_row, hi_row) <= loc_x;
   if (!is_current_loc_legal) {
     // LOG(info)   << "Overlap illegal\n";
     return false;
@@ -532,9 +524,8 @@ bool WellLegalizer::FindLocLeft(Value2D<int>& loc, int num, int width,
     tmp_x = std::max(left_white_space_bound, left_block_bound);
 
     // make sure no overlap
-    for (int n = tmp_start_row; n <= tmp_end_row; ++n) {
-      tmp_x = std::max(tmp_x, block_contour_[n]);
-    }
+    tmp_x = std::max(tmp_x,
+                     block_contour_.MaxInRange(tmp_start_row, tmp_end_row));
 
     tmp_y = RowToLoc(tmp_start_row);
     tmp_cost =
@@ -576,7 +567,7 @@ bool WellLegalizer::FindLocLeft(Value2D<int>& loc, int num, int width,
 bool WellLegalizer::WellLegalizationLeft() {
   int fail_count = 0;
   bool is_successful = true;
-  block_contour_.assign(block_contour_.size(), left_);
+  block_contour_.Assign(block_contour_.Size(), left_);
   std::vector<Block>& block_list = ckt_ptr_->Blocks();
 
   int sz = blk_inits_.size();
@@ -660,8 +651,8 @@ void WellLegalizer::MarkSpaceWellRight(Block const& block, int p_row) {
 
   int end_x = int(block.LLX());
 
+  block_contour_.AssignRange(lo_row, hi_row, end_x);
   for (int i = lo_row; i <= hi_row; ++i) {
-    block_contour_[i] = end_x;
     row_well_status_[i].is_n = (i > last_p_row);
   }
 }
@@ -819,13 +810,7 @@ bool WellLegalizer::IsCurrentLocLegalRight(int loc_x, int width, int lo_row,
   }
 
   // 2. check if the space covers any placed blocks
-  is_current_loc_legal = true;
-  for (int i = lo_row; i <= hi_row; ++i) {
-    if (block_contour_[i] < loc_x) {
-      is_current_loc_legal = false;
-      break;
-    }
-  }
+  is_current_loc_legal = block_contour_.MinInRange(lo_row, hi_row) >= loc_x;
   if (!is_current_loc_legal) {
     // LOG(info)   << "Overlap illegal\n";
     return false;
@@ -894,9 +879,8 @@ bool WellLegalizer::FindLocRight(Value2D<int>& loc, int num, int width,
     tmp_x = std::min(right_white_space_bound, right_block_bound);
     // tmp_x = std::min(right_, right_block_bound);
 
-    for (int n = tmp_start_row; n <= tmp_end_row; ++n) {
-      tmp_x = std::min(tmp_x, block_contour_[n]);
-    }
+    tmp_x = std::min(tmp_x,
+                     block_contour_.MinInRange(tmp_start_row, tmp_end_row));
 
     tmp_y = RowToLoc(tmp_start_row);
     tmp_cost = std::abs(tmp_x - init_loc_[num].x - width) +
@@ -935,7 +919,7 @@ bool WellLegalizer::FindLocRight(Value2D<int>& loc, int num, int width,
 bool WellLegalizer::WellLegalizationRight() {
   int fail_count = 0;
   bool is_successful = true;
-  block_contour_.assign(block_contour_.size(), right_);
+  block_contour_.Assign(block_contour_.Size(), right_);
   std::vector<Block>& block_list = ckt_ptr_->Blocks();
 
   int sz = blk_inits_.size();
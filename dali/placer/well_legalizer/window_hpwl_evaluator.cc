@@ -0,0 +1,114 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "window_hpwl_evaluator.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "dali/common/logging.h"
+
+namespace dali {
+
+void WindowHpwlEvaluator::SetCircuit(Circuit* ckt_ptr) {
+  DaliExpects(ckt_ptr != nullptr, "Cannot set ckt_ptr_ to nullptr");
+  ckt_ptr_ = ckt_ptr;
+  grid_value_x_ = ckt_ptr_->GridValueX();
+  grid_value_y_ = ckt_ptr_->GridValueY();
+}
+
+/****
+ * @brief Collect nets of the window, and cache everything that does not change
+ * when blocks in the window are permuted. Nets with at most one pin are
+ * skipped, their HPWL is 0. Nets are never modified, so evaluators of
+ * disjoint windows can be used concurrently.
+ * ****/
+void WindowHpwlEvaluator::SetWindow(Block* const* blocks, int num_blocks) {
+  DaliExpects(ckt_ptr_ != nullptr, "Circuit is not set");
+  auto& nets = ckt_ptr_->Nets();
+  window_blks_.assign(blocks, blocks + num_blocks);
+  net_ids_.clear();
+  for (Block* blk_ptr : window_blks_) {
+    for (int net_id : blk_ptr->NetList()) {
+      size_t pin_cnt = nets[net_id].PinCnt();
+      if (pin_cnt > 1 && pin_cnt < kMaxNetPinCnt) {
+        net_ids_.push_back(net_id);
+      }
+    }
+  }
+  std::sort(net_ids_.begin(), net_ids_.end());
+  net_ids_.erase(std::unique(net_ids_.begin(), net_ids_.end()), net_ids_.end());
+
+  size_t num_nets = net_ids_.size();
+  weights_.resize(num_nets);
+  fixed_max_x_.resize(num_nets);
+  fixed_min_x_.resize(num_nets);
+  window_pin_begin_.resize(num_nets + 1);
+  window_pin_blks_.clear();
+  window_pin_offsets_.clear();
+  weighted_hpwl_y_ = 0;
+  for (size_t k = 0; k < num_nets; ++k) {
+    Net& net = nets[net_ids_[k]];
+    weights_[k] = net.Weight();
+    window_pin_begin_[k] = static_cast<int>(window_pin_blks_.size());
+    double max_x = -DBL_MAX;
+    double min_x = DBL_MAX;
+    double max_y = -DBL_MAX;
+    double min_y = DBL_MAX;
+    for (auto& blk_pin : net.BlockPins()) {
+      max_y = std::max(max_y, blk_pin.AbsY());
+      min_y = std::min(min_y, blk_pin.AbsY());
+      if (IsInWindow(blk_pin.BlkPtr())) {
+        window_pin_blks_.push_back(blk_pin.BlkPtr());
+        window_pin_offsets_.push_back(blk_pin.OffsetX());
+      } else {
+        max_x = std::max(max_x, blk_pin.AbsX());
+        min_x = std::min(min_x, blk_pin.AbsX());
+      }
+    }
+    fixed_max_x_[k] = max_x;
+    fixed_min_x_[k] = min_x;
+    weighted_hpwl_y_ += (max_y - min_y) * weights_[k];
+  }
+  window_pin_begin_[num_nets] = static_cast<int>(window_pin_blks_.size());
+}
+
+double WindowHpwlEvaluator::Cost() const {
+  double weighted_hpwl_x = 0;
+  size_t num_nets = net_ids_.size();
+  for (size_t k = 0; k < num_nets; ++k) {
+    double max_x = fixed_max_x_[k];
+    double min_x = fixed_min_x_[k];
+    for (int j = window_pin_begin_[k]; j < window_pin_begin_[k + 1]; ++j) {
+      double x = window_pin_offsets_[j] + window_pin_blks_[j]->LLX();
+      max_x = std::max(max_x, x);
+      min_x = std::min(min_x, x);
+    }
+    weighted_hpwl_x += (max_x - min_x) * weights_[k];
+  }
+  return weighted_hpwl_x * grid_value_x_ + weighted_hpwl_y_ * grid_value_y_;
+}
+
+bool WindowHpwlEvaluator::IsInWindow(Block const* blk_ptr) const {
+  return std::find(window_blks_.begin(), window_blks_.end(), blk_ptr) !=
+         window_blks_.end();
+}
+
+}  // namespace dali
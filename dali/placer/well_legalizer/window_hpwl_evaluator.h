@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#ifndef DALI_PLACER_WELL_LEGALIZER_WINDOW_HPWL_EVALUATOR_H_
+#define DALI_PLACER_WELL_LEGALIZER_WINDOW_HPWL_EVALUATOR_H_
+
+#include <vector>
+
+#include "dali/circuit/block.h"
+#include "dali/circuit/circuit.h"
+
+namespace dali {
+
+/**
+ * Wire-length cost of a window of consecutive blocks in a row, used to score
+ * local reordering candidates. The cost is the weighted HPWL, in microns, of
+ * nets of blocks in the window, nets with kMaxNetPinCnt pins or more are
+ * ignored.
+ *
+ * Blocks in a window only move horizontally. SetWindow() caches the x bounding
+ * box of pins outside the window for every involved net, and the y HPWL of all
+ * involved nets. Cost() then only reads the locations of window pins, and does
+ * not allocate memory. Nets are summed in ascending index, so the cost is
+ * bitwise equal to summing Net::WeightedHPWLX() and Net::WeightedHPWLY().
+ */
+class WindowHpwlEvaluator {
+ public:
+  static constexpr size_t kMaxNetPinCnt = 100;
+
+  void SetCircuit(Circuit* ckt_ptr);
+
+  /** Cache nets of blocks[0, num_blocks) at their current locations. */
+  void SetWindow(Block* const* blocks, int num_blocks);
+
+  /** Return the cost at the current locations of blocks in the window. */
+  double Cost() const;
+
+  /** Return the number of nets involved in the current window. */
+  int NumNets() const { return static_cast<int>(net_ids_.size()); }
+
+ private:
+  bool IsInWindow(Block const* blk_ptr) const;
+
+  Circuit* ckt_ptr_ = nullptr;
+  double grid_value_x_ = 1;
+  double grid_value_y_ = 1;
+
+  std::vector<Block*> window_blks_;
+  std::vector<int> net_ids_;
+  std::vector<double> weights_;
+  // x bounding box of pins outside the window, one per involved net
+  std::vector<double> fixed_max_x_;
+  std::vector<double> fixed_min_x_;
+  // pins on window blocks, pins of the k-th net are in
+  // [window_pin_begin_[k], window_pin_begin_[k + 1])
+  std::vector<int> window_pin_begin_;
+  std::vector<Block const*> window_pin_blks_;
+  std::vector<double> window_pin_offsets_;
+  double weighted_hpwl_y_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PLACER_WELL_LEGALIZER_WINDOW_HPWL_EVALUATOR_H_
@@ -63,7 +63,9 @@ TEST_F(DaliCommandLineTest, ParsesRuntimeConfigOptions) {
       Parse({"dali", "-lef", "input.lef", "-def", "input.def", "-output_name",
              "placed", "-metrics_file", "metrics.json", "-target_density",
              "0.72", "-num_threads", "8", "-io_metal_layer", "3",
-             "-well_legalization_mode", "scavenge", "-disable_io_place"},
+             "-well_legalization_mode", "scavenge", "-disable_io_place",
+             "-compact_storage", "-row_band_legalization",
+             "-parallel_local_reorder"},
             &options));
 
   EXPECT_EQ(options.output_name, "placed");
@@ -73,6 +75,44 @@ TEST_F(DaliCommandLineTest, ParsesRuntimeConfigOptions) {
   EXPECT_EQ(config_get_int("dali.io_metal_layer"), 2);
   EXPECT_STREQ(config_get_string("dali.well_legalization_mode"), "scavenge");
   EXPECT_EQ(config_get_int("dali.disable_io_place"), 1);
+  EXPECT_EQ(config_get_int("dali.compact_storage"), 1);
+  EXPECT_EQ(config_get_int("dali.row_band_legalization"), 1);
+  EXPECT_EQ(config_get_int("dali.parallel_local_reorder"), 1);
+}
+
+TEST_F(DaliCommandLineTest, ParsesLinearSolver) {
+  dali::DaliCommandLineOptions options;
+  EXPECT_TRUE(Parse({"dali", "-lef", "input.lef", "-def", "input.def",
+                     "-linear_solver", "ic"},
+                    &options));
+  EXPECT_STREQ(config_get_string("dali.global_placer.linear_solver"), "ic");
+
+  EXPECT_FALSE(Parse({"dali", "-lef", "input.lef", "-def", "input.def",
+                      "-linear_solver", "cholesky"},
+                     &options));
+}
+
+TEST_F(DaliCommandLineTest, ParsesCheckpointOptions) {
+  dali::DaliCommandLineOptions options;
+  EXPECT_TRUE(Parse({"dali", "-lef", "input.lef", "-def", "input.def",
+                     "-save_checkpoint", "global_placement", "gp.ckpt",
+                     "-load_checkpoint", "input.ckpt"},
+                    &options));
+
+  EXPECT_STREQ(config_get_string("dali.save_checkpoint_stage"),
+               "global_placement");
+  EXPECT_STREQ(config_get_string("dali.save_checkpoint_file"), "gp.ckpt");
+  EXPECT_STREQ(config_get_string("dali.load_checkpoint_file"), "input.ckpt");
+}
+
+TEST_F(DaliCommandLineTest, RejectsUnknownCheckpointStage) {
+  dali::DaliCommandLineOptions options;
+  EXPECT_FALSE(Parse({"dali", "-lef", "input.lef", "-def", "input.def",
+                      "-save_checkpoint", "detailed_placement", "dp.ckpt"},
+                     &options));
+  EXPECT_FALSE(Parse({"dali", "-lef", "input.lef", "-def", "input.def",
+                      "-save_checkpoint", "legalization"},
+                     &options));
 }
 
 TEST_F(DaliCommandLineTest, RejectsMissingRequiredInputs) {
@@ -47,6 +47,14 @@ TEST_F(DaliConfigTest, KeepsDefaultRuntimeOptionsWhenConfigIsEmpty) {
   EXPECT_FALSE(options.enable_end_cap_cell);
   EXPECT_FALSE(options.enable_shrink_off_grid_die_area);
   EXPECT_EQ(options.output_name, "dali_out");
+  EXPECT_EQ(options.save_checkpoint_stage, "");
+  EXPECT_EQ(options.save_checkpoint_file, "");
+  EXPECT_EQ(options.load_checkpoint_file, "");
+  EXPECT_FALSE(options.compact_storage);
+  EXPECT_FALSE(options.row_band_legalization);
+  EXPECT_FALSE(options.parallel_local_reorder);
+  EXPECT_EQ(placer.GetGlobalPlacer().LinearSolver(),
+            dali::LinearSolverType::DIAGONAL_CG);
 
   placer.Close();
 }
@@ -70,6 +78,12 @@ TEST_F(DaliConfigTest, LoadsRuntimeOptionsFromActConfig) {
   config_set_int("dali.enable_end_cap_cell", 1);
   config_set_int("dali.enable_shrink_off_grid_die_area", 1);
   config_set_string("dali.output_name", "placed");
+  config_set_string("dali.save_checkpoint_stage", "legalization");
+  config_set_string("dali.save_checkpoint_file", "lg.ckpt");
+  config_set_string("dali.load_checkpoint_file", "gp.ckpt");
+  config_set_int("dali.compact_storage", 1);
+  config_set_int("dali.row_band_legalization", 1);
+  config_set_int("dali.parallel_local_reorder", 1);
 
   dali::Dali placer(nullptr, dali::severity::info);
   const dali::Dali::RuntimeOptions options = placer.GetRuntimeOptions();
@@ -93,6 +107,25 @@ TEST_F(DaliConfigTest, LoadsRuntimeOptionsFromActConfig) {
   EXPECT_TRUE(options.enable_end_cap_cell);
   EXPECT_TRUE(options.enable_shrink_off_grid_die_area);
   EXPECT_EQ(options.output_name, "placed");
+  EXPECT_EQ(options.save_checkpoint_stage, "legalization");
+  EXPECT_EQ(options.save_checkpoint_file, "lg.ckpt");
+  EXPECT_EQ(options.load_checkpoint_file, "gp.ckpt");
+  EXPECT_TRUE(options.compact_storage);
+  EXPECT_TRUE(options.row_band_legalization);
+  EXPECT_TRUE(options.parallel_local_reorder);
+
+  placer.Close();
+}
+
+TEST_F(DaliConfigTest, LoadsGlobalPlacerOptionsFromActConfig) {
+  config_set_string("dali.global_placer.linear_solver", "amg");
+  config_set_int("dali.global_placer.cg_iteration_max_num", 50);
+
+  dali::Dali placer(nullptr, dali::severity::info);
+  const dali::GlobalPlacer& global_placer = placer.GetGlobalPlacer();
+
+  EXPECT_EQ(global_placer.LinearSolver(), dali::LinearSolverType::AMG_CG);
+  EXPECT_EQ(global_placer.CgIterationMaxNum(), 50);
 
   placer.Close();
 }
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "dali/circuit/circuit.h"
+
+namespace {
+
+void BuildCircuit(dali::Circuit& circuit) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, dali::VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, dali::HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  auto inv_ptr = circuit.AddBlockType("INV", 0.8, 1.6);
+  circuit.AddBlkTypePin(inv_ptr, "a", true)->SetOffset(0.2, 0.4);
+  circuit.AddBlkTypePin(inv_ptr, "z", false)->SetOffset(0.6, 1.2);
+  auto nand_ptr = circuit.AddBlockType("NAND2", 1.2, 3.2);
+  circuit.AddBlkTypePin(nand_ptr, "a", true)->SetOffset(0.2, 0.4);
+  circuit.AddBlkTypePin(nand_ptr, "b", true)->SetOffset(0.4, 2.0);
+  circuit.AddBlkTypePin(nand_ptr, "z", false)->SetOffset(1.0, 1.2);
+  circuit.AddWellTapBlockType("TAP", 0.4, 1.6);
+  circuit.SetNwellParams(0.6, 0.6, 0.6, 40, 0.2);
+  circuit.SetPwellParams(0.6, 0.6, 0.6, 40, 0.2);
+  circuit.SetWellRect("INV", true, 0, 0.8, 0.8, 1.6);
+  circuit.SetWellRect("INV", false, 0, 0, 0.8, 0.8);
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 8000, 6400);
+  circuit.design().AddIntrinsicPlacementBlockage(2, 2, 4, 4);
+  circuit.ReserveSpaceForDesignImp(4, 2, 3);
+  circuit.AddBlock("u0", "INV", 1, 0, dali::PLACED, dali::N);
+  circuit.AddBlock("u1", "INV", 5, 8, dali::FIXED, dali::FS);
+  circuit.AddBlock("u2", "NAND2", 0, 0, dali::UNPLACED, dali::N);
+  circuit.AddBlock("u3", "NAND2", 12.5, 20.25, dali::PLACED, dali::S);
+  auto in_ptr = circuit.AddIoPin("in", dali::PLACED, dali::SIGNAL,
+                                 dali::INPUT, 0, 12.5);
+  in_ptr->SetLayerPtr(circuit.GetMetalLayerPtr("m1"));
+  in_ptr->SetShape(-0.05, -0.1, 0.05, 0.125);
+  circuit.AddIoPin("out", dali::UNPLACED, dali::SIGNAL, dali::OUTPUT, 0, 0);
+  circuit.AddNet("n0", 3, 2.5);
+  circuit.AddIoPinToNet("in", "n0");
+  circuit.AddBlkPinToNet("u0", "a", "n0");
+  circuit.AddBlkPinToNet("u1", "z", "n0");
+  circuit.AddNet("n1", 3);
+  circuit.AddBlkPinToNet("u0", "z", "n1");
+  circuit.AddBlkPinToNet("u3", "b", "n1");
+  circuit.AddBlkPinToNet("u2", "a", "n1");
+  circuit.AddNet("n2", 2);
+  circuit.AddBlkPinToNet("u3", "z", "n2");
+  circuit.AddIoPinToNet("out", "n2");
+  circuit.UpdateTotalBlkArea();
+}
+
+std::string CheckpointFile(std::string const& name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+TEST(CheckpointTest, LoadRestoresTheSavedCircuit) {
+  const std::string file_name = CheckpointFile("dali_checkpoint_test.ckpt");
+  dali::Circuit saved;
+  BuildCircuit(saved);
+  saved.SaveCheckpoint(file_name, "global_placement");
+
+  // blocks and nets are filled concurrently
+  dali::Circuit loaded;
+  EXPECT_EQ(loaded.LoadCheckpoint(file_name, nullptr, 4), "global_placement");
+
+  EXPECT_EQ(loaded.DatabaseMicrons(), saved.DatabaseMicrons());
+  EXPECT_EQ(loaded.GridValueX(), saved.GridValueX());
+  EXPECT_EQ(loaded.GridValueY(), saved.GridValueY());
+  EXPECT_EQ(loaded.RowHeightGridUnit(), saved.RowHeightGridUnit());
+  EXPECT_EQ(loaded.RegionLLX(), saved.RegionLLX());
+  EXPECT_EQ(loaded.RegionURY(), saved.RegionURY());
+  EXPECT_EQ(loaded.GetMetalLayerPtr("m2")->Name(), "m2");
+
+  ASSERT_EQ(loaded.BlockTypes().size(), saved.BlockTypes().size());
+  for (size_t i = 0; i < saved.BlockTypes().size(); ++i) {
+    auto& expected = saved.BlockTypes()[i];
+    auto& actual = loaded.BlockTypes()[i];
+    EXPECT_EQ(actual.Name(), expected.Name());
+    EXPECT_EQ(actual.Width(), expected.Width());
+    EXPECT_EQ(actual.Height(), expected.Height());
+    ASSERT_EQ(actual.PinList().size(), expected.PinList().size());
+    for (size_t j = 0; j < expected.PinList().size(); ++j) {
+      EXPECT_EQ(actual.PinList()[j].Name(), expected.PinList()[j].Name());
+      EXPECT_EQ(actual.PinList()[j].OffsetX(),
+                expected.PinList()[j].OffsetX());
+      EXPECT_EQ(actual.PinList()[j].OffsetY(),
+                expected.PinList()[j].OffsetY());
+    }
+  }
+  auto inv_ptr = loaded.GetBlockTypePtr("INV");
+  ASSERT_TRUE(inv_ptr->HasWellInfo());
+  EXPECT_EQ(inv_ptr->NwellRect(0).URY(),
+            saved.GetBlockTypePtr("INV")->NwellRect(0).URY());
+
+  ASSERT_EQ(loaded.Blocks().size(), saved.Blocks().size());
+  for (size_t i = 0; i < saved.Blocks().size(); ++i) {
+    auto& expected = saved.Blocks()[i];
+    auto& actual = loaded.Blocks()[i];
+    EXPECT_EQ(actual.Name(), expected.Name());
+    EXPECT_EQ(actual.Id(), expected.Id());
+    EXPECT_EQ(actual.TypePtr()->Name(), expected.TypePtr()->Name());
+    EXPECT_EQ(actual.LLX(), expected.LLX());
+    EXPECT_EQ(actual.LLY(), expected.LLY());
+    EXPECT_EQ(actual.Status(), expected.Status());
+    EXPECT_EQ(actual.Orient(), expected.Orient());
+    EXPECT_EQ(actual.NetList(), expected.NetList());
+  }
+  EXPECT_EQ(loaded.GetBlockPtr("u3"), &loaded.Blocks()[3]);
+
+  ASSERT_EQ(loaded.IoPins().size(), 2u);
+  auto& in = loaded.IoPins()[0];
+  EXPECT_EQ(in.Name(), "in");
+  EXPECT_EQ(in.NetName(), "n0");
+  EXPECT_EQ(in.LayerName(), "m1");
+  EXPECT_EQ(in.InitPlaceStatus(), dali::PLACED);
+  EXPECT_EQ(in.Y(), saved.IoPins()[0].Y());
+  EXPECT_EQ(in.GetShape().URY(), saved.IoPins()[0].GetShape().URY());
+  EXPECT_EQ(loaded.IoPins()[1].InitPlaceStatus(), dali::UNPLACED);
+
+  ASSERT_EQ(loaded.Nets().size(), saved.Nets().size());
+  for (size_t i = 0; i < saved.Nets().size(); ++i) {
+    auto& expected = saved.Nets()[i];
+    auto& actual = loaded.Nets()[i];
+    EXPECT_EQ(actual.Name(), expected.Name());
+    EXPECT_EQ(actual.Weight(), expected.Weight());
+    ASSERT_EQ(actual.BlockPins().size(), expected.BlockPins().size());
+    for (size_t j = 0; j < expected.BlockPins().size(); ++j) {
+      EXPECT_EQ(actual.BlockPins()[j].BlkId(),
+                expected.BlockPins()[j].BlkId());
+      EXPECT_EQ(actual.BlockPins()[j].PinId(),
+                expected.BlockPins()[j].PinId());
+    }
+    ASSERT_EQ(actual.IoPinPtrs().size(), expected.IoPinPtrs().size());
+    for (size_t j = 0; j < expected.IoPinPtrs().size(); ++j) {
+      EXPECT_EQ(actual.IoPinPtrs()[j]->Name(),
+                expected.IoPinPtrs()[j]->Name());
+    }
+  }
+
+  EXPECT_EQ(loaded.design().PlacementBlockages().size(),
+            saved.design().PlacementBlockages().size());
+  EXPECT_EQ(loaded.TotBlkArea(), saved.TotBlkArea());
+  EXPECT_EQ(loaded.TotMovBlkCnt(), saved.TotMovBlkCnt());
+  EXPECT_EQ(loaded.TotFixedBlkCnt(), saved.TotFixedBlkCnt());
+  EXPECT_EQ(loaded.MinBlkWidth(), saved.MinBlkWidth());
+  EXPECT_EQ(loaded.MaxBlkHeight(), saved.MaxBlkHeight());
+  EXPECT_DOUBLE_EQ(loaded.WhiteSpaceUsage(), saved.WhiteSpaceUsage());
+  EXPECT_DOUBLE_EQ(loaded.WeightedHPWL(), saved.WeightedHPWL());
+}
+
+TEST(CheckpointTest, TruncatedCheckpointIsRejected) {
+  const std::string file_name = CheckpointFile("dali_checkpoint_trunc.ckpt");
+  dali::Circuit saved;
+  BuildCircuit(saved);
+  saved.SaveCheckpoint(file_name, "legalization");
+  std::filesystem::resize_file(file_name,
+                               std::filesystem::file_size(file_name) - 8);
+
+  EXPECT_EXIT(
+      {
+        dali::Circuit loaded;
+        loaded.LoadCheckpoint(file_name);
+      },
+      testing::ExitedWithCode(1), "");
+}
+
+}  // namespace
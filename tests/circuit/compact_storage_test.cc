@@ -0,0 +1,197 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "dali/circuit/circuit.h"
+
+namespace {
+
+void BuildCircuit(dali::Circuit& circuit) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, dali::VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, dali::HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  auto nand_ptr = circuit.AddBlockType("NAND2", 1.2, 1.6);
+  circuit.AddBlkTypePin(nand_ptr, "a", true);
+  circuit.AddBlkTypePin(nand_ptr, "b", true);
+  circuit.AddBlkTypePin(nand_ptr, "z", false);
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 8000, 6400);
+  circuit.ReserveSpaceForDesignImp(4, 1, 4);
+  circuit.AddBlock("u0", "NAND2", 0, 0, dali::PLACED, dali::N);
+  circuit.AddBlock("u1", "NAND2", 2.4, 0, dali::PLACED, dali::N);
+  circuit.AddBlock("u2", "NAND2", 4.8, 1.6, dali::PLACED, dali::N);
+  circuit.AddBlock("u3", "NAND2", 7.2, 3.2, dali::FIXED, dali::N);
+  circuit.AddIoPin("in", dali::PLACED, dali::SIGNAL, dali::INPUT, 0, 1);
+  // capacities are larger than the number of pins on purpose
+  circuit.AddNet("n0", 8);
+  circuit.AddIoPinToNet("in", "n0");
+  circuit.AddBlkPinToNet("u0", "a", "n0");
+  circuit.AddBlkPinToNet("u1", "a", "n0");
+  circuit.AddNet("n1", 8);
+  circuit.AddBlkPinToNet("u0", "z", "n1");
+  circuit.AddBlkPinToNet("u2", "a", "n1");
+  circuit.AddBlkPinToNet("u3", "a", "n1");
+  circuit.AddNet("n2", 8);
+  circuit.AddBlkPinToNet("u1", "z", "n2");
+  circuit.AddBlkPinToNet("u2", "b", "n2");
+  circuit.AddNet("n3", 8);
+  circuit.AddBlkPinToNet("u2", "z", "n3");
+  circuit.AddBlkPinToNet("u3", "b", "n3");
+}
+
+size_t BytesOf(std::vector<dali::ContainerMemory> const& usage,
+               std::string const& name) {
+  for (auto const& container : usage) {
+    if (container.name == name) return container.bytes;
+  }
+  return 0;
+}
+
+TEST(CompactStorageTest, KeepsNetListsAndHpwl) {
+  dali::Circuit circuit;
+  BuildCircuit(circuit);
+  std::vector<std::vector<int>> net_lists;
+  for (auto& block : circuit.Blocks()) {
+    net_lists.emplace_back(block.NetList().begin(), block.NetList().end());
+  }
+  double hpwl = circuit.WeightedHPWL();
+  std::vector<dali::ContainerMemory> usage = circuit.MemoryUsage();
+
+  circuit.CompactStorage();
+
+  EXPECT_TRUE(circuit.IsStorageCompact());
+  ASSERT_EQ(circuit.Blocks().size(), net_lists.size());
+  for (size_t i = 0; i < net_lists.size(); ++i) {
+    auto& net_list = circuit.Blocks()[i].NetList();
+    EXPECT_TRUE(net_list.IsBorrowed());
+    EXPECT_EQ(std::vector<int>(net_list.begin(), net_list.end()),
+              net_lists[i]);
+  }
+  for (auto& net : circuit.Nets()) {
+    EXPECT_EQ(net.BlockPins().capacity(), net.BlockPins().size());
+  }
+  EXPECT_DOUBLE_EQ(circuit.WeightedHPWL(), hpwl);
+
+  // a copied block still sees the same nets
+  dali::Block copied = circuit.Blocks()[2];
+  EXPECT_EQ(copied.NetList(), circuit.Blocks()[2].NetList());
+
+  std::vector<dali::ContainerMemory> compact_usage = circuit.MemoryUsage();
+  EXPECT_LT(BytesOf(compact_usage, "block net lists"),
+            BytesOf(usage, "block net lists"));
+  EXPECT_LT(BytesOf(compact_usage, "net block pins"),
+            BytesOf(usage, "net block pins"));
+}
+
+TEST(CompactStorageTest, LoadedNetListsAreBorrowedUntilTheyGrow) {
+  const std::string file_name =
+      (std::filesystem::temp_directory_path() / "dali_compact_test.ckpt")
+          .string();
+  dali::Circuit saved;
+  BuildCircuit(saved);
+  saved.SaveCheckpoint(file_name, "global_placement");
+  dali::Circuit loaded;
+  loaded.LoadCheckpoint(file_name, nullptr, 2);
+  std::filesystem::remove(file_name);
+
+  // nets loaded in bulk allocate no per-block list
+  for (auto& block : loaded.Blocks()) {
+    EXPECT_TRUE(block.NetList().IsBorrowed());
+  }
+  EXPECT_EQ(BytesOf(loaded.MemoryUsage(), "block net lists"),
+            dali::HeapAllocationBytes(10 * sizeof(int)));
+
+  loaded.AddNet("n4", 1);
+  loaded.AddBlkPinToNet("u1", "b", "n4");
+  EXPECT_FALSE(loaded.Blocks()[1].NetList().IsBorrowed());
+  EXPECT_EQ(loaded.Blocks()[1].NetList().size(), 3u);
+  EXPECT_TRUE(loaded.Blocks()[0].NetList().IsBorrowed());
+
+  loaded.CompactStorage();
+  EXPECT_TRUE(loaded.Blocks()[1].NetList().IsBorrowed());
+  EXPECT_EQ(loaded.Blocks()[1].NetList()[2], 4);
+  EXPECT_EQ(loaded.Blocks()[2].NetList(), saved.Blocks()[2].NetList());
+}
+
+TEST(CompactStorageTest, RejectsNewPinsAfterCompaction) {
+  dali::Circuit circuit;
+  BuildCircuit(circuit);
+  circuit.CompactStorage();
+
+  EXPECT_EXIT(circuit.AddBlkPinToNet("u3", "z", "n0"),
+              testing::ExitedWithCode(1), "");
+  EXPECT_EXIT(circuit.Blocks()[0].NetList().push_back(3),
+              testing::ExitedWithCode(1), "");
+}
+
+TEST(BlockNetListTest, CopiesAndMovesOwnedIds) {
+  dali::BlockNetList net_list;
+  for (int i = 0; i < 10; ++i) {
+    net_list.push_back(i);
+  }
+  dali::BlockNetList copied = net_list;
+  dali::BlockNetList moved = std::move(net_list);
+  EXPECT_EQ(copied, moved);
+  EXPECT_EQ(moved.size(), 10u);
+  EXPECT_EQ(moved[9], 9);
+  EXPECT_FALSE(moved.IsBorrowed());
+
+  copied.push_back(10);
+  EXPECT_EQ(copied.size(), 11u);
+  EXPECT_EQ(moved.size(), 10u);
+}
+
+TEST(BlockCoordinateTest, MatchesBuildOption) {
+#ifdef DALI_FLOAT_BLOCK_COORDINATES
+  EXPECT_TRUE((std::is_same_v<dali::BlockCoordinate, float>));
+#else
+  EXPECT_TRUE((std::is_same_v<dali::BlockCoordinate, double>));
+#endif
+}
+
+TEST(BlockCoordinateTest, KeepsGridLocations) {
+  dali::Circuit circuit;
+  BuildCircuit(circuit);
+  // grid locations far from the origin are still exact in float
+  dali::Block& block = circuit.Blocks()[0];
+  block.SetLoc(1 << 22, (1 << 22) + 8);
+  EXPECT_EQ(block.LLX(), 1 << 22);
+  EXPECT_EQ(block.LLY(), (1 << 22) + 8);
+  block.IncreaseX(1);
+  block.DecreaseY(8);
+  EXPECT_EQ(block.LLX(), (1 << 22) + 1);
+  EXPECT_EQ(block.LLY(), 1 << 22);
+
+  // a global placement location keeps float precision at least
+  block.SetLoc(12.3456, 7.891);
+  EXPECT_NEAR(block.LLX(), 12.3456, 1e-5);
+  EXPECT_NEAR(block.LLY(), 7.891, 1e-5);
+}
+
+}  // namespace
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "dali/circuit/circuit.h"
+
+namespace {
+
+std::string ReadFile(const std::filesystem::path& path) {
+  std::ifstream input(path);
+  return std::string(std::istreambuf_iterator<char>(input),
+                     std::istreambuf_iterator<char>());
+}
+
+// the first 4 lines are the title, which contains the time
+std::string SkipTitle(std::string const& content) {
+  size_t pos = 0;
+  for (int i = 0; i < 4; ++i) {
+    pos = content.find('\n', pos) + 1;
+  }
+  return content.substr(pos);
+}
+
+void BuildCircuit(dali::Circuit& circuit) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, dali::VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, dali::HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  auto type_ptr = circuit.AddBlockType("INV", 0.8, 1.6);
+  circuit.AddBlkTypePin(type_ptr, "a", true);
+  circuit.AddBlkTypePin(type_ptr, "z", false);
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 8000, 6400);
+  circuit.ReserveSpaceForDesignImp(3, 1, 1);
+  circuit.AddBlock("u0", "INV", 1, 0, dali::PLACED, dali::N);
+  circuit.AddBlock("u1", "INV", 5, 8, dali::FIXED, dali::FS);
+  circuit.AddBlock("u2", "INV", 0, 0, dali::UNPLACED, dali::N);
+  auto iopin_ptr = circuit.AddIoPin("in", dali::PLACED, dali::SIGNAL,
+                                    dali::INPUT, 0, 12.5);
+  iopin_ptr->SetLayerPtr(circuit.GetMetalLayerPtr("m1"));
+  iopin_ptr->SetShape(-0.05, -0.1, 0.05, 0.125);
+  circuit.AddNet("n0", 3);
+  circuit.AddIoPinToNet("in", "n0");
+  circuit.AddBlkPinToNet("u0", "a", "n0");
+  circuit.AddBlkPinToNet("u1", "z", "n0");
+}
+
+const char kInputDef[] =
+    "VERSION 5.8 ;\n"
+    "DESIGN top ;\n"
+    "COMPONENTS 1 ;\n"
+    "- x INV + PLACED ( 0 0 ) N ;\n"
+    "END COMPONENTS\n"
+    "\n"
+    "SPECIALNETS 0 ;\n"
+    "END SPECIALNETS\n"
+    "END DESIGN\n";
+
+const char kComponents[] =
+    "COMPONENTS 3 ;\n"
+    "- u0 INV + PLACED ( 200 0 ) N ;\n"
+    "- u1 INV + FIXED ( 1000 1600 ) FS ;\n"
+    "- u2 INV + UNPLACED ( 0 0 ) N ;\n"
+    "END COMPONENTS\n"
+    "\n";
+
+const char kPins[] =
+    "PINS 1 ;\n"
+    "- in + NET n0 + DIRECTION INPUT + USE SIGNAL\n"
+    "  + LAYER m1 ( -50 -100 )  ( 50 125 ) \n"
+    "  + PLACED ( 0 2500 ) E ;\n"
+    "END PINS\n"
+    "\n";
+
+TEST(DefWriterTest, EveryFileOfOnePassMatchesTheExpectedContent) {
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string input_file =
+      (dir / "dali_def_writer_test_in.def").string();
+  {
+    std::ofstream ost(input_file);
+    ost << kInputDef;
+  }
+  const std::string base_name = (dir / "dali_def_writer_test").string();
+
+  dali::Circuit circuit;
+  BuildCircuit(circuit);
+  for (int num_threads : {1, 4}) {
+    std::vector<dali::DefFileOptions> def_files = {
+        {base_name + ".def", base_name, 1, 1, 1, false},
+        {base_name + "_placed.def", base_name, 5, 0, 0, false},
+        {base_name + "_filling.def", base_name, 4, 2, 0, false},
+        {base_name + "_comp.def", "", 1, 0, 0, true},
+    };
+    circuit.SaveDefFiles(def_files, input_file, num_threads);
+
+    EXPECT_EQ(SkipTitle(ReadFile(base_name + ".def")),
+              std::string("VERSION 5.8 ;\nDESIGN top ;\n") + kComponents +
+                  kPins +
+                  "NETS 1 ;\n"
+                  "- n0\n"
+                  "  ( PIN in )  ( u0 a )  ( u1 z ) \n"
+                  " ;\n"
+                  "END NETS\n\n"
+                  "END DESIGN\n");
+    EXPECT_EQ(SkipTitle(ReadFile(base_name + "_placed.def")),
+              "VERSION 5.8 ;\nDESIGN top ;\n"
+              "COMPONENTS 2 ;\n"
+              "- u0 INV + PLACED ( 200 0 ) N ;\n"
+              "- u1 INV + FIXED ( 1000 1600 ) FS ;\n"
+              "END COMPONENTS\n\n"
+              "PINS 0 ;\n"
+              "NETS 0 ;\nEND NETS\n\n"
+              "END DESIGN\n");
+    // cover cells are named after the base name
+    EXPECT_EQ(SkipTitle(ReadFile(base_name + "_filling.def")),
+              "VERSION 5.8 ;\nDESIGN top ;\n"
+              "COMPONENTS 5 ;\n"
+              "- npwells " + base_name + "well + COVER ( 0 0 ) N ;\n" +
+                  "- ppnps " + base_name + "ppnp + COVER ( 0 0 ) N ;\n" +
+                  "- u0 INV + PLACED ( 200 0 ) N ;\n"
+                  "- u1 INV + FIXED ( 1000 1600 ) FS ;\n"
+                  "- u2 INV + UNPLACED ( 0 0 ) N ;\n"
+                  "END COMPONENTS\n\n" +
+                  kPins +
+                  "NETS 0 ;\nEND NETS\n\n"
+                  "END DESIGN\n");
+    EXPECT_EQ(SkipTitle(ReadFile(base_name + "_comp.def")),
+              std::string("VERSION 5.8 ;\nDESIGN top ;\n") + kComponents +
+                  "\nSPECIALNETS 0 ;\nEND SPECIALNETS\nEND DESIGN\n");
+  }
+}
+
+}  // namespace
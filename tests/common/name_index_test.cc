@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dali/common/name_index.h"
+#include "dali/common/named_instance_collection.h"
+
+namespace {
+
+using dali::NameIndex;
+
+TEST(NameIndexTest, InsertsNamesWithDenseIds) {
+  NameIndex index;
+  EXPECT_EQ(index.Find("a"), NameIndex::kNotFound);
+  EXPECT_EQ(index.Insert("a"), std::make_pair(size_t(0), true));
+  EXPECT_EQ(index.Insert("b"), std::make_pair(size_t(1), true));
+  EXPECT_EQ(index.Insert("a"), std::make_pair(size_t(0), false));
+  EXPECT_EQ(index.Size(), 2u);
+  EXPECT_EQ(index.Name(1), "b");
+}
+
+TEST(NameIndexTest, FindsNamesWithoutStrings) {
+  NameIndex index;
+  index.Insert("u1/inv_with_a_long_name");
+  std::string query = "top/u1/inv_with_a_long_name";
+  EXPECT_EQ(index.Find(std::string_view(query).substr(4)), 0u);
+  EXPECT_EQ(index.Find(query), NameIndex::kNotFound);
+  EXPECT_EQ(index.Find("u1/inv_with_a_long_name"), 0u);
+  EXPECT_EQ(index.Find(""), NameIndex::kNotFound);
+}
+
+TEST(NameIndexTest, KeepsNamesWhenGrowing) {
+  NameIndex index;
+  std::string const* first = &index.Name(index.Insert("n0").first);
+  for (int i = 1; i < 100000; ++i) {
+    index.Insert("n" + std::to_string(i));
+  }
+  EXPECT_EQ(&index.Name(0), first);
+  for (int i = 0; i < 100000; i += 997) {
+    EXPECT_EQ(index.Find("n" + std::to_string(i)), size_t(i));
+  }
+  EXPECT_EQ(index.Find("n100000"), NameIndex::kNotFound);
+
+  index.Clear();
+  EXPECT_EQ(index.Size(), 0u);
+  EXPECT_EQ(index.Find("n0"), NameIndex::kNotFound);
+}
+
+TEST(NameIndexTest, BulkInsertReportsTheFirstDuplicate) {
+  std::vector<std::string> names = {"x", "y", "z", "y", "w"};
+  NameIndex index;
+  index.Insert("v");
+  size_t duplicate = index.BulkInsert(
+      names.size(), [&names](size_t i) -> std::string const& {
+        return names[i];
+      });
+  EXPECT_EQ(duplicate, 3u);
+  EXPECT_EQ(index.Size(), 4u);
+  EXPECT_EQ(index.Find("z"), 3u);
+
+  NameIndex unique_index;
+  EXPECT_EQ(unique_index.BulkInsert(
+                3, [&names](size_t i) -> std::string const& {
+                  return names[i];
+                }),
+            NameIndex::kNotFound);
+  EXPECT_EQ(unique_index.Find("x"), 0u);
+}
+
+struct Instance {
+  explicit Instance(std::string const* name_ptr) : name(name_ptr) {}
+  std::string const* name;
+};
+
+TEST(NamedInstanceCollectionTest, CreatesInstancesAtOnce) {
+  dali::NamedInstanceCollection<Instance> collection;
+  collection.CreateInstance("first");
+  std::vector<std::string> names = {"a", "b", "c"};
+  size_t first_id = collection.CreateInstances(
+      names.size(), [&names](size_t i) -> std::string const& {
+        return names[i];
+      });
+  EXPECT_EQ(first_id, 1u);
+  EXPECT_EQ(collection.GetSize(), 4u);
+  EXPECT_EQ(*collection.GetInstanceByName("c")->name, "c");
+  EXPECT_EQ(collection.GetInstanceIdByName(std::string_view("bc", 1)), 2u);
+  EXPECT_TRUE(collection.NameExists("first"));
+  EXPECT_EXIT(collection.CreateInstance("b"), testing::ExitedWithCode(1), "");
+}
+
+}  // namespace
@@ -70,4 +70,62 @@ TEST(PlacementMetricsTest, GlobalWrapperClearRemovesOldStageValues) {
   std::filesystem::remove(metrics_file);
 }
 
+TEST(PlacementMetricsTest, NestedTimersAndSeriesAreWrittenToJson) {
+  const std::filesystem::path metrics_file =
+      std::filesystem::temp_directory_path() /
+      "dali_placement_metrics_timer_test.json";
+  std::filesystem::remove(metrics_file);
+
+  dali::PlacementMetrics metrics;
+  metrics.BeginTimer("placement");
+  for (int i = 0; i < 3; ++i) {
+    metrics.BeginTimer("iteration");
+    metrics.AddTime("solve", 0.5, 2);
+    metrics.EndTimer();
+    metrics.AppendSeries("hpwl", 10.0 - i);
+  }
+  // clearing metrics keeps the timer in progress
+  metrics.Clear();
+  metrics.BeginTimer("legalization");
+  metrics.EndTimer();
+  metrics.EndTimer();
+
+  const auto& timers = metrics.Timers();
+  ASSERT_EQ(timers.size(), 2u);
+  EXPECT_EQ(timers[0].name, "placement");
+  EXPECT_EQ(timers[0].calls, 1);
+  EXPECT_TRUE(timers[0].is_scoped);
+  EXPECT_EQ(timers[1].name, "placement.legalization");
+  EXPECT_GE(timers[0].wall_time, timers[1].wall_time);
+
+  metrics.BeginTimer("placement");
+  for (int i = 0; i < 3; ++i) {
+    metrics.BeginTimer("iteration");
+    metrics.AddTime("solve", 0.5, 2);
+    metrics.EndTimer();
+    metrics.AppendSeries("hpwl", 10.0 - i);
+  }
+  metrics.EndTimer();
+  ASSERT_EQ(timers.size(), 4u);
+  EXPECT_EQ(timers[0].calls, 2);
+  EXPECT_EQ(timers[2].name, "placement.iteration");
+  EXPECT_EQ(timers[2].calls, 3);
+  EXPECT_EQ(timers[3].name, "placement.iteration.solve");
+  EXPECT_EQ(timers[3].calls, 6);
+  EXPECT_DOUBLE_EQ(timers[3].wall_time, 1.5);
+  EXPECT_FALSE(timers[3].is_scoped);
+
+  ASSERT_TRUE(metrics.WriteJson(metrics_file.string(), true));
+  const std::string json = ReadFile(metrics_file);
+  EXPECT_NE(json.find("\"placement.iteration.solve\": {\"calls\": 6, "
+                      "\"wall_time\": 1.5}"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"placement.iteration\": {\"calls\": 3, "),
+            std::string::npos);
+  EXPECT_NE(json.find("\"peak_rss_delta_bytes\""), std::string::npos);
+  EXPECT_NE(json.find("\"hpwl\": [10, 9, 8]"), std::string::npos);
+
+  std::filesystem::remove(metrics_file);
+}
+
 }  // namespace
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "dali/placer/global_placer/grid_bin_cluster.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+typedef std::vector<std::vector<dali::GridBin>> GridBinMesh;
+
+GridBinMesh MakeMesh(int num_x, int num_y) {
+  GridBinMesh mesh(num_x, std::vector<dali::GridBin>(num_y));
+  for (int i = 0; i < num_x; ++i) {
+    for (int j = 0; j < num_y; ++j) {
+      mesh[i][j].index = dali::GridBinIndex(i, j);
+      mesh[i][j].white_space = 100;
+      mesh[i][j].create_adjacent_bin_list(num_x, num_y);
+    }
+  }
+  return mesh;
+}
+
+void OverFill(GridBinMesh& mesh, int x, int y, unsigned long long cell_area) {
+  mesh[x][y].over_fill = true;
+  mesh[x][y].cell_area = cell_area;
+}
+
+std::vector<dali::GridBinIndex> TopBins(
+    dali::GridBinClusterQueue const& queue) {
+  dali::GridBinCluster const& cluster = queue.Top();
+  std::vector<dali::GridBinIndex> bins(
+      queue.Bins().begin() + cluster.bin_begin,
+      queue.Bins().begin() + cluster.bin_end);
+  std::sort(bins.begin(), bins.end());
+  return bins;
+}
+
+// Take the cluster on top the way look-ahead legalization does: its bins are
+// roughly legalized, and then clusters with placed bins are split.
+std::vector<dali::GridBinIndex> TakeTop(dali::GridBinClusterQueue& queue,
+                                        GridBinMesh& mesh) {
+  std::vector<dali::GridBinIndex> bins = TopBins(queue);
+  for (auto& index : bins) mesh[index.x][index.y].global_placed = true;
+  queue.SplitPlacedClusters(mesh, 100);
+  return bins;
+}
+
+TEST(GridBinClusterTest, ClustersGoInCellAreaOrder) {
+  GridBinMesh mesh = MakeMesh(6, 6);
+  // a: area 30, three bins
+  OverFill(mesh, 0, 0, 10);
+  OverFill(mesh, 0, 1, 10);
+  OverFill(mesh, 1, 0, 10);
+  // b: area 50, one bin
+  OverFill(mesh, 0, 5, 50);
+  // c: area 20, four bins
+  OverFill(mesh, 3, 3, 5);
+  OverFill(mesh, 3, 4, 5);
+  OverFill(mesh, 4, 3, 5);
+  OverFill(mesh, 4, 4, 5);
+  // d: area 30, one bin, the same area as a
+  OverFill(mesh, 5, 0, 30);
+
+  dali::GridBinClusterQueue queue;
+  queue.Build(mesh, 100);
+  EXPECT_EQ(queue.NumClusters(), 4);
+  EXPECT_EQ(queue.Bins().size(), 9u);
+  for (auto& row : mesh) {
+    for (auto& bin : row) EXPECT_EQ(bin.cluster_visited, bin.over_fill);
+  }
+
+  EXPECT_EQ(queue.Top().total_cell_area, 50u);
+  EXPECT_EQ(queue.Top().total_white_space, 100u);
+  using Bins = std::vector<dali::GridBinIndex>;
+  EXPECT_EQ(TakeTop(queue, mesh), (Bins{{0, 5}}));
+  // a and d have the same area, and a is found first
+  EXPECT_EQ(queue.Top().total_cell_area, 30u);
+  EXPECT_EQ(queue.Top().total_white_space, 300u);
+  EXPECT_EQ(TakeTop(queue, mesh), (Bins{{0, 0}, {0, 1}, {1, 0}}));
+  EXPECT_EQ(TakeTop(queue, mesh), (Bins{{5, 0}}));
+  EXPECT_EQ(queue.Top().total_cell_area, 20u);
+  EXPECT_EQ(TakeTop(queue, mesh), (Bins{{3, 3}, {3, 4}, {4, 3}, {4, 4}}));
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(GridBinClusterTest, ClusterWithPlacedBinIsSplit) {
+  GridBinMesh mesh = MakeMesh(5, 5);
+  // a row of five bins, the middle one is roughly legalized later
+  OverFill(mesh, 2, 0, 10);
+  OverFill(mesh, 2, 1, 10);
+  OverFill(mesh, 2, 2, 10);
+  OverFill(mesh, 2, 3, 20);
+  OverFill(mesh, 2, 4, 20);
+  OverFill(mesh, 4, 4, 45);
+
+  dali::GridBinClusterQueue queue;
+  queue.Build(mesh, 100);
+  EXPECT_EQ(queue.NumClusters(), 2);
+  EXPECT_EQ(queue.Top().total_cell_area, 70u);
+
+  mesh[2][2].global_placed = true;
+  queue.SplitPlacedClusters(mesh, 100);
+  EXPECT_EQ(queue.NumClusters(), 3);
+  using Bins = std::vector<dali::GridBinIndex>;
+  EXPECT_EQ(TakeTop(queue, mesh), (Bins{{4, 4}}));
+  EXPECT_EQ(TakeTop(queue, mesh), (Bins{{2, 3}, {2, 4}}));
+  EXPECT_EQ(TakeTop(queue, mesh), (Bins{{2, 0}, {2, 1}}));
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(GridBinClusterTest, ClusterStopsGrowingAtUpperSize) {
+  GridBinMesh mesh = MakeMesh(4, 4);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) OverFill(mesh, i, j, 10);
+  }
+
+  // the search from (0, 0) adds (1, 0), (0, 1), (2, 0) and (1, 1), then the
+  // rest of the bins are a cluster grown from (0, 2)
+  dali::GridBinClusterQueue queue;
+  queue.Build(mesh, 3);
+  EXPECT_EQ(queue.NumClusters(), 2);
+  using Bins = std::vector<dali::GridBinIndex>;
+  EXPECT_EQ(TopBins(queue), (Bins{{0, 0}, {0, 1}, {1, 0}, {1, 1}, {2, 0}}));
+  mesh[0][0].global_placed = true;
+  queue.SplitPlacedClusters(mesh, 3);
+  EXPECT_EQ(TopBins(queue), (Bins{{0, 2}, {1, 2}, {2, 1}, {2, 2}}));
+}
+
+}  // namespace
@@ -0,0 +1,232 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "dali/placer/global_placer/hpwl_evaluator.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include "dali/circuit/circuit.h"
+#include "dali/circuit/netlist_kernels.h"
+
+namespace {
+
+// A row of cells, net i connects cell i to a few of the following cells.
+// Every third cell is flipped to exercise orientation-aware pin offsets.
+void BuildCircuit(dali::Circuit& circuit, int num_cells) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, dali::VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, dali::HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  dali::BlockType* cell = circuit.AddBlockType("CELL", 1.2, 1.6);
+  for (int p = 0; p < 3; ++p) {
+    dali::Pin* pin = circuit.AddBlkTypePin(cell, "P" + std::to_string(p), true);
+    pin->SetOffset(0.2 * p, 0.4 * p);
+  }
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 100000, 100000);
+  circuit.ReserveSpaceForDesignImp(num_cells, 0, num_cells);
+  for (int i = 0; i < num_cells; ++i) {
+    dali::BlockOrient orient = i % 3 == 0 ? dali::FN : dali::N;
+    circuit.AddBlock("c" + std::to_string(i), "CELL", 0, 0, dali::PLACED,
+                     orient, true);
+  }
+  for (int i = 0; i < num_cells; ++i) {
+    std::string net_name = "n" + std::to_string(i);
+    int fanout = std::min(2 + i % 4, num_cells - i);
+    circuit.AddNet(net_name, fanout, 1.0 + i % 3);
+    for (int k = 0; k < fanout; ++k) {
+      circuit.AddBlkPinToNet("c" + std::to_string(i + k),
+                             "P" + std::to_string(k % 3), net_name);
+    }
+  }
+}
+
+class HpwlEvaluatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    BuildCircuit(circuit_, num_cells_);
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> dist(0, 400);
+    loc_x_.resize(num_cells_);
+    loc_y_.resize(num_cells_);
+    for (int i = 0; i < num_cells_; ++i) {
+      loc_x_[i] = dist(rng);
+      loc_y_[i] = dist(rng);
+    }
+    MoveBlocks();
+    netlist_.Build(circuit_.Nets(), circuit_.Blocks());
+  }
+
+  // locations are read back, blocks may store them in float
+  void MoveBlocks() {
+    for (int i = 0; i < num_cells_; ++i) {
+      dali::Block& block = circuit_.Blocks()[i];
+      block.SetLoc(loc_x_[i], loc_y_[i]);
+      loc_x_[i] = block.LLX();
+      loc_y_[i] = block.LLY();
+    }
+  }
+
+  int num_cells_ = 2000;
+  dali::Circuit circuit_;
+  dali::NetlistView netlist_;
+  Eigen::VectorXd loc_x_;
+  Eigen::VectorXd loc_y_;
+};
+
+TEST_F(HpwlEvaluatorTest, NetlistViewMatchesNets) {
+  netlist_.UpdateBlockLocationsX(circuit_.Blocks());
+  netlist_.UpdateBlockLocationsY(circuit_.Blocks(), 4);
+  double const* blk_x = netlist_.BlockX().data();
+  double const* blk_y = netlist_.BlockY().data();
+  for (auto& net : circuit_.Nets()) {
+    int max_pin_x, min_pin_x, max_pin_y, min_pin_y;
+    netlist_.FindMaxMinPins(net.Id(), true, blk_x, max_pin_x, min_pin_x);
+    netlist_.FindMaxMinPins(net.Id(), false, blk_y, max_pin_y, min_pin_y);
+    net.UpdateMaxMinIndex();
+    EXPECT_EQ(max_pin_x, net.MaxBlkPinIdX());
+    EXPECT_EQ(min_pin_x, net.MinBlkPinIdX());
+    EXPECT_EQ(max_pin_y, net.MaxBlkPinIdY());
+    EXPECT_EQ(min_pin_y, net.MinBlkPinIdY());
+    EXPECT_EQ(netlist_.WeightedHpwl(net.Id(), true, blk_x),
+              net.WeightedHPWLX());
+  }
+}
+
+TEST_F(HpwlEvaluatorTest, MatchesCircuitHpwl) {
+  dali::HpwlEvaluator evaluator_x;
+  dali::HpwlEvaluator evaluator_y;
+  evaluator_x.Build(&netlist_, true, circuit_.GridValueX());
+  evaluator_y.Build(&netlist_, false, circuit_.GridValueY());
+  evaluator_x.SetNumThreads(4);
+  EXPECT_EQ(evaluator_x.Evaluate(loc_x_), circuit_.WeightedHPWLX());
+  EXPECT_EQ(evaluator_y.Evaluate(loc_y_), circuit_.WeightedHPWLY());
+  EXPECT_EQ(evaluator_x.NumUpdatedNets(), num_cells_);
+}
+
+TEST_F(HpwlEvaluatorTest, UpdatesOnlyNetsOfMovedBlocks) {
+  dali::HpwlEvaluator evaluator;
+  evaluator.Build(&netlist_, true, circuit_.GridValueX());
+  evaluator.Evaluate(loc_x_);
+
+  // cell 100 is in nets 95 to 100, depending on their fanout
+  loc_x_[100] += 37.5;
+  MoveBlocks();
+  EXPECT_EQ(evaluator.Evaluate(loc_x_), circuit_.WeightedHPWLX());
+  int num_nets_of_cell = 0;
+  for (auto& net : circuit_.Nets()) {
+    for (auto& blk_pin : net.BlockPins()) {
+      num_nets_of_cell += blk_pin.BlkId() == 100;
+    }
+  }
+  EXPECT_EQ(evaluator.NumUpdatedNets(), num_nets_of_cell);
+
+  evaluator.Evaluate(loc_x_);
+  EXPECT_EQ(evaluator.NumUpdatedNets(), 0);
+}
+
+TEST_F(HpwlEvaluatorTest, SkipsMovesBelowThreshold) {
+  dali::HpwlEvaluator evaluator;
+  evaluator.Build(&netlist_, true, circuit_.GridValueX());
+  evaluator.SetUpdateThreshold(1.0);
+  double hpwl = evaluator.Evaluate(loc_x_);
+
+  loc_x_[100] += 0.5;
+  EXPECT_EQ(evaluator.Evaluate(loc_x_), hpwl);
+  EXPECT_EQ(evaluator.NumUpdatedNets(), 0);
+
+  // moves accumulate against the location at the last update
+  loc_x_[100] += 0.75;
+  MoveBlocks();
+  EXPECT_EQ(evaluator.Evaluate(loc_x_), circuit_.WeightedHPWLX());
+  EXPECT_GT(evaluator.NumUpdatedNets(), 0);
+
+  evaluator.Reset();
+  evaluator.Evaluate(loc_x_);
+  EXPECT_EQ(evaluator.NumUpdatedNets(), num_cells_);
+}
+
+TEST_F(HpwlEvaluatorTest, BatchedKernelsMatchCircuitHpwl) {
+  double hpwl_x = circuit_.WeightedHPWLX();
+  double hpwl_y = circuit_.WeightedHPWLY();
+  for (auto simd_level : {dali::SimdLevel::SCALAR, dali::SimdLevel::AVX2,
+                          dali::SimdLevel::AVX512}) {
+    netlist_.SetSimdLevel(simd_level);
+    EXPECT_EQ(circuit_.WeightedHPWLX(netlist_, 3), hpwl_x);
+    EXPECT_EQ(circuit_.WeightedHPWLY(netlist_), hpwl_y);
+  }
+}
+
+// Nets of 0 to 40 pins on a coarse grid of locations, so that large nets,
+// ties and nets with all pins at the same location are all covered.
+TEST(NetlistKernelTest, EverySimdLevelMatchesScalar) {
+  std::mt19937 rng(7);
+  int num_nets = 1001;
+  std::vector<int> net_pin_begin(1, 0);
+  for (int i = 0; i < num_nets; ++i) {
+    int sz = i % 50 == 0 ? static_cast<int>(rng() % 41)
+                         : static_cast<int>(rng() % 6);
+    net_pin_begin.push_back(net_pin_begin.back() + sz);
+  }
+  int num_pins = net_pin_begin.back();
+  int num_blocks = 300;
+  std::vector<int> pin_blk_ids(num_pins);
+  std::vector<double> pin_offsets(num_pins);
+  for (int j = 0; j < num_pins; ++j) {
+    pin_blk_ids[j] = static_cast<int>(rng() % num_blocks);
+    pin_offsets[j] = 0.5 * static_cast<double>(rng() % 3);
+  }
+  std::vector<double> blk_loc(num_blocks);
+  for (auto& loc : blk_loc) {
+    loc = static_cast<double>(rng() % 8);
+  }
+
+  std::vector<double> expected_loc(num_pins);
+  std::vector<int> expected_max(num_nets), expected_min(num_nets);
+  dali::ComputePinLocations(dali::SimdLevel::SCALAR, pin_blk_ids.data(),
+                            pin_offsets.data(), blk_loc.data(), 0, num_pins,
+                            expected_loc.data());
+  dali::FindMaxMinPins(dali::SimdLevel::SCALAR, net_pin_begin.data(), 0,
+                       num_nets, expected_loc.data(), expected_max.data(),
+                       expected_min.data());
+  for (auto simd_level : {dali::SimdLevel::AVX2, dali::SimdLevel::AVX512}) {
+    if (simd_level > dali::DetectSimdLevel()) continue;
+    std::vector<double> pin_loc(num_pins);
+    std::vector<int> max_pin(num_nets), min_pin(num_nets);
+    dali::ComputePinLocations(simd_level, pin_blk_ids.data(),
+                              pin_offsets.data(), blk_loc.data(), 0, num_pins,
+                              pin_loc.data());
+    // an odd start exercises the scalar remainder of net batches
+    dali::FindMaxMinPins(simd_level, net_pin_begin.data(), 0, 3,
+                         pin_loc.data(), max_pin.data(), min_pin.data());
+    dali::FindMaxMinPins(simd_level, net_pin_begin.data(), 3, num_nets,
+                         pin_loc.data(), max_pin.data(), min_pin.data());
+    EXPECT_EQ(pin_loc, expected_loc) << dali::SimdLevelStr(simd_level);
+    EXPECT_EQ(max_pin, expected_max) << dali::SimdLevelStr(simd_level);
+    EXPECT_EQ(min_pin, expected_min) << dali::SimdLevelStr(simd_level);
+  }
+}
+
+}  // namespace
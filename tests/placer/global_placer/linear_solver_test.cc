@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "dali/placer/global_placer/linear_solver.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// A connected graph Laplacian like the B2B systems. Every 100th unknown gets
+// an anchor if @param is_anchored is true, otherwise the matrix is singular.
+dali::SpMat PlacementLikeMatrix(int sz, bool is_anchored) {
+  std::vector<Eigen::Triplet<double>> coefficients;
+  for (int i = 0; i < sz; ++i) {
+    for (int k = 1; k <= 3; ++k) {
+      int j = (i + 7 * k * k + 1) % sz;
+      double weight = 0.1 + (i * 31 + k * 17) % 100 / 10.0;
+      coefficients.emplace_back(i, i, weight);
+      coefficients.emplace_back(j, j, weight);
+      coefficients.emplace_back(i, j, -weight);
+      coefficients.emplace_back(j, i, -weight);
+    }
+    if (is_anchored && i % 100 == 0) {
+      coefficients.emplace_back(i, i, 1.0);
+    }
+  }
+  dali::SpMat A(sz, sz);
+  A.setFromTriplets(coefficients.begin(), coefficients.end());
+  return A;
+}
+
+double RelativeResidual(dali::SpMat const& A, Eigen::VectorXd const& x,
+                        Eigen::VectorXd const& b) {
+  return (A * x - b).norm() / b.norm();
+}
+
+class LinearSolverTest
+    : public ::testing::TestWithParam<dali::LinearSolverType> {};
+
+TEST_P(LinearSolverTest, SolvesAnchoredSystem) {
+  dali::SpMat A = PlacementLikeMatrix(5000, true);
+  Eigen::VectorXd b = Eigen::VectorXd::LinSpaced(A.rows(), -1.0, 1.0);
+  auto solver = dali::CreateLinearSolver(GetParam());
+  solver->SetMaxIterations(2000);
+  solver->SetTolerance(1e-8);
+  solver->Compute(A);
+  EXPECT_TRUE(solver->IsComputeSuccessful());
+
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(A.rows());
+  solver->SolveWithGuess(b, x);
+  EXPECT_LT(RelativeResidual(A, x, b), 1e-7);
+  EXPECT_GT(solver->Iterations(), 0);
+}
+
+TEST_P(LinearSolverTest, StaysFiniteOnSingularSystem) {
+  dali::SpMat A = PlacementLikeMatrix(5000, false);
+  Eigen::VectorXd b = Eigen::VectorXd::LinSpaced(A.rows(), -1.0, 1.0);
+  b.array() -= b.mean();
+  auto solver = dali::CreateLinearSolver(GetParam());
+  solver->SetMaxIterations(10);
+  solver->SetTolerance(1e-35);
+  solver->Compute(A);
+
+  // global placement solves in rounds of a few iterations until converged
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(A.rows());
+  for (int i = 0; i < 50; ++i) {
+    solver->SolveWithGuess(b, x);
+  }
+  EXPECT_TRUE(std::isfinite(x.norm()));
+  EXPECT_LT(RelativeResidual(A, x, b), 1e-2);
+}
+
+TEST_P(LinearSolverTest, IsIndependentOfNumThreads) {
+  dali::SpMat A = PlacementLikeMatrix(20000, true);
+  Eigen::VectorXd b = Eigen::VectorXd::LinSpaced(A.rows(), -1.0, 1.0);
+  std::vector<Eigen::VectorXd> solutions;
+  for (int num_threads : {1, 3, 8}) {
+    auto solver = dali::CreateLinearSolver(GetParam());
+    solver->SetMaxIterations(50);
+    solver->SetTolerance(1e-35);
+    solver->SetNumThreads(num_threads);
+    solver->Compute(A);
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(A.rows());
+    solver->SolveWithGuess(b, x);
+    solutions.push_back(x);
+  }
+  for (auto& x : solutions) {
+    EXPECT_TRUE(x == solutions[0]);
+  }
+}
+
+TEST(ParallelKernelTest, DotProductIsIndependentOfNumThreads) {
+  Eigen::VectorXd a = Eigen::VectorXd::LinSpaced(100003, -3.0, 7.0);
+  Eigen::VectorXd b = a.cwiseAbs().cwiseSqrt();
+  double dot = dali::ParallelDot(a, b, 1);
+  EXPECT_NEAR(dot, a.dot(b), 1e-9 * std::fabs(a.dot(b)));
+  for (int num_threads : {2, 5, 16}) {
+    EXPECT_EQ(dali::ParallelDot(a, b, num_threads), dot);
+  }
+}
+
+TEST(LinearSolverTypeTest, ConvertsConfigurationNames) {
+  for (auto solver_type : {dali::LinearSolverType::DIAGONAL_CG,
+                           dali::LinearSolverType::INCOMPLETE_CHOLESKY_CG,
+                           dali::LinearSolverType::AMG_CG}) {
+    EXPECT_EQ(dali::StrToLinearSolverType(
+                  dali::LinearSolverTypeStr(solver_type)),
+              solver_type);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AllBackends, LinearSolverTest,
+    ::testing::Values(dali::LinearSolverType::DIAGONAL_CG,
+                      dali::LinearSolverType::INCOMPLETE_CHOLESKY_CG,
+                      dali::LinearSolverType::AMG_CG));
+
+}  // namespace
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "dali/placer/global_placer/rough_legalizer.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dali/circuit/circuit.h"
+
+namespace {
+
+// Cells crowd around the center of the region, so the largest cluster of
+// over-filled grid bins has enough cells to be spread by several tasks.
+void BuildCircuit(dali::Circuit& circuit, int num_cells) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, dali::VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, dali::HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  circuit.AddBlockType("CELL", 1.2, 1.6);
+  circuit.AddBlockType("WIDE_CELL", 2.4, 1.6);
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 150000, 150000);
+  circuit.ReserveSpaceForDesignImp(num_cells, 0, 0);
+  std::mt19937 rng(1);
+  std::normal_distribution<double> dist(375, 30);
+  for (int i = 0; i < num_cells; ++i) {
+    std::string type = i % 4 == 0 ? "WIDE_CELL" : "CELL";
+    circuit.AddBlock("c" + std::to_string(i), type, dist(rng), dist(rng),
+                     dali::PLACED);
+  }
+  circuit.UpdateTotalBlkArea();
+}
+
+std::vector<double> Locations(dali::Circuit& circuit) {
+  std::vector<double> locations;
+  for (auto& block : circuit.Blocks()) {
+    locations.push_back(block.LLX());
+    locations.push_back(block.LLY());
+  }
+  return locations;
+}
+
+// Spread the box around the largest cluster once, and return cell locations.
+std::vector<double> SpreadLargestCluster(int num_threads) {
+  dali::Circuit circuit;
+  BuildCircuit(circuit, 4000);
+  std::vector<double> initial_locations = Locations(circuit);
+
+  dali::LookAheadLegalizer legalizer(&circuit);
+  legalizer.SetNumThreads(num_threads);
+  legalizer.Initialize(0.7);
+  legalizer.ClearGridBinFlag();
+  legalizer.UpdateGridBinState();
+  legalizer.UpdateClusterList();
+  legalizer.UpdateLargestCluster();
+  legalizer.FindMinimumBoxForLargestCluster();
+  legalizer.RecursiveBisectionBlockSpreading();
+
+  std::vector<double> locations = Locations(circuit);
+  EXPECT_NE(locations, initial_locations);
+  return locations;
+}
+
+TEST(LookAheadLegalizerTest, SpreadsBoxTheSameWithAnyNumberOfThreads) {
+  std::vector<double> serial_locations = SpreadLargestCluster(1);
+  std::vector<double> parallel_locations = SpreadLargestCluster(4);
+  EXPECT_EQ(serial_locations, parallel_locations);
+}
+
+TEST(LookAheadLegalizerTest, GridBinCellListsAreInBlockOrder) {
+  dali::Circuit circuit;
+  BuildCircuit(circuit, 4000);
+  dali::LookAheadLegalizer serial_legalizer(&circuit);
+  serial_legalizer.Initialize(0.7);
+  serial_legalizer.UpdateGridBinState();
+  dali::LookAheadLegalizer parallel_legalizer(&circuit);
+  parallel_legalizer.SetNumThreads(4);
+  parallel_legalizer.Initialize(0.7);
+  parallel_legalizer.UpdateGridBinState();
+
+  auto& mesh = parallel_legalizer.GridBinMesh();
+  auto& serial_mesh = serial_legalizer.GridBinMesh();
+  dali::Block const* first_block = circuit.Blocks().data();
+  std::vector<int> bin_counts(circuit.Blocks().size(), 0);
+  for (size_t i = 0; i < mesh.size(); ++i) {
+    for (size_t j = 0; j < mesh[i].size(); ++j) {
+      dali::GridBin const& bin = mesh[i][j];
+      EXPECT_EQ(bin.cell_list, serial_mesh[i][j].cell_list);
+      EXPECT_EQ(bin.cell_area, serial_mesh[i][j].cell_area);
+      EXPECT_EQ(bin.over_fill, serial_mesh[i][j].over_fill);
+      unsigned long long cell_area = 0;
+      for (size_t k = 0; k < bin.cell_list.size(); ++k) {
+        dali::Block const* block = bin.cell_list[k];
+        if (k > 0) {
+          EXPECT_LT(bin.cell_list[k - 1], block);
+        }
+        EXPECT_GE(block->X(), bin.left);
+        EXPECT_LE(block->X(), bin.right);
+        EXPECT_GE(block->Y(), bin.bottom);
+        EXPECT_LE(block->Y(), bin.top);
+        ++bin_counts[block - first_block];
+        cell_area += block->Area();
+      }
+      EXPECT_EQ(bin.cell_area, cell_area);
+    }
+  }
+  for (int count : bin_counts) EXPECT_EQ(count, 1);
+}
+
+}  // namespace
@@ -0,0 +1,271 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "dali/placer/legalizer/extended_tetris_legalizer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/circuit/circuit.h"
+#include "dali/placer/legalizer/row_contour.h"
+
+namespace {
+
+class TestLegalizer : public dali::ExtendedTetrisLegalizer {
+ public:
+  void SetRows(std::vector<std::vector<dali::SegI>> const& rows, int left,
+               int right) {
+    rows_ = rows;
+    left_ = left;
+    right_ = right;
+    tot_num_rows_ = static_cast<int>(rows.size());
+  }
+  std::vector<std::vector<dali::SegI>> const& Rows() const { return rows_; }
+};
+
+// the previous linear scans over all segments of each row
+bool LinearIsSpaceLegal(TestLegalizer const& legalizer, int lo_x, int hi_x,
+                        int lo_row, int hi_row) {
+  if (hi_x > legalizer.RegionRight() || lo_x < legalizer.RegionLeft()) {
+    return false;
+  }
+  for (int i = lo_row; i <= hi_row; ++i) {
+    bool is_row_legal = false;
+    for (auto& seg : legalizer.Rows()[i]) {
+      if (seg.lo <= lo_x && seg.hi >= hi_x) {
+        is_row_legal = true;
+        break;
+      }
+      bool is_partial_cover_lo = seg.lo > lo_x && seg.lo < hi_x;
+      bool is_partial_cover_hi = seg.hi > lo_x && seg.hi < hi_x;
+      bool is_before_seg = seg.lo >= hi_x;
+      if (is_partial_cover_lo || is_partial_cover_hi || is_before_seg) {
+        break;
+      }
+    }
+    if (!is_row_legal) return false;
+  }
+  return true;
+}
+
+int LinearWhiteSpaceBound(TestLegalizer const& legalizer, int lo_x, int hi_x,
+                          int lo_row, int hi_row, bool is_left) {
+  int white_space_bound =
+      is_left ? legalizer.RegionLeft() : legalizer.RegionRight();
+  int min_distance = INT_MAX;
+  for (int i = lo_row; i <= hi_row; ++i) {
+    int tmp_bound = is_left ? legalizer.RegionLeft() : legalizer.RegionRight();
+    for (auto& seg : legalizer.Rows()[i]) {
+      if (seg.lo <= lo_x && seg.hi >= hi_x) {
+        tmp_bound = is_left ? seg.lo : seg.hi;
+        min_distance = 0;
+        break;
+      }
+      int tmp_distance = std::min(abs(seg.lo - lo_x) + abs(seg.lo - hi_x),
+                                  abs(seg.hi - lo_x) + abs(seg.hi - hi_x));
+      if (tmp_distance < min_distance) {
+        tmp_bound = is_left ? seg.lo : seg.hi;
+        min_distance = tmp_distance;
+      }
+    }
+    white_space_bound = is_left ? std::max(white_space_bound, tmp_bound)
+                                : std::min(white_space_bound, tmp_bound);
+  }
+  return white_space_bound;
+}
+
+// Rows are fragmented by random blockages, some rows are empty, and some
+// segments touch each other or have zero width.
+std::vector<std::vector<dali::SegI>> RandomRows(std::mt19937& rng,
+                                                int num_rows, int left,
+                                                int right) {
+  std::vector<std::vector<dali::SegI>> rows(num_rows);
+  for (auto& row : rows) {
+    if (rng() % 10 == 0) continue;
+    int x = left + static_cast<int>(rng() % 5);
+    while (x < right) {
+      int width = static_cast<int>(rng() % 40);
+      int hi = std::min(right, x + width);
+      row.emplace_back(x, hi);
+      x = hi + (rng() % 3 == 0 ? 0 : static_cast<int>(rng() % 30));
+    }
+  }
+  return rows;
+}
+
+TEST(ExtendedTetrisLegalizerTest, SegmentQueriesMatchLinearScan) {
+  std::mt19937 rng(3);
+  int left = 0;
+  int right = 1000;
+  int num_rows = 40;
+  TestLegalizer legalizer;
+  for (int r = 0; r < 20; ++r) {
+    legalizer.SetRows(RandomRows(rng, num_rows, left, right), left, right);
+    for (int q = 0; q < 2000; ++q) {
+      int width = 1 + static_cast<int>(rng() % 30);
+      int lo_x = left - 10 + static_cast<int>(rng() % (right - left + 20));
+      int hi_x = lo_x + width;
+      int lo_row = static_cast<int>(rng() % num_rows);
+      int hi_row =
+          std::min(num_rows - 1, lo_row + static_cast<int>(rng() % 3));
+      EXPECT_EQ(legalizer.IsSpaceLegal(lo_x, hi_x, lo_row, hi_row),
+                LinearIsSpaceLegal(legalizer, lo_x, hi_x, lo_row, hi_row));
+      EXPECT_EQ(
+          legalizer.WhiteSpaceBoundLeft(lo_x, hi_x, lo_row, hi_row),
+          LinearWhiteSpaceBound(legalizer, lo_x, hi_x, lo_row, hi_row, true));
+      EXPECT_EQ(
+          legalizer.WhiteSpaceBoundRight(lo_x, hi_x, lo_row, hi_row),
+          LinearWhiteSpaceBound(legalizer, lo_x, hi_x, lo_row, hi_row, false));
+    }
+  }
+}
+
+TEST(ExtendedTetrisLegalizerTest, NearestSegmentPrefersTheEarlierTie) {
+  TestLegalizer legalizer;
+  // [10, 20) and [40, 50) are equally far away from [28, 32)
+  legalizer.SetRows({{dali::SegI(10, 20), dali::SegI(40, 50)}, {}}, 0, 100);
+  int distance = -1;
+  EXPECT_EQ(legalizer.NearestSegment(0, 28, 32, distance), 0);
+  EXPECT_EQ(distance, 20);
+  EXPECT_EQ(legalizer.CoveringSegment(0, 28, 32), -1);
+  EXPECT_EQ(legalizer.CoveringSegment(0, 40, 50), 1);
+  EXPECT_EQ(legalizer.NearestSegment(1, 28, 32, distance), -1);
+}
+
+// An odd number of rows, so that the segment tree is not a complete binary
+// tree.
+TEST(RowContourTest, RangeQueriesMatchLinearScan) {
+  std::mt19937 rng(5);
+  int num_rows = 37;
+  dali::RowContour contour;
+  contour.Assign(num_rows, 0);
+  std::vector<int> expected(num_rows, 0);
+  for (int q = 0; q < 5000; ++q) {
+    int lo_row = static_cast<int>(rng() % num_rows);
+    int hi_row = std::min(num_rows - 1, lo_row + static_cast<int>(rng() % 4));
+    int loc = static_cast<int>(rng() % 1000) - 500;
+    contour.AssignRange(lo_row, hi_row, loc);
+    std::fill(expected.begin() + lo_row, expected.begin() + hi_row + 1, loc);
+
+    lo_row = static_cast<int>(rng() % num_rows);
+    hi_row = lo_row + static_cast<int>(rng() % (num_rows - lo_row));
+    EXPECT_EQ(contour.MaxInRange(lo_row, hi_row),
+              *std::max_element(expected.begin() + lo_row,
+                                expected.begin() + hi_row + 1));
+    EXPECT_EQ(contour.MinInRange(lo_row, hi_row),
+              *std::min_element(expected.begin() + lo_row,
+                                expected.begin() + hi_row + 1));
+  }
+  for (int row = 0; row < num_rows; ++row) {
+    EXPECT_EQ(contour[row], expected[row]);
+  }
+}
+
+// Cells of a few widths at random locations, 70% of 128 rows are filled. A
+// dense_fraction of cells is in rows [32, 64), the second row band.
+void BuildCircuit(dali::Circuit& circuit, int num_cells,
+                  double dense_fraction) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, dali::VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, dali::HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  circuit.SetNwellParams(0.0, 0.0, 0.0, 1e8, 0.0);
+  circuit.SetPwellParams(0.0, 0.0, 0.0, 1e8, 0.0);
+  for (int t = 0; t < 4; ++t) {
+    std::string name = "T" + std::to_string(t);
+    double width = 0.4 * (t + 2);
+    circuit.AddBlockType(name, width, 1.6);
+    circuit.SetWellRect(name, false, 0, 0, width, 0.8);
+    circuit.SetWellRect(name, true, 0, 0.8, width, 1.6);
+  }
+  circuit.SetUnitsDistanceMicrons(1000);
+  int num_rows = 128;
+  int die_width = static_cast<int>(num_cells * 1.4 / num_rows / 0.7) * 1000;
+  circuit.SetDieArea(0, 0, die_width, num_rows * 1600);
+  circuit.ReserveSpaceForDesignImp(num_cells, 0, 0);
+  std::mt19937 rng(11);
+  for (int i = 0; i < num_cells; ++i) {
+    circuit.AddBlock("c" + std::to_string(i), "T" + std::to_string(rng() % 4),
+                     0, 0, dali::PLACED, dali::N, true);
+  }
+  std::uniform_real_distribution<double> dist(0, 1);
+  double width = circuit.RegionURX() - circuit.RegionLLX();
+  double height = circuit.RegionURY() - circuit.RegionLLY();
+  int num_dense_cells = static_cast<int>(dense_fraction * num_cells);
+  for (auto& block : circuit.Blocks()) {
+    double x = circuit.RegionLLX() + dist(rng) * (width - block.Width());
+    double y = circuit.RegionLLY() + dist(rng) * (height - block.Height());
+    if (block.Id() < num_dense_cells) {
+      y = circuit.RegionLLY() + (1 + dist(rng)) * height / 4 - block.Height();
+    }
+    block.SetLoc(x, y);
+  }
+}
+
+std::vector<std::pair<double, double>> LegalizeInRowBands(
+    int num_threads, double dense_fraction = 0) {
+  dali::Circuit circuit;
+  BuildCircuit(circuit, 5000, dense_fraction);
+  dali::ExtendedTetrisLegalizer legalizer;
+  legalizer.SetCircuit(&circuit);
+  legalizer.SetNumThreads(num_threads);
+  legalizer.SetRowBandMode(true);
+  EXPECT_TRUE(legalizer.StartPlacement());
+  EXPECT_FALSE(legalizer.IsRowBandFallbackUsed());
+
+  // every block is in a row, and blocks in a row do not overlap
+  int row_height = legalizer.RowHeight();
+  std::vector<std::vector<std::pair<double, double>>> rows(
+      (legalizer.RegionTop() - legalizer.RegionBottom()) / row_height);
+  std::vector<std::pair<double, double>> locs;
+  for (auto& block : circuit.Blocks()) {
+    int lly = static_cast<int>(block.LLY());
+    EXPECT_EQ((lly - legalizer.RegionBottom()) % row_height, 0);
+    int row = (lly - legalizer.RegionBottom()) / row_height;
+    rows[row].emplace_back(block.LLX(), block.URX());
+    locs.emplace_back(block.LLX(), block.LLY());
+  }
+  for (auto& row : rows) {
+    std::sort(row.begin(), row.end());
+    for (size_t i = 1; i < row.size(); ++i) {
+      EXPECT_LE(row[i - 1].second, row[i].first);
+    }
+  }
+  return locs;
+}
+
+TEST(ExtendedTetrisLegalizerTest, RowBandsAreLegalForAnyNumberOfThreads) {
+  EXPECT_EQ(LegalizeInRowBands(1), LegalizeInRowBands(4));
+}
+
+TEST(ExtendedTetrisLegalizerTest, FailedRowBandsAreLegalizedWithNeighbors) {
+  EXPECT_EQ(LegalizeInRowBands(1, 0.25), LegalizeInRowBands(4, 0.25));
+}
+
+}  // namespace
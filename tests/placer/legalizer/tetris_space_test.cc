@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "dali/placer/legalizer/tetris_legalizer/tetris_space.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef std::vector<std::pair<int, int>> Spans;
+
+Spans SegmentSpans(dali::FreeSegmentList const& list) {
+  Spans spans;
+  for (auto& seg : list.Segments()) {
+    spans.emplace_back(seg.Start(), seg.End());
+  }
+  return spans;
+}
+
+TEST(FreeSegmentListTest, UseSpaceShrinksRemovesAndSplitsSegments) {
+  dali::FreeSegmentList list(0, 100, 4);
+  list.UseSpace(0, 10);
+  EXPECT_EQ(SegmentSpans(list), (Spans{{10, 100}}));
+  list.UseSpace(90, 10);
+  EXPECT_EQ(SegmentSpans(list), (Spans{{10, 90}}));
+  list.UseSpace(40, 10);
+  EXPECT_EQ(SegmentSpans(list), (Spans{{10, 40}, {50, 90}}));
+  list.UseSpace(10, 30);
+  EXPECT_EQ(SegmentSpans(list), (Spans{{50, 90}}));
+  list.UseSpace(60, 5);
+  list.UseSpace(70, 5);
+  EXPECT_EQ(SegmentSpans(list), (Spans{{50, 60}, {65, 70}, {75, 90}}));
+}
+
+TEST(FreeSegmentListTest, SpaceIsAvailableOnlyInsideOneSegment) {
+  dali::FreeSegmentList list(0, 100, 4);
+  list.UseSpace(0, 10);
+  list.UseSpace(40, 10);
+  list.UseSpace(90, 10);
+  EXPECT_TRUE(list.IsSpaceAvail(10, 30));
+  EXPECT_TRUE(list.IsSpaceAvail(50, 40));
+  EXPECT_FALSE(list.IsSpaceAvail(35, 10));
+  EXPECT_FALSE(list.IsSpaceAvail(85, 10));
+  EXPECT_FALSE(list.IsSpaceAvail(0, 5));
+}
+
+TEST(FreeSegmentListTest, ApplyMaskSplitsAndMergesSegments) {
+  dali::FreeSegmentList list(0, 100, 4);
+  dali::FreeSegmentList mask;
+  EXPECT_TRUE(mask.EmplaceBack(0, 30));
+  EXPECT_TRUE(mask.EmplaceBack(30, 60));
+  EXPECT_TRUE(mask.EmplaceBack(70, 100));
+  EXPECT_FALSE(mask.EmplaceBack(90, 110));
+
+  // touching common parts are merged into one segment
+  EXPECT_TRUE(list.ApplyMask(mask));
+  EXPECT_EQ(SegmentSpans(list), (Spans{{0, 60}, {70, 100}}));
+
+  dali::FreeSegmentList window(20, 80, 4);
+  EXPECT_TRUE(list.ApplyMask(window));
+  EXPECT_EQ(SegmentSpans(list), (Spans{{20, 60}, {70, 80}}));
+
+  dali::FreeSegmentList gap(60, 70, 4);
+  EXPECT_TRUE(list.ApplyMask(gap));
+  EXPECT_TRUE(list.Empty());
+  EXPECT_FALSE(list.ApplyMask(mask));
+}
+
+TEST(FreeSegmentListTest, ShortSegmentsAreRemoved) {
+  dali::FreeSegmentList list;
+  list.SetMinWidth(4);
+  list.PushBack(dali::FreeSegment(0, 3));
+  list.PushBack(dali::FreeSegment(5, 12));
+  list.PushBack(dali::FreeSegment(12, 20));
+  list.PushBack(dali::FreeSegment(25, 27));
+  list.PushBack(dali::FreeSegment(30, 40));
+  EXPECT_EQ(SegmentSpans(list), (Spans{{0, 3}, {5, 20}, {25, 27}, {30, 40}}));
+
+  list.RemoveShortSeg(list.MinWidth());
+  EXPECT_EQ(SegmentSpans(list), (Spans{{5, 20}, {30, 40}}));
+  EXPECT_EQ(list.MinDispLoc(list.MinWidth()), 5);
+
+  dali::FreeSegmentList copy;
+  copy.CopyFrom(list);
+  EXPECT_EQ(SegmentSpans(copy), SegmentSpans(list));
+  EXPECT_EQ(copy.MinWidth(), 4);
+
+  list.RemoveShortSeg(12);
+  EXPECT_EQ(SegmentSpans(list), (Spans{{5, 20}}));
+}
+
+TEST(TetrisSpaceTest, BlocksSkipGapsNarrowerThanTheirWidth) {
+  dali::TetrisSpace space(0, 100, 0, 20, 10, 4);
+  EXPECT_TRUE(space.IsSpaceAvail(0, 0, 40, 10));
+  EXPECT_TRUE(space.IsSpaceAvail(45, 0, 55, 10));
+  EXPECT_FALSE(space.IsSpaceAvail(38, 0, 4, 10));
+
+  // the gap [40, 45) in row 0 is too narrow for a width of 8
+  dali::int2d loc;
+  EXPECT_TRUE(space.FindBlockLoc(40, 0, 8, 10, loc));
+  EXPECT_EQ(loc.x, 40);
+  EXPECT_EQ(loc.y, 10);
+  EXPECT_TRUE(space.FindBlockLoc(40, 0, 4, 10, loc));
+  EXPECT_EQ(loc.x, 40);
+  EXPECT_EQ(loc.y, 0);
+
+  // a two-row block needs the same free space in both rows
+  EXPECT_FALSE(space.FindBlockLoc(30, 0, 4, 20, loc));
+}
+
+// Locations given by the linked-list FreeSegmentList, before segments were
+// stored in flat vectors, for the same random blocks.
+TEST(TetrisSpaceTest, MatchesLinkedListImplementation) {
+  Spans expected = {
+      {121, 43}, {87, 14},  {158, 28}, {62, 58},  {183, 50}, {95, 45},
+      {43, 40},  {51, 75},  {5, 6},    {165, 62}, {104, 74}, {54, 50},
+      {9, 80},   {0, 60},   {74, 60},  {53, 20},  {143, 10}, {175, 60},
+      {105, 50}, {74, 50},  {131, 11}, {-1, -1},  {175, 80}, {127, 60},
+      {167, 0},  {192, 0},  {27, 50},  {0, 40},   {105, 20}, {15, 20},
+      {61, 10},  {-1, -1},  {104, 0},  {26, 40},  {140, 40}, {136, 20},
+      {181, 60}, {139, 60}, {190, 30}, {-1, -1},  {147, 20}, {-1, -1},
+      {159, 60}, {-1, -1},  {33, 90},  {161, 50}, {30, 20},  {-1, -1},
+      {127, 80}, {55, 80},  {67, 20},  {-1, -1},  {126, 0},  {-1, -1},
+      {-1, -1},  {156, 90}, {-1, -1},  {16, 80},  {-1, -1},  {25, 0},
+  };
+
+  // blocks of 1 or 2 rows are placed at their random locations if the space
+  // is free, and moved by FindBlockLoc() otherwise
+  dali::TetrisSpace space(0, 200, 0, 100, 10, 4);
+  std::mt19937 rng(7);
+  for (auto& expected_loc : expected) {
+    int width = 4 + static_cast<int>(rng() % 30);
+    int height = 10 * (1 + static_cast<int>(rng() % 2));
+    int llx = static_cast<int>(rng() % 200);
+    int lly = static_cast<int>(rng() % (101 - height));
+    dali::int2d loc(-1, -1);
+    if (space.IsSpaceAvail(llx, lly, width, height)) {
+      loc = dali::int2d(llx, lly);
+    } else if (!space.FindBlockLoc(llx, lly, width, height, loc)) {
+      loc = dali::int2d(-1, -1);
+    }
+    EXPECT_EQ(loc.x, expected_loc.first);
+    EXPECT_EQ(loc.y, expected_loc.second);
+  }
+}
+
+}  // namespace
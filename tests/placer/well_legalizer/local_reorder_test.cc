@@ -0,0 +1,228 @@
+/*******************************************************************************
+ *
+ * Copyright (c) 2026 Yihang Yang
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA  02110-1301, USA.
+ *
+ ******************************************************************************/
+#include "dali/placer/well_legalizer/std_cluster_well_legalizer.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <string>
+
+#include "dali/circuit/circuit.h"
+#include "dali/placer/well_legalizer/window_hpwl_evaluator.h"
+
+namespace {
+
+// Net i connects cell i to a few of the following cells, the last net
+// connects all cells and is too large to be part of the cost, and the cell
+// right after the window has a single-pin net.
+void BuildCircuit(dali::Circuit& circuit, int num_cells) {
+  circuit.SetDatabaseMicrons(1000);
+  circuit.SetManufacturingGrid(0.001);
+  circuit.AddMetalLayer("m1", 0.1, 0.1, 0.042, 0.2, 0.2, dali::VERTICAL);
+  circuit.AddMetalLayer("m2", 0.1, 0.1, 0.042, 0.2, 0.2, dali::HORIZONTAL);
+  circuit.SetGridValue(0.2, 0.2);
+  circuit.SetRowHeight(1.6);
+  dali::BlockType* cell = circuit.AddBlockType("CELL", 1.2, 1.6);
+  for (int p = 0; p < 3; ++p) {
+    dali::Pin* pin = circuit.AddBlkTypePin(cell, "P" + std::to_string(p), true);
+    pin->SetOffset(0.2 * p, 0.4 * p);
+  }
+  circuit.SetUnitsDistanceMicrons(1000);
+  circuit.SetDieArea(0, 0, 100000, 100000);
+  circuit.ReserveSpaceForDesignImp(num_cells, 0, 2 * num_cells);
+  for (int i = 0; i < num_cells; ++i) {
+    dali::BlockOrient orient = i % 3 == 0 ? dali::FN : dali::N;
+    circuit.AddBlock("c" + std::to_string(i), "CELL", 0, 0, dali::PLACED,
+                     orient, true);
+  }
+  for (int i = 0; i < num_cells; ++i) {
+    std::string net_name = "n" + std::to_string(i);
+    int fanout = std::min(2 + i % 4, num_cells - i);
+    circuit.AddNet(net_name, fanout, 1.0 + i % 3);
+    for (int k = 0; k < fanout; ++k) {
+      circuit.AddBlkPinToNet("c" + std::to_string(i + k),
+                             "P" + std::to_string(k % 3), net_name);
+    }
+  }
+  circuit.AddNet("single", 1, 1.0);
+  circuit.AddBlkPinToNet("c14", "P0", "single");
+  circuit.AddNet("large", num_cells, 1.0);
+  for (int i = 0; i < num_cells; ++i) {
+    circuit.AddBlkPinToNet("c" + std::to_string(i), "P1", "large");
+  }
+}
+
+// The cost used by local reordering before WindowHpwlEvaluator.
+double ReferenceCost(dali::Circuit& circuit,
+                     std::vector<dali::Block*> const& window) {
+  auto& nets = circuit.Nets();
+  std::set<dali::Net*> net_involved;
+  for (auto* blk : window) {
+    for (auto& net_num : blk->NetList()) {
+      if (nets[net_num].PinCnt() < 100) {
+        net_involved.insert(&(nets[net_num]));
+      }
+    }
+  }
+  double hpwl_x = 0;
+  double hpwl_y = 0;
+  for (auto& net : net_involved) {
+    hpwl_x += net->WeightedHPWLX();
+    hpwl_y += net->WeightedHPWLY();
+  }
+  return hpwl_x * circuit.GridValueX() + hpwl_y * circuit.GridValueY();
+}
+
+TEST(WindowHpwlEvaluatorTest, MatchesNetHpwlForEveryPermutation) {
+  int num_cells = 200;
+  dali::Circuit circuit;
+  BuildCircuit(circuit, num_cells);
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> dist(0, 400);
+  for (auto& blk : circuit.Blocks()) {
+    blk.SetLoc(dist(rng), dist(rng));
+  }
+
+  std::vector<dali::Block*> window;
+  for (int i = 10; i < 14; ++i) {
+    window.push_back(&circuit.Blocks()[i]);
+  }
+  std::vector<double> slots;
+  for (auto* blk : window) {
+    slots.push_back(blk->LLX());
+  }
+  std::sort(slots.begin(), slots.end());
+
+  dali::WindowHpwlEvaluator evaluator;
+  evaluator.SetCircuit(&circuit);
+  evaluator.SetWindow(window.data(), static_cast<int>(window.size()));
+  // nets 7, 9, 10, 11, 12 and 13 reach the window
+  EXPECT_EQ(evaluator.NumNets(), 6);
+  int num_permutations = 0;
+  std::sort(window.begin(), window.end());
+  do {
+    for (size_t j = 0; j < window.size(); ++j) {
+      window[j]->SetLLX(slots[j]);
+    }
+    EXPECT_EQ(evaluator.Cost(), ReferenceCost(circuit, window));
+    ++num_permutations;
+  } while (std::next_permutation(window.begin(), window.end()));
+  EXPECT_EQ(num_permutations, 24);
+}
+
+// Rows of 20 cells, plus nets connecting cells 50 apart, so that rows which
+// are not adjacent also share nets.
+TEST(LocalReorderTest, ClustersOfSameColorAreIndependent) {
+  int num_cells = 200;
+  int row_size = 20;
+  dali::Circuit circuit;
+  BuildCircuit(circuit, num_cells);
+  for (int i = 0; i + 50 < num_cells; i += 7) {
+    std::string net_name = "x" + std::to_string(i);
+    circuit.AddNet(net_name, 2, 1.0);
+    circuit.AddBlkPinToNet("c" + std::to_string(i), "P0", net_name);
+    circuit.AddBlkPinToNet("c" + std::to_string(i + 50), "P2", net_name);
+  }
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<double> dist(0, 400);
+  int num_clusters = num_cells / row_size;
+  std::vector<dali::GriddedRow> clusters(num_clusters);
+  std::vector<dali::GriddedRow*> cluster_ptrs;
+  for (int i = 0; i < num_cells; ++i) {
+    dali::Block& blk = circuit.Blocks()[i];
+    blk.SetLoc(std::round(dist(rng)), 10.0 * (i / row_size));
+    clusters[i / row_size].Blocks().push_back(&blk);
+  }
+  for (auto& cluster : clusters) {
+    cluster_ptrs.push_back(&cluster);
+  }
+
+  dali::StdClusterWellLegalizer legalizer;
+  legalizer.SetCircuit(&circuit);
+  std::vector<int> color_begin;
+  legalizer.GroupClustersByColor(cluster_ptrs, color_begin);
+  ASSERT_EQ(color_begin.back(), num_clusters);
+  EXPECT_GT(color_begin.size(), 2u);
+
+  // clusters keep their order within a color, and share no evaluated nets
+  auto& nets = circuit.Nets();
+  std::vector<int> colors(num_cells);
+  for (size_t c = 0; c + 1 < color_begin.size(); ++c) {
+    for (int k = color_begin[c]; k < color_begin[c + 1]; ++k) {
+      if (k > color_begin[c]) {
+        EXPECT_LT(cluster_ptrs[k - 1], cluster_ptrs[k]);
+      }
+      for (auto* blk_ptr : cluster_ptrs[k]->Blocks()) {
+        colors[blk_ptr->Id()] = static_cast<int>(c);
+      }
+    }
+  }
+  for (auto& net : nets) {
+    if (net.PinCnt() >= dali::WindowHpwlEvaluator::kMaxNetPinCnt) continue;
+    for (auto& pin0 : net.BlockPins()) {
+      for (auto& pin1 : net.BlockPins()) {
+        int id0 = pin0.BlkPtr()->Id();
+        int id1 = pin1.BlkPtr()->Id();
+        if (id0 / row_size != id1 / row_size) {
+          EXPECT_NE(colors[id0], colors[id1]) << net.Name();
+        }
+      }
+    }
+  }
+
+  // reordering clusters of a color in any order gives the same placement
+  std::vector<double> init_llx;
+  for (auto& blk : circuit.Blocks()) {
+    init_llx.push_back(blk.LLX());
+  }
+  std::vector<std::vector<dali::Block*>> init_orders;
+  for (auto& cluster : clusters) {
+    init_orders.push_back(cluster.Blocks());
+  }
+  auto reorder = [&](bool is_reversed) {
+    for (int i = 0; i < num_cells; ++i) {
+      circuit.Blocks()[i].SetLLX(init_llx[i]);
+    }
+    for (int i = 0; i < num_clusters; ++i) {
+      clusters[i].Blocks() = init_orders[i];
+    }
+    dali::WindowHpwlEvaluator evaluator;
+    evaluator.SetCircuit(&circuit);
+    for (size_t c = 0; c + 1 < color_begin.size(); ++c) {
+      for (int k = color_begin[c]; k < color_begin[c + 1]; ++k) {
+        int index = is_reversed ? color_begin[c + 1] - 1 - (k - color_begin[c])
+                                : k;
+        legalizer.LocalReorderInCluster(cluster_ptrs[index], evaluator, 4);
+      }
+    }
+    std::vector<double> llx;
+    for (auto& blk : circuit.Blocks()) {
+      llx.push_back(blk.LLX());
+    }
+    return llx;
+  };
+  EXPECT_EQ(reorder(false), reorder(true));
+}
+
+}  // namespace